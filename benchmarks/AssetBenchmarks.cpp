@@ -0,0 +1,84 @@
+#include <source/components/assets/fonts/Font.h>
+#include <source/components/assets/objects/Model.h>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <benchmark/benchmark.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+  const std::vector<uint8_t>& getFontBuffer()
+  {
+    static const auto fontBuffer = vke::Font::loadFontFromFile(
+      VKE_BENCHMARK_ASSETS_DIR "/fonts/Roboto-VariableFont_wdth,wght.ttf"
+    );
+
+    return fontBuffer;
+  }
+
+  // Imported with the same post-processing as Model so only vertex and index extraction is measured
+  const aiMesh* getMesh()
+  {
+    static Assimp::Importer importer;
+    static const aiScene* scene = importer.ReadFile(
+      VKE_BENCHMARK_ASSETS_DIR "/models/viking_room.obj",
+      aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs |
+      aiProcess_CalcTangentSpace | aiProcess_PreTransformVertices
+    );
+
+    if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
+    {
+      throw std::runtime_error("Assimp Error: " + std::string(importer.GetErrorString()));
+    }
+
+    return scene->mMeshes[0];
+  }
+
+} // namespace
+
+static void BM_FontCreateAtlas(benchmark::State& state)
+{
+  const auto& fontBuffer = getFontBuffer();
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(vke::Font::createAtlas(fontBuffer, static_cast<uint32_t>(state.range(0))));
+  }
+}
+BENCHMARK(BM_FontCreateAtlas)->Arg(16)->Arg(32)->Arg(64)->Unit(benchmark::kMillisecond);
+
+static void BM_ModelLoadVertices(benchmark::State& state)
+{
+  const aiMesh* mesh = getMesh();
+  const auto orientation = glm::quat(glm::radians(glm::vec3(-90.0f, 0.0f, 0.0f)));
+
+  for (auto _ : state)
+  {
+    std::vector<vke::Vertex> vertices;
+    vke::Model::loadVertices(mesh, orientation, vertices);
+
+    benchmark::DoNotOptimize(vertices.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * mesh->mNumVertices);
+}
+BENCHMARK(BM_ModelLoadVertices)->Unit(benchmark::kMicrosecond);
+
+static void BM_ModelLoadIndices(benchmark::State& state)
+{
+  const aiMesh* mesh = getMesh();
+
+  for (auto _ : state)
+  {
+    std::vector<uint32_t> indices;
+    vke::Model::loadIndices(mesh, indices);
+
+    benchmark::DoNotOptimize(indices.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * mesh->mNumFaces);
+}
+BENCHMARK(BM_ModelLoadIndices)->Unit(benchmark::kMicrosecond);
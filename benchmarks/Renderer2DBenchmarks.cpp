@@ -0,0 +1,128 @@
+#include <source/components/assets/fonts/Font.h>
+#include <source/components/renderingManager/renderer2D/Renderer2D.h>
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+  const vke::FontAtlas& getFontAtlas()
+  {
+    static const vke::FontAtlas atlas = vke::Font::createAtlas(
+      vke::Font::loadFontFromFile(VKE_BENCHMARK_ASSETS_DIR "/fonts/Roboto-VariableFont_wdth,wght.ttf"),
+      32
+    );
+
+    return atlas;
+  }
+
+  const std::string sampleText = "The quick brown fox jumps over the lazy dog 0123456789 "
+                                 "\xC3\xA9\xC3\xA8\xC3\xBC \xE2\x82\xAC\xE2\x84\xA2 \xF0\x9F\x98\x80";
+
+  void submitPrimitives(vke::Renderer2D& renderer2D,
+                        const int64_t primitiveCount)
+  {
+    for (int64_t i = 0; i < primitiveCount; ++i)
+    {
+      const auto offset = static_cast<float>(i % 256);
+
+      renderer2D.pushMatrix();
+      renderer2D.translate(offset, offset);
+      renderer2D.rotate(offset);
+      renderer2D.fill(offset, 128, 255 - offset);
+
+      switch (i % 3)
+      {
+        case 0:
+          renderer2D.rect(0, 0, 32, 32);
+          break;
+        case 1:
+          renderer2D.triangle(0, 0, 32, 0, 16, 32);
+          break;
+        default:
+          renderer2D.ellipse(0, 0, 32, 32);
+          break;
+      }
+
+      renderer2D.popMatrix();
+    }
+  }
+
+} // namespace
+
+static void BM_Renderer2DPrimitiveSubmission(benchmark::State& state)
+{
+  vke::Renderer2D renderer2D(nullptr);
+
+  for (auto _ : state)
+  {
+    renderer2D.createNewFrame();
+
+    submitPrimitives(renderer2D, state.range(0));
+
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Renderer2DPrimitiveSubmission)->RangeMultiplier(8)->Range(64, 32768);
+
+static void BM_Renderer2DNormalizeZValues(benchmark::State& state)
+{
+  vke::Renderer2D renderer2D(nullptr);
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    renderer2D.createNewFrame();
+    submitPrimitives(renderer2D, state.range(0));
+    state.ResumeTiming();
+
+    renderer2D.normalizeZValues();
+
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Renderer2DNormalizeZValues)->RangeMultiplier(8)->Range(512, 32768);
+
+static void BM_DecodeUTF8(benchmark::State& state)
+{
+  std::string text;
+  for (int64_t i = 0; i < state.range(0); ++i)
+  {
+    text += sampleText;
+  }
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(vke::decodeUTF8(text));
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_DecodeUTF8)->RangeMultiplier(8)->Range(1, 512);
+
+static void BM_Renderer2DLayoutText(benchmark::State& state)
+{
+  const auto& atlas = getFontAtlas();
+
+  std::vector<vke::Glyph> glyphs;
+
+  for (auto _ : state)
+  {
+    glyphs.clear();
+
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+      vke::Renderer2D::layoutText(atlas, sampleText, 0.0f, static_cast<float>(i) * atlas.maxGlyphHeight,
+                                  glm::vec4(1.0f), glm::mat4(1.0f), static_cast<float>(i), glyphs);
+    }
+
+    benchmark::DoNotOptimize(glyphs.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Renderer2DLayoutText)->RangeMultiplier(8)->Range(1, 512);
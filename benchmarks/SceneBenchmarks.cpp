@@ -0,0 +1,116 @@
+#include <source/components/assets/objects/RenderObject.h>
+#include <source/components/lighting/lights/PointLight.h>
+#include <source/components/pipelines/implementations/vertexInputs/Vertex.h>
+#include <source/components/renderingManager/renderer3D/RayTracer.h>
+#include <source/utilities/EventSystem.h>
+#include <benchmark/benchmark.h>
+#include <vector>
+
+namespace {
+
+  struct BenchmarkEvent {
+    float value;
+  };
+
+  class BenchmarkEventSystem : public vke::EventSystem<BenchmarkEvent> {};
+
+  glm::vec3 getSamplePosition(const int64_t i)
+  {
+    const auto f = static_cast<float>(i);
+
+    return { f * 0.5f, f * 0.25f - 8.0f, -f };
+  }
+
+} // namespace
+
+static void BM_RenderObjectModelMatrix(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+      const auto position = getSamplePosition(i);
+
+      benchmark::DoNotOptimize(vke::RenderObject::createModelMatrix(
+        position,
+        glm::quat(glm::radians(position)),
+        glm::vec3(1.5f)
+      ));
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RenderObjectModelMatrix)->RangeMultiplier(8)->Range(64, 32768);
+
+static void BM_PointLightViewProjectionMatrices(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+      benchmark::DoNotOptimize(vke::PointLight::createLightViewProjectionMatrices(getSamplePosition(i), 100.0f));
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PointLightViewProjectionMatrices)->RangeMultiplier(4)->Range(1, 1024);
+
+static void BM_EventSystemEmit(benchmark::State& state)
+{
+  BenchmarkEventSystem eventSystem;
+
+  float total = 0.0f;
+
+  std::vector<vke::EventListener<BenchmarkEvent>> listeners;
+  for (int64_t i = 0; i < state.range(0); ++i)
+  {
+    listeners.push_back(eventSystem.on<BenchmarkEvent>([&total](const BenchmarkEvent& event) {
+      total += event.value;
+    }));
+  }
+
+  for (auto _ : state)
+  {
+    eventSystem.emit(BenchmarkEvent { 1.0f });
+  }
+
+  benchmark::DoNotOptimize(total);
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EventSystemEmit)->RangeMultiplier(4)->Range(1, 256);
+
+static void BM_RayTracerMergeMeshGeometry(benchmark::State& state)
+{
+  constexpr uint32_t verticesPerMesh = 4096;
+  constexpr uint32_t indicesPerMesh = 6144;
+
+  const std::vector<vke::Vertex> vertices(verticesPerMesh);
+
+  std::vector<uint32_t> indices(indicesPerMesh);
+  for (uint32_t i = 0; i < indicesPerMesh; ++i)
+  {
+    indices[i] = i % verticesPerMesh;
+  }
+
+  for (auto _ : state)
+  {
+    std::vector<vke::Vertex> mergedVertices;
+    std::vector<uint32_t> mergedIndices;
+    std::vector<vke::MeshInfo> meshInfos;
+
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+      meshInfos.push_back(vke::RayTracer::mergeMeshGeometry(vertices, indices, mergedVertices, mergedIndices));
+    }
+
+    benchmark::DoNotOptimize(mergedVertices.data());
+    benchmark::DoNotOptimize(mergedIndices.data());
+    benchmark::DoNotOptimize(meshInfos.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RayTracerMergeMeshGeometry)->RangeMultiplier(4)->Range(1, 256)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,419 @@
+#include "BenchmarkReport.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+  // Differences below this are treated as noise regardless of the relative tolerance
+  constexpr double MIN_REGRESSION_DELTA = 0.05;
+
+  constexpr std::string_view SCENES_PREFIX = "scenes.";
+
+  // Just enough JSON to read reports back, every number is recorded under its dotted path
+  class JsonFlattener {
+  public:
+    JsonFlattener(const std::string& text,
+                  ReportMetrics& metrics)
+      : m_text(text), m_metrics(metrics)
+    {}
+
+    void parse()
+    {
+      parseValue("");
+
+      skipWhitespace();
+      if (m_position != m_text.size())
+      {
+        throw std::runtime_error("Unexpected trailing characters in benchmark report");
+      }
+    }
+
+  private:
+    const std::string& m_text;
+    ReportMetrics& m_metrics;
+    size_t m_position = 0;
+
+    void parseValue(const std::string& path)
+    {
+      skipWhitespace();
+
+      switch (peek())
+      {
+        case '{':
+          parseObject(path);
+          break;
+        case '[':
+          parseArray(path);
+          break;
+        case '"':
+          static_cast<void>(parseString());
+          break;
+        case 't':
+          expect("true");
+          break;
+        case 'f':
+          expect("false");
+          break;
+        case 'n':
+          expect("null");
+          break;
+        default:
+          m_metrics[path] = parseNumber();
+          break;
+      }
+    }
+
+    void parseObject(const std::string& path)
+    {
+      expect("{");
+
+      skipWhitespace();
+      if (peek() == '}')
+      {
+        ++m_position;
+        return;
+      }
+
+      while (true)
+      {
+        skipWhitespace();
+        const auto key = parseString();
+
+        skipWhitespace();
+        expect(":");
+
+        parseValue(path.empty() ? key : path + "." + key);
+
+        skipWhitespace();
+        if (peek() == ',')
+        {
+          ++m_position;
+          continue;
+        }
+
+        expect("}");
+        return;
+      }
+    }
+
+    void parseArray(const std::string& path)
+    {
+      expect("[");
+
+      skipWhitespace();
+      if (peek() == ']')
+      {
+        ++m_position;
+        return;
+      }
+
+      for (size_t index = 0;; ++index)
+      {
+        parseValue(path + "." + std::to_string(index));
+
+        skipWhitespace();
+        if (peek() == ',')
+        {
+          ++m_position;
+          continue;
+        }
+
+        expect("]");
+        return;
+      }
+    }
+
+    std::string parseString()
+    {
+      expect("\"");
+
+      std::string string;
+      while (peek() != '"')
+      {
+        if (peek() == '\\')
+        {
+          ++m_position;
+        }
+
+        string += peek();
+        ++m_position;
+      }
+
+      ++m_position;
+
+      return string;
+    }
+
+    double parseNumber()
+    {
+      const char* begin = m_text.c_str() + m_position;
+      char* end = nullptr;
+
+      const double number = std::strtod(begin, &end);
+      if (end == begin)
+      {
+        throw std::runtime_error("Malformed number in benchmark report");
+      }
+
+      m_position += end - begin;
+
+      return number;
+    }
+
+    void expect(const std::string_view token)
+    {
+      if (m_text.compare(m_position, token.size(), token) != 0)
+      {
+        throw std::runtime_error("Malformed benchmark report, expected " + std::string(token));
+      }
+
+      m_position += token.size();
+    }
+
+    [[nodiscard]] char peek() const
+    {
+      if (m_position >= m_text.size())
+      {
+        throw std::runtime_error("Unexpected end of benchmark report");
+      }
+
+      return m_text[m_position];
+    }
+
+    void skipWhitespace()
+    {
+      while (m_position < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_position])))
+      {
+        ++m_position;
+      }
+    }
+  };
+
+  void writePercentiles(std::ofstream& file,
+                        const char* name,
+                        const Percentiles& percentiles)
+  {
+    file << "      \"" << name << "\": { \"p50\": " << percentiles.p50
+         << ", \"p95\": " << percentiles.p95
+         << ", \"p99\": " << percentiles.p99 << " }";
+  }
+
+  void addPercentiles(ReportMetrics& metrics,
+                      const std::string& prefix,
+                      const Percentiles& percentiles)
+  {
+    metrics[prefix + ".p50"] = percentiles.p50;
+    metrics[prefix + ".p95"] = percentiles.p95;
+    metrics[prefix + ".p99"] = percentiles.p99;
+  }
+
+  std::string getSceneName(const std::string& key)
+  {
+    const auto end = key.find('.', SCENES_PREFIX.size());
+
+    return key.substr(SCENES_PREFIX.size(), end - SCENES_PREFIX.size());
+  }
+
+  bool isParameter(const std::string& key)
+  {
+    return key.find(".parameters.") != std::string::npos;
+  }
+
+  // Scenes only compare against a baseline recorded with the same scene parameters
+  std::set<std::string> getMismatchedScenes(const ReportMetrics& current,
+                                            const ReportMetrics& baseline)
+  {
+    std::set<std::string> mismatchedScenes;
+
+    for (const auto& [key, value] : current)
+    {
+      if (!key.starts_with(SCENES_PREFIX) || !isParameter(key))
+      {
+        continue;
+      }
+
+      const auto it = baseline.find(key);
+      if (it != baseline.end() && it->second != value)
+      {
+        mismatchedScenes.insert(getSceneName(key));
+      }
+    }
+
+    return mismatchedScenes;
+  }
+
+} // namespace
+
+Percentiles computePercentiles(std::vector<double> samples)
+{
+  if (samples.empty())
+  {
+    return {};
+  }
+
+  std::ranges::sort(samples);
+
+  const auto percentile = [&samples](const double fraction) {
+    const auto rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(samples.size())));
+
+    return samples[std::clamp<size_t>(rank, 1, samples.size()) - 1];
+  };
+
+  return {
+    .p50 = percentile(0.50),
+    .p95 = percentile(0.95),
+    .p99 = percentile(0.99)
+  };
+}
+
+void writeReport(const std::string& path,
+                 const RunSettings& settings,
+                 const std::vector<SceneResult>& results)
+{
+  std::ofstream file(path);
+
+  if (!file.is_open())
+  {
+    throw std::runtime_error("Failed to open benchmark report: " + path);
+  }
+
+  file << std::fixed << std::setprecision(4);
+
+  file << "{\n"
+       << "  \"settings\": {\n"
+       << "    \"frames\": " << settings.frames << ",\n"
+       << "    \"warmupFrames\": " << settings.warmupFrames << ",\n"
+       << "    \"timestep\": " << settings.timestep << ",\n"
+       << "    \"width\": " << settings.width << ",\n"
+       << "    \"height\": " << settings.height << "\n"
+       << "  },\n"
+       << "  \"scenes\": {";
+
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    const auto& result = results[i];
+
+    file << (i == 0 ? "\n" : ",\n")
+         << "    \"" << result.name << "\": {\n"
+         << "      \"parameters\": { \"objectCount\": " << result.parameters.objectCount
+         << ", \"lightCount\": " << result.parameters.lightCount
+         << ", \"particleCount\": " << result.parameters.particleCount << " },\n"
+         << "      \"startupMs\": " << result.startupMs << ",\n";
+
+    if (result.peakDeviceMemoryMiB)
+    {
+      file << "      \"peakDeviceMemoryMiB\": " << *result.peakDeviceMemoryMiB << ",\n";
+    }
+
+    writePercentiles(file, "cpuFrameMs", result.cpuFrameMs);
+    file << ",\n";
+    writePercentiles(file, "gpuGraphicsMs", result.gpuGraphicsMs);
+    file << ",\n";
+    writePercentiles(file, "gpuComputeMs", result.gpuComputeMs);
+    file << "\n    }";
+  }
+
+  file << "\n  }\n}\n";
+}
+
+ReportMetrics readReportMetrics(const std::string& path)
+{
+  std::ifstream file(path);
+
+  if (!file.is_open())
+  {
+    throw std::runtime_error("Failed to open benchmark baseline: " + path);
+  }
+
+  std::stringstream stream;
+  stream << file.rdbuf();
+  const auto text = stream.str();
+
+  ReportMetrics metrics;
+  JsonFlattener(text, metrics).parse();
+
+  return metrics;
+}
+
+ReportMetrics getReportMetrics(const std::vector<SceneResult>& results)
+{
+  ReportMetrics metrics;
+
+  for (const auto& result : results)
+  {
+    const auto prefix = std::string(SCENES_PREFIX) + result.name;
+
+    metrics[prefix + ".parameters.objectCount"] = result.parameters.objectCount;
+    metrics[prefix + ".parameters.lightCount"] = result.parameters.lightCount;
+    metrics[prefix + ".parameters.particleCount"] = result.parameters.particleCount;
+
+    metrics[prefix + ".startupMs"] = result.startupMs;
+
+    if (result.peakDeviceMemoryMiB)
+    {
+      metrics[prefix + ".peakDeviceMemoryMiB"] = *result.peakDeviceMemoryMiB;
+    }
+
+    addPercentiles(metrics, prefix + ".cpuFrameMs", result.cpuFrameMs);
+    addPercentiles(metrics, prefix + ".gpuGraphicsMs", result.gpuGraphicsMs);
+    addPercentiles(metrics, prefix + ".gpuComputeMs", result.gpuComputeMs);
+  }
+
+  return metrics;
+}
+
+uint32_t compareAgainstBaseline(const ReportMetrics& current,
+                                const ReportMetrics& baseline,
+                                const double tolerance)
+{
+  const auto mismatchedScenes = getMismatchedScenes(current, baseline);
+
+  for (const auto& scene : mismatchedScenes)
+  {
+    std::cout << "Skipping " << scene << ", its parameters differ from the baseline" << std::endl;
+  }
+
+  uint32_t regressions = 0;
+
+  std::cout << std::fixed << std::setprecision(3);
+
+  for (const auto& [key, value] : current)
+  {
+    if (!key.starts_with(SCENES_PREFIX) || isParameter(key) || mismatchedScenes.contains(getSceneName(key)))
+    {
+      continue;
+    }
+
+    const auto it = baseline.find(key);
+    if (it == baseline.end())
+    {
+      continue;
+    }
+
+    const double baselineValue = it->second;
+    const double delta = value - baselineValue;
+    const bool regressed = delta > MIN_REGRESSION_DELTA && value > baselineValue * (1.0 + tolerance);
+
+    const double change = baselineValue > 0.0 ? delta / baselineValue * 100.0 : 0.0;
+
+    std::cout << (regressed ? "REGRESSION " : "           ")
+              << std::left << std::setw(48) << key.substr(SCENES_PREFIX.size())
+              << std::right << std::setw(12) << baselineValue << " -> " << std::setw(12) << value
+              << " (" << std::showpos << change << std::noshowpos << "%)" << std::endl;
+
+    if (regressed)
+    {
+      ++regressions;
+    }
+  }
+
+  return regressions;
+}
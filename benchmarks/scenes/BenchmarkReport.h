@@ -0,0 +1,56 @@
+#ifndef VKE_BENCHMARKREPORT_H
+#define VKE_BENCHMARKREPORT_H
+
+#include "BenchmarkScene.h"
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct Percentiles {
+  double p50 = 0.0;
+  double p95 = 0.0;
+  double p99 = 0.0;
+};
+
+// Nearest-rank percentiles, all zero when there are no samples
+[[nodiscard]] Percentiles computePercentiles(std::vector<double> samples);
+
+struct SceneResult {
+  std::string name;
+  SceneParameters parameters;
+
+  double startupMs = 0.0;
+  std::optional<double> peakDeviceMemoryMiB;
+
+  Percentiles cpuFrameMs;
+  Percentiles gpuGraphicsMs;
+  Percentiles gpuComputeMs;
+};
+
+struct RunSettings {
+  uint32_t frames = 0;
+  uint32_t warmupFrames = 0;
+  float timestep = 0.0f;
+  uint32_t width = 0;
+  uint32_t height = 0;
+};
+
+using ReportMetrics = std::map<std::string, double>;
+
+void writeReport(const std::string& path,
+                 const RunSettings& settings,
+                 const std::vector<SceneResult>& results);
+
+// Flattens every number in a report into dotted paths such as scenes.shadows.cpuFrameMs.p95
+[[nodiscard]] ReportMetrics readReportMetrics(const std::string& path);
+
+[[nodiscard]] ReportMetrics getReportMetrics(const std::vector<SceneResult>& results);
+
+// Prints every compared metric and returns how many exceeded the baseline by more than the tolerance
+[[nodiscard]] uint32_t compareAgainstBaseline(const ReportMetrics& current,
+                                              const ReportMetrics& baseline,
+                                              double tolerance);
+
+#endif //VKE_BENCHMARKREPORT_H
@@ -0,0 +1,526 @@
+#include "BenchmarkScene.h"
+#include <source/VulkanEngine.h>
+#include <source/components/assets/AssetManager.h>
+#include <source/components/assets/objects/Cloud.h>
+#include <source/components/assets/objects/RenderObject.h>
+#include <source/components/assets/particleSystems/SmokeSystem.h>
+#include <source/components/lighting/LightingManager.h>
+#include <source/components/pipelines/implementations/common/PipelineTypes.h>
+#include <source/components/renderingManager/RenderingManager.h>
+#include <source/components/renderingManager/renderer2D/Renderer2D.h>
+#include <source/components/renderingManager/renderer3D/Renderer3D.h>
+#include <glm/gtc/constants.hpp>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+  constexpr std::array LIGHT_COLORS {
+    glm::vec3(1.0f, 1.0f, 1.0f),
+    glm::vec3(1.0f, 1.0f, 0.0f),
+    glm::vec3(0.5f, 0.5f, 1.0f),
+    glm::vec3(0.0f, 1.0f, 0.0f),
+    glm::vec3(1.0f, 0.5f, 1.0f)
+  };
+
+  // Matches the demo layouts, the first position is the centre and the rest fill rings of four around it
+  glm::vec3 getRingPosition(const uint32_t index,
+                            const float height)
+  {
+    if (index == 0)
+    {
+      return { 0.0f, height, 0.0f };
+    }
+
+    const uint32_t ring = (index - 1) / 4 + 1;
+    const float angle = glm::quarter_pi<float>() + glm::half_pi<float>() * static_cast<float>((index - 1) % 4) +
+                        glm::pi<float>() / 8.0f * static_cast<float>(ring - 1);
+    const float radius = 5.0f * std::sqrt(2.0f) * static_cast<float>(ring);
+
+    return { radius * std::cos(angle), height, radius * std::sin(angle) };
+  }
+
+  glm::vec3 getGridPosition(const uint32_t index,
+                            const uint32_t count,
+                            const float spacing,
+                            const float height)
+  {
+    const auto side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(count))));
+    const float offset = static_cast<float>(side - 1) * spacing * 0.5f;
+
+    return {
+      static_cast<float>(index % side) * spacing - offset,
+      height,
+      static_cast<float>(index / side) * spacing - offset
+    };
+  }
+
+  std::vector<std::shared_ptr<vke::Light>> createLights(const vke::VulkanEngine& engine,
+                                                        const uint32_t lightCount,
+                                                        const float height,
+                                                        const bool includeSpotLights = false)
+  {
+    std::vector<std::shared_ptr<vke::Light>> lights;
+
+    for (uint32_t i = 0; i < lightCount; ++i)
+    {
+      const auto position = getRingPosition(i, height);
+      const auto color = LIGHT_COLORS[i % LIGHT_COLORS.size()];
+      const float ambient = i == 0 ? 0.1f : 0.0f;
+
+      if (includeSpotLights && i % LIGHT_COLORS.size() < 2)
+      {
+        lights.push_back(engine.getLightingManager()->createSpotLight(position, color, ambient, 0.5f, 1.0f));
+      }
+      else
+      {
+        lights.push_back(engine.getLightingManager()->createPointLight(position, color, ambient, 0.5f, 1.0f));
+      }
+    }
+
+    return lights;
+  }
+
+  std::shared_ptr<vke::RenderObject> createSquare(const vke::VulkanEngine& engine)
+  {
+    const auto assetManager = engine.getAssetManager();
+
+    return assetManager->loadRenderObject(
+      assetManager->loadTexture("assets/textures/white.png"),
+      assetManager->loadTexture("assets/textures/blank_specular.png"),
+      assetManager->loadModel("assets/models/square.glb")
+    );
+  }
+
+  std::vector<std::shared_ptr<vke::RenderObject>> createSquareGrid(const vke::VulkanEngine& engine,
+                                                                   const uint32_t objectCount,
+                                                                   const float height)
+  {
+    std::vector<std::shared_ptr<vke::RenderObject>> objects;
+
+    for (uint32_t i = 0; i < objectCount; ++i)
+    {
+      const auto object = createSquare(engine);
+      object->setPosition(getGridPosition(i, objectCount, 5.0f, height));
+      objects.push_back(object);
+    }
+
+    return objects;
+  }
+
+  void renderLights(const vke::VulkanEngine& engine,
+                    const std::vector<std::shared_ptr<vke::Light>>& lights)
+  {
+    for (const auto& light : lights)
+    {
+      engine.getLightingManager()->renderLight(light);
+    }
+  }
+
+  class ShadowsScene final : public BenchmarkScene {
+  public:
+    [[nodiscard]] SceneParameters getDefaultParameters() const override
+    {
+      return { .objectCount = 3, .lightCount = 5 };
+    }
+
+    [[nodiscard]] CameraPath getCameraPath() const override
+    {
+      return { .target = { 0.0f, -5.0f, 0.0f }, .radius = 20.0f, .height = 5.0f };
+    }
+
+    void setup(const vke::VulkanEngine& engine,
+               const SceneParameters& parameters) override
+    {
+      m_objects = createSquareGrid(engine, parameters.objectCount, -5.0f);
+      m_lights = createLights(engine, parameters.lightCount, -3.5f, true);
+    }
+
+    void submit(const vke::VulkanEngine& engine,
+                [[maybe_unused]] const float time) override
+    {
+      const auto r3d = engine.getRenderingManager()->getRenderer3D();
+
+      for (const auto& object : m_objects)
+      {
+        r3d->renderObject(object, vke::PipelineType::object);
+      }
+
+      renderLights(engine, m_lights);
+    }
+
+  private:
+    std::vector<std::shared_ptr<vke::RenderObject>> m_objects;
+    std::vector<std::shared_ptr<vke::Light>> m_lights;
+  };
+
+  // The object count scales the number of smoke systems, the particle count is the base count per system
+  class SmokeScene final : public BenchmarkScene {
+  public:
+    [[nodiscard]] SceneParameters getDefaultParameters() const override
+    {
+      return { .objectCount = 5, .lightCount = 5, .particleCount = 2'500'000 };
+    }
+
+    [[nodiscard]] CameraPath getCameraPath() const override
+    {
+      return { .target = { 0.0f, 2.0f, 0.0f }, .radius = 15.0f, .height = 5.0f };
+    }
+
+    void setup(const vke::VulkanEngine& engine,
+               const SceneParameters& parameters) override
+    {
+      m_floor = createSquare(engine);
+
+      m_lights = createLights(engine, parameters.lightCount, 1.5f);
+
+      // Particle counts vary per system like the demo
+      constexpr std::array particleScales { 1.0f, 2.0f, 0.5f, 2.0f, 0.5f };
+
+      for (uint32_t i = 0; i < parameters.objectCount; ++i)
+      {
+        const auto numParticles = static_cast<uint32_t>(static_cast<float>(parameters.particleCount) *
+                                                        particleScales[i % particleScales.size()]);
+
+        m_smokeSystems.push_back(engine.getAssetManager()->createSmokeSystem(getRingPosition(i, 0.95f), numParticles));
+      }
+    }
+
+    void submit(const vke::VulkanEngine& engine,
+                [[maybe_unused]] const float time) override
+    {
+      const auto r3d = engine.getRenderingManager()->getRenderer3D();
+
+      r3d->renderObject(m_floor, vke::PipelineType::object);
+
+      for (const auto& smokeSystem : m_smokeSystems)
+      {
+        r3d->renderSmokeSystem(smokeSystem);
+      }
+
+      renderLights(engine, m_lights);
+    }
+
+  private:
+    std::shared_ptr<vke::RenderObject> m_floor;
+    std::vector<std::shared_ptr<vke::Light>> m_lights;
+    std::vector<std::shared_ptr<vke::SmokeSystem>> m_smokeSystems;
+  };
+
+  // The object count adds squares on top of the cloud floor
+  class CloudsScene final : public BenchmarkScene {
+  public:
+    [[nodiscard]] SceneParameters getDefaultParameters() const override
+    {
+      return { .objectCount = 0, .lightCount = 5 };
+    }
+
+    [[nodiscard]] CameraPath getCameraPath() const override
+    {
+      return { .target = { 0.0f, 5.0f, 0.0f }, .radius = 15.0f, .height = 5.0f };
+    }
+
+    void setup(const vke::VulkanEngine& engine,
+               const SceneParameters& parameters) override
+    {
+      m_floor = createSquare(engine);
+      m_floor->setScale({ 1000.0f, 1.0f, 1000.0f });
+
+      m_objects = createSquareGrid(engine, parameters.objectCount, 1.0f);
+
+      m_lights = createLights(engine, parameters.lightCount, 1.5f);
+
+      m_cloud = engine.getAssetManager()->createCloud();
+    }
+
+    void submit(const vke::VulkanEngine& engine,
+                const float time) override
+    {
+      const auto r3d = engine.getRenderingManager()->getRenderer3D();
+
+      // Same rate the demo advances the cloud at
+      m_cloud->setTime(time / 250.0f);
+      r3d->setCloudToRender(m_cloud);
+
+      r3d->renderObject(m_floor, vke::PipelineType::object);
+
+      for (const auto& object : m_objects)
+      {
+        r3d->renderObject(object, vke::PipelineType::object);
+      }
+
+      renderLights(engine, m_lights);
+    }
+
+  private:
+    std::shared_ptr<vke::RenderObject> m_floor;
+    std::vector<std::shared_ptr<vke::RenderObject>> m_objects;
+    std::vector<std::shared_ptr<vke::Light>> m_lights;
+    std::shared_ptr<vke::Cloud> m_cloud;
+  };
+
+  // The object count scales the number of bendy plants
+  class PlantsScene final : public BenchmarkScene {
+  public:
+    [[nodiscard]] SceneParameters getDefaultParameters() const override
+    {
+      return { .objectCount = 2, .lightCount = 5 };
+    }
+
+    [[nodiscard]] CameraPath getCameraPath() const override
+    {
+      return { .target = { 0.0f, -3.0f, 0.0f }, .radius = 12.0f, .height = 2.0f };
+    }
+
+    void setup(const vke::VulkanEngine& engine,
+               const SceneParameters& parameters) override
+    {
+      m_floor = createSquare(engine);
+      m_floor->setPosition({ 0, -5, 0 });
+
+      m_lights = createLights(engine, parameters.lightCount, -3.5f);
+
+      for (uint32_t i = 0; i < parameters.objectCount; ++i)
+      {
+        m_bendyPlants.push_back({
+          .position = getGridPosition(i, parameters.objectCount, 6.0f, -4.0f)
+        });
+      }
+    }
+
+    void submit(const vke::VulkanEngine& engine,
+                [[maybe_unused]] const float time) override
+    {
+      const auto r3d = engine.getRenderingManager()->getRenderer3D();
+
+      r3d->renderObject(m_floor, vke::PipelineType::object);
+
+      renderLights(engine, m_lights);
+
+      for (const auto& bendyPlant : m_bendyPlants)
+      {
+        r3d->renderBendyPlant(bendyPlant);
+      }
+    }
+
+  private:
+    std::shared_ptr<vke::RenderObject> m_floor;
+    std::vector<std::shared_ptr<vke::Light>> m_lights;
+    std::vector<vke::BendyPlant> m_bendyPlants;
+  };
+
+  class RenderObjectScene final : public BenchmarkScene {
+  public:
+    [[nodiscard]] SceneParameters getDefaultParameters() const override
+    {
+      return { .objectCount = 1, .lightCount = 5 };
+    }
+
+    [[nodiscard]] CameraPath getCameraPath() const override
+    {
+      return { .target = glm::vec3(0.0f), .radius = 10.0f, .height = 3.0f };
+    }
+
+    void setup(const vke::VulkanEngine& engine,
+               const SceneParameters& parameters) override
+    {
+      m_objects = createSquareGrid(engine, parameters.objectCount, 0.0f);
+      m_lights = createLights(engine, parameters.lightCount, 1.5f);
+    }
+
+    void submit(const vke::VulkanEngine& engine,
+                [[maybe_unused]] const float time) override
+    {
+      const auto r3d = engine.getRenderingManager()->getRenderer3D();
+
+      for (const auto& object : m_objects)
+      {
+        r3d->renderObject(object, vke::PipelineType::object);
+      }
+
+      renderLights(engine, m_lights);
+    }
+
+  private:
+    std::vector<std::shared_ptr<vke::RenderObject>> m_objects;
+    std::vector<std::shared_ptr<vke::Light>> m_lights;
+  };
+
+  // The object count scales how many copies of the demo's shapes and text are drawn
+  class Scene2D final : public BenchmarkScene {
+  public:
+    [[nodiscard]] SceneParameters getDefaultParameters() const override
+    {
+      return { .objectCount = 1 };
+    }
+
+    [[nodiscard]] CameraPath getCameraPath() const override
+    {
+      return {};
+    }
+
+    void setup(const vke::VulkanEngine& engine,
+               const SceneParameters& parameters) override
+    {
+      engine.getAssetManager()->registerFont("roboto", "assets/fonts/Roboto-VariableFont_wdth,wght.ttf");
+
+      m_copies = parameters.objectCount;
+    }
+
+    void submit(const vke::VulkanEngine& engine,
+                [[maybe_unused]] const float time) override
+    {
+      const auto r2d = engine.getRenderingManager()->getRenderer2D();
+
+      r2d->textFont("roboto");
+
+      for (uint32_t i = 0; i < m_copies; ++i)
+      {
+        r2d->pushMatrix();
+        r2d->translate(static_cast<float>(i % 8) * 10.0f, static_cast<float>(i / 8 % 8) * 10.0f);
+
+        r2d->fill(200, 100, 50);
+        r2d->pushMatrix();
+        r2d->translate(150, 150);
+        r2d->rotate(45.0f);
+        r2d->rect(-50, -50, 100, 100);
+        r2d->popMatrix();
+
+        r2d->fill(50, 100, 200);
+        r2d->rect(250, 100, 100, 100);
+
+        r2d->fill(200, 100, 200);
+        r2d->triangle(200, 200, 200, 300, 300, 250);
+
+        r2d->fill(100, 200, 200);
+        r2d->ellipse(500, 100, 200, 100);
+
+        r2d->textSize(25);
+        r2d->text("Hello, World!", 400, 200);
+
+        r2d->fill(139, 20, 70);
+        r2d->rect(400, 200, 100, 100);
+
+        r2d->fill(225, 225, 225);
+        r2d->textSize(45);
+        r2d->text("Bigger!", 400, 250);
+
+        r2d->popMatrix();
+      }
+    }
+
+  private:
+    uint32_t m_copies = 0;
+  };
+
+  // Headless runs have no cursor, so this measures the highlight and picking-aware object path without readbacks
+  class MousePickingScene final : public BenchmarkScene {
+  public:
+    [[nodiscard]] SceneParameters getDefaultParameters() const override
+    {
+      return { .objectCount = 3, .lightCount = 5 };
+    }
+
+    [[nodiscard]] CameraPath getCameraPath() const override
+    {
+      return { .target = { 0.0f, -5.0f, 0.0f }, .radius = 20.0f, .height = 5.0f };
+    }
+
+    void setup(const vke::VulkanEngine& engine,
+               const SceneParameters& parameters) override
+    {
+      m_objects = createSquareGrid(engine, parameters.objectCount, -5.0f);
+      m_lights = createLights(engine, parameters.lightCount, -3.5f);
+
+      m_hovering = std::make_unique<bool[]>(m_objects.size());
+    }
+
+    void submit(const vke::VulkanEngine& engine,
+                [[maybe_unused]] const float time) override
+    {
+      const auto r3d = engine.getRenderingManager()->getRenderer3D();
+
+      for (size_t i = 0; i < m_objects.size(); ++i)
+      {
+        // Highlight every other object so the highlight pipeline is exercised like a selection would
+        if (i % 2 == 0 || m_hovering[i])
+        {
+          r3d->renderObject(m_objects[i], vke::PipelineType::objectHighlight);
+        }
+
+        r3d->renderObject(m_objects[i], vke::PipelineType::object, &m_hovering[i]);
+      }
+
+      renderLights(engine, m_lights);
+    }
+
+  private:
+    std::vector<std::shared_ptr<vke::RenderObject>> m_objects;
+    std::vector<std::shared_ptr<vke::Light>> m_lights;
+    std::unique_ptr<bool[]> m_hovering;
+  };
+
+} // namespace
+
+glm::vec3 CameraPath::getPosition(const float time) const
+{
+  const float angle = glm::two_pi<float>() * time / period;
+
+  return target + glm::vec3(radius * std::cos(angle), height, radius * std::sin(angle));
+}
+
+const std::vector<std::string>& getBenchmarkSceneNames()
+{
+  static const std::vector<std::string> sceneNames {
+    "shadows",
+    "smoke",
+    "clouds",
+    "plants",
+    "renderObject",
+    "2D",
+    "mousePicking"
+  };
+
+  return sceneNames;
+}
+
+std::unique_ptr<BenchmarkScene> createBenchmarkScene(const std::string& name)
+{
+  if (name == "shadows")
+  {
+    return std::make_unique<ShadowsScene>();
+  }
+
+  if (name == "smoke")
+  {
+    return std::make_unique<SmokeScene>();
+  }
+
+  if (name == "clouds")
+  {
+    return std::make_unique<CloudsScene>();
+  }
+
+  if (name == "plants")
+  {
+    return std::make_unique<PlantsScene>();
+  }
+
+  if (name == "renderObject")
+  {
+    return std::make_unique<RenderObjectScene>();
+  }
+
+  if (name == "2D")
+  {
+    return std::make_unique<Scene2D>();
+  }
+
+  if (name == "mousePicking")
+  {
+    return std::make_unique<MousePickingScene>();
+  }
+
+  throw std::runtime_error("Unknown benchmark scene: " + name);
+}
@@ -0,0 +1,51 @@
+#ifndef VKE_BENCHMARKSCENE_H
+#define VKE_BENCHMARKSCENE_H
+
+#include <glm/vec3.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace vke {
+  class VulkanEngine;
+}
+
+struct SceneParameters {
+  uint32_t objectCount = 0;
+  uint32_t lightCount = 0;
+  uint32_t particleCount = 0;
+};
+
+// The camera orbits the target once per period, looking at it the whole time
+struct CameraPath {
+  glm::vec3 target = glm::vec3(0.0f);
+  float radius = 15.0f;
+  float height = 5.0f;
+  float period = 10.0f;
+
+  [[nodiscard]] glm::vec3 getPosition(float time) const;
+};
+
+class BenchmarkScene {
+public:
+  virtual ~BenchmarkScene() = default;
+
+  [[nodiscard]] virtual SceneParameters getDefaultParameters() const = 0;
+
+  [[nodiscard]] virtual CameraPath getCameraPath() const = 0;
+
+  // Loads assets and creates every object, light and system the scene draws
+  virtual void setup(const vke::VulkanEngine& engine,
+                     const SceneParameters& parameters) = 0;
+
+  // Submits one frame of the scene, time is the simulated number of seconds since the first frame
+  virtual void submit(const vke::VulkanEngine& engine,
+                      float time) = 0;
+};
+
+[[nodiscard]] const std::vector<std::string>& getBenchmarkSceneNames();
+
+[[nodiscard]] std::unique_ptr<BenchmarkScene> createBenchmarkScene(const std::string& name);
+
+#endif //VKE_BENCHMARKSCENE_H
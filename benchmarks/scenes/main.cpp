@@ -0,0 +1,369 @@
+#include "BenchmarkReport.h"
+#include "BenchmarkScene.h"
+#include <source/VulkanEngine.h>
+#include <source/components/camera/Camera.h>
+#include <source/components/logicalDevice/LogicalDevice.h>
+#include <source/components/physicalDevice/PhysicalDevice.h>
+#include <source/components/profiler/GpuProfiler.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+  struct Options {
+    std::string scene = "all";
+
+    RunSettings settings {
+      .frames = 600,
+      .warmupFrames = 60,
+      .timestep = 1.0f / 60.0f,
+      .width = 1280,
+      .height = 720
+    };
+
+    std::optional<uint32_t> objectCount;
+    std::optional<uint32_t> lightCount;
+    std::optional<uint32_t> particleCount;
+
+    std::string outputFile = "sceneBenchmarks.json";
+    std::string baselineFile;
+    double tolerance = 0.1;
+  };
+
+  void printUsage()
+  {
+    std::cout << "Usage: sceneBenchmarks [options]\n"
+              << "  --scene <name|all>    Scene to run (default all)\n"
+              << "  --frames <count>      Measured frames per scene (default 600)\n"
+              << "  --warmup <count>      Unmeasured frames before measuring (default 60)\n"
+              << "  --timestep <seconds>  Simulated seconds per frame (default 1/60)\n"
+              << "  --width <pixels>      Render width (default 1280)\n"
+              << "  --height <pixels>     Render height (default 720)\n"
+              << "  --objects <count>     Overrides the scene's object count\n"
+              << "  --lights <count>      Overrides the scene's light count\n"
+              << "  --particles <count>   Overrides the scene's particle count\n"
+              << "  --output <file>       Report path (default sceneBenchmarks.json)\n"
+              << "  --baseline <file>     Report to compare against, regressions exit with failure\n"
+              << "  --tolerance <ratio>   Allowed slowdown against the baseline (default 0.1)\n"
+              << "Scenes:";
+
+    for (const auto& name : getBenchmarkSceneNames())
+    {
+      std::cout << " " << name;
+    }
+
+    std::cout << std::endl;
+  }
+
+  Options parseOptions(const int argc,
+                       char* argv[])
+  {
+    Options options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+      const std::string argument = argv[i];
+
+      if (argument == "--help")
+      {
+        printUsage();
+        std::exit(EXIT_SUCCESS);
+      }
+
+      if (i + 1 >= argc)
+      {
+        throw std::runtime_error("Missing value for " + argument);
+      }
+
+      const std::string value = argv[++i];
+
+      if (argument == "--scene")
+      {
+        options.scene = value;
+      }
+      else if (argument == "--frames")
+      {
+        options.settings.frames = std::stoul(value);
+      }
+      else if (argument == "--warmup")
+      {
+        options.settings.warmupFrames = std::stoul(value);
+      }
+      else if (argument == "--timestep")
+      {
+        options.settings.timestep = std::stof(value);
+      }
+      else if (argument == "--width")
+      {
+        options.settings.width = std::stoul(value);
+      }
+      else if (argument == "--height")
+      {
+        options.settings.height = std::stoul(value);
+      }
+      else if (argument == "--objects")
+      {
+        options.objectCount = std::stoul(value);
+      }
+      else if (argument == "--lights")
+      {
+        options.lightCount = std::stoul(value);
+      }
+      else if (argument == "--particles")
+      {
+        options.particleCount = std::stoul(value);
+      }
+      else if (argument == "--output")
+      {
+        options.outputFile = value;
+      }
+      else if (argument == "--baseline")
+      {
+        options.baselineFile = value;
+      }
+      else if (argument == "--tolerance")
+      {
+        options.tolerance = std::stod(value);
+      }
+      else
+      {
+        throw std::runtime_error("Unknown option " + argument);
+      }
+    }
+
+    if (options.settings.frames == 0)
+    {
+      throw std::runtime_error("--frames must be greater than 0");
+    }
+
+    if (options.settings.timestep <= 0.0f)
+    {
+      throw std::runtime_error("--timestep must be greater than 0");
+    }
+
+    return options;
+  }
+
+  SceneParameters getSceneParameters(const BenchmarkScene& scene,
+                                     const Options& options)
+  {
+    const auto defaults = scene.getDefaultParameters();
+
+    return {
+      .objectCount = options.objectCount.value_or(defaults.objectCount),
+      .lightCount = options.lightCount.value_or(defaults.lightCount),
+      .particleCount = options.particleCount.value_or(defaults.particleCount)
+    };
+  }
+
+  double getElapsedMs(const std::chrono::steady_clock::time_point start)
+  {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  void trackPeakMemory(const vke::VulkanEngine& engine,
+                       std::optional<double>& peakDeviceMemoryMiB)
+  {
+    const auto usage = engine.getLogicalDevice()->getPhysicalDevice()->getDeviceLocalMemoryUsage();
+
+    if (!usage)
+    {
+      return;
+    }
+
+    const double usageMiB = static_cast<double>(*usage) / (1024.0 * 1024.0);
+
+    peakDeviceMemoryMiB = std::max(peakDeviceMemoryMiB.value_or(0.0), usageMiB);
+  }
+
+  SceneResult runScene(const std::string& name,
+                       const Options& options)
+  {
+    const auto scene = createBenchmarkScene(name);
+    const auto parameters = getSceneParameters(*scene, options);
+    const auto cameraPath = scene->getCameraPath();
+
+    const vke::EngineConfig engineConfig {
+      .window {
+        .width = options.settings.width,
+        .height = options.settings.height,
+        .title = "Scene Benchmark",
+        .resizable = false
+      },
+      .camera {
+        .position = cameraPath.getPosition(0.0f)
+      },
+      .rendering {
+        .headless = true,
+        .fixedTimestep = options.settings.timestep
+      },
+      .profiling {
+        .gpuTimings = true
+      }
+    };
+
+    SceneResult result {
+      .name = name,
+      .parameters = parameters
+    };
+
+    const auto startupStart = std::chrono::steady_clock::now();
+
+    vke::VulkanEngine engine(engineConfig);
+    const auto camera = engine.getCamera();
+    const auto gpuProfiler = engine.getGpuProfiler();
+
+    scene->setup(engine, parameters);
+
+    // Startup lasts until the first frame has finished on the GPU
+    camera->lookAt(cameraPath.target);
+    scene->submit(engine, 0.0f);
+    engine.render();
+    engine.getLogicalDevice()->waitIdle();
+
+    result.startupMs = getElapsedMs(startupStart);
+    trackPeakMemory(engine, result.peakDeviceMemoryMiB);
+
+    std::vector<double> cpuFrameTimes;
+    std::vector<double> gpuGraphicsTimes;
+    std::vector<double> gpuComputeTimes;
+
+    cpuFrameTimes.reserve(options.settings.frames);
+    gpuGraphicsTimes.reserve(options.settings.frames);
+    gpuComputeTimes.reserve(options.settings.frames);
+
+    const uint32_t totalFrames = options.settings.warmupFrames + options.settings.frames;
+
+    for (uint32_t frame = 1; frame <= totalFrames; ++frame)
+    {
+      const float time = static_cast<float>(frame) * options.settings.timestep;
+
+      camera->setPosition(cameraPath.getPosition(time));
+      camera->lookAt(cameraPath.target);
+
+      const auto frameStart = std::chrono::steady_clock::now();
+
+      scene->submit(engine, time);
+      engine.render();
+
+      const double cpuFrameTime = getElapsedMs(frameStart);
+
+      trackPeakMemory(engine, result.peakDeviceMemoryMiB);
+
+      if (frame <= options.settings.warmupFrames)
+      {
+        continue;
+      }
+
+      cpuFrameTimes.push_back(cpuFrameTime);
+
+      // Timings lag by the frames in flight and stay at zero for queues with no work
+      if (const double gpuGraphicsTime = gpuProfiler->getFrameTime(vke::GpuQueue::graphics); gpuGraphicsTime > 0.0)
+      {
+        gpuGraphicsTimes.push_back(gpuGraphicsTime);
+      }
+
+      if (const double gpuComputeTime = gpuProfiler->getFrameTime(vke::GpuQueue::compute); gpuComputeTime > 0.0)
+      {
+        gpuComputeTimes.push_back(gpuComputeTime);
+      }
+    }
+
+    engine.getLogicalDevice()->waitIdle();
+
+    result.cpuFrameMs = computePercentiles(std::move(cpuFrameTimes));
+    result.gpuGraphicsMs = computePercentiles(std::move(gpuGraphicsTimes));
+    result.gpuComputeMs = computePercentiles(std::move(gpuComputeTimes));
+
+    return result;
+  }
+
+  std::vector<std::string> getSelectedScenes(const std::string& scene)
+  {
+    const auto& names = getBenchmarkSceneNames();
+
+    if (scene == "all")
+    {
+      return names;
+    }
+
+    if (std::ranges::find(names, scene) == names.end())
+    {
+      throw std::runtime_error("Unknown scene " + scene);
+    }
+
+    return { scene };
+  }
+
+  void printResult(const SceneResult& result)
+  {
+    std::cout << result.name
+              << " (objects " << result.parameters.objectCount
+              << ", lights " << result.parameters.lightCount
+              << ", particles " << result.parameters.particleCount << ")\n"
+              << "  startup      " << result.startupMs << " ms\n"
+              << "  cpu frame    p50 " << result.cpuFrameMs.p50
+              << " p95 " << result.cpuFrameMs.p95
+              << " p99 " << result.cpuFrameMs.p99 << " ms\n"
+              << "  gpu graphics p50 " << result.gpuGraphicsMs.p50
+              << " p95 " << result.gpuGraphicsMs.p95
+              << " p99 " << result.gpuGraphicsMs.p99 << " ms\n"
+              << "  gpu compute  p50 " << result.gpuComputeMs.p50
+              << " p95 " << result.gpuComputeMs.p95
+              << " p99 " << result.gpuComputeMs.p99 << " ms\n";
+
+    if (result.peakDeviceMemoryMiB)
+    {
+      std::cout << "  peak memory  " << *result.peakDeviceMemoryMiB << " MiB\n";
+    }
+
+    std::cout << std::flush;
+  }
+
+} // namespace
+
+int main(const int argc,
+         char* argv[])
+{
+  try
+  {
+    const auto options = parseOptions(argc, argv);
+
+    std::vector<SceneResult> results;
+
+    for (const auto& name : getSelectedScenes(options.scene))
+    {
+      results.push_back(runScene(name, options));
+      printResult(results.back());
+    }
+
+    writeReport(options.outputFile, options.settings, results);
+    std::cout << "Wrote " << options.outputFile << std::endl;
+
+    if (!options.baselineFile.empty())
+    {
+      const auto regressions = compareAgainstBaseline(getReportMetrics(results),
+                                                      readReportMetrics(options.baselineFile),
+                                                      options.tolerance);
+
+      if (regressions > 0)
+      {
+        std::cerr << regressions << " metric(s) regressed against " << options.baselineFile << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -28,6 +28,26 @@ namespace vke {
       uint32_t maxTextures = 5;
       std::function<void()> styleSetup;
     } imGui;
+
+    struct Rendering {
+      // 1 minimizes latency, 3 keeps GPU bound scenes saturated
+      uint32_t framesInFlight = 2;
+
+      // Renders offscreen at the window size without creating a window, surface or swap chain
+      bool headless = false;
+
+      // Seconds advanced per frame by animations and simulations, 0 follows the wall clock
+      float fixedTimestep = 0.0f;
+    } rendering;
+
+    struct Profiling {
+      bool gpuTimings = false;
+      bool gpuPipelineStatistics = false;
+      bool gpuOverlay = false;
+
+      // Chrome trace written on shutdown when not empty, zones are only recorded with VKE_ENABLE_CPU_PROFILING
+      std::string cpuTraceFile;
+    } profiling;
   };
 
 } // namespace vke
@@ -8,17 +8,29 @@
 #include "components/logicalDevice/LogicalDevice.h"
 #include "components/physicalDevice/PhysicalDevice.h"
 #include "components/pipelines/pipelineManager/PipelineManager.h"
+#include "components/profiler/CpuProfiler.h"
+#include "components/profiler/GpuProfiler.h"
 #include "components/renderingManager/RenderingManager.h"
 #include "components/renderingManager/renderer3D/Renderer3D.h"
+#include "components/uploadManager/UploadManager.h"
 #include "components/window/Surface.h"
 #include "components/window/Window.h"
+#include <iostream>
 #include <stdexcept>
 
 namespace vke {
 
   VulkanEngine::VulkanEngine(const EngineConfig& engineConfig)
+    : m_headless(engineConfig.rendering.headless), m_fixedTimestep(engineConfig.rendering.fixedTimestep),
+      m_cpuTraceFile(engineConfig.profiling.cpuTraceFile)
   {
-    if (!glfwInit())
+#ifdef VKE_ENABLE_CPU_PROFILING
+    CpuProfiler::setThreadName("Main");
+#endif
+
+    VKE_PROFILE_ZONE("VulkanEngine::VulkanEngine");
+
+    if (!m_headless && !glfwInit())
     {
       throw std::runtime_error("Failed to initialize GLFW!");
     }
@@ -44,14 +56,35 @@ namespace vke {
       m_computingManager.reset();
       m_lightingManager.reset();
       m_assetManager.reset();
+
+      // The device is idle, so everything retired so far can go while ImGui is still around to release its textures
+      m_logicalDevice->collectRetiredObjects();
+
       m_imGuiInstance.reset();
+      m_gpuProfiler.reset();
+      m_uploadManager.reset();
 
       m_logicalDevice.reset();
       m_physicalDevice.reset();
       m_instance.reset();
     }
 
-    glfwTerminate();
+    if (!m_headless)
+    {
+      glfwTerminate();
+    }
+
+    if (!m_cpuTraceFile.empty())
+    {
+      try
+      {
+        CpuProfiler::writeChromeTrace(m_cpuTraceFile);
+      }
+      catch (const std::exception& e)
+      {
+        std::cerr << e.what() << std::endl;
+      }
+    }
   }
 
   bool VulkanEngine::isActive() const
@@ -61,19 +94,32 @@ namespace vke {
       return m_window->isOpen();
     }
 
-    return false;
+    return m_headless;
   }
 
   void VulkanEngine::render()
   {
-    m_window->update();
+    VKE_PROFILE_ZONE("VulkanEngine::render");
+
+    if (m_window)
+    {
+      m_window->update();
 
-    if (m_renderingManager->isSceneFocused() && m_camera->isEnabled())
+      if (m_renderingManager->isSceneFocused() && m_camera->isEnabled())
+      {
+        m_camera->processInput(m_window);
+        m_renderingManager->getRenderer3D()->setCameraParameters(m_camera->getPosition(), m_camera->getViewMatrix());
+      }
+    }
+    else if (m_camera->isEnabled())
     {
-      m_camera->processInput(m_window);
       m_renderingManager->getRenderer3D()->setCameraParameters(m_camera->getPosition(), m_camera->getViewMatrix());
     }
 
+    updateDeltaTime();
+
+    m_renderingManager->setDeltaTime(m_deltaTime);
+
     m_computingManager->doComputing(m_pipelineManager, m_currentFrame, m_renderingManager->getRenderer2D(),
                                     m_renderingManager->getRenderer3D());
 
@@ -82,6 +128,11 @@ namespace vke {
     createNewFrame();
   }
 
+  float VulkanEngine::getDeltaTime() const
+  {
+    return m_deltaTime;
+  }
+
   std::shared_ptr<AssetManager> VulkanEngine::getAssetManager() const
   {
     return m_assetManager;
@@ -92,11 +143,21 @@ namespace vke {
     return m_camera;
   }
 
+  std::shared_ptr<GpuProfiler> VulkanEngine::getGpuProfiler() const
+  {
+    return m_gpuProfiler;
+  }
+
   std::shared_ptr<ImGuiInstance> VulkanEngine::getImGuiInstance() const
   {
     return m_imGuiInstance;
   }
 
+  std::shared_ptr<LogicalDevice> VulkanEngine::getLogicalDevice() const
+  {
+    return m_logicalDevice;
+  }
+
   std::shared_ptr<LightingManager> VulkanEngine::getLightingManager() const
   {
     return m_lightingManager;
@@ -114,27 +175,45 @@ namespace vke {
 
   void VulkanEngine::initializeVulkanAndWindow(const EngineConfig& engineConfig)
   {
-    m_instance = std::make_shared<Instance>();
+    VKE_PROFILE_ZONE("VulkanEngine::initializeVulkanAndWindow");
+
+    m_instance = std::make_shared<Instance>(m_headless);
 
-    m_window = std::make_shared<Window>(engineConfig.window);
+    if (!m_headless)
+    {
+      m_window = std::make_shared<Window>(engineConfig.window);
 
-    m_surface = std::make_shared<Surface>(m_instance, m_window);
+      m_surface = std::make_shared<Surface>(m_instance, m_window);
+    }
 
     m_physicalDevice = std::make_shared<PhysicalDevice>(m_instance, m_surface);
 
-    m_logicalDevice = std::make_shared<LogicalDevice>(m_physicalDevice);
+    m_logicalDevice = std::make_shared<LogicalDevice>(m_physicalDevice, engineConfig.rendering.framesInFlight);
   }
 
   void VulkanEngine::createComponents(const EngineConfig& engineConfig)
   {
-    m_assetManager = std::make_shared<AssetManager>(m_logicalDevice);
+    VKE_PROFILE_ZONE("VulkanEngine::createComponents");
+
+    m_uploadManager = std::make_shared<UploadManager>(m_logicalDevice);
+
+    m_assetManager = std::make_shared<AssetManager>(m_logicalDevice, m_uploadManager);
+
+    m_gpuProfiler = std::make_shared<GpuProfiler>(
+      m_logicalDevice,
+      engineConfig.profiling.gpuTimings,
+      engineConfig.profiling.gpuPipelineStatistics,
+      engineConfig.profiling.gpuOverlay
+    );
 
     m_renderingManager = std::make_shared<RenderingManager>(
       m_logicalDevice,
       m_surface,
       m_window,
-      engineConfig.imGui.sceneViewName.c_str(),
-      m_assetManager
+      engineConfig,
+      m_assetManager,
+      m_gpuProfiler,
+      m_uploadManager
     );
 
     m_lightingManager = std::make_shared<LightingManager>(m_logicalDevice);
@@ -143,17 +222,18 @@ namespace vke {
       m_logicalDevice,
       m_renderingManager,
       m_lightingManager,
-      m_assetManager
+      m_assetManager,
+      m_uploadManager
     );
 
     m_imGuiInstance = std::make_shared<ImGuiInstance>(
       m_window,
       m_instance,
       m_logicalDevice,
-      engineConfig.imGui
+      engineConfig
     );
 
-    m_computingManager = std::make_shared<ComputingManager>(m_logicalDevice);
+    m_computingManager = std::make_shared<ComputingManager>(m_logicalDevice, m_gpuProfiler, m_uploadManager);
   }
 
   void VulkanEngine::createCamera(const EngineConfig& engineConfig)
@@ -172,4 +252,20 @@ namespace vke {
     m_renderingManager->createNewFrame();
   }
 
+  void VulkanEngine::updateDeltaTime()
+  {
+    if (m_fixedTimestep > 0.0f)
+    {
+      m_deltaTime = m_fixedTimestep;
+      return;
+    }
+
+    const auto currentTime = std::chrono::steady_clock::now();
+
+    // The first frame starts the clock so scene loading time is not simulated
+    m_deltaTime = m_previousFrameTime ? std::chrono::duration<float>(currentTime - *m_previousFrameTime).count() : 0.0f;
+
+    m_previousFrameTime = currentTime;
+  }
+
 } // namespace vke
\ No newline at end of file
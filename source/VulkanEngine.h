@@ -2,13 +2,17 @@
 #define VKE_VULKANENGINE_H
 
 #include "EngineConfig.h"
+#include <chrono>
 #include <memory>
+#include <optional>
+#include <string>
 
 namespace vke {
 
   class AssetManager;
   class Camera;
   class ComputingManager;
+  class GpuProfiler;
   class ImGuiInstance;
   class Instance;
   class LightingManager;
@@ -17,6 +21,7 @@ namespace vke {
   class PipelineManager;
   class RenderingManager;
   class Surface;
+  class UploadManager;
   class Window;
 
   class VulkanEngine {
@@ -33,14 +38,21 @@ namespace vke {
 
     [[nodiscard]] std::shared_ptr<Camera> getCamera() const;
 
+    [[nodiscard]] std::shared_ptr<GpuProfiler> getGpuProfiler() const;
+
     [[nodiscard]] std::shared_ptr<ImGuiInstance> getImGuiInstance() const;
 
     [[nodiscard]] std::shared_ptr<LightingManager> getLightingManager() const;
 
+    [[nodiscard]] std::shared_ptr<LogicalDevice> getLogicalDevice() const;
+
     [[nodiscard]] std::shared_ptr<RenderingManager> getRenderingManager() const;
 
     [[nodiscard]] std::shared_ptr<Window> getWindow() const;
 
+    // Seconds simulated by the most recently rendered frame
+    [[nodiscard]] float getDeltaTime() const;
+
   private:
     std::shared_ptr<Instance> m_instance;
     std::shared_ptr<Surface> m_surface;
@@ -50,6 +62,10 @@ namespace vke {
 
     std::shared_ptr<ImGuiInstance> m_imGuiInstance;
 
+    std::shared_ptr<GpuProfiler> m_gpuProfiler;
+
+    std::shared_ptr<UploadManager> m_uploadManager;
+
     std::shared_ptr<LightingManager> m_lightingManager;
 
     std::shared_ptr<PipelineManager> m_pipelineManager;
@@ -64,6 +80,16 @@ namespace vke {
 
     uint32_t m_currentFrame = 0;
 
+    bool m_headless = false;
+
+    float m_fixedTimestep = 0.0f;
+
+    float m_deltaTime = 0.0f;
+
+    std::optional<std::chrono::steady_clock::time_point> m_previousFrameTime;
+
+    std::string m_cpuTraceFile;
+
     void initializeVulkanAndWindow(const EngineConfig& engineConfig);
 
     void createComponents(const EngineConfig& engineConfig);
@@ -71,6 +97,8 @@ namespace vke {
     void createCamera(const EngineConfig& engineConfig);
 
     void createNewFrame();
+
+    void updateDeltaTime();
   };
 
 } // namespace vke
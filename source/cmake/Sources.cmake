@@ -41,6 +41,8 @@ set(VULKAN_ENGINE_SOURCES_COMPONENTS
   components/commandBuffer/CommandBuffer.h
   components/commandBuffer/SingleUseCommandBuffer.cpp
   components/commandBuffer/SingleUseCommandBuffer.h
+  components/commandBuffer/UploadCommandBuffer.cpp
+  components/commandBuffer/UploadCommandBuffer.h
 
   # Computing
   components/computingManager/ComputingManager.cpp
@@ -65,29 +67,57 @@ set(VULKAN_ENGINE_SOURCES_COMPONENTS
     components/lighting/lights/SpotLight.cpp
     components/lighting/lights/SpotLight.h
 
+    # Shadow Maps
+    components/lighting/shadowMaps/ShadowAtlas.cpp
+    components/lighting/shadowMaps/ShadowAtlas.h
+    components/lighting/shadowMaps/ShadowCubeMapArray.cpp
+    components/lighting/shadowMaps/ShadowCubeMapArray.h
+    components/lighting/shadowMaps/ShadowMapPool.cpp
+    components/lighting/shadowMaps/ShadowMapPool.h
+
   components/lighting/LightingManager.cpp
   components/lighting/LightingManager.h
 
   # Logical Device Management
+  components/logicalDevice/DeletionQueue.cpp
+  components/logicalDevice/DeletionQueue.h
   components/logicalDevice/LogicalDevice.cpp
   components/logicalDevice/LogicalDevice.h
 
+  # Memory
+  components/memory/MemoryAllocation.cpp
+  components/memory/MemoryAllocation.h
+  components/memory/MemoryAllocator.cpp
+  components/memory/MemoryAllocator.h
+
   # Physical Device Management
   components/physicalDevice/PhysicalDevice.cpp
   components/physicalDevice/PhysicalDevice.h
 
+  # Profiling
+  components/profiler/CpuProfiler.cpp
+  components/profiler/CpuProfiler.h
+  components/profiler/GpuProfiler.cpp
+  components/profiler/GpuProfiler.h
+
   # Rendering Manager
     # Renderer2D
     components/renderingManager/renderer2D/Renderer2D.cpp
     components/renderingManager/renderer2D/Renderer2D.h
 
     # Renderer3D
+    components/renderingManager/renderer3D/DrawList.cpp
+    components/renderingManager/renderer3D/DrawList.h
+    components/renderingManager/renderer3D/FrustumCuller.cpp
+    components/renderingManager/renderer3D/FrustumCuller.h
     components/renderingManager/renderer3D/MousePicker.cpp
     components/renderingManager/renderer3D/MousePicker.h
     components/renderingManager/renderer3D/RayTracer.cpp
     components/renderingManager/renderer3D/RayTracer.h
     components/renderingManager/renderer3D/Renderer3D.cpp
     components/renderingManager/renderer3D/Renderer3D.h
+    components/renderingManager/renderer3D/SceneBuffers.cpp
+    components/renderingManager/renderer3D/SceneBuffers.h
 
   components/renderingManager/ImageResource.cpp
   components/renderingManager/ImageResource.h
@@ -96,6 +126,10 @@ set(VULKAN_ENGINE_SOURCES_COMPONENTS
   components/renderingManager/RenderTarget.cpp
   components/renderingManager/RenderTarget.h
 
+  # Uploads
+  components/uploadManager/UploadManager.cpp
+  components/uploadManager/UploadManager.h
+
   # Windows
   components/window/Surface.cpp
   components/window/Surface.h
@@ -139,6 +173,8 @@ set(VULKAN_ENGINE_SOURCES_PIPELINES_IMPLEMENTATIONS
   components/pipelines/implementations/BendyPipeline.h
   components/pipelines/implementations/DotsPipeline.cpp
   components/pipelines/implementations/DotsPipeline.h
+  components/pipelines/implementations/LightClusterPipeline.cpp
+  components/pipelines/implementations/LightClusterPipeline.h
   components/pipelines/implementations/LinePipeline.cpp
   components/pipelines/implementations/LinePipeline.h
   components/pipelines/implementations/SmokePipeline.cpp
@@ -7,16 +7,16 @@
 #include "../assets/textures/Texture2D.h"
 #include "../logicalDevice/LogicalDevice.h"
 #include "../physicalDevice/PhysicalDevice.h"
+#include "../profiler/CpuProfiler.h"
 #include <array>
 #include <stdexcept>
 
 namespace vke {
 
-  AssetManager::AssetManager(std::shared_ptr<LogicalDevice> logicalDevice)
-    : m_logicalDevice(std::move(logicalDevice))
+  AssetManager::AssetManager(std::shared_ptr<LogicalDevice> logicalDevice,
+                             std::shared_ptr<UploadManager> uploadManager)
+    : m_logicalDevice(std::move(logicalDevice)), m_uploadManager(std::move(uploadManager))
   {
-    createCommandPool();
-
     createDescriptorPool();
 
     createDescriptorSetLayouts();
@@ -25,9 +25,11 @@ namespace vke {
   std::shared_ptr<Texture2D> AssetManager::loadTexture(const char* path,
                                                        const bool repeat)
   {
+    VKE_PROFILE_ZONE("AssetManager::loadTexture");
+
     return std::make_shared<Texture2D>(
       m_logicalDevice,
-      *m_commandPool,
+      m_uploadManager,
       path,
       repeat ? vk::SamplerAddressMode::eRepeat : vk::SamplerAddressMode::eClampToEdge
     );
@@ -36,9 +38,11 @@ namespace vke {
   std::shared_ptr<Model> AssetManager::loadModel(const char* path,
                                                  glm::vec3 rotation)
   {
+    VKE_PROFILE_ZONE("AssetManager::loadModel");
+
     return std::make_shared<Model>(
       m_logicalDevice,
-      *m_commandPool,
+      m_uploadManager,
       path,
       rotation
     );
@@ -49,6 +53,8 @@ namespace vke {
     const std::shared_ptr<Texture2D>& specularMap,
     const std::shared_ptr<Model>& model)
   {
+    VKE_PROFILE_ZONE("AssetManager::loadRenderObject");
+
     return std::make_shared<RenderObject>(
       m_logicalDevice,
       getDescriptorPool(),
@@ -86,7 +92,7 @@ namespace vke {
   {
     return std::make_shared<SmokeSystem>(
       m_logicalDevice,
-      *m_commandPool,
+      m_uploadManager,
       getDescriptorPool(),
       *m_smokeSystemDescriptorSetLayout,
       position,
@@ -96,7 +102,7 @@ namespace vke {
 
   std::shared_ptr<Cloud> AssetManager::createCloud()
   {
-    return std::make_shared<Cloud>(m_logicalDevice, *m_commandPool);
+    return std::make_shared<Cloud>(m_logicalDevice, m_uploadManager);
   }
 
   vk::DescriptorSetLayout AssetManager::getObjectDescriptorSetLayout() const
@@ -132,15 +138,6 @@ namespace vke {
 
   void AssetManager::createObjectDescriptorSetLayout()
   {
-    constexpr vk::DescriptorSetLayoutBinding transformLayout {
-      .binding = 0,
-      .descriptorType = vk::DescriptorType::eUniformBuffer,
-      .descriptorCount = 1,
-      .stageFlags = vk::ShaderStageFlagBits::eVertex |
-                    vk::ShaderStageFlagBits::eGeometry |
-                    vk::ShaderStageFlagBits::eFragment
-    };
-
     constexpr vk::DescriptorSetLayoutBinding textureLayout {
       .binding = 1,
       .descriptorType = vk::DescriptorType::eCombinedImageSampler,
@@ -156,7 +153,6 @@ namespace vke {
     };
 
     constexpr std::array objectBindings {
-      transformLayout,
       textureLayout,
       specularLayout
     };
@@ -320,6 +316,8 @@ namespace vke {
   void AssetManager::loadFont(const std::string& fontName,
                               const uint32_t fontSize)
   {
+    VKE_PROFILE_ZONE("AssetManager::loadFont");
+
     const auto fontPath = m_fontNames.find(fontName);
 
     if (fontPath == m_fontNames.end())
@@ -331,7 +329,7 @@ namespace vke {
       m_logicalDevice,
       fontPath->second,
       fontSize,
-      *m_commandPool,
+      m_uploadManager,
       getDescriptorPool(),
       *m_fontDescriptorSetLayout
     );
@@ -339,15 +337,6 @@ namespace vke {
     m_fonts.emplace(FontKey{ fontName, fontSize }, std::move(font));
   }
 
-  void AssetManager::createCommandPool()
-  {
-    const vk::CommandPoolCreateInfo poolInfo {
-      .queueFamilyIndex = m_logicalDevice->getPhysicalDevice()->getQueueFamilies().graphicsFamily.value()
-    };
-
-    m_commandPool = m_logicalDevice->createCommandPool(poolInfo);
-  }
-
   void AssetManager::createDescriptorPool()
   {
     const std::array<vk::DescriptorPoolSize, 3> poolSizes {{
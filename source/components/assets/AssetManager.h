@@ -18,6 +18,7 @@ namespace vke {
   class SmokeSystem;
   class Texture;
   class Texture2D;
+  class UploadManager;
 
   struct FontKey {
     std::string name;
@@ -41,7 +42,8 @@ namespace vke {
 
   class AssetManager {
   public:
-    explicit AssetManager(std::shared_ptr<LogicalDevice> logicalDevice);
+    AssetManager(std::shared_ptr<LogicalDevice> logicalDevice,
+                 std::shared_ptr<UploadManager> uploadManager);
 
     [[nodiscard]] std::shared_ptr<Texture2D> loadTexture(const char* path,
                                                          bool repeat = true);
@@ -75,7 +77,7 @@ namespace vke {
   private:
     std::shared_ptr<LogicalDevice> m_logicalDevice;
 
-    vk::raii::CommandPool m_commandPool { nullptr };
+    std::shared_ptr<UploadManager> m_uploadManager;
 
     std::vector<vk::raii::DescriptorPool> m_descriptorPools;
     uint32_t m_descriptorPoolSize = 500;
@@ -105,8 +107,6 @@ namespace vke {
     void loadFont(const std::string& fontName,
                   uint32_t fontSize);
 
-    void createCommandPool();
-
     void createDescriptorPool();
 
     [[nodiscard]] vk::DescriptorPool getDescriptorPool();
@@ -12,27 +12,37 @@ namespace vke {
   Font::Font(const std::shared_ptr<LogicalDevice>& logicalDevice,
              const std::string& fileName,
              const uint32_t fontSize,
-             const vk::CommandPool commandPool,
+             const std::shared_ptr<UploadManager>& uploadManager,
              const vk::DescriptorPool descriptorPool,
              const vk::DescriptorSetLayout descriptorSetLayout)
   {
     const auto fontBuffer = loadFontFromFile(fileName);
 
-    createGlyphAtlas(logicalDevice, commandPool, fontBuffer, fontSize);
+    createGlyphAtlas(logicalDevice, uploadManager, fontBuffer, fontSize);
 
     createDescriptorSet(logicalDevice, descriptorPool, descriptorSetLayout);
   }
 
-  GlyphInfo* Font::getGlyphInfo(const uint32_t codepoint)
+  const GlyphInfo* FontAtlas::getGlyphInfo(const uint32_t codepoint) const
   {
-    const auto it = m_glyphMap.find(codepoint);
+    const auto it = glyphMap.find(codepoint);
 
-    return it != m_glyphMap.end() ? &it->second : nullptr;
+    return it != glyphMap.end() ? &it->second : nullptr;
+  }
+
+  const GlyphInfo* Font::getGlyphInfo(const uint32_t codepoint) const
+  {
+    return m_atlas.getGlyphInfo(codepoint);
   }
 
   float Font::getMaxGlyphHeight() const
   {
-    return m_maxGlyphHeight;
+    return m_atlas.maxGlyphHeight;
+  }
+
+  const FontAtlas& Font::getAtlas() const
+  {
+    return m_atlas;
   }
 
   vk::DescriptorSet Font::getDescriptorSet(const uint32_t currentFrame) const
@@ -62,9 +72,7 @@ namespace vke {
     return buffer;
   }
 
-  void Font::createGlyphAtlas(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                              const vk::CommandPool commandPool,
-                              const std::vector<uint8_t>& fontBuffer,
+  FontAtlas Font::createAtlas(const std::vector<uint8_t>& fontBuffer,
                               const uint32_t fontSize)
   {
     FT_Library ft;
@@ -84,26 +92,40 @@ namespace vke {
 
     const auto charset = getCharset(face);
 
-    uint32_t maxGlyphWidth, maxGlyphHeight, glyphsPerRow, atlasWidth, atlasHeight;
-    auto atlasBuffer = createAtlasBuffer(face, charset, maxGlyphWidth, maxGlyphHeight,
-                                         glyphsPerRow, atlasWidth, atlasHeight);
+    FontAtlas atlas;
+
+    uint32_t maxGlyphWidth, maxGlyphHeight, glyphsPerRow;
+    atlas.pixels = createAtlasBuffer(face, charset, maxGlyphWidth, maxGlyphHeight,
+                                     glyphsPerRow, atlas.width, atlas.height);
 
+    populateAtlasBuffer(face, charset, atlas, maxGlyphWidth, maxGlyphHeight, glyphsPerRow);
 
-    populateAtlasBuffer(face, charset, atlasBuffer, maxGlyphWidth, maxGlyphHeight,
-                        glyphsPerRow, atlasWidth, atlasHeight);
+    atlas.maxGlyphHeight = static_cast<float>(maxGlyphHeight);
+
+    FT_Done_Face(face);
+    FT_Done_FreeType(ft);
+
+    return atlas;
+  }
+
+  void Font::createGlyphAtlas(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                              const std::shared_ptr<UploadManager>& uploadManager,
+                              const std::vector<uint8_t>& fontBuffer,
+                              const uint32_t fontSize)
+  {
+    m_atlas = createAtlas(fontBuffer, fontSize);
 
     m_glyphTexture = std::make_shared<TextureGlyph>(
       logicalDevice,
-      commandPool,
-      atlasBuffer.data(),
-      atlasWidth,
-      atlasHeight
+      uploadManager,
+      m_atlas.pixels.data(),
+      m_atlas.width,
+      m_atlas.height
     );
 
-    m_maxGlyphHeight = static_cast<float>(maxGlyphHeight);
-
-    FT_Done_Face(face);
-    FT_Done_FreeType(ft);
+    // The pixels live on the GPU from here on
+    m_atlas.pixels.clear();
+    m_atlas.pixels.shrink_to_fit();
   }
 
   std::vector<FT_ULong> Font::getCharset(const FT_Face face)
@@ -153,13 +175,14 @@ namespace vke {
 
   void Font::populateAtlasBuffer(const FT_Face face,
                                  const std::vector<FT_ULong>& charset,
-                                 std::vector<uint8_t>& atlasBuffer,
+                                 FontAtlas& atlas,
                                  const uint32_t maxGlyphWidth,
                                  const uint32_t maxGlyphHeight,
-                                 const uint32_t glyphsPerRow,
-                                 const uint32_t atlasWidth,
-                                 const uint32_t atlasHeight)
+                                 const uint32_t glyphsPerRow)
   {
+    const uint32_t atlasWidth = atlas.width;
+    const uint32_t atlasHeight = atlas.height;
+
     uint32_t x = 0;
     uint32_t y = 0;
     uint32_t currentGlyph = 0;
@@ -178,13 +201,13 @@ namespace vke {
         const uint32_t atlasOffset = (y + row) * atlasWidth + x;
         const uint32_t bitmapOffset = row * bitmap.width;
 
-        if (atlasOffset + bitmap.width <= atlasBuffer.size())
+        if (atlasOffset + bitmap.width <= atlas.pixels.size())
         {
-          std::memcpy(&atlasBuffer[atlasOffset], &bitmap.buffer[bitmapOffset], bitmap.width);
+          std::memcpy(&atlas.pixels[atlasOffset], &bitmap.buffer[bitmapOffset], bitmap.width);
         }
       }
 
-      m_glyphMap.emplace(charcode, GlyphInfo {
+      atlas.glyphMap.emplace(charcode, GlyphInfo {
         .u0 = static_cast<float>(x) / static_cast<float>(atlasWidth),
         .v0 = static_cast<float>(y) / static_cast<float>(atlasHeight),
         .u1 = static_cast<float>(x + bitmap.width) / static_cast<float>(atlasWidth),
@@ -13,6 +13,7 @@ namespace vke {
   class DescriptorSet;
   class LogicalDevice;
   class TextureGlyph;
+  class UploadManager;
 
   struct GlyphInfo {
     float u0, v0;
@@ -22,6 +23,16 @@ namespace vke {
     float advance;
   };
 
+  struct FontAtlas {
+    std::vector<uint8_t> pixels;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    float maxGlyphHeight = 0.0f;
+    std::unordered_map<uint32_t, GlyphInfo> glyphMap;
+
+    [[nodiscard]] const GlyphInfo* getGlyphInfo(uint32_t codepoint) const;
+  };
+
   inline std::vector<uint32_t> decodeUTF8(const std::string& utf8String)
   {
     std::vector<uint32_t> codepoints;
@@ -74,29 +85,33 @@ namespace vke {
     Font(const std::shared_ptr<LogicalDevice>& logicalDevice,
          const std::string& fileName,
          uint32_t fontSize,
-         vk::CommandPool commandPool,
+         const std::shared_ptr<UploadManager>& uploadManager,
          vk::DescriptorPool descriptorPool,
          vk::DescriptorSetLayout descriptorSetLayout);
 
-    [[nodiscard]] GlyphInfo* getGlyphInfo(uint32_t codepoint);
+    [[nodiscard]] const GlyphInfo* getGlyphInfo(uint32_t codepoint) const;
 
     [[nodiscard]] float getMaxGlyphHeight() const;
 
+    [[nodiscard]] const FontAtlas& getAtlas() const;
+
     [[nodiscard]] vk::DescriptorSet getDescriptorSet(uint32_t currentFrame) const;
 
+    [[nodiscard]] static std::vector<uint8_t> loadFontFromFile(const std::string& fileName);
+
+    // Rasterizes every glyph of the font into a single-channel atlas on the CPU
+    [[nodiscard]] static FontAtlas createAtlas(const std::vector<uint8_t>& fontBuffer,
+                                               uint32_t fontSize);
+
   private:
     std::shared_ptr<TextureGlyph> m_glyphTexture;
 
-    std::unordered_map<uint32_t, GlyphInfo> m_glyphMap;
-
-    float m_maxGlyphHeight = 0.0f;
+    FontAtlas m_atlas;
 
     std::shared_ptr<DescriptorSet> m_descriptorSet;
 
-    static std::vector<uint8_t> loadFontFromFile(const std::string& fileName);
-
     void createGlyphAtlas(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                          vk::CommandPool commandPool,
+                          const std::shared_ptr<UploadManager>& uploadManager,
                           const std::vector<uint8_t>& fontBuffer,
                           uint32_t fontSize);
 
@@ -110,14 +125,12 @@ namespace vke {
                                                   uint32_t& atlasWidth,
                                                   uint32_t& atlasHeight);
 
-    void populateAtlasBuffer(FT_Face face,
-                             const std::vector<FT_ULong>& charset,
-                             std::vector<uint8_t>& atlasBuffer,
-                             uint32_t maxGlyphWidth,
-                             uint32_t maxGlyphHeight,
-                             uint32_t glyphsPerRow,
-                             uint32_t atlasWidth,
-                             uint32_t atlasHeight);
+    static void populateAtlasBuffer(FT_Face face,
+                                    const std::vector<FT_ULong>& charset,
+                                    FontAtlas& atlas,
+                                    uint32_t maxGlyphWidth,
+                                    uint32_t maxGlyphHeight,
+                                    uint32_t glyphsPerRow);
 
     void createDescriptorSet(const std::shared_ptr<LogicalDevice>& logicalDevice,
                              vk::DescriptorPool descriptorPool,
@@ -1,9 +1,9 @@
 #include "Cloud.h"
-#include "../../commandBuffer/SingleUseCommandBuffer.h"
+#include "../../commandBuffer/CommandBuffer.h"
 #include "../../logicalDevice/LogicalDevice.h"
 #include "../../physicalDevice/PhysicalDevice.h"
+#include "../../uploadManager/UploadManager.h"
 #include "../../../utilities/Buffers.h"
-#include <cstring>
 
 constexpr uint32_t PRIMITIVE_COUNT = 1;
 constexpr vk::DeviceSize AABB_BUFFER_SIZE = sizeof(vk::AabbPositionsKHR);
@@ -11,17 +11,18 @@ constexpr vk::DeviceSize AABB_BUFFER_SIZE = sizeof(vk::AabbPositionsKHR);
 namespace vke {
 
   Cloud::Cloud(std::shared_ptr<LogicalDevice> logicalDevice,
-               const vk::CommandPool& commandPool)
+               const std::shared_ptr<UploadManager>& uploadManager)
     : m_logicalDevice(std::move(logicalDevice))
   {
-    createAABBBuffer(commandPool);
+    createAABBBuffer(uploadManager);
 
-    createBLAS(commandPool);
+    createBLAS(uploadManager);
   }
 
   Cloud::~Cloud()
   {
-    m_logicalDevice->waitIdle();
+    m_logicalDevice->retire(std::move(m_blas), std::move(m_blasBuffer), std::move(m_blasBufferMemory),
+                            std::move(m_aabbBuffer), std::move(m_aabbBufferMemory));
   }
 
   vk::AccelerationStructureKHR Cloud::getBLAS() const
@@ -104,23 +105,8 @@ namespace vke {
     m_scale = scale;
   }
 
-  void Cloud::createAABBBuffer(const vk::CommandPool& commandPool)
+  void Cloud::createAABBBuffer(const std::shared_ptr<UploadManager>& uploadManager)
   {
-    vk::raii::Buffer stagingBuffer = nullptr;
-    vk::raii::DeviceMemory stagingBufferMemory = nullptr;
-    Buffers::createBuffer(
-      m_logicalDevice,
-      AABB_BUFFER_SIZE,
-      vk::BufferUsageFlagBits::eTransferSrc,
-      vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
-      stagingBuffer,
-      stagingBufferMemory
-    );
-
-    Buffers::doMappedMemoryOperation(stagingBufferMemory, [this](void* data) {
-      memcpy(data, &m_aabbPositions, AABB_BUFFER_SIZE);
-    });
-
     Buffers::createBuffer(
       m_logicalDevice,
       AABB_BUFFER_SIZE,
@@ -132,17 +118,10 @@ namespace vke {
       m_aabbBufferMemory
     );
 
-    Buffers::copyBuffer(
-      m_logicalDevice,
-      commandPool,
-      m_logicalDevice->getGraphicsQueue(),
-      stagingBuffer,
-      m_aabbBuffer,
-      AABB_BUFFER_SIZE
-    );
+    uploadManager->uploadBuffer(m_aabbBuffer, &m_aabbPositions, AABB_BUFFER_SIZE);
   }
 
-  void Cloud::createBLAS(const vk::CommandPool& commandPool)
+  void Cloud::createBLAS(const std::shared_ptr<UploadManager>& uploadManager)
   {
     if (!m_logicalDevice->getPhysicalDevice()->supportsRayTracing())
     {
@@ -176,7 +155,7 @@ namespace vke {
 
     m_blas = m_logicalDevice->createAccelerationStructure(accelerationStructureCreateInfo);
 
-    populateBLAS(commandPool, buildGeometryInfo, buildSizesInfo);
+    populateBLAS(uploadManager, buildGeometryInfo, buildSizesInfo);
   }
 
   void Cloud::createCoreBLASData(vk::AccelerationStructureGeometryAabbsDataKHR& aabbsData,
@@ -201,12 +180,12 @@ namespace vke {
     };
   }
 
-  void Cloud::populateBLAS(const vk::CommandPool& commandPool,
+  void Cloud::populateBLAS(const std::shared_ptr<UploadManager>& uploadManager,
                            vk::AccelerationStructureBuildGeometryInfoKHR& buildGeometryInfo,
                            const vk::AccelerationStructureBuildSizesInfoKHR& buildSizesInfo) const
   {
     vk::raii::Buffer scratchBuffer = nullptr;
-    vk::raii::DeviceMemory scratchBufferMemory = nullptr;
+    MemoryAllocation scratchBufferMemory = nullptr;
 
     Buffers::createBuffer(
       m_logicalDevice,
@@ -227,10 +206,24 @@ namespace vke {
       .transformOffset = 0
     };
 
-    const auto commandBuffer = SingleUseCommandBuffer(m_logicalDevice, commandPool, m_logicalDevice->getGraphicsQueue());
+    uploadManager->record([&buildGeometryInfo, &buildRangeInfo](const CommandBuffer& commandBuffer) {
+      constexpr vk::MemoryBarrier memoryBarrier {
+        .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+        .dstAccessMask = vk::AccessFlagBits::eAccelerationStructureReadKHR | vk::AccessFlagBits::eShaderRead
+      };
+
+      commandBuffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eTransfer,
+        vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR,
+        {},
+        { memoryBarrier },
+        {},
+        {}
+      );
 
-    commandBuffer.record([&commandBuffer, buildGeometryInfo, buildRangeInfo] {
       commandBuffer.buildAccelerationStructure(buildGeometryInfo, &buildRangeInfo);
     });
+
+    uploadManager->retain(std::move(scratchBuffer), std::move(scratchBufferMemory));
   }
 } // vke
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef VULKANPROJECT_CLOUD_H
 #define VULKANPROJECT_CLOUD_H
 
+#include "../../memory/MemoryAllocation.h"
 #include <glm/vec3.hpp>
 #include <vulkan/vulkan_raii.hpp>
 #include <memory>
@@ -8,6 +9,7 @@
 namespace vke {
 
   class LogicalDevice;
+  class UploadManager;
 
   struct CloudUniform {
     float frequency = 20.0f;
@@ -20,7 +22,7 @@ namespace vke {
   class Cloud {
   public:
     Cloud(std::shared_ptr<LogicalDevice> logicalDevice,
-          const vk::CommandPool& commandPool);
+          const std::shared_ptr<UploadManager>& uploadManager);
 
     ~Cloud();
 
@@ -48,7 +50,7 @@ namespace vke {
     std::shared_ptr<LogicalDevice> m_logicalDevice;
 
     vk::raii::Buffer m_blasBuffer = nullptr;
-    vk::raii::DeviceMemory m_blasBufferMemory = nullptr;
+    MemoryAllocation m_blasBufferMemory = nullptr;
     vk::raii::AccelerationStructureKHR m_blas = nullptr;
 
     vk::AabbPositionsKHR m_aabbPositions {
@@ -57,22 +59,22 @@ namespace vke {
     };
 
     vk::raii::Buffer m_aabbBuffer = nullptr;
-    vk::raii::DeviceMemory m_aabbBufferMemory = nullptr;
+    MemoryAllocation m_aabbBufferMemory = nullptr;
 
     CloudUniform m_uniformData;
 
     glm::vec3 m_translation = glm::vec3(0.0f, 500.0f, 0.0f);
     glm::vec3 m_scale = glm::vec3(5500.0f, 400.0f, 5500.0f);
 
-    void createAABBBuffer(const vk::CommandPool& commandPool);
+    void createAABBBuffer(const std::shared_ptr<UploadManager>& uploadManager);
 
-    void createBLAS(const vk::CommandPool& commandPool);
+    void createBLAS(const std::shared_ptr<UploadManager>& uploadManager);
 
     void createCoreBLASData(vk::AccelerationStructureGeometryAabbsDataKHR& aabbsData,
                             vk::AccelerationStructureGeometryKHR& geometry,
                             vk::AccelerationStructureBuildGeometryInfoKHR& buildGeometryInfo) const;
 
-    void populateBLAS(const vk::CommandPool& commandPool,
+    void populateBLAS(const std::shared_ptr<UploadManager>& uploadManager,
                       vk::AccelerationStructureBuildGeometryInfoKHR& buildGeometryInfo,
                       const vk::AccelerationStructureBuildSizesInfoKHR& buildSizesInfo) const;
   };
@@ -1,38 +1,44 @@
 #include "Model.h"
 #include "../../commandBuffer/CommandBuffer.h"
-#include "../../commandBuffer/SingleUseCommandBuffer.h"
 #include "../../logicalDevice/LogicalDevice.h"
 #include "../../physicalDevice/PhysicalDevice.h"
+#include "../../uploadManager/UploadManager.h"
 #include "../../../utilities/Buffers.h"
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
 namespace vke {
 
   Model::Model(const std::shared_ptr<LogicalDevice>& logicalDevice,
-               const vk::CommandPool& commandPool,
+               const std::shared_ptr<UploadManager>& uploadManager,
                const char* path,
                const glm::vec3 rotation)
   {
     loadModel(path, glm::quat(glm::radians(rotation)));
+    computeBounds();
 
-    createVertexBuffer(logicalDevice, commandPool);
-    createIndexBuffer(logicalDevice, commandPool);
-    createBLAS(logicalDevice, commandPool);
+    createVertexBuffer(logicalDevice, uploadManager);
+    createIndexBuffer(logicalDevice, uploadManager);
+    createBLAS(logicalDevice, uploadManager);
   }
 
   Model::Model(const std::shared_ptr<LogicalDevice>& logicalDevice,
-               const vk::CommandPool& commandPool,
+               const std::shared_ptr<UploadManager>& uploadManager,
                const char* path,
                const glm::quat orientation)
   {
     loadModel(path, glm::normalize(orientation));
+    computeBounds();
 
-    createVertexBuffer(logicalDevice, commandPool);
-    createIndexBuffer(logicalDevice, commandPool);
-    createBLAS(logicalDevice, commandPool);
+    createVertexBuffer(logicalDevice, uploadManager);
+    createIndexBuffer(logicalDevice, uploadManager);
+    createBLAS(logicalDevice, uploadManager);
   }
 
   void Model::loadModel(const char* path,
@@ -49,15 +55,48 @@ namespace vke {
     }
 
     const aiMesh* mesh = scene->mMeshes[0];
-    loadVertices(mesh, orientation);
-    loadIndices(mesh);
+    loadVertices(mesh, orientation, m_vertices);
+    loadIndices(mesh, m_indices);
+  }
+
+  void Model::computeBounds()
+  {
+    if (m_vertices.empty())
+    {
+      return;
+    }
+
+    glm::vec3 min = m_vertices.front().pos;
+    glm::vec3 max = m_vertices.front().pos;
+
+    for (const auto& vertex : m_vertices)
+    {
+      min = glm::min(min, vertex.pos);
+      max = glm::max(max, vertex.pos);
+    }
+
+    m_bounds.center = (min + max) * 0.5f;
+    m_bounds.extents = (max - min) * 0.5f;
+
+    // Measured from the box center rather than taken from its corner, which is usually tighter
+    float radiusSquared = 0.0f;
+    for (const auto& vertex : m_vertices)
+    {
+      const glm::vec3 offset = vertex.pos - m_bounds.center;
+      radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+    }
+
+    m_bounds.radius = std::sqrt(radiusSquared);
   }
 
   void Model::loadVertices(const aiMesh* mesh,
-                           const glm::quat orientation)
+                           const glm::quat orientation,
+                           std::vector<Vertex>& vertices)
   {
     const auto orientationMatrix = glm::mat4(orientation);
 
+    vertices.reserve(vertices.size() + mesh->mNumVertices);
+
     for (unsigned int i = 0; i < mesh->mNumVertices; i++)
     {
       Vertex vertex {
@@ -80,11 +119,12 @@ namespace vke {
       vertex.pos = orientationMatrix * glm::vec4(vertex.pos, 1.0f);
       vertex.normal = orientationMatrix * glm::vec4(vertex.normal, 1.0f);
 
-      m_vertices.push_back(vertex);
+      vertices.push_back(vertex);
     }
   }
 
-  void Model::loadIndices(const aiMesh* mesh)
+  void Model::loadIndices(const aiMesh* mesh,
+                          std::vector<uint32_t>& indices)
   {
     for (unsigned int i = 0; i < mesh->mNumFaces; i++)
     {
@@ -92,31 +132,16 @@ namespace vke {
 
       for (unsigned int j = 0; j < face.mNumIndices; j++)
       {
-        m_indices.push_back(face.mIndices[j]);
+        indices.push_back(face.mIndices[j]);
       }
     }
   }
 
   void Model::createVertexBuffer(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                 const vk::CommandPool& commandPool)
+                                 const std::shared_ptr<UploadManager>& uploadManager)
   {
     const vk::DeviceSize bufferSize = sizeof(m_vertices[0]) * m_vertices.size();
 
-    vk::raii::Buffer stagingBuffer = nullptr;
-    vk::raii::DeviceMemory stagingBufferMemory = nullptr;
-    Buffers::createBuffer(
-      logicalDevice,
-      bufferSize,
-      vk::BufferUsageFlagBits::eTransferSrc,
-      vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
-      stagingBuffer,
-      stagingBufferMemory
-    );
-
-    Buffers::doMappedMemoryOperation(stagingBufferMemory, [this, bufferSize](void* data) {
-      memcpy(data, m_vertices.data(), bufferSize);
-    });
-
     Buffers::createBuffer(
       logicalDevice,
       bufferSize,
@@ -127,37 +152,14 @@ namespace vke {
       m_vertexBufferMemory
     );
 
-    Buffers::copyBuffer(
-      logicalDevice,
-      commandPool,
-      logicalDevice->getGraphicsQueue(),
-      stagingBuffer,
-      m_vertexBuffer,
-      bufferSize
-    );
+    uploadManager->uploadBuffer(m_vertexBuffer, m_vertices.data(), bufferSize);
   }
 
   void Model::createIndexBuffer(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                const vk::CommandPool& commandPool)
+                                const std::shared_ptr<UploadManager>& uploadManager)
   {
     const vk::DeviceSize bufferSize = sizeof(m_indices[0]) * m_indices.size();
 
-    vk::raii::Buffer stagingBuffer = nullptr;
-    vk::raii::DeviceMemory stagingBufferMemory = nullptr;
-
-    Buffers::createBuffer(
-      logicalDevice,
-      bufferSize,
-      vk::BufferUsageFlagBits::eTransferSrc,
-      vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
-      stagingBuffer,
-      stagingBufferMemory
-    );
-
-    Buffers::doMappedMemoryOperation(stagingBufferMemory, [this, bufferSize](void* data) {
-      memcpy(data, m_indices.data(), bufferSize);
-    });
-
     Buffers::createBuffer(
       logicalDevice,
       bufferSize,
@@ -168,8 +170,7 @@ namespace vke {
       m_indexBufferMemory
     );
 
-    Buffers::copyBuffer(logicalDevice, commandPool, logicalDevice->getGraphicsQueue(), *stagingBuffer,
-                        *m_indexBuffer, bufferSize);
+    uploadManager->uploadBuffer(m_indexBuffer, m_indices.data(), bufferSize);
   }
 
   void Model::bind(const std::shared_ptr<CommandBuffer>& commandBuffer) const
@@ -181,7 +182,7 @@ namespace vke {
   }
 
   void Model::createBLAS(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                         const vk::CommandPool& commandPool)
+                         const std::shared_ptr<UploadManager>& uploadManager)
   {
     if (!logicalDevice->getPhysicalDevice()->supportsRayTracing())
     {
@@ -217,7 +218,7 @@ namespace vke {
 
     m_blas = logicalDevice->createAccelerationStructure(accelerationStructureCreateInfo);
 
-    populateBLAS(logicalDevice, commandPool, buildGeometryInfo, buildSizesInfo, primitiveCount);
+    populateBLAS(logicalDevice, uploadManager, buildGeometryInfo, buildSizesInfo, primitiveCount);
   }
 
   void Model::createCoreBLASData(const std::shared_ptr<LogicalDevice>& logicalDevice,
@@ -249,13 +250,13 @@ namespace vke {
   }
 
   void Model::populateBLAS(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                           const vk::CommandPool& commandPool,
+                           const std::shared_ptr<UploadManager>& uploadManager,
                            vk::AccelerationStructureBuildGeometryInfoKHR& buildGeometryInfo,
                            const vk::AccelerationStructureBuildSizesInfoKHR& buildSizesInfo,
                            const uint32_t primitiveCount) const
   {
     vk::raii::Buffer scratchBuffer = nullptr;
-    vk::raii::DeviceMemory scratchBufferMemory = nullptr;
+    MemoryAllocation scratchBufferMemory = nullptr;
 
     Buffers::createBuffer(
       logicalDevice,
@@ -276,18 +277,42 @@ namespace vke {
       .transformOffset = 0
     };
 
-    const auto commandBuffer = SingleUseCommandBuffer(logicalDevice, commandPool, logicalDevice->getGraphicsQueue());
+    uploadManager->record([&buildGeometryInfo, &buildRangeInfo](const CommandBuffer& commandBuffer) {
+      constexpr vk::MemoryBarrier memoryBarrier {
+        .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+        .dstAccessMask = vk::AccessFlagBits::eAccelerationStructureReadKHR | vk::AccessFlagBits::eShaderRead
+      };
+
+      // The vertex and index copies earlier in the batch feed the build
+      commandBuffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eTransfer,
+        vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR,
+        {},
+        { memoryBarrier },
+        {},
+        {}
+      );
 
-    commandBuffer.record([&commandBuffer, buildGeometryInfo, buildRangeInfo] {
       commandBuffer.buildAccelerationStructure(buildGeometryInfo, &buildRangeInfo);
     });
+
+    uploadManager->retain(std::move(scratchBuffer), std::move(scratchBufferMemory));
   }
 
-  void Model::draw(const std::shared_ptr<CommandBuffer>& commandBuffer) const
+  void Model::draw(const std::shared_ptr<CommandBuffer>& commandBuffer,
+                   const uint32_t firstInstance,
+                   const uint32_t instanceCount) const
   {
     bind(commandBuffer);
 
-    commandBuffer->drawIndexed(static_cast<uint32_t>(m_indices.size()), 1, 0, 0, 0);
+    drawInstances(commandBuffer, firstInstance, instanceCount);
+  }
+
+  void Model::drawInstances(const std::shared_ptr<CommandBuffer>& commandBuffer,
+                            const uint32_t firstInstance,
+                            const uint32_t instanceCount) const
+  {
+    commandBuffer->drawIndexed(static_cast<uint32_t>(m_indices.size()), instanceCount, 0, 0, firstInstance);
   }
 
   vk::AccelerationStructureKHR Model::getBLAS() const
@@ -304,4 +329,9 @@ namespace vke {
   {
     return m_indices;
   }
+
+  const ModelBounds& Model::getBounds() const
+  {
+    return m_bounds;
+  }
 } // namespace vke
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define VKE_MODEL_H
 
 #include "../../pipelines/implementations/vertexInputs/Vertex.h"
+#include "../../memory/MemoryAllocation.h"
 #include <assimp/mesh.h>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/vec3.hpp>
@@ -13,20 +14,39 @@ namespace vke {
 
   class CommandBuffer;
   class LogicalDevice;
+  class UploadManager;
+
+  // Object space bounds, the sphere is centered on the box so both share a center once transformed
+  struct ModelBounds {
+    glm::vec3 center;
+    glm::vec3 extents;
+    float radius;
+  };
 
   class Model {
   public:
     Model(const std::shared_ptr<LogicalDevice>& logicalDevice,
-          const vk::CommandPool& commandPool,
+          const std::shared_ptr<UploadManager>& uploadManager,
           const char* path,
           glm::vec3 rotation);
 
     Model(const std::shared_ptr<LogicalDevice>& logicalDevice,
-          const vk::CommandPool& commandPool,
+          const std::shared_ptr<UploadManager>& uploadManager,
           const char* path,
           glm::quat orientation);
 
-    void draw(const std::shared_ptr<CommandBuffer>& commandBuffer) const;
+    // Instances reach the shaders as gl_InstanceIndex, which they use to look up the object each one draws
+    void draw(const std::shared_ptr<CommandBuffer>& commandBuffer,
+              uint32_t firstInstance,
+              uint32_t instanceCount) const;
+
+    // Binds the vertex and index buffers, consecutive draws of the model can then skip it with drawInstances
+    void bind(const std::shared_ptr<CommandBuffer>& commandBuffer) const;
+
+    // Draws with the buffers left bound by the last bind
+    void drawInstances(const std::shared_ptr<CommandBuffer>& commandBuffer,
+                       uint32_t firstInstance,
+                       uint32_t instanceCount) const;
 
     [[nodiscard]] vk::AccelerationStructureKHR getBLAS() const;
 
@@ -34,38 +54,44 @@ namespace vke {
 
     [[nodiscard]] const std::vector<uint32_t>& getIndices() const;
 
+    [[nodiscard]] const ModelBounds& getBounds() const;
+
+    static void loadVertices(const aiMesh* mesh,
+                             glm::quat orientation,
+                             std::vector<Vertex>& vertices);
+
+    static void loadIndices(const aiMesh* mesh,
+                            std::vector<uint32_t>& indices);
+
   private:
     std::vector<Vertex> m_vertices;
     std::vector<uint32_t> m_indices;
 
+    ModelBounds m_bounds {};
+
     vk::raii::Buffer m_vertexBuffer = nullptr;
-    vk::raii::DeviceMemory m_vertexBufferMemory = nullptr;
+    MemoryAllocation m_vertexBufferMemory = nullptr;
 
     vk::raii::Buffer m_indexBuffer = nullptr;
-    vk::raii::DeviceMemory m_indexBufferMemory = nullptr;
+    MemoryAllocation m_indexBufferMemory = nullptr;
 
     vk::raii::Buffer m_blasBuffer = nullptr;
-    vk::raii::DeviceMemory m_blasBufferMemory = nullptr;
+    MemoryAllocation m_blasBufferMemory = nullptr;
     vk::raii::AccelerationStructureKHR m_blas = nullptr;
 
     void loadModel(const char* path,
                    glm::quat orientation);
 
-    void loadVertices(const aiMesh* mesh,
-                      glm::quat orientation);
-
-    void loadIndices(const aiMesh* mesh);
+    void computeBounds();
 
     void createVertexBuffer(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                            const vk::CommandPool& commandPool);
+                            const std::shared_ptr<UploadManager>& uploadManager);
 
     void createIndexBuffer(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                           const vk::CommandPool& commandPool);
-
-    void bind(const std::shared_ptr<CommandBuffer>& commandBuffer) const;
+                           const std::shared_ptr<UploadManager>& uploadManager);
 
     void createBLAS(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                    const vk::CommandPool& commandPool);
+                    const std::shared_ptr<UploadManager>& uploadManager);
 
     void createCoreBLASData(const std::shared_ptr<LogicalDevice>& logicalDevice,
                             vk::AccelerationStructureGeometryTrianglesDataKHR& trianglesData,
@@ -73,7 +99,7 @@ namespace vke {
                             vk::AccelerationStructureBuildGeometryInfoKHR& buildGeometryInfo) const;
 
     void populateBLAS(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                      const vk::CommandPool& commandPool,
+                      const std::shared_ptr<UploadManager>& uploadManager,
                       vk::AccelerationStructureBuildGeometryInfoKHR& buildGeometryInfo,
                       const vk::AccelerationStructureBuildSizesInfoKHR& buildSizesInfo,
                       uint32_t primitiveCount) const;
@@ -1,22 +1,11 @@
 #include "RenderObject.h"
 #include "Model.h"
-#include "../../commandBuffer/CommandBuffer.h"
 #include "../../logicalDevice/LogicalDevice.h"
 #include "../../pipelines/descriptorSets/DescriptorSet.h"
 #include "../../assets/textures/Texture.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <vector>
 
-namespace {
-
-  struct TransformUniform {
-    alignas(16) glm::mat4 model;
-    alignas(16) glm::mat4 view;
-    alignas(16) glm::mat4 proj;
-  };
-
-}
-
 namespace vke {
 
   RenderObject::RenderObject(const std::shared_ptr<LogicalDevice>& logicalDevice,
@@ -27,67 +16,63 @@ namespace vke {
                              std::shared_ptr<Model> model)
     : m_texture(std::move(texture)),
       m_specularMap(std::move(specularMap)),
-      m_model(std::move(model)),
-      m_transformUniform(std::make_unique<UniformBuffer>(logicalDevice, sizeof(TransformUniform)))
+      m_model(std::move(model))
   {
     createDescriptorSet(logicalDevice, descriptorPool, descriptorSetLayout);
   }
 
-  void RenderObject::draw(const std::shared_ptr<CommandBuffer>& commandBuffer,
-                          const vk::PipelineLayout& pipelineLayout,
-                          const uint32_t currentFrame) const
-  {
-    commandBuffer->bindDescriptorSets(
-      vk::PipelineBindPoint::eGraphics,
-      pipelineLayout,
-      0,
-      { m_descriptorSet->getDescriptorSet(currentFrame) }
-    );
-
-    m_model->draw(commandBuffer);
-  }
-
-  void RenderObject::draw(const std::shared_ptr<CommandBuffer>& commandBuffer) const
+  void RenderObject::setObjectIndex(const uint32_t objectIndex)
   {
-    m_model->draw(commandBuffer);
+    m_objectIndex = objectIndex;
   }
 
-  void RenderObject::updateUniformBuffer(const uint32_t currentFrame,
-                                         const glm::mat4& viewMatrix,
-                                         const glm::mat4& projectionMatrix) const
+  uint32_t RenderObject::getObjectIndex() const
   {
-    const TransformUniform transformUBO {
-      .model = getModelMatrix(),
-      .view = viewMatrix,
-      .proj = projectionMatrix
-    };
-
-    m_transformUniform->update(currentFrame, &transformUBO);
+    return m_objectIndex;
   }
 
   void RenderObject::setPosition(const glm::vec3 position)
   {
-    m_position = position;
+    if (m_position != position)
+    {
+      m_position = position;
+      ++m_transformRevision;
+    }
   }
 
   void RenderObject::setScale(const glm::vec3 scale)
   {
-    m_scale = scale;
+    if (m_scale != scale)
+    {
+      m_scale = scale;
+      ++m_transformRevision;
+    }
   }
 
   void RenderObject::setScale(const float scale)
   {
-    m_scale = glm::vec3(scale);
+    setScale(glm::vec3(scale));
   }
 
   void RenderObject::setOrientationEuler(const glm::vec3 orientation)
   {
-    m_orientation = glm::quat(glm::radians(orientation));
+    setOrientationQuat(glm::quat(glm::radians(orientation)));
   }
 
   void RenderObject::setOrientationQuat(const glm::quat orientation)
   {
-    m_orientation = glm::normalize(orientation);
+    const glm::quat normalizedOrientation = glm::normalize(orientation);
+
+    if (m_orientation != normalizedOrientation)
+    {
+      m_orientation = normalizedOrientation;
+      ++m_transformRevision;
+    }
+  }
+
+  uint32_t RenderObject::getTransformRevision() const
+  {
+    return m_transformRevision;
   }
 
   glm::vec3 RenderObject::getPosition() const
@@ -122,9 +107,16 @@ namespace vke {
 
   glm::mat4 RenderObject::getModelMatrix() const
   {
-    const glm::mat4 model = glm::translate(glm::mat4(1.0f), m_position)
-                            * glm::mat4(m_orientation)
-                            * glm::scale(glm::mat4(1.0f), m_scale);
+    return createModelMatrix(m_position, m_orientation, m_scale);
+  }
+
+  glm::mat4 RenderObject::createModelMatrix(const glm::vec3& position,
+                                            const glm::quat& orientation,
+                                            const glm::vec3& scale)
+  {
+    const glm::mat4 model = glm::translate(glm::mat4(1.0f), position)
+                            * glm::mat4(orientation)
+                            * glm::scale(glm::mat4(1.0f), scale);
 
     return model;
   }
@@ -169,15 +161,34 @@ namespace vke {
     return m_indexOfRefraction;
   }
 
+  void RenderObject::setCastsShadows(const bool castsShadows)
+  {
+    m_castsShadows = castsShadows;
+  }
+
+  bool RenderObject::castsShadows() const
+  {
+    return m_castsShadows;
+  }
+
+  void RenderObject::setReceivesShadows(const bool receivesShadows)
+  {
+    m_receivesShadows = receivesShadows;
+  }
+
+  bool RenderObject::receivesShadows() const
+  {
+    return m_receivesShadows;
+  }
+
   void RenderObject::createDescriptorSet(const std::shared_ptr<LogicalDevice>& logicalDevice,
                                          vk::DescriptorPool descriptorPool,
                                          vk::DescriptorSetLayout descriptorSetLayout)
   {
     m_descriptorSet = std::make_shared<DescriptorSet>(logicalDevice, descriptorPool, descriptorSetLayout);
-    m_descriptorSet->updateDescriptorSets([this](const vk::DescriptorSet descriptorSet, const size_t frame)
+    m_descriptorSet->updateDescriptorSets([this](const vk::DescriptorSet descriptorSet, [[maybe_unused]] const size_t frame)
     {
       std::vector descriptorWrites{{
-        m_transformUniform->getDescriptorSet(0, descriptorSet, frame),
         m_texture->getDescriptorSet(1, descriptorSet),
         m_specularMap->getDescriptorSet(4, descriptorSet)
       }};
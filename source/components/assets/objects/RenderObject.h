@@ -1,14 +1,12 @@
 #ifndef VKE_RENDEROBJECT_H
 #define VKE_RENDEROBJECT_H
 
-#include "../../pipelines/uniformBuffers/UniformBuffer.h"
 #include <glm/gtc/quaternion.hpp>
 #include <vulkan/vulkan_raii.hpp>
 #include <memory>
 
 namespace vke {
 
-  class CommandBuffer;
   class DescriptorSet;
   class LogicalDevice;
   class Model;
@@ -23,15 +21,10 @@ namespace vke {
                  std::shared_ptr<Texture> specularMap,
                  std::shared_ptr<Model> model);
 
-    void draw(const std::shared_ptr<CommandBuffer>& commandBuffer,
-              const vk::PipelineLayout& pipelineLayout,
-              uint32_t currentFrame) const;
+    // Slot of the object's data in the frame's object buffer, assigned each frame before any pass draws it
+    void setObjectIndex(uint32_t objectIndex);
 
-    void draw(const std::shared_ptr<CommandBuffer>& commandBuffer) const;
-
-    void updateUniformBuffer(uint32_t currentFrame,
-                             const glm::mat4& viewMatrix,
-                             const glm::mat4& projectionMatrix) const;
+    [[nodiscard]] uint32_t getObjectIndex() const;
 
     void setPosition(glm::vec3 position);
     void setScale(glm::vec3 scale);
@@ -44,12 +37,19 @@ namespace vke {
     [[nodiscard]] glm::vec3 getOrientationEuler() const;
     [[nodiscard]] glm::quat getOrientationQuat() const;
 
+    // Bumped whenever the transform changes, so cached results such as shadow maps can tell the object moved
+    [[nodiscard]] uint32_t getTransformRevision() const;
+
     [[nodiscard]] vk::DescriptorSet getDescriptorSet(uint32_t currentFrame) const;
 
     [[nodiscard]] std::shared_ptr<Model> getModel() const;
 
     [[nodiscard]] glm::mat4 getModelMatrix() const;
 
+    [[nodiscard]] static glm::mat4 createModelMatrix(const glm::vec3& position,
+                                                     const glm::quat& orientation,
+                                                     const glm::vec3& scale);
+
     [[nodiscard]] std::shared_ptr<Texture> getTexture() const;
 
     [[nodiscard]] std::shared_ptr<Texture> getSpecularMap() const;
@@ -66,6 +66,14 @@ namespace vke {
 
     [[nodiscard]] float getIndexOfRefraction() const;
 
+    void setCastsShadows(bool castsShadows);
+
+    [[nodiscard]] bool castsShadows() const;
+
+    void setReceivesShadows(bool receivesShadows);
+
+    [[nodiscard]] bool receivesShadows() const;
+
   private:
     std::shared_ptr<DescriptorSet> m_descriptorSet;
 
@@ -77,12 +85,17 @@ namespace vke {
     glm::vec3 m_scale = glm::vec3(1);
     glm::quat m_orientation = glm::quat(1, 0, 0, 0);
 
-    std::unique_ptr<UniformBuffer> m_transformUniform;
+    uint32_t m_transformRevision = 0;
+
+    uint32_t m_objectIndex = 0;
 
     float m_reflectivity = 0.0f;
     float m_refractivity = 0.0f;
     float m_indexOfRefraction = 1.0f;
 
+    bool m_castsShadows = true;
+    bool m_receivesShadows = true;
+
     void createDescriptorSet(const std::shared_ptr<LogicalDevice>& logicalDevice,
                              vk::DescriptorPool descriptorPool,
                              vk::DescriptorSetLayout descriptorSetLayout);
@@ -4,6 +4,7 @@
 #include "../../pipelines/descriptorSets/DescriptorSet.h"
 #include "../../pipelines/uniformBuffers/UniformBuffer.h"
 #include "../../pipelines/implementations/vertexInputs/SmokeParticle.h"
+#include "../../uploadManager/UploadManager.h"
 #include "../../../utilities/Buffers.h"
 #include <imgui.h>
 #include <cstring>
@@ -20,36 +21,25 @@ namespace {
 
 namespace vke {
   SmokeSystem::SmokeSystem(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                           const vk::CommandPool commandPool,
+                           const std::shared_ptr<UploadManager>& uploadManager,
                            const vk::DescriptorPool descriptorPool,
                            const vk::DescriptorSetLayout smokeSystemDescriptorSetLayout,
                            const glm::vec3 position,
                            const uint32_t numParticles)
-    : m_previousTime(std::chrono::steady_clock::now()),
-      m_numParticles(numParticles)
+    : m_numParticles(numParticles)
   {
     m_smokeUBO.systemPosition = position;
 
     createUniforms(logicalDevice);
 
-    createShaderStorageBuffers(logicalDevice, commandPool);
+    createShaderStorageBuffers(logicalDevice, uploadManager);
 
     createDescriptorSet(logicalDevice, descriptorPool, smokeSystemDescriptorSetLayout);
   }
 
   void SmokeSystem::update(const RenderInfo* renderInfo)
   {
-    if (!m_ran)
-    {
-      m_previousTime = std::chrono::steady_clock::now();
-      m_ran = true;
-    }
-
-    const auto currentTime = std::chrono::steady_clock::now();
-    const float dt = std::chrono::duration<float>(currentTime - m_previousTime).count();
-    m_previousTime = currentTime;
-
-    const float deltaTimeUBO = m_dotSpeed * dt;
+    const float deltaTimeUBO = m_dotSpeed * renderInfo->deltaTime;
 
     m_deltaTimeUniform->update(renderInfo->currentFrame, &deltaTimeUBO);
 
@@ -138,7 +128,7 @@ namespace vke {
   }
 
   void SmokeSystem::createShaderStorageBuffers(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                               const vk::CommandPool& commandPool)
+                                               const std::shared_ptr<UploadManager>& uploadManager)
   {
     std::default_random_engine randomEngine(static_cast<unsigned int>(time(nullptr)));
     std::uniform_real_distribution colorDistribution(0.25f, 1.0f);
@@ -158,11 +148,11 @@ namespace vke {
       currentTTL -= currentTTL > -4.0f ? ttlSpan * 4.0f : ttlSpan;
     }
 
-    uploadShaderStorageBuffers(logicalDevice, commandPool, particles);
+    uploadShaderStorageBuffers(logicalDevice, uploadManager, particles);
   }
 
   void SmokeSystem::uploadShaderStorageBuffers(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                               const vk::CommandPool& commandPool,
+                                               const std::shared_ptr<UploadManager>& uploadManager,
                                                const std::vector<SmokeParticle>& particles)
   {
     m_shaderStorageBuffers.reserve(logicalDevice->getMaxFramesInFlight());
@@ -170,18 +160,6 @@ namespace vke {
 
     const vk::DeviceSize bufferSize = sizeof(SmokeParticle) * m_numParticles;
 
-    vk::raii::Buffer stagingBuffer = nullptr;
-    vk::raii::DeviceMemory stagingBufferMemory = nullptr;
-
-    Buffers::createBuffer(logicalDevice, bufferSize,
-                          vk::BufferUsageFlagBits::eTransferSrc,
-                          vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
-                          stagingBuffer, stagingBufferMemory);
-
-    Buffers::doMappedMemoryOperation(stagingBufferMemory, [particles, bufferSize](void* data) {
-      memcpy(data, particles.data(), bufferSize);
-    });
-
     for (size_t i = 0; i < logicalDevice->getMaxFramesInFlight(); i++)
     {
       m_shaderStorageBuffers.emplace_back(nullptr);
@@ -191,9 +169,6 @@ namespace vke {
                             vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eTransferDst,
                             vk::MemoryPropertyFlagBits::eDeviceLocal, m_shaderStorageBuffers[i], m_shaderStorageBuffersMemory[i]);
 
-      Buffers::copyBuffer(logicalDevice, commandPool, logicalDevice->getComputeQueue(),
-                          *stagingBuffer, *m_shaderStorageBuffers[i], bufferSize);
-
       const vk::DescriptorBufferInfo bufferInfo {
         .buffer = *m_shaderStorageBuffers[i],
         .offset = 0,
@@ -202,6 +177,21 @@ namespace vke {
 
       m_shaderStorageBufferInfos.push_back(bufferInfo);
     }
+
+    // Every frame's buffer starts from the same particles, so they share one staging copy
+    uploadManager->upload(bufferSize, [&particles, bufferSize](void* data) {
+      memcpy(data, particles.data(), bufferSize);
+    }, [this, bufferSize](const CommandBuffer& commandBuffer, const StagingRegion& stagingRegion) {
+      for (const auto& shaderStorageBuffer : m_shaderStorageBuffers)
+      {
+        Buffers::copyBuffer(commandBuffer, stagingRegion.buffer, shaderStorageBuffer, bufferSize, stagingRegion.offset);
+      }
+    });
+
+    for (const auto& shaderStorageBuffer : m_shaderStorageBuffers)
+    {
+      uploadManager->releaseBuffer(shaderStorageBuffer);
+    }
   }
 
   void SmokeSystem::createDescriptorSet(const std::shared_ptr<LogicalDevice>& logicalDevice,
@@ -1,9 +1,9 @@
 #ifndef VULKANPROJECT_SMOKESYSTEM_H
 #define VULKANPROJECT_SMOKESYSTEM_H
 
+#include "../../memory/MemoryAllocation.h"
 #include <glm/vec3.hpp>
 #include <vulkan/vulkan_raii.hpp>
-#include <chrono>
 #include <memory>
 #include <vector>
 
@@ -14,11 +14,12 @@ namespace vke {
   struct RenderInfo;
   struct SmokeParticle;
   class UniformBuffer;
+  class UploadManager;
 
   class SmokeSystem {
   public:
     SmokeSystem(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                vk::CommandPool commandPool,
+                const std::shared_ptr<UploadManager>& uploadManager,
                 vk::DescriptorPool descriptorPool,
                 vk::DescriptorSetLayout smokeSystemDescriptorSetLayout,
                 glm::vec3 position,
@@ -54,7 +55,7 @@ namespace vke {
 
   private:
     std::vector<vk::raii::Buffer> m_shaderStorageBuffers;
-    std::vector<vk::raii::DeviceMemory> m_shaderStorageBuffersMemory;
+    std::vector<MemoryAllocation> m_shaderStorageBuffersMemory;
     std::vector<vk::DescriptorBufferInfo> m_shaderStorageBufferInfos;
 
     std::shared_ptr<DescriptorSet> m_smokeSystemDescriptorSet;
@@ -64,12 +65,9 @@ namespace vke {
     std::shared_ptr<UniformBuffer> m_smokeUniform;
 
     float m_dotSpeed = 0.75f;
-    std::chrono::time_point<std::chrono::steady_clock> m_previousTime;
 
     uint32_t m_numParticles = 0;
 
-    bool m_ran = false;
-
     struct SmokeUniform {
       glm::vec3 systemPosition;
       float spreadFactor;
@@ -86,10 +84,10 @@ namespace vke {
     void createUniforms(const std::shared_ptr<LogicalDevice>& logicalDevice);
 
     void createShaderStorageBuffers(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                    const vk::CommandPool& commandPool);
+                                    const std::shared_ptr<UploadManager>& uploadManager);
 
     void uploadShaderStorageBuffers(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                    const vk::CommandPool& commandPool,
+                                    const std::shared_ptr<UploadManager>& uploadManager,
                                     const std::vector<SmokeParticle>& particles);
 
     void createDescriptorSet(const std::shared_ptr<LogicalDevice>& logicalDevice,
@@ -1,5 +1,5 @@
 #include "Texture.h"
-#include "../../commandBuffer/SingleUseCommandBuffer.h"
+#include "../../commandBuffer/CommandBuffer.h"
 #include "../../logicalDevice/LogicalDevice.h"
 #include "../../physicalDevice/PhysicalDevice.h"
 #include "../../../utilities/Buffers.h"
@@ -59,7 +59,7 @@ namespace vke {
   }
 
   void Texture::generateMipmaps(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                const vk::CommandPool commandPool,
+                                const CommandBuffer& commandBuffer,
                                 const vk::Image image,
                                 const vk::Format imageFormat,
                                 const int32_t texWidth,
@@ -73,52 +73,48 @@ namespace vke {
       throw std::runtime_error("texture image format does not support linear blitting!");
     }
 
-    const auto commandBuffer = SingleUseCommandBuffer(logicalDevice, commandPool, logicalDevice->getGraphicsQueue());
-
-    commandBuffer.record([&commandBuffer, image, texWidth, texHeight, mipLevels] {
-      vk::ImageMemoryBarrier barrier {
-        .sType = vk::StructureType::eImageMemoryBarrier,
-        .srcAccessMask = {},
-        .dstAccessMask = {},
-        .oldLayout = vk::ImageLayout::eUndefined,
-        .newLayout = vk::ImageLayout::eUndefined,
-        .srcQueueFamilyIndex = vk::QueueFamilyIgnored,
-        .dstQueueFamilyIndex = vk::QueueFamilyIgnored,
-        .image = image,
-        .subresourceRange = {
-          vk::ImageAspectFlagBits::eColor,
-          0, 1,
-          0, 1
-        }
-      };
-
-      int32_t mipWidth = texWidth;
-      int32_t mipHeight = texHeight;
-
-      for (uint32_t i = 1; i < mipLevels; i++)
-      {
-        transitionMipLevelToTransferSrc(commandBuffer, barrier, i - 1);
+    vk::ImageMemoryBarrier barrier {
+      .sType = vk::StructureType::eImageMemoryBarrier,
+      .srcAccessMask = {},
+      .dstAccessMask = {},
+      .oldLayout = vk::ImageLayout::eUndefined,
+      .newLayout = vk::ImageLayout::eUndefined,
+      .srcQueueFamilyIndex = vk::QueueFamilyIgnored,
+      .dstQueueFamilyIndex = vk::QueueFamilyIgnored,
+      .image = image,
+      .subresourceRange = {
+        vk::ImageAspectFlagBits::eColor,
+        0, 1,
+        0, 1
+      }
+    };
+
+    int32_t mipWidth = texWidth;
+    int32_t mipHeight = texHeight;
 
-        blitImage(commandBuffer, image, i - 1, mipWidth, mipHeight);
+    for (uint32_t i = 1; i < mipLevels; i++)
+    {
+      transitionMipLevelToTransferSrc(commandBuffer, barrier, i - 1);
 
-        transitionMipLevelToShaderRead(commandBuffer, barrier);
+      blitImage(commandBuffer, image, i - 1, mipWidth, mipHeight);
 
-        if (mipWidth > 1)
-        {
-          mipWidth /= 2;
-        }
+      transitionMipLevelToShaderRead(commandBuffer, barrier);
 
-        if (mipHeight > 1)
-        {
-          mipHeight /= 2;
-        }
+      if (mipWidth > 1)
+      {
+        mipWidth /= 2;
       }
 
-      transitionFinalMipLevelToShaderRead(commandBuffer, barrier, mipLevels - 1);
-    });
+      if (mipHeight > 1)
+      {
+        mipHeight /= 2;
+      }
+    }
+
+    transitionFinalMipLevelToShaderRead(commandBuffer, barrier, mipLevels - 1);
   }
 
-  void Texture::blitImage(const SingleUseCommandBuffer& commandBuffer,
+  void Texture::blitImage(const CommandBuffer& commandBuffer,
                           const vk::Image image,
                           const uint32_t mipLevel,
                           const int32_t mipWidth,
@@ -157,7 +153,7 @@ namespace vke {
     );
   }
 
-  void Texture::transitionMipLevelToTransferSrc(const SingleUseCommandBuffer& commandBuffer,
+  void Texture::transitionMipLevelToTransferSrc(const CommandBuffer& commandBuffer,
                                                 vk::ImageMemoryBarrier& barrier,
                                                 const uint32_t mipLevel)
   {
@@ -177,7 +173,7 @@ namespace vke {
     );
   }
 
-  void Texture::transitionMipLevelToShaderRead(const SingleUseCommandBuffer& commandBuffer,
+  void Texture::transitionMipLevelToShaderRead(const CommandBuffer& commandBuffer,
                                                vk::ImageMemoryBarrier& barrier)
   {
     barrier.oldLayout = vk::ImageLayout::eTransferSrcOptimal;
@@ -195,7 +191,7 @@ namespace vke {
     );
   }
 
-  void Texture::transitionFinalMipLevelToShaderRead(const SingleUseCommandBuffer& commandBuffer,
+  void Texture::transitionFinalMipLevelToShaderRead(const CommandBuffer& commandBuffer,
                                                     vk::ImageMemoryBarrier& barrier,
                                                     const uint32_t mipLevel)
   {
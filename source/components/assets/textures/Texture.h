@@ -1,14 +1,15 @@
 #ifndef VKE_TEXTURE_H
 #define VKE_TEXTURE_H
 
+#include "../../memory/MemoryAllocation.h"
 #include <imgui.h>
 #include <vulkan/vulkan_raii.hpp>
 #include <memory>
 
 namespace vke {
 
+  class CommandBuffer;
   class LogicalDevice;
-  class SingleUseCommandBuffer;
 
   class Texture {
   public:
@@ -26,7 +27,7 @@ namespace vke {
 
   protected:
     vk::raii::Image m_textureImage = nullptr;
-    vk::raii::DeviceMemory m_textureImageMemory = nullptr;
+    MemoryAllocation m_textureImageMemory = nullptr;
     vk::raii::ImageView m_textureImageView = nullptr;
     vk::raii::Sampler m_textureSampler = nullptr;
 
@@ -37,27 +38,27 @@ namespace vke {
     vk::DescriptorSet m_imGuiTexture{};
 
     static void generateMipmaps(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                vk::CommandPool commandPool,
+                                const CommandBuffer& commandBuffer,
                                 vk::Image image,
                                 vk::Format imageFormat,
                                 int32_t texWidth,
                                 int32_t texHeight,
                                 uint32_t mipLevels);
 
-    static void blitImage(const SingleUseCommandBuffer& commandBuffer,
+    static void blitImage(const CommandBuffer& commandBuffer,
                           vk::Image image,
                           uint32_t mipLevel,
                           int32_t mipWidth,
                           int32_t mipHeight);
 
-    static void transitionMipLevelToTransferSrc(const SingleUseCommandBuffer& commandBuffer,
+    static void transitionMipLevelToTransferSrc(const CommandBuffer& commandBuffer,
                                                 vk::ImageMemoryBarrier& barrier,
                                                 uint32_t mipLevel);
 
-    static void transitionMipLevelToShaderRead(const SingleUseCommandBuffer& commandBuffer,
+    static void transitionMipLevelToShaderRead(const CommandBuffer& commandBuffer,
                                                vk::ImageMemoryBarrier& barrier);
 
-    static void transitionFinalMipLevelToShaderRead(const SingleUseCommandBuffer& commandBuffer,
+    static void transitionFinalMipLevelToShaderRead(const CommandBuffer& commandBuffer,
                                                     vk::ImageMemoryBarrier& barrier,
                                                     uint32_t mipLevel);
 
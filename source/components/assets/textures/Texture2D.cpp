@@ -1,6 +1,6 @@
 #include "Texture2D.h"
 #include "../../logicalDevice/LogicalDevice.h"
-#include "../../../utilities/Buffers.h"
+#include "../../uploadManager/UploadManager.h"
 #include "../../../utilities/Images.h"
 #ifndef STB_IMAGE_IMPLEMENTATION
 #define STB_IMAGE_IMPLEMENTATION
@@ -12,18 +12,18 @@
 namespace vke {
 
   Texture2D::Texture2D(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                       const vk::CommandPool commandPool,
+                       const std::shared_ptr<UploadManager>& uploadManager,
                        const char* path,
                        const vk::SamplerAddressMode samplerAddressMode)
     : Texture(logicalDevice, samplerAddressMode)
   {
-    createTextureImage(logicalDevice, commandPool, path);
+    createTextureImage(logicalDevice, uploadManager, path);
 
     createImageView(logicalDevice);
   }
 
   void Texture2D::createTextureImage(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                     const vk::CommandPool commandPool,
+                                     const std::shared_ptr<UploadManager>& uploadManager,
                                      const char* path)
   {
     int texWidth, texHeight, texChannels;
@@ -38,18 +38,6 @@ namespace vke {
 
     const vk::DeviceSize imageSize = texWidth * texHeight * 4;
 
-    vk::raii::Buffer stagingBuffer = nullptr;
-    vk::raii::DeviceMemory stagingBufferMemory = nullptr;
-    Buffers::createBuffer(logicalDevice, imageSize, vk::BufferUsageFlagBits::eTransferSrc,
-                          vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
-                          stagingBuffer, stagingBufferMemory);
-
-    Buffers::doMappedMemoryOperation(stagingBufferMemory, [pixels, imageSize](void* data) {
-      memcpy(data, pixels, imageSize);
-    });
-
-    stbi_image_free(pixels);
-
     auto [image, imageMemory] = Images::createImage(
       logicalDevice,
       {
@@ -73,13 +61,29 @@ namespace vke {
     m_textureImage = std::move(image);
     m_textureImageMemory = std::move(imageMemory);
 
-    Images::transitionImageLayout(logicalDevice, commandPool, m_textureImage, vk::Format::eR8G8B8A8Unorm,
-                                  vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, m_mipLevels, 1);
-    Images::copyBufferToImage(logicalDevice, commandPool, stagingBuffer, m_textureImage, static_cast<uint32_t>(texWidth),
-                              static_cast<uint32_t>(texHeight), 1);
-    // Transitioned to vk::ImageLayout::eShaderReadOnlyOptimal while generating mipmaps
+    uploadManager->upload(imageSize, [pixels, imageSize](void* data) {
+      memcpy(data, pixels, imageSize);
+    }, [this, texWidth, texHeight](const CommandBuffer& commandBuffer, const StagingRegion& stagingRegion) {
+      Images::transitionImageLayout(commandBuffer, m_textureImage, vk::Format::eR8G8B8A8Unorm,
+                                    vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, m_mipLevels, 1);
+      Images::copyBufferToImage(commandBuffer, stagingRegion.buffer, stagingRegion.offset, m_textureImage,
+                                static_cast<uint32_t>(texWidth), static_cast<uint32_t>(texHeight), 1);
+    });
+
+    // Blits need the graphics queue, so the image is handed over still in the transfer layout
+    uploadManager->releaseImage({
+      .image = *m_textureImage,
+      .oldLayout = vk::ImageLayout::eTransferDstOptimal,
+      .newLayout = vk::ImageLayout::eTransferDstOptimal,
+      .mipLevels = m_mipLevels
+    });
 
-    generateMipmaps(logicalDevice, commandPool, *m_textureImage, vk::Format::eR8G8B8A8Unorm, texWidth, texHeight, m_mipLevels);
+    uploadManager->record([this, &logicalDevice, texWidth, texHeight](const CommandBuffer& commandBuffer) {
+      // Transitioned to vk::ImageLayout::eShaderReadOnlyOptimal while generating mipmaps
+      generateMipmaps(logicalDevice, commandBuffer, *m_textureImage, vk::Format::eR8G8B8A8Unorm, texWidth, texHeight, m_mipLevels);
+    });
+
+    stbi_image_free(pixels);
   }
 
   void Texture2D::createImageView(const std::shared_ptr<LogicalDevice>& logicalDevice)
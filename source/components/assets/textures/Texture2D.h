@@ -5,16 +5,18 @@
 
 namespace vke {
 
+  class UploadManager;
+
   class Texture2D final : public Texture {
   public:
     explicit Texture2D(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                       vk::CommandPool commandPool,
+                       const std::shared_ptr<UploadManager>& uploadManager,
                        const char* path,
                        vk::SamplerAddressMode samplerAddressMode);
 
   private:
     void createTextureImage(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                            vk::CommandPool commandPool,
+                            const std::shared_ptr<UploadManager>& uploadManager,
                             const char* path);
 
     void createImageView(const std::shared_ptr<LogicalDevice>& logicalDevice) override;
@@ -1,6 +1,6 @@
 #include "Texture3D.h"
 #include "../../logicalDevice/LogicalDevice.h"
-#include "../../../utilities/Buffers.h"
+#include "../../uploadManager/UploadManager.h"
 #include "../../../utilities/Images.h"
 #include <stdexcept>
 #include <cstdio>
@@ -35,18 +35,18 @@ namespace vke {
   }
 
   Texture3D::Texture3D(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                       const vk::raii::CommandPool& commandPool,
+                       const std::shared_ptr<UploadManager>& uploadManager,
                        const char* path,
                        const vk::SamplerAddressMode samplerAddressMode)
     : Texture(logicalDevice, samplerAddressMode)
   {
-    createTextureImage(logicalDevice, commandPool, path);
+    createTextureImage(logicalDevice, uploadManager, path);
 
     createImageView(logicalDevice);
   }
 
   void Texture3D::createTextureImage(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                     const vk::raii::CommandPool& commandPool,
+                                     const std::shared_ptr<UploadManager>& uploadManager,
                                      const char* path)
   {
     m_mipLevels = 1;
@@ -56,18 +56,6 @@ namespace vke {
 
     const vk::DeviceSize imageSize = width * height * depth * 4;
 
-    vk::raii::Buffer stagingBuffer = nullptr;
-    vk::raii::DeviceMemory stagingBufferMemory = nullptr;
-    Buffers::createBuffer(logicalDevice, imageSize, vk::BufferUsageFlagBits::eTransferSrc,
-                          vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
-                          stagingBuffer, stagingBufferMemory);
-
-    Buffers::doMappedMemoryOperation(stagingBufferMemory, [imageData, imageSize](void* data) {
-      memcpy(data, imageData, imageSize);
-    });
-
-    delete[] imageData;
-
     auto [image, imageMemory] = Images::createImage(
       logicalDevice,
       {
@@ -91,13 +79,21 @@ namespace vke {
     m_textureImage = std::move(image);
     m_textureImageMemory = std::move(imageMemory);
 
-    Images::transitionImageLayout(logicalDevice, commandPool, m_textureImage, vk::Format::eR8G8B8A8Unorm,
-      vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, m_mipLevels, 1);
+    uploadManager->upload(imageSize, [imageData, imageSize](void* data) {
+      memcpy(data, imageData, imageSize);
+    }, [this, width, height, depth](const CommandBuffer& commandBuffer, const StagingRegion& stagingRegion) {
+      Images::transitionImageLayout(commandBuffer, m_textureImage, vk::Format::eR8G8B8A8Unorm,
+        vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, m_mipLevels, 1);
 
-    Images::copyBufferToImage(logicalDevice, commandPool, stagingBuffer, m_textureImage, width, height, depth);
+      Images::copyBufferToImage(commandBuffer, stagingRegion.buffer, stagingRegion.offset, m_textureImage, width, height, depth);
+    });
 
-    Images::transitionImageLayout(logicalDevice, commandPool, m_textureImage, vk::Format::eR8G8B8A8Unorm,
-      vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal, m_mipLevels, 1);
+    uploadManager->releaseImage({
+      .image = *m_textureImage,
+      .mipLevels = m_mipLevels
+    });
+
+    delete[] imageData;
   }
 
   void Texture3D::createImageView(const std::shared_ptr<LogicalDevice>& logicalDevice)
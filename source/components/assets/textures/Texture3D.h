@@ -5,16 +5,18 @@
 
 namespace vke {
 
+  class UploadManager;
+
   class Texture3D final : public Texture {
   public:
     Texture3D(const std::shared_ptr<LogicalDevice>& logicalDevice,
-              const vk::raii::CommandPool& commandPool,
+              const std::shared_ptr<UploadManager>& uploadManager,
               const char* path,
               vk::SamplerAddressMode samplerAddressMode);
 
   private:
     void createTextureImage(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                            const vk::raii::CommandPool& commandPool,
+                            const std::shared_ptr<UploadManager>& uploadManager,
                             const char* path);
 
     void createImageView(const std::shared_ptr<LogicalDevice>& logicalDevice) override;
@@ -1,7 +1,7 @@
 #include "TextureCubemap.h"
-#include "../../commandBuffer/SingleUseCommandBuffer.h"
+#include "../../commandBuffer/CommandBuffer.h"
 #include "../../logicalDevice/LogicalDevice.h"
-#include "../../../utilities/Buffers.h"
+#include "../../uploadManager/UploadManager.h"
 #include "../../../utilities/Images.h"
 #include <stb_image.h>
 #include <stdexcept>
@@ -9,17 +9,17 @@
 namespace vke {
 
   TextureCubemap::TextureCubemap(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                 const vk::raii::CommandPool& commandPool,
+                                 const std::shared_ptr<UploadManager>& uploadManager,
                                  const std::array<std::string, 6>& paths)
     : Texture(logicalDevice, vk::SamplerAddressMode::eClampToEdge)
   {
-    createTextureImage(logicalDevice, commandPool, paths);
+    createTextureImage(logicalDevice, uploadManager, paths);
 
     createImageView(logicalDevice);
   }
 
   void TextureCubemap::createTextureImage(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                          const vk::raii::CommandPool& commandPool,
+                                          const std::shared_ptr<UploadManager>& uploadManager,
                                           const std::array<std::string, 6>& paths)
   {
     int texWidth, texHeight;
@@ -37,28 +37,30 @@ namespace vke {
     const vk::DeviceSize imageSize = texWidth * texHeight * 4;
     const vk::DeviceSize totalSize = imageSize * paths.size();
 
-    vk::raii::Buffer stagingBuffer = nullptr;
-    vk::raii::DeviceMemory stagingBufferMemory = nullptr;
-    Buffers::createBuffer(logicalDevice, totalSize, vk::BufferUsageFlagBits::eTransferSrc,
-                          vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
-                          stagingBuffer, stagingBufferMemory);
+    createImage(logicalDevice, texWidth, texHeight);
 
-    Buffers::doMappedMemoryOperation(stagingBufferMemory, [pixels, imageSize](void* data) {
+    uploadManager->upload(totalSize, [pixels, imageSize](void* data) {
       for (size_t i = 0; i < pixels.size(); ++i)
       {
         const vk::DeviceSize offset = i * imageSize;
         memcpy(static_cast<uint8_t*>(data) + offset, pixels[i], imageSize);
         stbi_image_free(pixels[i]);
       }
+    }, [this, imageSize, texWidth, texHeight](const CommandBuffer& commandBuffer, const StagingRegion& stagingRegion) {
+      Images::transitionImageLayout(commandBuffer, m_textureImage, vk::Format::eR8G8B8A8Unorm,
+                                    vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal,
+                                    1, 6);
+
+      copyBufferToImage(commandBuffer, stagingRegion, imageSize, texWidth, texHeight);
     });
 
-    createImage(logicalDevice, stagingBuffer, commandPool, imageSize, texWidth, texHeight);
+    uploadManager->releaseImage({
+      .image = *m_textureImage,
+      .layerCount = 6
+    });
   }
 
   void TextureCubemap::createImage(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                   const vk::raii::Buffer& stagingBuffer,
-                                   const vk::raii::CommandPool& commandPool,
-                                   const vk::DeviceSize imageSize,
                                    const uint32_t texWidth,
                                    const uint32_t texHeight)
   {
@@ -84,21 +86,10 @@ namespace vke {
 
     m_textureImage = std::move(image);
     m_textureImageMemory = std::move(imageMemory);
-
-    Images::transitionImageLayout(logicalDevice, commandPool, m_textureImage, vk::Format::eR8G8B8A8Unorm,
-                                  vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal,
-                                  1, 6);
-
-    copyBufferToImage(logicalDevice, commandPool, stagingBuffer, imageSize, texWidth, texHeight);
-
-    Images::transitionImageLayout(logicalDevice, commandPool, m_textureImage, vk::Format::eR8G8B8A8Unorm,
-                                  vk::ImageLayout::eTransferDstOptimal,
-                                  vk::ImageLayout::eShaderReadOnlyOptimal, 1, 6);
   }
 
-  void TextureCubemap::copyBufferToImage(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                         const vk::raii::CommandPool& commandPool,
-                                         const vk::raii::Buffer& stagingBuffer,
+  void TextureCubemap::copyBufferToImage(const CommandBuffer& commandBuffer,
+                                         const StagingRegion& stagingRegion,
                                          const vk::DeviceSize imageSize,
                                          const uint32_t textureWidth,
                                          const uint32_t textureHeight) const
@@ -106,7 +97,7 @@ namespace vke {
     std::vector<vk::BufferImageCopy> bufferCopyRegions(6);
     for (uint32_t i = 0; i < 6; ++i)
     {
-      bufferCopyRegions[i].bufferOffset = i * imageSize;
+      bufferCopyRegions[i].bufferOffset = stagingRegion.offset + i * imageSize;
       bufferCopyRegions[i].bufferRowLength = 0;
       bufferCopyRegions[i].bufferImageHeight = 0;
       bufferCopyRegions[i].imageSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
@@ -117,16 +108,12 @@ namespace vke {
       bufferCopyRegions[i].imageExtent = vk::Extent3D{ textureWidth, textureHeight, 1 };
     }
 
-    const auto commandBuffer = SingleUseCommandBuffer(logicalDevice, commandPool, logicalDevice->getGraphicsQueue());
-
-    commandBuffer.record([this, &commandBuffer, &stagingBuffer, bufferCopyRegions] {
-      commandBuffer.copyBufferToImage(
-        stagingBuffer,
-        m_textureImage,
-        vk::ImageLayout::eTransferDstOptimal,
-        bufferCopyRegions
-      );
-    });
+    commandBuffer.copyBufferToImage(
+      stagingRegion.buffer,
+      m_textureImage,
+      vk::ImageLayout::eTransferDstOptimal,
+      bufferCopyRegions
+    );
   }
 
   void TextureCubemap::createImageView(const std::shared_ptr<LogicalDevice>& logicalDevice)
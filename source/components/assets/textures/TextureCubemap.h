@@ -9,28 +9,26 @@
 namespace vke {
 
   class LogicalDevice;
+  class UploadManager;
+  struct StagingRegion;
 
   class TextureCubemap final : public Texture {
   public:
     TextureCubemap(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                   const vk::raii::CommandPool& commandPool,
+                   const std::shared_ptr<UploadManager>& uploadManager,
                    const std::array<std::string, 6>& paths);
 
   private:
     void createTextureImage(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                            const vk::raii::CommandPool& commandPool,
+                            const std::shared_ptr<UploadManager>& uploadManager,
                             const std::array<std::string, 6>& paths);
 
     void createImage(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                     const vk::raii::Buffer& stagingBuffer,
-                     const vk::raii::CommandPool& commandPool,
-                     vk::DeviceSize imageSize,
                      uint32_t texWidth,
                      uint32_t texHeight);
 
-    void copyBufferToImage(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                           const vk::raii::CommandPool& commandPool,
-                           const vk::raii::Buffer& stagingBuffer,
+    void copyBufferToImage(const CommandBuffer& commandBuffer,
+                           const StagingRegion& stagingRegion,
                            vk::DeviceSize imageSize,
                            uint32_t textureWidth,
                            uint32_t textureHeight) const;
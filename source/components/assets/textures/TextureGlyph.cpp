@@ -1,68 +1,51 @@
 #include "TextureGlyph.h"
-#include "../../commandBuffer/SingleUseCommandBuffer.h"
+#include "../../commandBuffer/CommandBuffer.h"
 #include "../../logicalDevice/LogicalDevice.h"
-#include "../../../utilities/Buffers.h"
+#include "../../uploadManager/UploadManager.h"
 #include "../../../utilities/Images.h"
+#include <cstring>
 
 namespace vke {
 
   TextureGlyph::TextureGlyph(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                             const vk::CommandPool commandPool,
+                             const std::shared_ptr<UploadManager>& uploadManager,
                              const unsigned char* pixelData,
                              const uint32_t width,
                              const uint32_t height)
     : Texture(logicalDevice, vk::SamplerAddressMode::eClampToEdge)
   {
-    createTextureImage(logicalDevice, commandPool, pixelData, width, height);
+    createTextureImage(logicalDevice, uploadManager, pixelData, width, height);
 
     createImageView(logicalDevice);
   }
 
   void TextureGlyph::createTextureImage(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                        const vk::CommandPool commandPool,
+                                        const std::shared_ptr<UploadManager>& uploadManager,
                                         const unsigned char* pixelData,
                                         const uint32_t width,
                                         const uint32_t height)
   {
-    vk::raii::Buffer stagingBuffer = nullptr;
-    vk::raii::DeviceMemory stagingBufferMemory = nullptr;
+    const vk::DeviceSize imageSize = width * height;
 
-    createAndFillStagingBuffer(logicalDevice, pixelData, width, height, stagingBuffer, stagingBufferMemory);
+    createImage(logicalDevice, width, height);
 
-    createAndPrepareImage(logicalDevice, commandPool, width, height);
-
-    copyBufferToImage(logicalDevice, commandPool, width, height, stagingBuffer);
-
-    transitionImageToShaderReadable(logicalDevice, commandPool);
-  }
-
-  void TextureGlyph::createAndFillStagingBuffer(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                                const unsigned char* pixelData,
-                                                const uint32_t width,
-                                                const uint32_t height,
-                                                vk::raii::Buffer& stagingBuffer,
-                                                vk::raii::DeviceMemory& stagingBufferMemory)
-  {
-    const auto imageSize = width * height;
+    uploadManager->upload(imageSize, [pixelData, imageSize](void* data) {
+      memcpy(data, pixelData, imageSize);
+    }, [this, width, height](const CommandBuffer& commandBuffer, const StagingRegion& stagingRegion) {
+      transitionImageToTransferDst(commandBuffer);
 
-    Buffers::createBuffer(
-      logicalDevice,
-      imageSize,
-      vk::BufferUsageFlagBits::eTransferSrc,
-      vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
-      stagingBuffer,
-      stagingBufferMemory
-    );
+      copyBufferToImage(commandBuffer, stagingRegion, width, height);
+    });
 
-    Buffers::doMappedMemoryOperation(stagingBufferMemory, [pixelData, imageSize](void* data) {
-      memcpy(data, pixelData, imageSize);
+    uploadManager->releaseImage({
+      .image = *m_textureImage,
+      .mipLevels = m_mipLevels
     });
   }
 
-  void TextureGlyph::createAndPrepareImage(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                           const vk::CommandPool commandPool,
-                                           const uint32_t width,
-                                           const uint32_t height)
+  void TextureGlyph::createImage(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                                 const uint32_t width,
+                                 const uint32_t height)
   {
     auto [ image, imageMemory ] = Images::createImage(
       logicalDevice,
@@ -86,10 +69,12 @@ namespace vke {
 
     m_textureImage = std::move(image);
     m_textureImageMemory = std::move(imageMemory);
+  }
 
+  void TextureGlyph::transitionImageToTransferDst(const CommandBuffer& commandBuffer) const
+  {
     Images::transitionImageLayout(
-      logicalDevice,
-      commandPool,
+      commandBuffer,
       m_textureImage,
       vk::Format::eR8Unorm,
       vk::ImageLayout::eUndefined,
@@ -99,50 +84,30 @@ namespace vke {
     );
   }
 
-  void TextureGlyph::copyBufferToImage(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                       const vk::CommandPool commandPool,
+  void TextureGlyph::copyBufferToImage(const CommandBuffer& commandBuffer,
+                                       const StagingRegion& stagingRegion,
                                        const uint32_t width,
-                                       const uint32_t height,
-                                       vk::raii::Buffer& stagingBuffer) const
+                                       const uint32_t height) const
   {
-    const auto commandBuffer = SingleUseCommandBuffer(logicalDevice, commandPool, logicalDevice->getGraphicsQueue());
-
-    commandBuffer.record([this, &commandBuffer, width, height, &stagingBuffer] {
-      const vk::BufferImageCopy region{
-        0,
+    const vk::BufferImageCopy region{
+      stagingRegion.offset,
+      0,
+      0,
+      vk::ImageSubresourceLayers{
+        vk::ImageAspectFlagBits::eColor,
         0,
         0,
-        vk::ImageSubresourceLayers{
-          vk::ImageAspectFlagBits::eColor,
-          0,
-          0,
-          1,
-        },
-        vk::Offset3D{0, 0, 0},
-        vk::Extent3D{width, height, 1}
-      };
-
-      commandBuffer.copyBufferToImage(
-        stagingBuffer,
-        m_textureImage,
-        vk::ImageLayout::eTransferDstOptimal,
-        { region }
-      );
-    });
-  }
+        1,
+      },
+      vk::Offset3D{0, 0, 0},
+      vk::Extent3D{width, height, 1}
+    };
 
-  void TextureGlyph::transitionImageToShaderReadable(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                                     const vk::CommandPool commandPool) const
-  {
-    Images::transitionImageLayout(
-      logicalDevice,
-      commandPool,
+    commandBuffer.copyBufferToImage(
+      stagingRegion.buffer,
       m_textureImage,
-      vk::Format::eR8Unorm,
       vk::ImageLayout::eTransferDstOptimal,
-      vk::ImageLayout::eShaderReadOnlyOptimal,
-      m_mipLevels,
-      1
+      { region }
     );
   }
 
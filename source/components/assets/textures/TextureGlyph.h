@@ -5,41 +5,34 @@
 
 namespace vke {
 
+  class UploadManager;
+  struct StagingRegion;
+
   class TextureGlyph final : public Texture {
   public:
     TextureGlyph(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                 vk::CommandPool commandPool,
+                 const std::shared_ptr<UploadManager>& uploadManager,
                  const unsigned char* pixelData,
                  uint32_t width,
                  uint32_t height);
 
   private:
     void createTextureImage(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                            vk::CommandPool commandPool,
+                            const std::shared_ptr<UploadManager>& uploadManager,
                             const unsigned char* pixelData,
                             uint32_t width,
                             uint32_t height);
 
-    static void createAndFillStagingBuffer(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                           const unsigned char* pixelData,
-                                           uint32_t width,
-                                           uint32_t height,
-                                           vk::raii::Buffer& stagingBuffer,
-                                           vk::raii::DeviceMemory& stagingBufferMemory);
+    void createImage(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                     uint32_t width,
+                     uint32_t height);
 
-    void createAndPrepareImage(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                               vk::CommandPool commandPool,
-                               uint32_t width,
-                               uint32_t height);
+    void transitionImageToTransferDst(const CommandBuffer& commandBuffer) const;
 
-    void copyBufferToImage(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                           vk::CommandPool commandPool,
+    void copyBufferToImage(const CommandBuffer& commandBuffer,
+                           const StagingRegion& stagingRegion,
                            uint32_t width,
-                           uint32_t height,
-                           vk::raii::Buffer& stagingBuffer) const;
-
-    void transitionImageToShaderReadable(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                         vk::CommandPool commandPool) const;
+                           uint32_t height) const;
 
     void createImageView(const std::shared_ptr<LogicalDevice>& logicalDevice) override;
   };
@@ -2,6 +2,7 @@
 #include "../window/Window.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <algorithm>
+#include <cmath>
 
 namespace vke {
 
@@ -23,6 +24,25 @@ namespace vke {
     return m_position;
   }
 
+  void Camera::setPosition(const glm::vec3 position)
+  {
+    m_position = position;
+  }
+
+  void Camera::lookAt(const glm::vec3 target)
+  {
+    const auto offset = target - m_position;
+    if (glm::length(offset) <= 0.0f)
+    {
+      return;
+    }
+
+    m_direction = normalize(offset);
+
+    m_rotation.pitch = std::clamp(glm::degrees(std::asin(m_direction.y)), -89.9f, 89.9f);
+    m_rotation.yaw = glm::degrees(std::atan2(m_direction.z, m_direction.x));
+  }
+
   void Camera::setSpeed(const float cameraSpeed)
   {
     m_speedSettings.speed = cameraSpeed * 50.0f;
@@ -19,6 +19,11 @@ namespace vke {
 
     [[nodiscard]] glm::vec3 getPosition() const;
 
+    void setPosition(glm::vec3 position);
+
+    // Points the camera at a target, keeping the pitch and yaw used by mouse rotation in sync
+    void lookAt(glm::vec3 target);
+
     void setSpeed(float cameraSpeed);
 
     void processInput(const std::shared_ptr<Window>& window);
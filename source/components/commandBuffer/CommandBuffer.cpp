@@ -63,14 +63,15 @@ namespace vke {
   void CommandBuffer::bindDescriptorSets(const vk::PipelineBindPoint pipelineBindPoint,
                                          const vk::PipelineLayout& pipelineLayout,
                                          const uint32_t firstSet,
-                                         const std::vector<vk::DescriptorSet>& descriptorSets) const
+                                         const std::vector<vk::DescriptorSet>& descriptorSets,
+                                         const std::vector<uint32_t>& dynamicOffsets) const
   {
     m_commandBuffers[m_currentFrame].bindDescriptorSets(
       pipelineBindPoint,
       pipelineLayout,
       firstSet,
       descriptorSets,
-      {}
+      dynamicOffsets
     );
   }
 
@@ -205,6 +206,25 @@ namespace vke {
     m_commandBuffers[m_currentFrame].copyImage(srcImage, srcImageLayout, dstImage, dstImageLayout, regions);
   }
 
+  void CommandBuffer::writeTimestamp(const vk::PipelineStageFlagBits pipelineStage,
+                                     const vk::QueryPool& queryPool,
+                                     const uint32_t query) const
+  {
+    m_commandBuffers[m_currentFrame].writeTimestamp(pipelineStage, queryPool, query);
+  }
+
+  void CommandBuffer::beginQuery(const vk::QueryPool& queryPool,
+                                 const uint32_t query) const
+  {
+    m_commandBuffers[m_currentFrame].beginQuery(queryPool, query, {});
+  }
+
+  void CommandBuffer::endQuery(const vk::QueryPool& queryPool,
+                               const uint32_t query) const
+  {
+    m_commandBuffers[m_currentFrame].endQuery(queryPool, query);
+  }
+
   void CommandBuffer::allocateCommandBuffers(const std::shared_ptr<LogicalDevice>& logicalDevice,
                                              const vk::CommandPool commandPool)
   {
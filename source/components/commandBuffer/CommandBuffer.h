@@ -47,7 +47,8 @@ namespace vke {
     void bindDescriptorSets(vk::PipelineBindPoint pipelineBindPoint,
                             const vk::PipelineLayout& pipelineLayout,
                             uint32_t firstSet,
-                            const std::vector<vk::DescriptorSet>& descriptorSets) const;
+                            const std::vector<vk::DescriptorSet>& descriptorSets,
+                            const std::vector<uint32_t>& dynamicOffsets = {}) const;
 
     void dispatch(uint32_t groupCountX,
                   uint32_t groupCountY,
@@ -126,6 +127,16 @@ namespace vke {
                    vk::ImageLayout dstImageLayout,
                    const std::vector<vk::ImageCopy>& regions) const;
 
+    void writeTimestamp(vk::PipelineStageFlagBits pipelineStage,
+                        const vk::QueryPool& queryPool,
+                        uint32_t query) const;
+
+    void beginQuery(const vk::QueryPool& queryPool,
+                    uint32_t query) const;
+
+    void endQuery(const vk::QueryPool& queryPool,
+                  uint32_t query) const;
+
     friend class ImGuiInstance;
 
   protected:
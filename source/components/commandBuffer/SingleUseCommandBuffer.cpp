@@ -1,5 +1,6 @@
 #include "SingleUseCommandBuffer.h"
 #include "../logicalDevice/LogicalDevice.h"
+#include "../profiler/CpuProfiler.h"
 
 namespace vke {
   SingleUseCommandBuffer::SingleUseCommandBuffer(const std::shared_ptr<LogicalDevice>& logicalDevice,
@@ -12,6 +13,8 @@ namespace vke {
 
   void SingleUseCommandBuffer::record(const std::function<void()>& renderFunction) const
   {
+    VKE_PROFILE_ZONE("SingleUseCommandBuffer::record");
+
     constexpr vk::CommandBufferBeginInfo beginInfo {
       .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit
     };
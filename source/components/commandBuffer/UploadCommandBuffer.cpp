@@ -0,0 +1,54 @@
+#include "UploadCommandBuffer.h"
+#include "../logicalDevice/LogicalDevice.h"
+#include <stdexcept>
+
+namespace vke {
+
+  UploadCommandBuffer::UploadCommandBuffer(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                                           const vk::CommandPool commandPool)
+  {
+    UploadCommandBuffer::allocateCommandBuffers(logicalDevice, commandPool);
+  }
+
+  void UploadCommandBuffer::begin()
+  {
+    constexpr vk::CommandBufferBeginInfo beginInfo {
+      .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit
+    };
+
+    m_commandBuffers[m_currentFrame].reset();
+    m_commandBuffers[m_currentFrame].begin(beginInfo);
+
+    m_recording = true;
+  }
+
+  void UploadCommandBuffer::record(const std::function<void()>& renderFunction) const
+  {
+    if (!m_recording)
+    {
+      throw std::runtime_error("upload command buffer is not recording!");
+    }
+
+    renderFunction();
+  }
+
+  void UploadCommandBuffer::end()
+  {
+    m_commandBuffers[m_currentFrame].end();
+
+    m_recording = false;
+  }
+
+  void UploadCommandBuffer::allocateCommandBuffers(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                                                   const vk::CommandPool commandPool)
+  {
+    const vk::CommandBufferAllocateInfo allocInfo {
+      .commandPool = commandPool,
+      .level = vk::CommandBufferLevel::ePrimary,
+      .commandBufferCount = 1
+    };
+
+    logicalDevice->allocateCommandBuffers(allocInfo, m_commandBuffers);
+  }
+
+} // namespace vke
@@ -0,0 +1,37 @@
+#ifndef VKE_UPLOADCOMMANDBUFFER_H
+#define VKE_UPLOADCOMMANDBUFFER_H
+
+#include "CommandBuffer.h"
+#include <vulkan/vulkan_raii.hpp>
+
+namespace vke {
+
+  // Stays open between begin and end so many uploads can be recorded into one submission
+  class UploadCommandBuffer final : public CommandBuffer {
+  public:
+    UploadCommandBuffer(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                        vk::CommandPool commandPool);
+
+    UploadCommandBuffer(const UploadCommandBuffer&) = delete;
+    UploadCommandBuffer& operator=(const UploadCommandBuffer&) = delete;
+
+    UploadCommandBuffer(UploadCommandBuffer&&) noexcept = default;
+    UploadCommandBuffer& operator=(UploadCommandBuffer&&) noexcept = default;
+
+    void begin();
+
+    // Appends to the open recording instead of beginning a new one
+    void record(const std::function<void()>& renderFunction) const override;
+
+    void end();
+
+  private:
+    bool m_recording = false;
+
+    void allocateCommandBuffers(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                                vk::CommandPool commandPool) override;
+  };
+
+} // namespace vke
+
+#endif //VKE_UPLOADCOMMANDBUFFER_H
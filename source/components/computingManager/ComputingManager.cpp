@@ -3,13 +3,19 @@
 #include "../logicalDevice/LogicalDevice.h"
 #include "../physicalDevice/PhysicalDevice.h"
 #include "../pipelines/pipelineManager/PipelineManager.h"
+#include "../profiler/CpuProfiler.h"
+#include "../profiler/GpuProfiler.h"
 #include "../renderingManager/renderer2D/Renderer2D.h"
 #include "../renderingManager/renderer3D/Renderer3D.h"
+#include "../uploadManager/UploadManager.h"
 
 namespace vke {
 
-  ComputingManager::ComputingManager(std::shared_ptr<LogicalDevice> logicalDevice)
-    : m_logicalDevice(std::move(logicalDevice))
+  ComputingManager::ComputingManager(std::shared_ptr<LogicalDevice> logicalDevice,
+                                     std::shared_ptr<GpuProfiler> gpuProfiler,
+                                     std::shared_ptr<UploadManager> uploadManager)
+    : m_logicalDevice(std::move(logicalDevice)), m_gpuProfiler(std::move(gpuProfiler)),
+      m_uploadManager(std::move(uploadManager))
   {
     createCommandPool();
 
@@ -21,14 +27,19 @@ namespace vke {
                                      const std::shared_ptr<Renderer2D>& renderer2D,
                                      const std::shared_ptr<Renderer3D>& renderer3D) const
   {
-    m_logicalDevice->waitForComputeFences(currentFrame);
+    VKE_PROFILE_ZONE("ComputingManager::doComputing");
 
-    m_logicalDevice->resetComputeFences(currentFrame);
+    m_logicalDevice->waitForComputeFrame(currentFrame);
+
+    m_gpuProfiler->beginFrame(GpuQueue::compute, currentFrame);
 
     m_computeCommandBuffer->setCurrentFrame(currentFrame);
     m_computeCommandBuffer->resetCommandBuffer();
     recordComputeCommandBuffer(pipelineManager, currentFrame, renderer2D, renderer3D);
 
+    // Compute waits on the last upload batch, so anything pending is submitted first
+    m_uploadManager->flush();
+
     m_logicalDevice->submitComputeCommandBuffer(currentFrame, m_computeCommandBuffer->getCommandBuffer());
   }
 
@@ -40,10 +51,14 @@ namespace vke {
     m_computeCommandBuffer->record([this, pipelineManager, currentFrame, renderer2D, renderer3D] {
       if (renderer2D->shouldDoDots())
       {
+        m_gpuProfiler->beginZone(m_computeCommandBuffer, GpuQueue::compute, "Dots");
         pipelineManager->computeDotsPipeline(m_computeCommandBuffer, currentFrame);
+        m_gpuProfiler->endZone(m_computeCommandBuffer, GpuQueue::compute);
       }
 
+      m_gpuProfiler->beginZone(m_computeCommandBuffer, GpuQueue::compute, "Smoke");
       pipelineManager->computeSmokePipeline(m_computeCommandBuffer, currentFrame, &renderer3D->getSmokeSystems());
+      m_gpuProfiler->endZone(m_computeCommandBuffer, GpuQueue::compute);
     });
   }
 
@@ -7,14 +7,18 @@
 namespace vke {
 
   class CommandBuffer;
+  class GpuProfiler;
   class LogicalDevice;
   class PipelineManager;
   class Renderer2D;
   class Renderer3D;
+  class UploadManager;
 
   class ComputingManager {
   public:
-    explicit ComputingManager(std::shared_ptr<LogicalDevice> logicalDevice);
+    ComputingManager(std::shared_ptr<LogicalDevice> logicalDevice,
+                     std::shared_ptr<GpuProfiler> gpuProfiler,
+                     std::shared_ptr<UploadManager> uploadManager);
 
     void doComputing(const std::shared_ptr<PipelineManager>& pipelineManager,
                      uint32_t currentFrame,
@@ -24,6 +28,10 @@ namespace vke {
   private:
     std::shared_ptr<LogicalDevice> m_logicalDevice;
 
+    std::shared_ptr<GpuProfiler> m_gpuProfiler;
+
+    std::shared_ptr<UploadManager> m_uploadManager;
+
     vk::raii::CommandPool m_commandPool = nullptr;
 
     std::shared_ptr<CommandBuffer> m_computeCommandBuffer;
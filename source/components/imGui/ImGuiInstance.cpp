@@ -7,6 +7,7 @@
 #include <backends/imgui_impl_glfw.h>
 #include <backends/imgui_impl_vulkan.h>
 #include <imgui_internal.h>
+#include <algorithm>
 
 constexpr bool ALLOW_VIEWPORTS = false;
 
@@ -15,10 +16,10 @@ namespace vke {
   ImGuiInstance::ImGuiInstance(const std::shared_ptr<Window>& window,
                                const std::shared_ptr<Instance>& instance,
                                const std::shared_ptr<LogicalDevice>& logicalDevice,
-                               const EngineConfig::ImGui& config)
-    : m_window(window), m_useDockSpace(config.useDockspace)
+                               const EngineConfig& config)
+    : m_window(window), m_useDockSpace(config.imGui.useDockspace)
   {
-    createDescriptorPool(logicalDevice, config.maxTextures);
+    createDescriptorPool(logicalDevice, config.imGui.maxTextures);
 
     ImGui::CreateContext();
 
@@ -26,20 +27,30 @@ namespace vke {
     {
       ImGui::GetIO().ConfigFlags |= ImGuiConfigFlags_DockingEnable;
 
-      if (ALLOW_VIEWPORTS)
+      if (ALLOW_VIEWPORTS && m_window)
       {
         ImGui::GetIO().ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;
       }
     }
 
-    ImGui_ImplGlfw_InitForVulkan(window->getWindow(), true);
+    if (m_window)
+    {
+      ImGui_ImplGlfw_InitForVulkan(window->getWindow(), true);
+    }
 
-    if (config.styleSetup)
+    if (config.imGui.styleSetup)
     {
-      config.styleSetup();
+      config.imGui.styleSetup();
     }
 
-    initFromWindow();
+    if (m_window)
+    {
+      initFromWindow();
+    }
+    else
+    {
+      initHeadless(config.window);
+    }
 
     const SwapChainSupportDetails swapChainSupport = logicalDevice->getPhysicalDevice()->getSwapChainSupport();
 
@@ -49,6 +60,9 @@ namespace vke {
       imageCount = swapChainSupport.capabilities.maxImageCount;
     }
 
+    // Nothing is presented when headless, but the backend still requires a valid image count
+    imageCount = std::max(imageCount, 2u);
+
     ImGui_ImplVulkan_InitInfo initInfo {
       .Instance = static_cast<VkInstance>(*instance->m_instance),
       .PhysicalDevice = static_cast<VkPhysicalDevice>(*logicalDevice->getPhysicalDevice()->m_physicalDevice),
@@ -82,16 +96,34 @@ namespace vke {
   ImGuiInstance::~ImGuiInstance()
   {
     ImGui_ImplVulkan_Shutdown();
-    ImGui_ImplGlfw_Shutdown();
+
+    if (m_window)
+    {
+      ImGui_ImplGlfw_Shutdown();
+    }
+
     ImGui::DestroyContext();
 
-    m_window->removeListener(m_contentScaleEventListener);
+    if (m_window)
+    {
+      m_window->removeListener(m_contentScaleEventListener);
+    }
   }
 
   void ImGuiInstance::createNewFrame()
   {
     ImGui_ImplVulkan_NewFrame();
-    ImGui_ImplGlfw_NewFrame();
+
+    if (m_window)
+    {
+      ImGui_ImplGlfw_NewFrame();
+    }
+    else if (ImGui::GetFrameCount() > 0)
+    {
+      // Headless frames are never rendered, so end them here instead
+      ImGui::EndFrame();
+    }
+
     ImGui::NewFrame();
 
     displayDockSpace();
@@ -255,6 +287,14 @@ namespace vke {
     });
   }
 
+  void ImGuiInstance::initHeadless(const EngineConfig::Window& config)
+  {
+    ImGuiIO& io = ImGui::GetIO();
+
+    io.DisplaySize = ImVec2(static_cast<float>(config.width), static_cast<float>(config.height));
+    io.IniFilename = nullptr;
+  }
+
   void ImGuiInstance::displayDockSpace()
   {
     if (!m_useDockSpace)
@@ -20,7 +20,7 @@ namespace vke {
     ImGuiInstance(const std::shared_ptr<Window>& window,
                   const std::shared_ptr<Instance>& instance,
                   const std::shared_ptr<LogicalDevice>& logicalDevice,
-                  const EngineConfig::ImGui& config);
+                  const EngineConfig& config);
 
     ~ImGuiInstance();
 
@@ -84,6 +84,8 @@ namespace vke {
 
     void initFromWindow();
 
+    static void initHeadless(const EngineConfig::Window& config);
+
     void displayDockSpace();
 
     static void renderPlatformWindows();
@@ -14,7 +14,7 @@ inline constexpr bool IS_MAC = false;
 
 namespace vke {
 
-  Instance::Instance()
+  Instance::Instance(const bool headless)
   {
     VULKAN_HPP_DEFAULT_DISPATCHER.init();
 
@@ -31,7 +31,7 @@ namespace vke {
       .apiVersion = vk::ApiVersion13
     };
 
-    const auto extensions = getRequiredExtensions();
+    const auto extensions = getRequiredExtensions(headless);
 
     vk::DebugUtilsMessengerCreateInfoEXT debugCreateInfo{};
     DebugMessenger::populateCreateInfo(debugCreateInfo);
@@ -107,12 +107,17 @@ namespace vke {
     });
   }
 
-  std::vector<const char*> Instance::getRequiredExtensions()
+  std::vector<const char*> Instance::getRequiredExtensions(const bool headless)
   {
-    uint32_t glfwExtensionCount = 0;
-    const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+    std::vector<const char*> extensions;
 
-    std::vector extensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+    if (!headless)
+    {
+      uint32_t glfwExtensionCount = 0;
+      const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+
+      extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+    }
 
     if (validationLayersEnabled())
     {
@@ -14,7 +14,7 @@ namespace vke {
 
   class Instance {
   public:
-    Instance();
+    explicit Instance(bool headless);
 
     [[nodiscard]] vk::raii::SurfaceKHR createSurface(GLFWwindow* window) const;
 
@@ -35,7 +35,7 @@ namespace vke {
 
     [[nodiscard]] bool checkValidationLayerSupport() const;
 
-    static std::vector<const char*> getRequiredExtensions();
+    static std::vector<const char*> getRequiredExtensions(bool headless);
   };
 
 } // namespace vke
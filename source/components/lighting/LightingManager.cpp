@@ -2,6 +2,9 @@
 #include "lights/Light.h"
 #include "lights/PointLight.h"
 #include "lights/SpotLight.h"
+#include "shadowMaps/ShadowAtlas.h"
+#include "shadowMaps/ShadowCubeMapArray.h"
+#include "../assets/objects/Model.h"
 #include "../assets/objects/RenderObject.h"
 #include "../commandBuffer/CommandBuffer.h"
 #include "../logicalDevice/LogicalDevice.h"
@@ -9,31 +12,44 @@
 #include "../pipelines/descriptorSets/DescriptorSet.h"
 #include "../pipelines/pipelineManager/PipelineManager.h"
 #include "../pipelines/uniformBuffers/UniformBuffer.h"
-#include "../renderingManager/ImageResource.h"
+#include "../profiler/CpuProfiler.h"
+#include "../renderingManager/renderer3D/FrustumCuller.h"
+#include "../../utilities/Buffers.h"
+#include <glm/geometric.hpp>
+#include <glm/matrix.hpp>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <functional>
+#include <utility>
 
 namespace {
 
-  constexpr uint32_t MAX_SHADOW_MAPS = 16;
+  // Lights each light buffer has room for before its first reallocation
+  constexpr size_t INITIAL_LIGHT_CAPACITY = 16;
 
   constexpr vk::DescriptorSetLayoutBinding lightMetadataLayout {
     .binding = 0,
     .descriptorType = vk::DescriptorType::eUniformBuffer,
     .descriptorCount = 1,
-    .stageFlags = vk::ShaderStageFlagBits::eFragment | vk::ShaderStageFlagBits::eClosestHitKHR
+    .stageFlags = vk::ShaderStageFlagBits::eFragment | vk::ShaderStageFlagBits::eClosestHitKHR |
+                  vk::ShaderStageFlagBits::eCompute
   };
 
   constexpr vk::DescriptorSetLayoutBinding pointLightsLayout {
     .binding = 1,
     .descriptorType = vk::DescriptorType::eStorageBuffer,
     .descriptorCount = 1,
-    .stageFlags = vk::ShaderStageFlagBits::eFragment | vk::ShaderStageFlagBits::eClosestHitKHR
+    .stageFlags = vk::ShaderStageFlagBits::eFragment | vk::ShaderStageFlagBits::eClosestHitKHR |
+                  vk::ShaderStageFlagBits::eCompute
   };
 
   constexpr vk::DescriptorSetLayoutBinding spotLightsLayout {
     .binding = 2,
     .descriptorType = vk::DescriptorType::eStorageBuffer,
     .descriptorCount = 1,
-    .stageFlags = vk::ShaderStageFlagBits::eFragment | vk::ShaderStageFlagBits::eClosestHitKHR
+    .stageFlags = vk::ShaderStageFlagBits::eFragment | vk::ShaderStageFlagBits::eClosestHitKHR |
+                  vk::ShaderStageFlagBits::eCompute
   };
 
   constexpr vk::DescriptorSetLayoutBinding cameraLayout {
@@ -46,24 +62,48 @@ namespace {
   constexpr vk::DescriptorSetLayoutBinding spotLightsSamplerLayout {
     .binding = 4,
     .descriptorType = vk::DescriptorType::eCombinedImageSampler,
-    .descriptorCount = MAX_SHADOW_MAPS,
+    .descriptorCount = 1,
     .stageFlags = vk::ShaderStageFlagBits::eFragment
   };
 
   constexpr vk::DescriptorSetLayoutBinding pointLightsSamplerLayout {
     .binding = 5,
     .descriptorType = vk::DescriptorType::eCombinedImageSampler,
-    .descriptorCount = MAX_SHADOW_MAPS,
+    .descriptorCount = vke::SHADOW_MAP_TIER_COUNT,
+    .stageFlags = vk::ShaderStageFlagBits::eFragment
+  };
+
+  constexpr vk::DescriptorSetLayoutBinding spotLightShadowsLayout {
+    .binding = 6,
+    .descriptorType = vk::DescriptorType::eStorageBuffer,
+    .descriptorCount = 1,
     .stageFlags = vk::ShaderStageFlagBits::eFragment
   };
 
+  constexpr vk::DescriptorSetLayoutBinding lightClusterInfoLayout {
+    .binding = 7,
+    .descriptorType = vk::DescriptorType::eUniformBuffer,
+    .descriptorCount = 1,
+    .stageFlags = vk::ShaderStageFlagBits::eFragment | vk::ShaderStageFlagBits::eCompute
+  };
+
+  constexpr vk::DescriptorSetLayoutBinding lightClustersLayout {
+    .binding = 8,
+    .descriptorType = vk::DescriptorType::eStorageBuffer,
+    .descriptorCount = 1,
+    .stageFlags = vk::ShaderStageFlagBits::eFragment | vk::ShaderStageFlagBits::eCompute
+  };
+
   inline std::vector lightingLayoutBindings {
     lightMetadataLayout,
     pointLightsLayout,
     spotLightsLayout,
     cameraLayout,
     spotLightsSamplerLayout,
-    pointLightsSamplerLayout
+    pointLightsSamplerLayout,
+    spotLightShadowsLayout,
+    lightClusterInfoLayout,
+    lightClustersLayout
   };
 
   inline std::vector pointLightShadowMapBindings {
@@ -86,12 +126,78 @@ namespace {
 
   using CameraUniform = glm::vec3;
 
+  // A light count per type followed by the cluster's light indices, matches LightCluster in LightClusters.glsl
+  constexpr vk::DeviceSize LIGHT_CLUSTER_SIZE = (2 + vke::MAX_LIGHTS_PER_CLUSTER) * sizeof(uint32_t);
+
+  // Changes whenever a caster is added, removed or moved, so an unchanged shadow map can be kept
+  size_t getCasterSignature(const std::vector<std::shared_ptr<vke::RenderObject>>& shadowCasters)
+  {
+    size_t signature = shadowCasters.size();
+
+    const auto combine = [&signature](const size_t value) {
+      signature ^= value + 0x9e3779b97f4a7c15 + (signature << 6) + (signature >> 2);
+    };
+
+    for (const auto& shadowCaster : shadowCasters)
+    {
+      combine(std::hash<const vke::RenderObject*>{}(shadowCaster.get()));
+      combine(shadowCaster->getTransformRevision());
+    }
+
+    return signature;
+  }
+
+  // Writes the uniforms that differ from the ones last written to the frame's buffer, which only holds valid ones for
+  // the lights it was written with
+  template<typename T>
+  void writeChangedUniforms(const vke::UniformBuffer& uniformBuffer,
+                            const uint32_t currentFrame,
+                            const std::vector<T>& uniforms,
+                            std::vector<T>& writtenUniforms)
+  {
+    for (size_t i = 0; i < uniforms.size(); ++i)
+    {
+      if (i >= writtenUniforms.size() || uniforms[i] != writtenUniforms[i])
+      {
+        uniformBuffer.update(currentFrame, &uniforms[i], sizeof(T), sizeof(T) * i);
+      }
+    }
+
+    writtenUniforms = uniforms;
+  }
+
+  // Importance a light needs for each tier but the smallest, the camera being within its range earns the largest
+  constexpr std::array<float, vke::SHADOW_MAP_TIER_COUNT - 1> SHADOW_MAP_TIER_IMPORTANCE {
+    1.0f,
+    0.5f,
+    0.25f
+  };
+
+  // Grows with how much of the screen the light's range can cover, the sine of the angle its range subtends
+  float getScreenImportance(const vke::Light& light,
+                            const glm::vec3 viewPosition)
+  {
+    return light.getRange() / std::max(glm::distance(light.getPosition(), viewPosition), 0.001f);
+  }
+
+  uint32_t getShadowMapTier(const float importance)
+  {
+    uint32_t tier = 0;
+    while (tier < SHADOW_MAP_TIER_IMPORTANCE.size() && importance < SHADOW_MAP_TIER_IMPORTANCE[tier])
+    {
+      ++tier;
+    }
+
+    return tier;
+  }
+
 }
 
 namespace vke {
 
   LightingManager::LightingManager(std::shared_ptr<LogicalDevice> logicalDevice)
-    : m_logicalDevice(std::move(logicalDevice))
+    : m_logicalDevice(std::move(logicalDevice)), m_pointLightCapacity(INITIAL_LIGHT_CAPACITY),
+      m_spotLightCapacity(INITIAL_LIGHT_CAPACITY)
   {
     createCommandPool();
 
@@ -101,9 +207,30 @@ namespace vke {
 
     createUniforms();
 
+    createLightClusterBuffers();
+
     createDescriptorSet();
 
     createShadowMapSampler();
+
+    for (uint32_t tier = 0; tier < SHADOW_MAP_TIER_COUNT; ++tier)
+    {
+      m_pointLightShadowMaps[tier] = std::make_shared<ShadowCubeMapArray>(m_logicalDevice, m_commandPool,
+                                                                          SHADOW_MAP_SIZES[tier]);
+    }
+
+    // Tiers without an image of their own are bound to the smallest one's
+    m_pointLightShadowMaps.back()->reserve(1);
+
+    m_spotLightShadowMaps = std::make_shared<ShadowAtlas>(m_logicalDevice, m_commandPool);
+
+    m_pointLightDescriptorsOutdated.resize(m_logicalDevice->getMaxFramesInFlight(), false);
+    m_spotLightDescriptorsOutdated.resize(m_logicalDevice->getMaxFramesInFlight(), false);
+    m_shadowMapDescriptorsOutdated.resize(m_logicalDevice->getMaxFramesInFlight(), true);
+
+    m_writtenPointLightUniforms.resize(m_logicalDevice->getMaxFramesInFlight());
+    m_writtenSpotLightUniforms.resize(m_logicalDevice->getMaxFramesInFlight());
+    m_writtenSpotLightShadowUniforms.resize(m_logicalDevice->getMaxFramesInFlight());
   }
 
   std::shared_ptr<Light> LightingManager::createPointLight(const glm::vec3 position,
@@ -123,7 +250,6 @@ namespace vke {
     auto light = std::make_shared<PointLight>(
       m_logicalDevice,
       commonLightData,
-      m_commandPool,
       getDescriptorPool(),
       m_pointLightDescriptorSetLayout
     );
@@ -147,8 +273,7 @@ namespace vke {
 
     auto light = std::make_shared<SpotLight>(
       m_logicalDevice,
-      commonLightData,
-      m_commandPool
+      commonLightData
     );
 
     return light;
@@ -179,19 +304,157 @@ namespace vke {
     m_spotLightsToRender.clear();
   }
 
-  void LightingManager::update(const uint32_t currentFrame, const glm::vec3 viewPosition)
+  void LightingManager::update(const uint32_t currentFrame,
+                               const glm::vec3 viewPosition,
+                               const glm::mat4* cameraViewProjection)
   {
+    VKE_PROFILE_ZONE("LightingManager::update");
+
+    m_cameraFrustumPlanes.reset();
+    if (cameraViewProjection)
+    {
+      cullLights(*cameraViewProjection);
+    }
+
+    assignPointLightShadowMaps(viewPosition);
+
+    assignSpotLightShadowMaps(viewPosition);
+
     updateUniforms(currentFrame, viewPosition);
   }
 
+  void LightingManager::updateShadowDrawBatches(const std::shared_ptr<SceneBuffers>& sceneBuffers,
+                                                const std::shared_ptr<FrustumCuller>& frustumCuller,
+                                                const std::vector<std::shared_ptr<RenderObject>>& renderObjects,
+                                                CullingStats& cullingStats)
+  {
+    VKE_PROFILE_ZONE("LightingManager::updateShadowDrawBatches");
+
+    m_shadowCasterCandidates.clear();
+    for (const auto& renderObject : renderObjects)
+    {
+      if (renderObject->castsShadows())
+      {
+        m_shadowCasterCandidates.push_back(renderObject);
+      }
+    }
+
+    // The shadow passes were sized and given their slots by update
+    for (size_t i = 0; i < m_pointLightsToRender.size(); ++i)
+    {
+      auto& shadowPass = m_pointLightShadowPasses[i];
+      shadowPass.drawBatches.clear();
+      shadowPass.render = false;
+
+      if (shadowPass.shadowMapSlot == NO_SHADOW_MAP_SLOT)
+      {
+        continue;
+      }
+
+      const auto pointLight = std::dynamic_pointer_cast<PointLight>(m_pointLightsToRender[i]);
+
+      // Each caster keeps a bit per cube face it reaches, faces it misses are dropped in the vertex shader
+      frustumCuller->cullFrusta(pointLight->getLightViewProjectionMatrices());
+      frustumCuller->cullSphere(pointLight->getPosition(), pointLight->getRange());
+
+      m_shadowCasters.clear();
+      m_shadowCasterViewMasks.clear();
+      frustumCuller->getVisibleObjects(m_shadowCasterCandidates, m_shadowCasters, cullingStats, &m_shadowCasterViewMasks);
+
+      shadowPass.render = m_pointLightShadowMaps[shadowPass.shadowMapTier]->updateSlots(
+        shadowPass.shadowMapSlot, 1, pointLight, getCasterSignature(m_shadowCasters));
+      if (shadowPass.render)
+      {
+        sceneBuffers->createDrawBatches(m_shadowCasters, false, shadowPass.drawBatches, &m_shadowCasterViewMasks);
+      }
+    }
+
+    for (size_t i = 0; i < m_spotLightsToRender.size(); ++i)
+    {
+      auto& shadowPass = m_spotLightShadowPasses[i];
+      shadowPass.drawBatches.clear();
+      shadowPass.render = false;
+
+      if (shadowPass.shadowMapSlot == NO_SHADOW_MAP_SLOT)
+      {
+        continue;
+      }
+
+      const auto spotLight = std::dynamic_pointer_cast<SpotLight>(m_spotLightsToRender[i]);
+
+      // The frustum's far corners reach past the light's range, the sphere trims them
+      frustumCuller->cullFrustum(spotLight->getLightViewProjectionMatrix());
+      frustumCuller->cullSphere(spotLight->getPosition(), spotLight->getRange());
+
+      m_shadowCasters.clear();
+      frustumCuller->getVisibleObjects(m_shadowCasterCandidates, m_shadowCasters, cullingStats);
+
+      shadowPass.render = m_spotLightShadowMaps->updateSlots(
+        shadowPass.shadowMapSlot, ShadowAtlas::getSlotCount(shadowPass.shadowMapRect.extent.width), spotLight,
+        getCasterSignature(m_shadowCasters));
+      if (shadowPass.render)
+      {
+        sceneBuffers->createDrawBatches(m_shadowCasters, false, shadowPass.drawBatches);
+      }
+    }
+  }
+
   void LightingManager::renderShadowMaps(const std::shared_ptr<CommandBuffer>& commandBuffer,
                                          const std::shared_ptr<PipelineManager>& pipelineManager,
-                                         const std::vector<std::shared_ptr<RenderObject>>* objects,
+                                         const std::shared_ptr<SceneBuffers>& sceneBuffers,
                                          const uint32_t currentFrame) const
   {
-    renderPointLightShadowMaps(commandBuffer, pipelineManager, objects, currentFrame);
+    renderPointLightShadowMaps(commandBuffer, pipelineManager, sceneBuffers, currentFrame);
+
+    renderSpotLightShadowMaps(commandBuffer, pipelineManager, sceneBuffers, currentFrame);
+  }
+
+  void LightingManager::updateLightClusterUniform(const uint32_t currentFrame,
+                                                  const glm::mat4& viewMatrix,
+                                                  const glm::mat4& projectionMatrix,
+                                                  const vk::Extent2D extent) const
+  {
+    // Planes of glm::perspective's [-1, 1] depth range
+    const float nearPlane = projectionMatrix[3][2] / (projectionMatrix[2][2] - 1.0f);
+    const float farPlane = projectionMatrix[3][2] / (projectionMatrix[2][2] + 1.0f);
+
+    const float logDepthRatio = std::log(farPlane / nearPlane);
+
+    const glm::vec2 screenSize(extent.width, extent.height);
+
+    const LightClusterUniform lightClusterUBO {
+      .view = viewMatrix,
+      .inverseProjection = glm::inverse(projectionMatrix),
+      .screenSize = screenSize,
+      .tileSize = glm::ceil(screenSize / glm::vec2(LIGHT_CLUSTER_COUNT_X, LIGHT_CLUSTER_COUNT_Y)),
+      .nearPlane = nearPlane,
+      .farPlane = farPlane,
+      .sliceScale = LIGHT_CLUSTER_COUNT_Z / logDepthRatio,
+      .sliceBias = LIGHT_CLUSTER_COUNT_Z * std::log(nearPlane) / logDepthRatio
+    };
+
+    m_lightClusterUniform->update(currentFrame, &lightClusterUBO);
+  }
+
+  void LightingManager::computeLightClusters(const std::shared_ptr<CommandBuffer>& commandBuffer,
+                                             const std::shared_ptr<PipelineManager>& pipelineManager,
+                                             const uint32_t currentFrame) const
+  {
+    pipelineManager->computeLightClusterPipeline(commandBuffer, currentFrame);
 
-    renderSpotLightShadowMaps(commandBuffer, pipelineManager, objects, currentFrame);
+    constexpr vk::MemoryBarrier memoryBarrier {
+      .srcAccessMask = vk::AccessFlagBits::eShaderWrite,
+      .dstAccessMask = vk::AccessFlagBits::eShaderRead
+    };
+
+    commandBuffer->pipelineBarrier(
+      vk::PipelineStageFlagBits::eComputeShader,
+      vk::PipelineStageFlagBits::eFragmentShader,
+      {},
+      { memoryBarrier },
+      {},
+      {}
+    );
   }
 
   vk::DescriptorSetLayout LightingManager::getPointLightDescriptorSetLayout() const
@@ -199,15 +462,59 @@ namespace vke {
     return m_pointLightDescriptorSetLayout;
   }
 
+  void LightingManager::cullLights(const glm::mat4& cameraViewProjection)
+  {
+    m_cameraFrustumPlanes = FrustumCuller::createFrustumPlanes(cameraViewProjection);
+
+    // Culled lights are left out of the uniforms, shadow maps and clusters alike
+    const auto missesFrustum = [this](const std::shared_ptr<Light>& light) {
+      return !light->reachesFrustum(*m_cameraFrustumPlanes);
+    };
+
+    std::erase_if(m_pointLightsToRender, missesFrustum);
+    std::erase_if(m_spotLightsToRender, missesFrustum);
+  }
+
   void LightingManager::createUniforms()
   {
     m_lightMetadataUniform = std::make_shared<UniformBuffer>(m_logicalDevice, sizeof(LightMetadataUniform));
 
-    m_pointLightsUniform = std::make_shared<UniformBuffer>(m_logicalDevice, sizeof(PointLightUniform));
+    m_pointLightsUniform = std::make_shared<UniformBuffer>(m_logicalDevice, sizeof(PointLightUniform) * m_pointLightCapacity);
+
+    m_spotLightsUniform = std::make_shared<UniformBuffer>(m_logicalDevice, sizeof(SpotLightUniform) * m_spotLightCapacity);
 
-    m_spotLightsUniform = std::make_shared<UniformBuffer>(m_logicalDevice, sizeof(SpotLightUniform));
+    m_spotLightShadowsUniform = std::make_shared<UniformBuffer>(m_logicalDevice, sizeof(SpotLightShadowUniform) * m_spotLightCapacity);
 
     m_cameraUniform = std::make_shared<UniformBuffer>(m_logicalDevice, sizeof(CameraUniform));
+
+    m_lightClusterUniform = std::make_shared<UniformBuffer>(m_logicalDevice, sizeof(LightClusterUniform));
+  }
+
+  void LightingManager::createLightClusterBuffers()
+  {
+    m_lightClusterBuffers.reserve(m_logicalDevice->getMaxFramesInFlight());
+    m_lightClusterBuffersMemory.reserve(m_logicalDevice->getMaxFramesInFlight());
+
+    constexpr vk::DeviceSize bufferSize = LIGHT_CLUSTER_SIZE * LIGHT_CLUSTER_COUNT;
+
+    for (size_t i = 0; i < m_logicalDevice->getMaxFramesInFlight(); i++)
+    {
+      vk::raii::Buffer buffer{nullptr};
+      MemoryAllocation memory{nullptr};
+
+      Buffers::createBuffer(m_logicalDevice, bufferSize, vk::BufferUsageFlagBits::eStorageBuffer,
+                            vk::MemoryPropertyFlagBits::eDeviceLocal, buffer, memory);
+
+      const vk::DescriptorBufferInfo bufferInfo {
+        .buffer = *buffer,
+        .offset = 0,
+        .range = bufferSize
+      };
+
+      m_lightClusterBuffers.push_back(std::move(buffer));
+      m_lightClusterBuffersMemory.push_back(std::move(memory));
+      m_lightClusterBufferInfos.push_back(bufferInfo);
+    }
   }
 
   void LightingManager::createDescriptorSet()
@@ -219,11 +526,22 @@ namespace vke {
         m_lightMetadataUniform->getDescriptorSet(0, descriptorSet, frame),
         m_pointLightsUniform->getDescriptorSet(1, descriptorSet, frame),
         m_spotLightsUniform->getDescriptorSet(2, descriptorSet, frame),
-        m_cameraUniform->getDescriptorSet(3, descriptorSet, frame)
+        m_cameraUniform->getDescriptorSet(3, descriptorSet, frame),
+        m_spotLightShadowsUniform->getDescriptorSet(6, descriptorSet, frame),
+        m_lightClusterUniform->getDescriptorSet(7, descriptorSet, frame),
+        {
+          .dstSet = descriptorSet,
+          .dstBinding = 8,
+          .dstArrayElement = 0,
+          .descriptorCount = 1,
+          .descriptorType = vk::DescriptorType::eStorageBuffer,
+          .pBufferInfo = &m_lightClusterBufferInfos[frame]
+        }
       }};
 
       descriptorWrites[1].descriptorType = vk::DescriptorType::eStorageBuffer;
       descriptorWrites[2].descriptorType = vk::DescriptorType::eStorageBuffer;
+      descriptorWrites[4].descriptorType = vk::DescriptorType::eStorageBuffer;
 
       return descriptorWrites;
     });
@@ -236,191 +554,322 @@ namespace vke {
 
     m_cameraUniform->update(currentFrame, &cameraUBO);
 
-    updateLightMetadataUniform();
+    updateLightMetadataUniform(currentFrame);
 
     updatePointLightUniforms(currentFrame);
 
     updateSpotLightUniforms(currentFrame);
+
+    updateShadowMapDescriptors(currentFrame);
   }
 
   void LightingManager::updatePointLightUniforms(const uint32_t currentFrame)
   {
-    if (m_prevNumPointLights != m_pointLightsToRender.size())
+    if (m_pointLightsToRender.empty())
     {
-      if (m_pointLightsToRender.empty())
-      {
-        m_prevNumPointLights = 0;
-
-        return;
-      }
-
-      m_logicalDevice->waitIdle();
+      return;
+    }
 
-      m_pointLightsUniform.reset();
+    // Buffers only grow, by doubling, so changing the light count usually just changes the metadata uniform
+    if (m_pointLightsToRender.size() > m_pointLightCapacity)
+    {
+      m_pointLightCapacity = std::bit_ceil(m_pointLightsToRender.size());
 
-      auto lightsUniformBufferSize = sizeof(PointLightUniform) * m_pointLightsToRender.size();
+      // The old buffers are retired by their destructor, so frames still in flight can finish reading them
+      m_pointLightsUniform = std::make_shared<UniformBuffer>(m_logicalDevice, sizeof(PointLightUniform) * m_pointLightCapacity);
 
-      m_pointLightsUniform = std::make_shared<UniformBuffer>(m_logicalDevice, lightsUniformBufferSize);
+      m_pointLightDescriptorsOutdated.assign(m_logicalDevice->getMaxFramesInFlight(), true);
 
-      m_lightingDescriptorSet->updateDescriptorSets([this](const vk::DescriptorSet descriptorSet, const size_t frame)
+      for (auto& writtenUniforms : m_writtenPointLightUniforms)
       {
-        std::vector descriptorWrites{{
-          m_pointLightsUniform->getDescriptorSet(1, descriptorSet, frame)
-        }};
+        writtenUniforms.clear();
+      }
+    }
 
-        descriptorWrites[0].descriptorType = vk::DescriptorType::eStorageBuffer;
+    // Descriptor sets of other frames may still be in use, so each one is pointed at the new buffer on its own frame
+    if (m_pointLightDescriptorsOutdated[currentFrame])
+    {
+      const auto descriptorSet = m_lightingDescriptorSet->getDescriptorSet(currentFrame);
 
-        return descriptorWrites;
-      });
+      auto descriptorWrite = m_pointLightsUniform->getDescriptorSet(1, descriptorSet, currentFrame);
+      descriptorWrite.descriptorType = vk::DescriptorType::eStorageBuffer;
 
-      m_prevNumPointLights = static_cast<int>(m_pointLightsToRender.size());
-    }
+      m_logicalDevice->updateDescriptorSets({ descriptorWrite });
 
-    if (m_pointLightsToRender.empty())
-    {
-      return;
+      m_pointLightDescriptorsOutdated[currentFrame] = false;
     }
 
-    std::vector<PointLightUniform> lightUniforms;
-    lightUniforms.resize(m_pointLightsToRender.size());
+    m_pointLightUniforms.resize(m_pointLightsToRender.size());
     for (int i = 0; i < m_pointLightsToRender.size(); i++)
     {
-      lightUniforms[i] = std::get<PointLightUniform>(m_pointLightsToRender[i]->getUniform());
-    }
+      m_pointLightUniforms[i] = std::get<PointLightUniform>(m_pointLightsToRender[i]->getUniform());
 
-    m_pointLightsUniform->update(currentFrame, lightUniforms.data());
+      const auto& shadowPass = m_pointLightShadowPasses[i];
+      if (shadowPass.shadowMapSlot != NO_SHADOW_MAP_SLOT)
+      {
+        m_pointLightUniforms[i].shadowMapIndex = static_cast<int32_t>(shadowPass.shadowMapSlot);
+        m_pointLightUniforms[i].shadowMapTier = static_cast<int32_t>(shadowPass.shadowMapTier);
+      }
+    }
 
-    updatePointLightShadowMaps(currentFrame);
+    writeChangedUniforms(*m_pointLightsUniform, currentFrame, m_pointLightUniforms, m_writtenPointLightUniforms[currentFrame]);
   }
 
-  void LightingManager::updatePointLightShadowMaps(const uint32_t currentFrame) const
+  void LightingManager::updateSpotLightUniforms(const uint32_t currentFrame)
   {
-    std::vector<vk::DescriptorImageInfo> imageInfos;
+    if (m_spotLightsToRender.empty())
+    {
+      return;
+    }
 
-    for (auto& light : m_pointLightsToRender)
+    // Buffers only grow, by doubling, so changing the light count usually just changes the metadata uniform
+    if (m_spotLightsToRender.size() > m_spotLightCapacity)
     {
-      if (!light->castsShadows())
+      m_spotLightCapacity = std::bit_ceil(m_spotLightsToRender.size());
+
+      // The old buffers are retired by their destructor, so frames still in flight can finish reading them
+      m_spotLightsUniform = std::make_shared<UniformBuffer>(m_logicalDevice, sizeof(SpotLightUniform) * m_spotLightCapacity);
+
+      m_spotLightShadowsUniform = std::make_shared<UniformBuffer>(m_logicalDevice, sizeof(SpotLightShadowUniform) * m_spotLightCapacity);
+
+      m_spotLightDescriptorsOutdated.assign(m_logicalDevice->getMaxFramesInFlight(), true);
+
+      for (auto& writtenUniforms : m_writtenSpotLightUniforms)
       {
-        continue;
+        writtenUniforms.clear();
       }
 
-      imageInfos.push_back({
-        m_shadowMapSampler,
-        light->getShadowMapDepthImageResource()->getImageView(),
-        vk::ImageLayout::eDepthStencilReadOnlyOptimal
-      });
+      for (auto& writtenUniforms : m_writtenSpotLightShadowUniforms)
+      {
+        writtenUniforms.clear();
+      }
+    }
+
+    // Descriptor sets of other frames may still be in use, so each one is pointed at the new buffer on its own frame
+    if (m_spotLightDescriptorsOutdated[currentFrame])
+    {
+      const auto descriptorSet = m_lightingDescriptorSet->getDescriptorSet(currentFrame);
+
+      auto descriptorWrite = m_spotLightsUniform->getDescriptorSet(2, descriptorSet, currentFrame);
+      descriptorWrite.descriptorType = vk::DescriptorType::eStorageBuffer;
+
+      auto shadowDescriptorWrite = m_spotLightShadowsUniform->getDescriptorSet(6, descriptorSet, currentFrame);
+      shadowDescriptorWrite.descriptorType = vk::DescriptorType::eStorageBuffer;
+
+      m_logicalDevice->updateDescriptorSets({ descriptorWrite, shadowDescriptorWrite });
+
+      m_spotLightDescriptorsOutdated[currentFrame] = false;
+    }
+
+    m_spotLightUniforms.resize(m_spotLightsToRender.size());
+    m_spotLightShadowUniforms.resize(m_spotLightsToRender.size());
+    for (int i = 0; i < m_spotLightsToRender.size(); i++)
+    {
+      const auto spotLight = std::dynamic_pointer_cast<SpotLight>(m_spotLightsToRender[i]);
+
+      m_spotLightUniforms[i] = std::get<SpotLightUniform>(spotLight->getUniform());
+      m_spotLightShadowUniforms[i] = spotLight->getShadowUniform();
 
-      if (imageInfos.size() >= MAX_SHADOW_MAPS)
+      const auto& shadowPass = m_spotLightShadowPasses[i];
+      if (shadowPass.shadowMapSlot != NO_SHADOW_MAP_SLOT)
       {
-        break;
+        const vk::Rect2D& rect = shadowPass.shadowMapRect;
+        const vk::Extent2D atlasExtent = m_spotLightShadowMaps->getExtent();
+        const glm::vec2 atlasSize(atlasExtent.width, atlasExtent.height);
+
+        m_spotLightShadowUniforms[i].shadowAtlasRect = glm::vec4(
+          glm::vec2(rect.offset.x, rect.offset.y) / atlasSize,
+          glm::vec2(rect.extent.width, rect.extent.height) / atlasSize
+        );
       }
     }
 
-    if (imageInfos.empty())
+    writeChangedUniforms(*m_spotLightsUniform, currentFrame, m_spotLightUniforms, m_writtenSpotLightUniforms[currentFrame]);
+
+    writeChangedUniforms(*m_spotLightShadowsUniform, currentFrame, m_spotLightShadowUniforms,
+                         m_writtenSpotLightShadowUniforms[currentFrame]);
+  }
+
+  void LightingManager::updateShadowMapDescriptors(const uint32_t currentFrame)
+  {
+    // Slots change hands without touching the descriptors, only a replaced image does
+    if (!m_shadowMapDescriptorsOutdated[currentFrame])
     {
       return;
     }
 
-    const vk::WriteDescriptorSet samplerWrite {
-      .dstSet = m_lightingDescriptorSet->getDescriptorSet(currentFrame),
+    const vk::DescriptorImageInfo spotLightShadowMapInfo {
+      .sampler = m_shadowMapSampler,
+      .imageView = m_spotLightShadowMaps->getImageView(),
+      .imageLayout = vk::ImageLayout::eDepthStencilReadOnlyOptimal
+    };
+
+    std::array<vk::DescriptorImageInfo, SHADOW_MAP_TIER_COUNT> pointLightShadowMapInfos;
+    for (uint32_t tier = 0; tier < SHADOW_MAP_TIER_COUNT; ++tier)
+    {
+      const vk::ImageView imageView = m_pointLightShadowMaps[tier]->getImageView();
+
+      // No light samples a tier without an image, the smallest tier's stands in so the descriptor stays valid
+      pointLightShadowMapInfos[tier] = {
+        .sampler = m_shadowMapSampler,
+        .imageView = imageView ? imageView : m_pointLightShadowMaps.back()->getImageView(),
+        .imageLayout = vk::ImageLayout::eDepthStencilReadOnlyOptimal
+      };
+    }
+
+    const auto descriptorSet = m_lightingDescriptorSet->getDescriptorSet(currentFrame);
+
+    const vk::WriteDescriptorSet spotLightSamplerWrite {
+      .dstSet = descriptorSet,
+      .dstBinding = 4,
+      .dstArrayElement = 0,
+      .descriptorCount = 1,
+      .descriptorType = vk::DescriptorType::eCombinedImageSampler,
+      .pImageInfo = &spotLightShadowMapInfo
+    };
+
+    const vk::WriteDescriptorSet pointLightSamplerWrite {
+      .dstSet = descriptorSet,
       .dstBinding = 5,
       .dstArrayElement = 0,
-      .descriptorCount = static_cast<uint32_t>(imageInfos.size()),
+      .descriptorCount = static_cast<uint32_t>(pointLightShadowMapInfos.size()),
       .descriptorType = vk::DescriptorType::eCombinedImageSampler,
-      .pImageInfo = imageInfos.data(),
+      .pImageInfo = pointLightShadowMapInfos.data()
     };
 
-    m_logicalDevice->updateDescriptorSets({ samplerWrite });
+    m_logicalDevice->updateDescriptorSets({ spotLightSamplerWrite, pointLightSamplerWrite });
+
+    m_shadowMapDescriptorsOutdated[currentFrame] = false;
   }
 
-  void LightingManager::updateSpotLightUniforms(const uint32_t currentFrame)
+  void LightingManager::prioritizeShadowedLights(const std::vector<std::shared_ptr<Light>>& lights,
+                                                 std::vector<ShadowPass>& shadowPasses,
+                                                 const glm::vec3 viewPosition)
   {
-    if (m_prevNumSpotLights != m_spotLightsToRender.size())
+    shadowPasses.resize(lights.size());
+
+    m_shadowedLights.clear();
+    for (uint32_t i = 0; i < lights.size(); ++i)
     {
-      if (m_spotLightsToRender.empty())
+      shadowPasses[i].shadowMapSlot = NO_SHADOW_MAP_SLOT;
+
+      // Lights whose shadows fall outside the camera's view are lit without them
+      if (lights[i]->castsShadows() &&
+          (!m_cameraFrustumPlanes || lights[i]->shadowsReachFrustum(*m_cameraFrustumPlanes)))
       {
-        m_prevNumSpotLights = 0;
+        const float importance = getScreenImportance(*lights[i], viewPosition);
 
-        return;
+        m_shadowedLights.push_back({
+          .lightIndex = i,
+          .tier = getShadowMapTier(importance),
+          .importance = importance
+        });
       }
+    }
 
-      m_logicalDevice->waitIdle();
-
-      m_spotLightsUniform.reset();
-
-      auto lightsUniformBufferSize = sizeof(SpotLightUniform) * m_spotLightsToRender.size();
+    std::ranges::sort(m_shadowedLights, std::ranges::greater{}, &ShadowedLight::importance);
+  }
 
-      m_spotLightsUniform = std::make_shared<UniformBuffer>(m_logicalDevice, lightsUniformBufferSize);
+  void LightingManager::assignPointLightShadowMaps(const glm::vec3 viewPosition)
+  {
+    prioritizeShadowedLights(m_pointLightsToRender, m_pointLightShadowPasses, viewPosition);
 
-      m_lightingDescriptorSet->updateDescriptorSets([this](const vk::DescriptorSet descriptorSet, const size_t frame)
+    // When a tier's array is full its lights fall back to smaller ones, past the smallest they go without shadows
+    std::array<uint32_t, SHADOW_MAP_TIER_COUNT> slotCounts {};
+    for (auto& shadowedLight : m_shadowedLights)
+    {
+      while (shadowedLight.tier < SHADOW_MAP_TIER_COUNT &&
+             slotCounts[shadowedLight.tier] == m_pointLightShadowMaps[shadowedLight.tier]->getMaxSlotCount())
       {
-        std::vector descriptorWrites{{
-          m_spotLightsUniform->getDescriptorSet(2, descriptorSet, frame)
-        }};
-
-        descriptorWrites[0].descriptorType = vk::DescriptorType::eStorageBuffer;
-
-        return descriptorWrites;
-      });
+        ++shadowedLight.tier;
+      }
 
-      m_prevNumSpotLights = static_cast<int>(m_spotLightsToRender.size());
+      if (shadowedLight.tier < SHADOW_MAP_TIER_COUNT)
+      {
+        ++slotCounts[shadowedLight.tier];
+      }
     }
 
-    if (m_spotLightsToRender.empty())
+    // Slots follow submission order, so lights keep their slot, and its cached shadow map, from frame to frame
+    std::ranges::sort(m_shadowedLights, {}, &ShadowedLight::lightIndex);
+
+    slotCounts.fill(0);
+    for (const auto& shadowedLight : m_shadowedLights)
     {
-      return;
+      if (shadowedLight.tier == SHADOW_MAP_TIER_COUNT)
+      {
+        continue;
+      }
+
+      auto& shadowPass = m_pointLightShadowPasses[shadowedLight.lightIndex];
+      shadowPass.shadowMapSlot = slotCounts[shadowedLight.tier]++;
+      shadowPass.shadowMapTier = shadowedLight.tier;
+      shadowPass.shadowMapRect = vk::Rect2D {
+        .offset = { 0, 0 },
+        .extent = {
+          .width = SHADOW_MAP_SIZES[shadowedLight.tier],
+          .height = SHADOW_MAP_SIZES[shadowedLight.tier]
+        }
+      };
     }
 
-    std::vector<SpotLightUniform> lightUniforms;
-    lightUniforms.resize(m_spotLightsToRender.size());
-    for (int i = 0; i < m_spotLightsToRender.size(); i++)
+    for (uint32_t tier = 0; tier < SHADOW_MAP_TIER_COUNT; ++tier)
     {
-      lightUniforms[i] = std::get<SpotLightUniform>(m_spotLightsToRender[i]->getUniform());
+      if (m_pointLightShadowMaps[tier]->reserve(slotCounts[tier]))
+      {
+        m_shadowMapDescriptorsOutdated.assign(m_logicalDevice->getMaxFramesInFlight(), true);
+      }
     }
-
-    m_spotLightsUniform->update(currentFrame, lightUniforms.data());
-
-    updateSpotLightShadowMaps(currentFrame);
   }
 
-  void LightingManager::updateSpotLightShadowMaps(const uint32_t currentFrame) const
+  void LightingManager::assignSpotLightShadowMaps(const glm::vec3 viewPosition)
   {
-    std::vector<vk::DescriptorImageInfo> imageInfos;
+    prioritizeShadowedLights(m_spotLightsToRender, m_spotLightShadowPasses, viewPosition);
 
-    for (auto& light : m_spotLightsToRender)
+    // When the atlas is too full for a light's tile it falls back to smaller ones, past the smallest it goes without shadows
+    uint32_t freeSlotCount = m_spotLightShadowMaps->getMaxSlotCount();
+    for (auto& shadowedLight : m_shadowedLights)
     {
-      if (!light->castsShadows())
+      while (shadowedLight.tier < SHADOW_MAP_TIER_COUNT &&
+             ShadowAtlas::getSlotCount(SHADOW_MAP_SIZES[shadowedLight.tier]) > freeSlotCount)
       {
-        continue;
+        ++shadowedLight.tier;
       }
 
-      imageInfos.push_back({
-        m_shadowMapSampler,
-        light->getShadowMapDepthImageResource()->getImageView(),
-        vk::ImageLayout::eDepthStencilReadOnlyOptimal
-      });
+      if (shadowedLight.tier < SHADOW_MAP_TIER_COUNT)
+      {
+        freeSlotCount -= ShadowAtlas::getSlotCount(SHADOW_MAP_SIZES[shadowedLight.tier]);
+      }
+    }
 
-      if (imageInfos.size() >= MAX_SHADOW_MAPS)
+    // Largest tiles first, so each starts on a multiple of its slot count and the tiles pack without gaps,
+    // then submission order, so lights of an unchanged tier keep their tile, and its cached shadow map
+    std::ranges::sort(m_shadowedLights, {}, [](const ShadowedLight& shadowedLight) {
+      return std::make_pair(shadowedLight.tier, shadowedLight.lightIndex);
+    });
+
+    uint32_t slotCount = 0;
+    for (const auto& shadowedLight : m_shadowedLights)
+    {
+      if (shadowedLight.tier == SHADOW_MAP_TIER_COUNT)
       {
         break;
       }
+
+      const uint32_t size = SHADOW_MAP_SIZES[shadowedLight.tier];
+
+      auto& shadowPass = m_spotLightShadowPasses[shadowedLight.lightIndex];
+      shadowPass.shadowMapSlot = slotCount;
+      shadowPass.shadowMapTier = shadowedLight.tier;
+      shadowPass.shadowMapRect = ShadowAtlas::getTileRect(slotCount, size);
+
+      slotCount += ShadowAtlas::getSlotCount(size);
     }
 
-    if (imageInfos.empty())
+    if (m_spotLightShadowMaps->reserve(slotCount))
     {
-      return;
+      m_shadowMapDescriptorsOutdated.assign(m_logicalDevice->getMaxFramesInFlight(), true);
     }
-
-    const vk::WriteDescriptorSet samplerWrite {
-      .dstSet = m_lightingDescriptorSet->getDescriptorSet(currentFrame),
-      .dstBinding = 4,
-      .dstArrayElement = 0,
-      .descriptorCount = static_cast<uint32_t>(imageInfos.size()),
-      .descriptorType = vk::DescriptorType::eCombinedImageSampler,
-      .pImageInfo = imageInfos.data(),
-    };
-
-    m_logicalDevice->updateDescriptorSets({ samplerWrite });
   }
 
   void LightingManager::createShadowMapSampler()
@@ -447,73 +896,65 @@ namespace vke {
 
   void LightingManager::renderPointLightShadowMaps(const std::shared_ptr<CommandBuffer>& commandBuffer,
                                                    const std::shared_ptr<PipelineManager>& pipelineManager,
-                                                   const std::vector<std::shared_ptr<RenderObject>>* objects,
+                                                   const std::shared_ptr<SceneBuffers>& sceneBuffers,
                                                    const uint32_t currentFrame) const
   {
-    for (auto& light : m_pointLightsToRender)
+    for (size_t i = 0; i < m_pointLightsToRender.size(); ++i)
     {
-      const auto pointLight = std::dynamic_pointer_cast<PointLight>(light);
-      if (!pointLight->castsShadows())
+      const auto& shadowPass = m_pointLightShadowPasses[i];
+
+      // Cached shadow maps are left as they are
+      if (!shadowPass.render)
       {
         continue;
       }
 
-      const auto shadowExtent = light->getShadowMapExtent();
+      const auto pointLight = std::dynamic_pointer_cast<PointLight>(m_pointLightsToRender[i]);
+
+      const vk::Rect2D& shadowRect = shadowPass.shadowMapRect;
 
-      beginShadowRendering(commandBuffer, light);
+      const vk::ImageView imageView = m_pointLightShadowMaps[shadowPass.shadowMapTier]->getSlotImageView(shadowPass.shadowMapSlot);
 
-      vk::Viewport viewport {
-        .x = 0.0f,
-        .y = 0.0f,
-        .width = static_cast<float>(shadowExtent.width),
-        .height = static_cast<float>(shadowExtent.height),
+      constexpr uint32_t kCubemapFacesMask = 0x3Fu;
+      beginShadowRendering(commandBuffer, imageView, shadowRect, kCubemapFacesMask);
+
+      const vk::Viewport viewport {
+        .x = static_cast<float>(shadowRect.offset.x),
+        .y = static_cast<float>(shadowRect.offset.y),
+        .width = static_cast<float>(shadowRect.extent.width),
+        .height = static_cast<float>(shadowRect.extent.height),
         .minDepth = 0.0f,
         .maxDepth = 1.0f
       };
       commandBuffer->setViewport(viewport);
 
-      vk::Rect2D scissor = {{0, 0}, shadowExtent};
-      commandBuffer->setScissor(scissor);
+      commandBuffer->setScissor(shadowRect);
 
-      RenderInfo shadowRenderInfo = {
-        .commandBuffer = commandBuffer,
-        .currentFrame = currentFrame,
-        .viewPosition = pointLight->getPosition(),
-        .viewMatrix = glm::mat4(1.0),
-        .extent = shadowExtent
-      };
+      pipelineManager->bindGraphicsPipeline(commandBuffer, PipelineType::pointLightShadowMap);
 
-      pipelineManager->bindGraphicsPipeline(shadowRenderInfo.commandBuffer, PipelineType::pointLightShadowMap);
+      // Shadow passes take their light's matrices from elsewhere, only the object data of the scene set is read
+      sceneBuffers->bind(pipelineManager, commandBuffer, PipelineType::pointLightShadowMap, currentFrame, 0);
 
-      pipelineManager->pushGraphicsPipelineConstants<glm::vec3>(
-        shadowRenderInfo.commandBuffer,
+      pipelineManager->pushGraphicsPipelineConstants<glm::vec4>(
+        commandBuffer,
         PipelineType::pointLightShadowMap,
         vk::ShaderStageFlagBits::eFragment,
         0,
-        shadowRenderInfo.viewPosition
+        glm::vec4(pointLight->getPosition(), pointLight->getRange())
       );
 
-      pointLight->updateUniform(shadowRenderInfo.currentFrame);
+      pointLight->updateUniform(currentFrame);
 
       pipelineManager->bindGraphicsPipelineDescriptorSet(
-        shadowRenderInfo.commandBuffer,
+        commandBuffer,
         PipelineType::pointLightShadowMap,
         pointLight->getDescriptorSet(currentFrame),
         1
       );
 
-      for (const auto& object : *objects)
+      for (const auto& batch : shadowPass.drawBatches)
       {
-        object->updateUniformBuffer(shadowRenderInfo.currentFrame, {1.0}, {1.0});
-
-        pipelineManager->bindGraphicsPipelineDescriptorSet(
-          shadowRenderInfo.commandBuffer,
-          PipelineType::pointLightShadowMap,
-          object->getDescriptorSet(currentFrame),
-          0
-        );
-
-        object->draw(shadowRenderInfo.commandBuffer);
+        batch.renderObject->getModel()->draw(commandBuffer, batch.firstInstance, batch.instanceCount);
       }
 
       commandBuffer->endRendering();
@@ -522,64 +963,54 @@ namespace vke {
 
   void LightingManager::renderSpotLightShadowMaps(const std::shared_ptr<CommandBuffer>& commandBuffer,
                                                   const std::shared_ptr<PipelineManager>& pipelineManager,
-                                                  const std::vector<std::shared_ptr<RenderObject>>* objects,
+                                                  const std::shared_ptr<SceneBuffers>& sceneBuffers,
                                                   const uint32_t currentFrame) const
   {
-    for (auto& light : m_spotLightsToRender)
+    for (size_t i = 0; i < m_spotLightsToRender.size(); ++i)
     {
-      const auto spotLight = std::dynamic_pointer_cast<SpotLight>(light);
-      if (!spotLight->castsShadows())
+      const auto& shadowPass = m_spotLightShadowPasses[i];
+
+      // Cached shadow maps are left as they are
+      if (!shadowPass.render)
       {
         continue;
       }
 
-      const auto shadowExtent = light->getShadowMapExtent();
+      const auto spotLight = std::dynamic_pointer_cast<SpotLight>(m_spotLightsToRender[i]);
 
-      beginShadowRendering(commandBuffer, light);
+      // The pass only covers the light's tile, so clearing it leaves the other tiles intact
+      const vk::Rect2D& shadowRect = shadowPass.shadowMapRect;
 
-      vk::Viewport viewport {
-        .x = 0.0f,
-        .y = 0.0f,
-        .width = static_cast<float>(shadowExtent.width),
-        .height = static_cast<float>(shadowExtent.height),
+      beginShadowRendering(commandBuffer, m_spotLightShadowMaps->getImageView(), shadowRect, 0);
+
+      const vk::Viewport viewport {
+        .x = static_cast<float>(shadowRect.offset.x),
+        .y = static_cast<float>(shadowRect.offset.y),
+        .width = static_cast<float>(shadowRect.extent.width),
+        .height = static_cast<float>(shadowRect.extent.height),
         .minDepth = 0.0f,
         .maxDepth = 1.0f
       };
       commandBuffer->setViewport(viewport);
 
-      vk::Rect2D scissor = {{0, 0}, shadowExtent};
-      commandBuffer->setScissor(scissor);
+      commandBuffer->setScissor(shadowRect);
 
-      RenderInfo shadowRenderInfo = {
-        .commandBuffer = commandBuffer,
-        .currentFrame = currentFrame,
-        .viewPosition = light->getPosition(),
-        .viewMatrix = spotLight->getLightViewProjectionMatrix(),
-        .extent = shadowExtent
-      };
+      pipelineManager->bindGraphicsPipeline(commandBuffer, PipelineType::shadow);
 
-      pipelineManager->bindGraphicsPipeline(shadowRenderInfo.commandBuffer, PipelineType::shadow);
+      // Shadow passes take their light's matrices from elsewhere, only the object data of the scene set is read
+      sceneBuffers->bind(pipelineManager, commandBuffer, PipelineType::shadow, currentFrame, 0);
 
       pipelineManager->pushGraphicsPipelineConstants<glm::mat4>(
-        shadowRenderInfo.commandBuffer,
+        commandBuffer,
         PipelineType::shadow,
         vk::ShaderStageFlagBits::eVertex,
         0,
-        shadowRenderInfo.viewMatrix
+        spotLight->getLightViewProjectionMatrix()
       );
 
-      for (const auto& object : *objects)
+      for (const auto& batch : shadowPass.drawBatches)
       {
-        object->updateUniformBuffer(shadowRenderInfo.currentFrame, {1.0}, {1.0});
-
-        pipelineManager->bindGraphicsPipelineDescriptorSet(
-          shadowRenderInfo.commandBuffer,
-          PipelineType::shadow,
-          object->getDescriptorSet(currentFrame),
-          0
-        );
-
-        object->draw(shadowRenderInfo.commandBuffer);
+        batch.renderObject->getModel()->draw(commandBuffer, batch.firstInstance, batch.instanceCount);
       }
 
       commandBuffer->endRendering();
@@ -609,7 +1040,7 @@ namespace vke {
   {
     const std::array<vk::DescriptorPoolSize, 3> poolSizes {{
       {vk::DescriptorType::eUniformBuffer, m_logicalDevice->getMaxFramesInFlight() * m_descriptorPoolSize},
-      {vk::DescriptorType::eCombinedImageSampler, m_logicalDevice->getMaxFramesInFlight() * MAX_SHADOW_MAPS * 2},
+      {vk::DescriptorType::eCombinedImageSampler, m_logicalDevice->getMaxFramesInFlight() * (1 + SHADOW_MAP_TIER_COUNT)},
       {vk::DescriptorType::eStorageBuffer, m_logicalDevice->getMaxFramesInFlight() * 20}
     }};
 
@@ -635,27 +1066,21 @@ namespace vke {
     return m_descriptorPools.back();
   }
 
-  void LightingManager::updateLightMetadataUniform() const
+  void LightingManager::updateLightMetadataUniform(const uint32_t currentFrame) const
   {
-    if (m_prevNumPointLights == m_pointLightsToRender.size() &&
-        m_prevNumSpotLights == m_spotLightsToRender.size())
-    {
-      return;
-    }
-
+    // Only this frame's copy is written, the others may still be read by frames in flight
     const LightMetadataUniform lightMetadataUBO {
       .numPointLights = static_cast<int>(m_pointLightsToRender.size()),
       .numSpotLights = static_cast<int>(m_spotLightsToRender.size())
     };
 
-    for (size_t i = 0; i < m_logicalDevice->getMaxFramesInFlight(); ++i)
-    {
-      m_lightMetadataUniform->update(i, &lightMetadataUBO);
-    }
+    m_lightMetadataUniform->update(currentFrame, &lightMetadataUBO);
   }
 
   void LightingManager::beginShadowRendering(const std::shared_ptr<CommandBuffer>& commandBuffer,
-                                             const std::shared_ptr<Light>& light)
+                                             const vk::ImageView imageView,
+                                             const vk::Rect2D& rect,
+                                             const uint32_t viewMask)
   {
     static constexpr vk::ClearValue s_clearDepth = vk::ClearDepthStencilValue{
       .depth = 1.0f,
@@ -663,21 +1088,17 @@ namespace vke {
     };
 
     vk::RenderingAttachmentInfo depthRenderingAttachmentInfo {
-      .imageView = light->getShadowMapDepthImageResource()->getImageView(),
+      .imageView = imageView,
       .imageLayout = vk::ImageLayout::eDepthStencilAttachmentOptimal,
       .loadOp = vk::AttachmentLoadOp::eClear,
       .storeOp = vk::AttachmentStoreOp::eStore,
       .clearValue = s_clearDepth
     };
 
-    constexpr uint32_t kCubemapFacesMask = 0x3Fu;
     const vk::RenderingInfo renderingInfo {
-      .renderArea = {
-        .offset = {0, 0},
-        .extent = light->getShadowMapExtent(),
-      },
+      .renderArea = rect,
       .layerCount = 1,
-      .viewMask = light->getLightType() == LightType::pointLight ? kCubemapFacesMask : 0,
+      .viewMask = viewMask,
       .colorAttachmentCount = 0,
       .pColorAttachments = nullptr,
       .pDepthAttachment = &depthRenderingAttachmentInfo,
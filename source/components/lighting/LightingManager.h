@@ -1,21 +1,75 @@
 #ifndef VKE_LIGHTINGMANAGER_H
 #define VKE_LIGHTINGMANAGER_H
 
+#include "lights/Light.h"
+#include "shadowMaps/ShadowMapPool.h"
+#include "../memory/MemoryAllocation.h"
+#include "../renderingManager/renderer3D/SceneBuffers.h"
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <vulkan/vulkan_raii.hpp>
+#include <array>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace vke {
 
   class CommandBuffer;
+  struct CullingStats;
   class DescriptorSet;
+  class FrustumCuller;
   class Light;
   class LogicalDevice;
   class PipelineManager;
   class RenderObject;
+  class ShadowAtlas;
+  class ShadowCubeMapArray;
   class UniformBuffer;
 
+  // Screen tiles across and down and depth slices the camera's frustum is binned into, matches LightClusters.glsl
+  constexpr uint32_t LIGHT_CLUSTER_COUNT_X = 16;
+  constexpr uint32_t LIGHT_CLUSTER_COUNT_Y = 9;
+  constexpr uint32_t LIGHT_CLUSTER_COUNT_Z = 24;
+  constexpr uint32_t LIGHT_CLUSTER_COUNT = LIGHT_CLUSTER_COUNT_X * LIGHT_CLUSTER_COUNT_Y * LIGHT_CLUSTER_COUNT_Z;
+
+  // Lights past this many in a cluster are left out of it, point lights first
+  constexpr uint32_t MAX_LIGHTS_PER_CLUSTER = 126;
+
+  struct LightClusterUniform {
+    glm::mat4 view;
+    glm::mat4 inverseProjection;
+    glm::vec2 screenSize;
+    glm::vec2 tileSize;
+    float nearPlane;
+    float farPlane;
+
+    // Depth slices are spaced exponentially, slice = log(depth) * sliceScale - sliceBias
+    float sliceScale;
+    float sliceBias;
+  };
+
+  // A light's shadow map slot and casters for the frame, render is cleared when its slot still holds them from an earlier frame
+  struct ShadowPass {
+    // First slot of the light's shadow map, in the pool of its tier
+    uint32_t shadowMapSlot = NO_SHADOW_MAP_SLOT;
+    uint32_t shadowMapTier = 0;
+
+    // Area of the pool's image the shadow map is rendered to
+    vk::Rect2D shadowMapRect;
+
+    std::vector<DrawBatch> drawBatches;
+    bool render = false;
+  };
+
+  // A shadow casting light waiting for a shadow map, tier is SHADOW_MAP_TIER_COUNT when none is left for it
+  struct ShadowedLight {
+    uint32_t lightIndex;
+    uint32_t tier;
+    float importance;
+  };
+
   class LightingManager {
   public:
     explicit LightingManager(std::shared_ptr<LogicalDevice> logicalDevice);
@@ -38,13 +92,34 @@ namespace vke {
 
     void clearLightsToRender();
 
-    void update(uint32_t currentFrame, glm::vec3 viewPosition);
+    // Drops the lights that cannot reach the camera's frustum, when one is given, hands the frame's shadow map slots to
+    // the rest, then writes their uniforms
+    void update(uint32_t currentFrame,
+                glm::vec3 viewPosition,
+                const glm::mat4* cameraViewProjection);
+
+    // Culls the frame's objects against every shadow casting light and batches the ones each light sees
+    void updateShadowDrawBatches(const std::shared_ptr<SceneBuffers>& sceneBuffers,
+                                 const std::shared_ptr<FrustumCuller>& frustumCuller,
+                                 const std::vector<std::shared_ptr<RenderObject>>& renderObjects,
+                                 CullingStats& cullingStats);
 
     void renderShadowMaps(const std::shared_ptr<CommandBuffer>& commandBuffer,
                           const std::shared_ptr<PipelineManager>& pipelineManager,
-                          const std::vector<std::shared_ptr<RenderObject>>* objects,
+                          const std::shared_ptr<SceneBuffers>& sceneBuffers,
                           uint32_t currentFrame) const;
 
+    // Writes the camera the lights are binned against this frame
+    void updateLightClusterUniform(uint32_t currentFrame,
+                                   const glm::mat4& viewMatrix,
+                                   const glm::mat4& projectionMatrix,
+                                   vk::Extent2D extent) const;
+
+    // Bins the lights into clusters, ahead of the passes shading with them
+    void computeLightClusters(const std::shared_ptr<CommandBuffer>& commandBuffer,
+                              const std::shared_ptr<PipelineManager>& pipelineManager,
+                              uint32_t currentFrame) const;
+
     [[nodiscard]] vk::DescriptorSetLayout getPointLightDescriptorSetLayout() const;
 
   private:
@@ -54,15 +129,56 @@ namespace vke {
 
     std::shared_ptr<UniformBuffer> m_lightMetadataUniform;
     std::shared_ptr<UniformBuffer> m_spotLightsUniform;
+    std::shared_ptr<UniformBuffer> m_spotLightShadowsUniform;
     std::shared_ptr<UniformBuffer> m_pointLightsUniform;
     std::shared_ptr<UniformBuffer> m_cameraUniform;
+    std::shared_ptr<UniformBuffer> m_lightClusterUniform;
+
+    // Written and read only by the GPU, one per frame
+    std::vector<vk::raii::Buffer> m_lightClusterBuffers;
+    std::vector<MemoryAllocation> m_lightClusterBuffersMemory;
+    std::vector<vk::DescriptorBufferInfo> m_lightClusterBufferInfos;
+
+    size_t m_pointLightCapacity;
+    size_t m_spotLightCapacity;
+
+    // Frames whose descriptor set still points at a light buffer that has since been replaced
+    std::vector<bool> m_pointLightDescriptorsOutdated;
+    std::vector<bool> m_spotLightDescriptorsOutdated;
 
-    int m_prevNumPointLights = 0;
-    int m_prevNumSpotLights = 0;
+    // Frames whose descriptor set still points at a shadow map image that has since been replaced
+    std::vector<bool> m_shadowMapDescriptorsOutdated;
+
+    // The frame's light uniforms, rebuilt in place every frame
+    std::vector<PointLightUniform> m_pointLightUniforms;
+    std::vector<SpotLightUniform> m_spotLightUniforms;
+    std::vector<SpotLightShadowUniform> m_spotLightShadowUniforms;
+
+    // Uniforms last written to each frame's light buffers, so lights that did not change are not written again
+    std::vector<std::vector<PointLightUniform>> m_writtenPointLightUniforms;
+    std::vector<std::vector<SpotLightUniform>> m_writtenSpotLightUniforms;
+    std::vector<std::vector<SpotLightShadowUniform>> m_writtenSpotLightShadowUniforms;
 
     std::vector<std::shared_ptr<Light>> m_pointLightsToRender;
     std::vector<std::shared_ptr<Light>> m_spotLightsToRender;
 
+    // Planes of the frame's camera frustum, unset when lights are not culled against it
+    std::optional<std::array<glm::vec4, 6>> m_cameraFrustumPlanes;
+
+    // Indexed by shadow map tier
+    std::array<std::shared_ptr<ShadowCubeMapArray>, SHADOW_MAP_TIER_COUNT> m_pointLightShadowMaps;
+    std::shared_ptr<ShadowAtlas> m_spotLightShadowMaps;
+
+    // Indexed like the lights to render
+    std::vector<ShadowPass> m_pointLightShadowPasses;
+    std::vector<ShadowPass> m_spotLightShadowPasses;
+
+    std::vector<ShadowedLight> m_shadowedLights;
+
+    std::vector<std::shared_ptr<RenderObject>> m_shadowCasterCandidates;
+    std::vector<std::shared_ptr<RenderObject>> m_shadowCasters;
+    std::vector<uint8_t> m_shadowCasterViewMasks;
+
     vk::raii::CommandPool m_commandPool = nullptr;
 
     std::vector<vk::raii::DescriptorPool> m_descriptorPools;
@@ -73,8 +189,12 @@ namespace vke {
 
     vk::raii::DescriptorSetLayout m_pointLightDescriptorSetLayout = nullptr;
 
+    void cullLights(const glm::mat4& cameraViewProjection);
+
     void createUniforms();
 
+    void createLightClusterBuffers();
+
     void createDescriptorSet();
 
     void updateUniforms(uint32_t currentFrame,
@@ -82,22 +202,29 @@ namespace vke {
 
     void updatePointLightUniforms(uint32_t currentFrame);
 
-    void updatePointLightShadowMaps(uint32_t currentFrame) const;
-
     void updateSpotLightUniforms(uint32_t currentFrame);
 
-    void updateSpotLightShadowMaps(uint32_t currentFrame) const;
+    void updateShadowMapDescriptors(uint32_t currentFrame);
+
+    // Collects the shadow casting lights, most important first, each with the tier its screen coverage asks for
+    void prioritizeShadowedLights(const std::vector<std::shared_ptr<Light>>& lights,
+                                  std::vector<ShadowPass>& shadowPasses,
+                                  glm::vec3 viewPosition);
+
+    void assignPointLightShadowMaps(glm::vec3 viewPosition);
+
+    void assignSpotLightShadowMaps(glm::vec3 viewPosition);
 
     void createShadowMapSampler();
 
     void renderPointLightShadowMaps(const std::shared_ptr<CommandBuffer>& commandBuffer,
                                     const std::shared_ptr<PipelineManager>& pipelineManager,
-                                    const std::vector<std::shared_ptr<RenderObject>>* objects,
+                                    const std::shared_ptr<SceneBuffers>& sceneBuffers,
                                     uint32_t currentFrame) const;
 
     void renderSpotLightShadowMaps(const std::shared_ptr<CommandBuffer>& commandBuffer,
                                    const std::shared_ptr<PipelineManager>& pipelineManager,
-                                   const std::vector<std::shared_ptr<RenderObject>>* objects,
+                                   const std::shared_ptr<SceneBuffers>& sceneBuffers,
                                    uint32_t currentFrame) const;
 
     void createPointLightDescriptorSetLayout();
@@ -108,10 +235,12 @@ namespace vke {
 
     [[nodiscard]] vk::DescriptorPool getDescriptorPool();
 
-    void updateLightMetadataUniform() const;
+    void updateLightMetadataUniform(uint32_t currentFrame) const;
 
     static void beginShadowRendering(const std::shared_ptr<CommandBuffer>& commandBuffer,
-                                     const std::shared_ptr<Light>& light);
+                                     vk::ImageView imageView,
+                                     const vk::Rect2D& rect,
+                                     uint32_t viewMask);
   };
 
 } // namespace vke
@@ -1,6 +1,6 @@
 #include "Light.h"
-#include "../../logicalDevice/LogicalDevice.h"
-#include "../../renderingManager/ImageResource.h"
+#include <glm/geometric.hpp>
+#include <algorithm>
 
 namespace vke {
 
@@ -10,11 +10,6 @@ namespace vke {
       m_ambient(commonLightData.ambient), m_diffuse(commonLightData.diffuse), m_specular(commonLightData.specular)
   {}
 
-  Light::~Light()
-  {
-    m_logicalDevice->waitIdle();
-  }
-
   glm::vec3 Light::getPosition() const
   {
     return m_position;
@@ -40,9 +35,18 @@ namespace vke {
     return m_specular;
   }
 
+  float Light::getRange() const
+  {
+    return m_range;
+  }
+
   void Light::setPosition(const glm::vec3& position)
   {
-    m_position = position;
+    if (m_position != position)
+    {
+      m_position = position;
+      ++m_shadowRevision;
+    }
   }
 
   void Light::setColor(const glm::vec3& color)
@@ -65,19 +69,42 @@ namespace vke {
     m_specular = specular;
   }
 
-  vk::Extent2D Light::getShadowMapExtent() const
+  void Light::setRange(const float range)
   {
-    return m_shadowMapExtent;
+    if (m_range != range)
+    {
+      m_range = range;
+      ++m_shadowRevision;
+    }
   }
 
-  std::shared_ptr<ImageResource> Light::getShadowMapDepthImageResource() const
+  bool Light::castsShadows() const
   {
-    return m_shadowMapDepthImageResource;
+    return m_castsShadows;
   }
 
-  bool Light::castsShadows() const
+  uint32_t Light::getShadowRevision() const
   {
-    return m_castsShadows;
+    return m_shadowRevision;
+  }
+
+  bool Light::reachesFrustum(const std::array<glm::vec4, 6>& frustumPlanes) const
+  {
+    return sphereIntersectsFrustum(m_position, m_range, frustumPlanes);
+  }
+
+  bool Light::shadowsReachFrustum(const std::array<glm::vec4, 6>& frustumPlanes) const
+  {
+    return reachesFrustum(frustumPlanes);
+  }
+
+  bool Light::sphereIntersectsFrustum(const glm::vec3& center,
+                                      const float radius,
+                                      const std::array<glm::vec4, 6>& frustumPlanes)
+  {
+    return std::ranges::all_of(frustumPlanes, [&center, radius](const glm::vec4& plane) {
+      return glm::dot(glm::vec3(plane), center) + plane.w >= -radius;
+    });
   }
 
 } // namespace vke
\ No newline at end of file
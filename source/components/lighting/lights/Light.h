@@ -2,6 +2,7 @@
 #define VKE_LIGHT_H
 
 #include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
 #include <glm/mat4x4.hpp>
 #include <vulkan/vulkan_raii.hpp>
 #include <array>
@@ -10,24 +11,28 @@
 
 namespace vke {
 
-  class ImageResource;
   class LogicalDevice;
 
+  // Shading data only, shadow passes read the light's matrices from its own uniform
   struct alignas(16) PointLightUniform {
-    std::array<glm::mat4, 6> lightViewProjections;
     glm::vec3 position;
-    float padding1;
+    float range;
     glm::vec3 color;
-    float padding2;
+
+    // Cube of the shadow map array, -1 when the light has no shadow map this frame
+    int32_t shadowMapIndex;
 
     float ambient;
     float diffuse;
     float specular;
-    float padding3;
+
+    // Shadow map array the cube is in, one per shadow map size
+    int32_t shadowMapTier;
+
+    bool operator==(const PointLightUniform&) const = default;
   };
 
   struct alignas(16) SpotLightUniform {
-    glm::mat4 lightViewProjection;
     glm::vec3 position;
     float ambient;
     glm::vec3 color;
@@ -35,6 +40,21 @@ namespace vke {
     glm::vec3 direction;
     float specular;
     float coneAngle;
+    float range;
+    float padding1;
+    float padding2;
+
+    bool operator==(const SpotLightUniform&) const = default;
+  };
+
+  // Kept in a buffer of its own, only fragments receiving shadows read it
+  struct alignas(16) SpotLightShadowUniform {
+    glm::mat4 lightViewProjection;
+
+    // Offset and scale of the light's tile in the shadow atlas, in texture coordinates, zero sized without a tile
+    glm::vec4 shadowAtlasRect;
+
+    bool operator==(const SpotLightShadowUniform&) const = default;
   };
 
   using LightUniform = std::variant<PointLightUniform, SpotLightUniform>;
@@ -57,7 +77,7 @@ namespace vke {
     Light(std::shared_ptr<LogicalDevice> logicalDevice,
           const CommonLightData& commonLightData);
 
-    virtual ~Light();
+    virtual ~Light() = default;
 
     [[nodiscard]] glm::vec3 getPosition() const;
     [[nodiscard]] glm::vec3 getColor() const;
@@ -65,40 +85,48 @@ namespace vke {
     [[nodiscard]] float getDiffuse() const;
     [[nodiscard]] float getSpecular() const;
 
+    // Distance past which the light adds nothing, also the far plane of its shadow map
+    [[nodiscard]] float getRange() const;
+
     void setPosition(const glm::vec3& position);
     void setColor(const glm::vec3& color);
     void setAmbient(float ambient);
     void setDiffuse(float diffuse);
     void setSpecular(float specular);
-
-    [[nodiscard]] vk::Extent2D getShadowMapExtent() const;
+    void setRange(float range);
 
     [[nodiscard]] bool castsShadows() const;
 
+    // Whether the sphere of the light's range, everything it lights, intersects the frustum of the planes
+    [[nodiscard]] bool reachesFrustum(const std::array<glm::vec4, 6>& frustumPlanes) const;
+
+    // Whether the part of the light's reach its shadows can fall on intersects the frustum of the planes
+    [[nodiscard]] virtual bool shadowsReachFrustum(const std::array<glm::vec4, 6>& frustumPlanes) const;
+
+    // Bumped whenever a change would move the light's shadows, and so its matrices
+    [[nodiscard]] uint32_t getShadowRevision() const;
+
     [[nodiscard]] virtual LightType getLightType() const = 0;
 
     [[nodiscard]] virtual LightUniform getUniform() const = 0;
 
-    [[nodiscard]] std::shared_ptr<ImageResource> getShadowMapDepthImageResource() const;
-
   protected:
     std::shared_ptr<LogicalDevice> m_logicalDevice;
 
-    std::shared_ptr<ImageResource> m_shadowMapDepthImageResource;
-
     bool m_castsShadows = true;
-    vk::Extent2D m_shadowMapExtent = {
-      1024,
-      1024
-    };
 
     glm::vec3 m_position;
     glm::vec3 m_color;
     float m_ambient;
     float m_diffuse;
     float m_specular;
+    float m_range = 100.0f;
+
+    uint32_t m_shadowRevision = 0;
 
-    virtual void createShadowMap(vk::CommandPool commandPool) = 0;
+    [[nodiscard]] static bool sphereIntersectsFrustum(const glm::vec3& center,
+                                                      float radius,
+                                                      const std::array<glm::vec4, 6>& frustumPlanes);
   };
 
 } // namespace vke
@@ -1,10 +1,8 @@
 #include "PointLight.h"
-#include "../../commandBuffer/CommandBuffer.h"
 #include "../../logicalDevice/LogicalDevice.h"
 #include "../../pipelines/descriptorSets/DescriptorSet.h"
 #include "../../pipelines/GraphicsPipeline.h"
 #include "../../pipelines/uniformBuffers/UniformBuffer.h"
-#include "../../renderingManager/ImageResource.h"
 
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
 #define GLM_FORCE_RIGHT_HANDED
@@ -15,16 +13,15 @@ namespace vke {
 
   PointLight::PointLight(std::shared_ptr<LogicalDevice> logicalDevice,
                          const CommonLightData& commonLightData,
-                         const vk::CommandPool& commandPool,
                          const vk::DescriptorPool descriptorPool,
                          const vk::DescriptorSetLayout descriptorSetLayout)
     : Light(std::move(logicalDevice), commonLightData)
   {
-    PointLight::createShadowMap(commandPool);
-
     createUniform();
 
     createDescriptorSet(descriptorPool, descriptorSetLayout);
+
+    m_uniformRevisions.resize(m_logicalDevice->getMaxFramesInFlight());
   }
 
   LightType PointLight::getLightType() const
@@ -35,36 +32,50 @@ namespace vke {
   LightUniform PointLight::getUniform() const
   {
     return PointLightUniform {
-      .lightViewProjections = getLightViewProjectionMatrices(),
       .position = m_position,
+      .range = m_range,
       .color = m_color,
+      .shadowMapIndex = -1,
       .ambient = m_ambient,
       .diffuse = m_diffuse,
-      .specular = m_specular
+      .specular = m_specular,
+      .shadowMapTier = 0
     };
   }
 
-  std::array<glm::mat4, 6> PointLight::getLightViewProjectionMatrices() const
+  const std::array<glm::mat4, 6>& PointLight::getLightViewProjectionMatrices() const
+  {
+    if (m_lightViewProjectionMatricesRevision != m_shadowRevision)
+    {
+      m_lightViewProjectionMatrices = createLightViewProjectionMatrices(m_position, m_range);
+      m_lightViewProjectionMatricesRevision = m_shadowRevision;
+    }
+
+    return m_lightViewProjectionMatrices;
+  }
+
+  std::array<glm::mat4, 6> PointLight::createLightViewProjectionMatrices(const glm::vec3& position,
+                                                                         const float range)
   {
     glm::mat4 projection = glm::perspective(
       glm::radians(90.0f),
       1.0f,
       0.1f,
-      100.0f
+      range
     );
 
     projection[1][1] *= -1;
 
     const std::array viewMatrices {
-      glm::lookAt(m_position, m_position + glm::vec3(1.0, 0.0, 0.0), glm::vec3(0.0,-1.0, 0.0)),
-      glm::lookAt(m_position, m_position + glm::vec3(-1.0, 0.0, 0.0), glm::vec3(0.0,-1.0, 0.0)),
+      glm::lookAt(position, position + glm::vec3(1.0, 0.0, 0.0), glm::vec3(0.0,-1.0, 0.0)),
+      glm::lookAt(position, position + glm::vec3(-1.0, 0.0, 0.0), glm::vec3(0.0,-1.0, 0.0)),
 
       // Y direction order must be swapped for point light shadow maps
-      glm::lookAt(m_position, m_position + glm::vec3(0.0,-1.0, 0.0), glm::vec3(0.0, 0.0,-1.0)),
-      glm::lookAt(m_position, m_position + glm::vec3(0.0, 1.0, 0.0), glm::vec3(0.0, 0.0, 1.0)),
+      glm::lookAt(position, position + glm::vec3(0.0,-1.0, 0.0), glm::vec3(0.0, 0.0,-1.0)),
+      glm::lookAt(position, position + glm::vec3(0.0, 1.0, 0.0), glm::vec3(0.0, 0.0, 1.0)),
 
-      glm::lookAt(m_position, m_position + glm::vec3(0.0, 0.0, 1.0), glm::vec3(0.0,-1.0, 0.0)),
-      glm::lookAt(m_position, m_position + glm::vec3(0.0, 0.0,-1.0), glm::vec3(0.0,-1.0, 0.0))
+      glm::lookAt(position, position + glm::vec3(0.0, 0.0, 1.0), glm::vec3(0.0,-1.0, 0.0)),
+      glm::lookAt(position, position + glm::vec3(0.0, 0.0,-1.0), glm::vec3(0.0,-1.0, 0.0))
     };
 
     return {
@@ -77,35 +88,21 @@ namespace vke {
     };
   }
 
-  void PointLight::updateUniform(const uint32_t currentFrame) const
-  {
-    const auto matrices = getLightViewProjectionMatrices();
-    m_viewProjectionUniform->update(currentFrame, &matrices);
-  }
-
-  vk::DescriptorSet PointLight::getDescriptorSet(const uint32_t currentFrame) const
-  {
-    return m_descriptorSet->getDescriptorSet(currentFrame);
-  }
-
-  void PointLight::createShadowMap(const vk::CommandPool commandPool)
+  void PointLight::updateUniform(const uint32_t currentFrame)
   {
-    if (!m_castsShadows)
+    if (m_uniformRevisions[currentFrame] == m_shadowRevision)
     {
       return;
     }
 
-    ImageResourceConfig imageResourceConfig {
-      .imageResourceType = ImageResourceType::Depth,
-      .logicalDevice = m_logicalDevice,
-      .extent = m_shadowMapExtent,
-      .commandPool = commandPool,
-      .depthFormat = vk::Format::eD32Sfloat,
-      .numSamples = vk::SampleCountFlagBits::e1,
-      .isCubeMap = true
-    };
+    m_viewProjectionUniform->update(currentFrame, getLightViewProjectionMatrices().data());
 
-    m_shadowMapDepthImageResource = std::make_shared<ImageResource>(imageResourceConfig);
+    m_uniformRevisions[currentFrame] = m_shadowRevision;
+  }
+
+  vk::DescriptorSet PointLight::getDescriptorSet(const uint32_t currentFrame) const
+  {
+    return m_descriptorSet->getDescriptorSet(currentFrame);
   }
 
   void PointLight::createUniform()
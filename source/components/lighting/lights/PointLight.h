@@ -3,6 +3,8 @@
 
 #include "Light.h"
 #include <array>
+#include <optional>
+#include <vector>
 
 namespace vke {
 
@@ -13,7 +15,6 @@ namespace vke {
   public:
     PointLight(std::shared_ptr<LogicalDevice> logicalDevice,
                const CommonLightData& commonLightData,
-               const vk::CommandPool& commandPool,
                vk::DescriptorPool descriptorPool,
                vk::DescriptorSetLayout descriptorSetLayout);
 
@@ -21,9 +22,14 @@ namespace vke {
 
     [[nodiscard]] LightUniform getUniform() const override;
 
-    [[nodiscard]] std::array<glm::mat4, 6> getLightViewProjectionMatrices() const;
+    // Cached until the light moves or its range changes
+    [[nodiscard]] const std::array<glm::mat4, 6>& getLightViewProjectionMatrices() const;
 
-    void updateUniform(uint32_t currentFrame) const;
+    [[nodiscard]] static std::array<glm::mat4, 6> createLightViewProjectionMatrices(const glm::vec3& position,
+                                                                                       float range);
+
+    // Writes the matrices to the frame's copy of the shadow pass uniform, unless it already holds them
+    void updateUniform(uint32_t currentFrame);
 
     [[nodiscard]] vk::DescriptorSet getDescriptorSet(uint32_t currentFrame) const;
 
@@ -32,7 +38,11 @@ namespace vke {
 
     std::shared_ptr<UniformBuffer> m_viewProjectionUniform;
 
-    void createShadowMap(vk::CommandPool commandPool) override;
+    mutable std::array<glm::mat4, 6> m_lightViewProjectionMatrices{};
+    mutable std::optional<uint32_t> m_lightViewProjectionMatricesRevision;
+
+    // Shadow revision each frame's copy of the uniform was written at
+    std::vector<std::optional<uint32_t>> m_uniformRevisions;
 
     void createUniform();
 
@@ -1,21 +1,18 @@
 #include "SpotLight.h"
-#include "../../logicalDevice/LogicalDevice.h"
-#include "../../renderingManager/ImageResource.h"
 
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
 #define GLM_FORCE_RIGHT_HANDED
 #include <glm/ext/matrix_transform.hpp>
+#include <glm/geometric.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <cmath>
 
 namespace vke {
 
   SpotLight::SpotLight(std::shared_ptr<LogicalDevice> logicalDevice,
-                       const CommonLightData& commonLightData,
-                       const vk::CommandPool commandPool)
+                       const CommonLightData& commonLightData)
     : Light(std::move(logicalDevice), commonLightData)
-  {
-    SpotLight::createShadowMap(commandPool);
-  }
+  {}
 
   glm::vec3 SpotLight::getDirection() const
   {
@@ -29,12 +26,20 @@ namespace vke {
 
   void SpotLight::setDirection(const glm::vec3& direction)
   {
-    m_direction = direction;
+    if (m_direction != direction)
+    {
+      m_direction = direction;
+      ++m_shadowRevision;
+    }
   }
 
   void SpotLight::setConeAngle(const float coneAngle)
   {
-    m_coneAngle = coneAngle;
+    if (m_coneAngle != coneAngle)
+    {
+      m_coneAngle = coneAngle;
+      ++m_shadowRevision;
+    }
   }
 
   LightType SpotLight::getLightType() const
@@ -42,22 +47,59 @@ namespace vke {
     return LightType::spotLight;
   }
 
+  bool SpotLight::shadowsReachFrustum(const std::array<glm::vec4, 6>& frustumPlanes) const
+  {
+    if (m_coneAngle >= 90.0f)
+    {
+      return reachesFrustum(frustumPlanes);
+    }
+
+    const glm::vec3 direction = glm::normalize(m_direction);
+
+    // Sphere around the part of the cone within the light's range, through the apex and the rim when the cone is
+    // narrow, centered on the rim's circle when it is wide
+    const float coneAngle = glm::radians(m_coneAngle);
+    const float cosConeAngle = std::cos(coneAngle);
+    if (m_coneAngle <= 45.0f)
+    {
+      const float radius = m_range / (2.0f * cosConeAngle);
+
+      return sphereIntersectsFrustum(m_position + direction * radius, radius, frustumPlanes);
+    }
+
+    return sphereIntersectsFrustum(m_position + direction * (m_range * cosConeAngle), m_range * std::sin(coneAngle),
+                                   frustumPlanes);
+  }
+
   LightUniform SpotLight::getUniform() const
   {
     return SpotLightUniform {
-      .lightViewProjection = getLightViewProjectionMatrix(),
       .position = m_position,
       .ambient = m_ambient,
       .color = m_color,
       .diffuse = m_diffuse,
       .direction = m_direction,
       .specular = m_specular,
-      .coneAngle = glm::radians(m_coneAngle)
+      .coneAngle = glm::radians(m_coneAngle),
+      .range = m_range
+    };
+  }
+
+  SpotLightShadowUniform SpotLight::getShadowUniform() const
+  {
+    return SpotLightShadowUniform {
+      .lightViewProjection = getLightViewProjectionMatrix(),
+      .shadowAtlasRect = glm::vec4(0.0f)
     };
   }
 
-  glm::mat4 SpotLight::getLightViewProjectionMatrix() const
+  const glm::mat4& SpotLight::getLightViewProjectionMatrix() const
   {
+    if (m_lightViewProjectionMatrixRevision == m_shadowRevision)
+    {
+      return m_lightViewProjectionMatrix;
+    }
+
     const glm::vec3 up = std::abs(m_direction.y) > 0.99f
                          ? glm::vec3(1, 0, 0)
                          : glm::vec3(0, 1, 0);
@@ -73,31 +115,15 @@ namespace vke {
       glm::radians(fov),
       1.0f,
       0.1f,
-      100.0f
+      m_range
     );
 
     proj[1][1] *= -1;
 
-    return proj * view;
-  }
-
-  void SpotLight::createShadowMap(const vk::CommandPool commandPool)
-  {
-    if (!m_castsShadows)
-    {
-      return;
-    }
-
-    ImageResourceConfig imageResourceConfig {
-      .imageResourceType = ImageResourceType::Depth,
-      .logicalDevice = m_logicalDevice,
-      .extent = m_shadowMapExtent,
-      .commandPool = commandPool,
-      .depthFormat = vk::Format::eD32Sfloat,
-      .numSamples = vk::SampleCountFlagBits::e1
-    };
+    m_lightViewProjectionMatrix = proj * view;
+    m_lightViewProjectionMatrixRevision = m_shadowRevision;
 
-    m_shadowMapDepthImageResource = std::make_shared<ImageResource>(imageResourceConfig);
+    return m_lightViewProjectionMatrix;
   }
 
 } // vke
\ No newline at end of file
@@ -2,14 +2,14 @@
 #define VULKANPROJECT_SPOTLIGHT_H
 
 #include "Light.h"
+#include <optional>
 
 namespace vke {
 
   class SpotLight final : public Light {
   public:
     SpotLight(std::shared_ptr<LogicalDevice> logicalDevice,
-              const CommonLightData& commonLightData,
-              vk::CommandPool commandPool);
+              const CommonLightData& commonLightData);
 
     [[nodiscard]] glm::vec3 getDirection() const;
     [[nodiscard]] float getConeAngle() const;
@@ -19,15 +19,22 @@ namespace vke {
 
     [[nodiscard]] LightType getLightType() const override;
 
+    // Outside its cone the light only adds ambient, which is never shadowed, so only the cone is tested
+    [[nodiscard]] bool shadowsReachFrustum(const std::array<glm::vec4, 6>& frustumPlanes) const override;
+
     [[nodiscard]] LightUniform getUniform() const override;
 
-    [[nodiscard]] glm::mat4 getLightViewProjectionMatrix() const;
+    [[nodiscard]] SpotLightShadowUniform getShadowUniform() const;
+
+    // Cached until the light moves, turns or its cone or range changes
+    [[nodiscard]] const glm::mat4& getLightViewProjectionMatrix() const;
 
   private:
     glm::vec3 m_direction = glm::vec3(0, -1, 0);
     float m_coneAngle = 15;
 
-    void createShadowMap(vk::CommandPool commandPool) override;
+    mutable glm::mat4 m_lightViewProjectionMatrix{};
+    mutable std::optional<uint32_t> m_lightViewProjectionMatrixRevision;
   };
 
 } // vke
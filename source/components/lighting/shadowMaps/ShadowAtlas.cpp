@@ -0,0 +1,94 @@
+#include "ShadowAtlas.h"
+#include "../../logicalDevice/LogicalDevice.h"
+#include "../../physicalDevice/PhysicalDevice.h"
+#include "../../../utilities/Images.h"
+#include <algorithm>
+#include <bit>
+
+namespace {
+
+  // Widest the atlas grows to, room for 16 of the largest shadow maps
+  constexpr uint32_t MAX_ATLAS_SIZE = 8192;
+
+  constexpr uint32_t TILE_SIZE = vke::SHADOW_MAP_SIZES.back();
+
+  uint32_t getMaxSlotCount(const std::shared_ptr<vke::LogicalDevice>& logicalDevice)
+  {
+    const uint32_t maxImageSize = logicalDevice->getPhysicalDevice()->getDeviceProperties().limits.maxImageDimension2D;
+
+    const uint32_t tilesPerSide = std::bit_floor(std::min(MAX_ATLAS_SIZE, maxImageSize) / TILE_SIZE);
+
+    return tilesPerSide * tilesPerSide;
+  }
+
+  // Keeps every other bit, turning a Morton index into one of its coordinates
+  uint32_t compactBits(uint32_t value)
+  {
+    value &= 0x55555555;
+    value = (value | value >> 1) & 0x33333333;
+    value = (value | value >> 2) & 0x0F0F0F0F;
+    value = (value | value >> 4) & 0x00FF00FF;
+    value = (value | value >> 8) & 0x0000FFFF;
+
+    return value;
+  }
+
+}
+
+namespace vke {
+
+  ShadowAtlas::ShadowAtlas(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                           const vk::CommandPool commandPool)
+    : ShadowMapPool(logicalDevice, commandPool, getMaxSlotCount(logicalDevice))
+  {
+    reserve(1);
+  }
+
+  vk::Rect2D ShadowAtlas::getTileRect(const uint32_t firstSlot,
+                                      const uint32_t size)
+  {
+    // Slots follow a Morton curve, so a shadow map starting on a multiple of its slot count covers a square of them,
+    // and growing the atlas leaves existing slots where they were
+    return {
+      .offset = {
+        .x = static_cast<int32_t>(compactBits(firstSlot) * TILE_SIZE),
+        .y = static_cast<int32_t>(compactBits(firstSlot >> 1) * TILE_SIZE)
+      },
+      .extent = {
+        .width = size,
+        .height = size
+      }
+    };
+  }
+
+  uint32_t ShadowAtlas::getSlotCount(const uint32_t size)
+  {
+    const uint32_t tilesPerSide = size / TILE_SIZE;
+
+    return tilesPerSide * tilesPerSide;
+  }
+
+  void ShadowAtlas::createShadowMaps(const uint32_t capacity)
+  {
+    // A power of two number of tiles along a Morton curve fills a rectangle twice as wide as tall, or a square
+    const int tileBits = std::countr_zero(capacity);
+
+    m_extent = vk::Extent2D {
+      .width = TILE_SIZE << (tileBits + 1) / 2,
+      .height = TILE_SIZE << tileBits / 2
+    };
+
+    createImage(m_extent, 1, {});
+
+    m_imageView = Images::createImageView(
+      m_logicalDevice,
+      m_image,
+      vk::Format::eD32Sfloat,
+      vk::ImageAspectFlagBits::eDepth,
+      1,
+      vk::ImageViewType::e2D,
+      1
+    );
+  }
+
+} // namespace vke
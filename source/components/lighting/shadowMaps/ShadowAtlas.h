@@ -0,0 +1,27 @@
+#ifndef VKE_SHADOWATLAS_H
+#define VKE_SHADOWATLAS_H
+
+#include "ShadowMapPool.h"
+
+namespace vke {
+
+  // Spot light shadow maps tiled across one 2D image, each slot is a tile of the smallest size
+  class ShadowAtlas final : public ShadowMapPool {
+  public:
+    ShadowAtlas(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                vk::CommandPool commandPool);
+
+    // Area of the atlas covered by the shadow map of the given size starting at firstSlot
+    [[nodiscard]] static vk::Rect2D getTileRect(uint32_t firstSlot,
+                                                uint32_t size);
+
+    // Slots taken by a shadow map of the given size
+    [[nodiscard]] static uint32_t getSlotCount(uint32_t size);
+
+  private:
+    void createShadowMaps(uint32_t capacity) override;
+  };
+
+} // namespace vke
+
+#endif //VKE_SHADOWATLAS_H
@@ -0,0 +1,73 @@
+#include "ShadowCubeMapArray.h"
+#include "../../logicalDevice/LogicalDevice.h"
+#include "../../physicalDevice/PhysicalDevice.h"
+#include "../../../utilities/Images.h"
+#include <algorithm>
+
+namespace {
+
+  constexpr uint32_t CUBE_FACE_COUNT = 6;
+
+  // Memory each size of cube map array grows to at most, four of the largest cubes or sixteen of the next size
+  constexpr vk::DeviceSize MAX_ARRAY_MEMORY = 384ull * 1024 * 1024;
+
+  uint32_t getMaxSlotCount(const std::shared_ptr<vke::LogicalDevice>& logicalDevice,
+                           const uint32_t size)
+  {
+    const uint32_t maxLayers = logicalDevice->getPhysicalDevice()->getDeviceProperties().limits.maxImageArrayLayers;
+
+    const vk::DeviceSize cubeMemory = static_cast<vk::DeviceSize>(size) * size * sizeof(float) * CUBE_FACE_COUNT;
+
+    return static_cast<uint32_t>(std::min<vk::DeviceSize>(MAX_ARRAY_MEMORY / cubeMemory, maxLayers / CUBE_FACE_COUNT));
+  }
+
+}
+
+namespace vke {
+
+  ShadowCubeMapArray::ShadowCubeMapArray(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                                         const vk::CommandPool commandPool,
+                                         const uint32_t size)
+    : ShadowMapPool(logicalDevice, commandPool, getMaxSlotCount(logicalDevice, size)), m_size(size)
+  {}
+
+  vk::ImageView ShadowCubeMapArray::getSlotImageView(const uint32_t slot) const
+  {
+    return m_slotImageViews[slot];
+  }
+
+  void ShadowCubeMapArray::createShadowMaps(const uint32_t capacity)
+  {
+    m_extent = vk::Extent2D {
+      .width = m_size,
+      .height = m_size
+    };
+
+    createImage(m_extent, capacity * CUBE_FACE_COUNT, vk::ImageCreateFlagBits::eCubeCompatible);
+
+    m_imageView = Images::createImageView(
+      m_logicalDevice,
+      m_image,
+      vk::Format::eD32Sfloat,
+      vk::ImageAspectFlagBits::eDepth,
+      1,
+      vk::ImageViewType::eCubeArray,
+      capacity * CUBE_FACE_COUNT
+    );
+
+    for (uint32_t slot = 0; slot < capacity; ++slot)
+    {
+      m_slotImageViews.push_back(Images::createImageView(
+        m_logicalDevice,
+        m_image,
+        vk::Format::eD32Sfloat,
+        vk::ImageAspectFlagBits::eDepth,
+        1,
+        vk::ImageViewType::e2DArray,
+        CUBE_FACE_COUNT,
+        slot * CUBE_FACE_COUNT
+      ));
+    }
+  }
+
+} // namespace vke
@@ -0,0 +1,27 @@
+#ifndef VKE_SHADOWCUBEMAPARRAY_H
+#define VKE_SHADOWCUBEMAPARRAY_H
+
+#include "ShadowMapPool.h"
+
+namespace vke {
+
+  // Point light shadow maps of one size as the cubes of one cube map array, each slot is a cube
+  class ShadowCubeMapArray final : public ShadowMapPool {
+  public:
+    // The image is only created by the first reserve
+    ShadowCubeMapArray(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                       vk::CommandPool commandPool,
+                       uint32_t size);
+
+    // The slot's six faces, rendered together with multiview
+    [[nodiscard]] vk::ImageView getSlotImageView(uint32_t slot) const;
+
+  private:
+    uint32_t m_size;
+
+    void createShadowMaps(uint32_t capacity) override;
+  };
+
+} // namespace vke
+
+#endif //VKE_SHADOWCUBEMAPARRAY_H
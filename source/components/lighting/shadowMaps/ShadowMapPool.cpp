@@ -0,0 +1,140 @@
+#include "ShadowMapPool.h"
+#include "../lights/Light.h"
+#include "../../commandBuffer/SingleUseCommandBuffer.h"
+#include "../../logicalDevice/LogicalDevice.h"
+#include "../../../utilities/Images.h"
+#include <algorithm>
+#include <bit>
+#include <span>
+#include <stdexcept>
+
+namespace vke {
+
+  ShadowMapPool::ShadowMapPool(std::shared_ptr<LogicalDevice> logicalDevice,
+                               const vk::CommandPool commandPool,
+                               const uint32_t maxSlotCount)
+    : m_logicalDevice(std::move(logicalDevice)), m_commandPool(commandPool), m_maxSlotCount(maxSlotCount)
+  {}
+
+  ShadowMapPool::~ShadowMapPool()
+  {
+    retireShadowMaps();
+  }
+
+  uint32_t ShadowMapPool::getMaxSlotCount() const
+  {
+    return m_maxSlotCount;
+  }
+
+  bool ShadowMapPool::reserve(const uint32_t slotCount)
+  {
+    if (slotCount <= m_capacity)
+    {
+      return false;
+    }
+
+    if (slotCount > m_maxSlotCount)
+    {
+      throw std::runtime_error("shadow map pool is too small for the requested slots!");
+    }
+
+    retireShadowMaps();
+
+    m_capacity = std::min(std::bit_ceil(slotCount), m_maxSlotCount);
+
+    createShadowMaps(m_capacity);
+
+    m_slotStates.assign(m_capacity, {});
+
+    return true;
+  }
+
+  bool ShadowMapPool::updateSlots(const uint32_t firstSlot,
+                                  const uint32_t slotCount,
+                                  const std::shared_ptr<Light>& light,
+                                  const size_t casterSignature)
+  {
+    const auto slotStates = std::span(m_slotStates).subspan(firstSlot, slotCount);
+
+    // Every slot is checked, another light may have drawn over part of them since
+    const bool cached = std::ranges::all_of(slotStates, [&light, casterSignature](const ShadowMapState& slotState) {
+      return slotState.light.lock() == light &&
+             slotState.lightRevision == light->getShadowRevision() &&
+             slotState.casterSignature == casterSignature;
+    });
+
+    if (cached)
+    {
+      return false;
+    }
+
+    std::ranges::fill(slotStates, ShadowMapState {
+      .light = light,
+      .lightRevision = light->getShadowRevision(),
+      .casterSignature = casterSignature
+    });
+
+    return true;
+  }
+
+  vk::ImageView ShadowMapPool::getImageView() const
+  {
+    return m_imageView;
+  }
+
+  vk::Extent2D ShadowMapPool::getExtent() const
+  {
+    return m_extent;
+  }
+
+  void ShadowMapPool::createImage(const vk::Extent2D extent,
+                                  const uint32_t layerCount,
+                                  const vk::ImageCreateFlags flags)
+  {
+    auto [image, imageMemory] = Images::createImage(
+      m_logicalDevice,
+      {
+        .flags = flags,
+        .extent = {
+          .width = extent.width,
+          .height = extent.height,
+          .depth = 1
+        },
+        .mipLevels = 1,
+        .numSamples = vk::SampleCountFlagBits::e1,
+        .format = vk::Format::eD32Sfloat,
+        .tiling = vk::ImageTiling::eOptimal,
+        .usage = vk::ImageUsageFlagBits::eDepthStencilAttachment | vk::ImageUsageFlagBits::eSampled,
+        .imageType = vk::ImageType::e2D,
+        .layerCount = layerCount,
+        .properties = vk::MemoryPropertyFlagBits::eDeviceLocal
+      }
+    );
+
+    m_image = std::move(image);
+    m_imageMemory = std::move(imageMemory);
+
+    const SingleUseCommandBuffer commandBuffer(m_logicalDevice, m_commandPool, m_logicalDevice->getGraphicsQueue());
+
+    commandBuffer.record([&] {
+      Images::transitionImageLayout(
+        commandBuffer,
+        m_image,
+        vk::Format::eD32Sfloat,
+        vk::ImageLayout::eUndefined,
+        vk::ImageLayout::eDepthStencilAttachmentOptimal,
+        1,
+        layerCount
+      );
+    });
+  }
+
+  void ShadowMapPool::retireShadowMaps()
+  {
+    // Frames still in flight may be sampling the old image
+    m_logicalDevice->retire(std::move(m_slotImageViews), std::move(m_imageView), std::move(m_image), std::move(m_imageMemory));
+
+    m_slotImageViews.clear();
+  }
+
+} // namespace vke
@@ -0,0 +1,96 @@
+#ifndef VKE_SHADOWMAPPOOL_H
+#define VKE_SHADOWMAPPOOL_H
+
+#include "../../memory/MemoryAllocation.h"
+#include <vulkan/vulkan_raii.hpp>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace vke {
+
+  class Light;
+  class LogicalDevice;
+
+  // Width and height of the shadow maps of each tier, lights covering less of the screen are given the smaller ones
+  constexpr std::array<uint32_t, 4> SHADOW_MAP_SIZES {
+    2048,
+    1024,
+    512,
+    256
+  };
+
+  constexpr uint32_t SHADOW_MAP_TIER_COUNT = SHADOW_MAP_SIZES.size();
+
+  // Lights without a slot this frame are lit without shadows
+  constexpr uint32_t NO_SHADOW_MAP_SLOT = std::numeric_limits<uint32_t>::max();
+
+  // What a slot was last rendered from, the light, its placement and the casters it saw
+  struct ShadowMapState {
+    std::weak_ptr<Light> light;
+    uint32_t lightRevision = 0;
+    size_t casterSignature = 0;
+  };
+
+  // One depth image holding the shadow maps of the shadowed lights rendered this frame, each is handed slots of it
+  class ShadowMapPool {
+  public:
+    ShadowMapPool(std::shared_ptr<LogicalDevice> logicalDevice,
+                  vk::CommandPool commandPool,
+                  uint32_t maxSlotCount);
+
+    virtual ~ShadowMapPool();
+
+    [[nodiscard]] uint32_t getMaxSlotCount() const;
+
+    // Grows the image, by doubling, to hold slotCount slots, discarding every shadow map already rendered when it does,
+    // returns whether it did and so replaced the image's views
+    bool reserve(uint32_t slotCount);
+
+    // Records what is about to be rendered into the slots, returns false when they already hold it
+    [[nodiscard]] bool updateSlots(uint32_t firstSlot,
+                                   uint32_t slotCount,
+                                   const std::shared_ptr<Light>& light,
+                                   size_t casterSignature);
+
+    // The view lighting samples every slot through, null until the first reserve
+    [[nodiscard]] vk::ImageView getImageView() const;
+
+    [[nodiscard]] vk::Extent2D getExtent() const;
+
+  protected:
+    std::shared_ptr<LogicalDevice> m_logicalDevice;
+
+    vk::CommandPool m_commandPool;
+
+    vk::raii::Image m_image = nullptr;
+    MemoryAllocation m_imageMemory = nullptr;
+    vk::raii::ImageView m_imageView = nullptr;
+
+    // One view per slot, left empty by pools whose slots share the sampled view
+    std::vector<vk::raii::ImageView> m_slotImageViews;
+
+    vk::Extent2D m_extent;
+
+    // Creates the image, its views and sets m_extent for capacity slots
+    virtual void createShadowMaps(uint32_t capacity) = 0;
+
+    void createImage(vk::Extent2D extent,
+                     uint32_t layerCount,
+                     vk::ImageCreateFlags flags);
+
+  private:
+    uint32_t m_maxSlotCount;
+
+    uint32_t m_capacity = 0;
+
+    std::vector<ShadowMapState> m_slotStates;
+
+    void retireShadowMaps();
+  };
+
+} // namespace vke
+
+#endif //VKE_SHADOWMAPPOOL_H
@@ -0,0 +1,16 @@
+#include "DeletionQueue.h"
+
+namespace vke {
+
+  void DeletionQueue::collect(const uint64_t completedGraphicsTimelineValue,
+                              const uint64_t completedComputeTimelineValue)
+  {
+    while (!m_retiredObjects.empty() &&
+           m_retiredObjects.front().graphicsTimelineValue <= completedGraphicsTimelineValue &&
+           m_retiredObjects.front().computeTimelineValue <= completedComputeTimelineValue)
+    {
+      m_retiredObjects.pop_front();
+    }
+  }
+
+} // namespace vke
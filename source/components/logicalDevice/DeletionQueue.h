@@ -0,0 +1,46 @@
+#ifndef VKE_DELETIONQUEUE_H
+#define VKE_DELETIONQUEUE_H
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace vke {
+
+  // Holds objects the GPU may still be using until the submissions that could reference them have completed
+  class DeletionQueue {
+  public:
+    template<typename... Objects>
+    void push(const uint64_t graphicsTimelineValue,
+              const uint64_t computeTimelineValue,
+              Objects&&... objects)
+    {
+      m_retiredObjects.push_back({
+        .graphicsTimelineValue = graphicsTimelineValue,
+        .computeTimelineValue = computeTimelineValue,
+        .objects = std::make_shared<std::tuple<std::decay_t<Objects>...>>(std::forward<Objects>(objects)...)
+      });
+    }
+
+    void collect(uint64_t completedGraphicsTimelineValue,
+                 uint64_t completedComputeTimelineValue);
+
+  private:
+    struct RetiredObjects {
+      uint64_t graphicsTimelineValue;
+      uint64_t computeTimelineValue;
+
+      // Type erased so any mix of RAII handles, allocations and containers of them can be retired together
+      std::shared_ptr<void> objects;
+    };
+
+    // Timeline values only grow, so entries complete in the order they were pushed
+    std::deque<RetiredObjects> m_retiredObjects;
+  };
+
+} // namespace vke
+
+#endif //VKE_DELETIONQUEUE_H
@@ -1,29 +1,62 @@
 #include "LogicalDevice.h"
 #include "../instance/Instance.h"
+#include "../memory/MemoryAllocator.h"
 #include "../physicalDevice/PhysicalDevice.h"
+#include "../profiler/CpuProfiler.h"
+#include <algorithm>
 #include <array>
 #include <set>
+#include <stdexcept>
+#include <string>
 
 namespace vke {
 
-  LogicalDevice::LogicalDevice(const std::shared_ptr<PhysicalDevice>& physicalDevice)
-    : m_physicalDevice(physicalDevice)
+  constexpr uint32_t MIN_FRAMES_IN_FLIGHT = 1;
+  constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 4;
+
+  LogicalDevice::LogicalDevice(const std::shared_ptr<PhysicalDevice>& physicalDevice,
+                               const uint32_t maxFramesInFlight)
+    : m_physicalDevice(physicalDevice), m_maxFramesInFlight(maxFramesInFlight)
   {
+    if (m_maxFramesInFlight < MIN_FRAMES_IN_FLIGHT || m_maxFramesInFlight > MAX_FRAMES_IN_FLIGHT)
+    {
+      throw std::runtime_error("frames in flight must be between " + std::to_string(MIN_FRAMES_IN_FLIGHT) +
+                               " and " + std::to_string(MAX_FRAMES_IN_FLIGHT) + "!");
+    }
+
     createDevice();
 
+    m_memoryAllocator = std::make_unique<MemoryAllocator>(*this, m_physicalDevice);
+
     createSyncObjects();
   }
 
+  LogicalDevice::~LogicalDevice() = default;
+
   std::shared_ptr<PhysicalDevice> LogicalDevice::getPhysicalDevice() const
   {
     return m_physicalDevice;
   }
 
+  MemoryAllocator& LogicalDevice::getMemoryAllocator() const
+  {
+    return *m_memoryAllocator;
+  }
+
   void LogicalDevice::waitIdle() const
   {
+    VKE_PROFILE_ZONE("LogicalDevice::waitIdle");
+
     m_device.waitIdle();
   }
 
+  void LogicalDevice::collectRetiredObjects()
+  {
+    VKE_PROFILE_ZONE("LogicalDevice::collectRetiredObjects");
+
+    m_deletionQueue.collect(m_graphicsTimelineSemaphore.getCounterValue(), m_computeTimelineSemaphore.getCounterValue());
+  }
+
   vk::Queue LogicalDevice::getGraphicsQueue() const
   {
     return *m_graphicsQueue;
@@ -39,111 +72,225 @@ namespace vke {
     return *m_computeQueue;
   }
 
+  vk::Queue LogicalDevice::getTransferQueue() const
+  {
+    return hasDedicatedTransferQueue() ? *m_transferQueue : *m_graphicsQueue;
+  }
+
+  bool LogicalDevice::hasDedicatedTransferQueue() const
+  {
+    return m_physicalDevice->getQueueFamilies().transferFamily.has_value();
+  }
+
   void LogicalDevice::submitOffscreenCommandBuffer(const uint32_t currentFrame,
-                                                   const vk::CommandBuffer commandBuffer) const
+                                                   const vk::CommandBuffer commandBuffer)
   {
     constexpr vk::PipelineStageFlags waitStages[] = {
-      vk::PipelineStageFlagBits::eVertexInput,
-      vk::PipelineStageFlagBits::eColorAttachmentOutput
+      vk::PipelineStageFlagBits::eVertexInput | vk::PipelineStageFlagBits::eColorAttachmentOutput
+    };
+
+    const uint64_t waitValue = m_computeFrameTimelineValues[currentFrame];
+    const uint64_t signalValue = ++m_graphicsTimelineValue;
+
+    const vk::TimelineSemaphoreSubmitInfo timelineSemaphoreSubmitInfo {
+      .waitSemaphoreValueCount = 1,
+      .pWaitSemaphoreValues = &waitValue,
+      .signalSemaphoreValueCount = 1,
+      .pSignalSemaphoreValues = &signalValue
     };
 
     const vk::SubmitInfo submitInfo {
+      .pNext = &timelineSemaphoreSubmitInfo,
       .waitSemaphoreCount = 1,
-      .pWaitSemaphores = &*m_computeFinishedSemaphores[currentFrame],
+      .pWaitSemaphores = &*m_computeTimelineSemaphore,
       .pWaitDstStageMask = waitStages,
       .commandBufferCount = 1,
       .pCommandBuffers = &commandBuffer,
       .signalSemaphoreCount = 1,
-      .pSignalSemaphores = &*m_offscreenRenderFinishedSemaphores[currentFrame]
+      .pSignalSemaphores = &*m_graphicsTimelineSemaphore
     };
 
-    m_graphicsQueue.submit(submitInfo, m_offscreenInFlightFences[currentFrame]);
+    m_graphicsQueue.submit(submitInfo);
+
+    m_offscreenFrameTimelineValues[currentFrame] = signalValue;
+    m_graphicsFrameTimelineValues[currentFrame] = signalValue;
   }
 
   void LogicalDevice::submitSwapchainCommandBuffer(const uint32_t currentFrame,
-                                                   const vk::CommandBuffer commandBuffer) const
+                                                   const vk::CommandBuffer commandBuffer)
   {
-    constexpr vk::PipelineStageFlags waitStages[] = {
-      vk::PipelineStageFlagBits::eVertexInput,
-      vk::PipelineStageFlagBits::eColorAttachmentOutput
+    const std::array waitSemaphores = {
+      *m_imageAvailableSemaphores[currentFrame],
+      *m_graphicsTimelineSemaphore
+    };
+
+    constexpr std::array<vk::PipelineStageFlags, 2> waitStages = {
+      vk::PipelineStageFlagBits::eColorAttachmentOutput,
+      vk::PipelineStageFlagBits::eFragmentShader
+    };
+
+    // Binary semaphore values are ignored, the offscreen value makes the scene image safe to sample
+    const std::array<uint64_t, 2> waitValues = {
+      0,
+      m_offscreenFrameTimelineValues[currentFrame]
+    };
+
+    const std::array signalSemaphores = {
+      *m_renderFinishedSemaphores[currentFrame],
+      *m_graphicsTimelineSemaphore
+    };
+
+    const std::array<uint64_t, 2> signalValues = {
+      0,
+      ++m_graphicsTimelineValue
+    };
+
+    const vk::TimelineSemaphoreSubmitInfo timelineSemaphoreSubmitInfo {
+      .waitSemaphoreValueCount = static_cast<uint32_t>(waitValues.size()),
+      .pWaitSemaphoreValues = waitValues.data(),
+      .signalSemaphoreValueCount = static_cast<uint32_t>(signalValues.size()),
+      .pSignalSemaphoreValues = signalValues.data()
     };
 
     const vk::SubmitInfo submitInfo {
-      .waitSemaphoreCount = 1,
-      .pWaitSemaphores = &*m_imageAvailableSemaphores[currentFrame],
-      .pWaitDstStageMask = waitStages,
+      .pNext = &timelineSemaphoreSubmitInfo,
+      .waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores.size()),
+      .pWaitSemaphores = waitSemaphores.data(),
+      .pWaitDstStageMask = waitStages.data(),
       .commandBufferCount = 1,
       .pCommandBuffers = &commandBuffer,
-      .signalSemaphoreCount = 1,
-      .pSignalSemaphores = &*m_renderFinishedSemaphores[currentFrame]
+      .signalSemaphoreCount = static_cast<uint32_t>(signalSemaphores.size()),
+      .pSignalSemaphores = signalSemaphores.data()
     };
 
-    m_graphicsQueue.submit(submitInfo, m_inFlightFences[currentFrame]);
+    m_graphicsQueue.submit(submitInfo);
+
+    m_graphicsFrameTimelineValues[currentFrame] = m_graphicsTimelineValue;
   }
 
   void LogicalDevice::submitComputeCommandBuffer(const uint32_t currentFrame,
-                                                 const vk::CommandBuffer commandBuffer) const
+                                                 const vk::CommandBuffer commandBuffer)
   {
+    constexpr vk::PipelineStageFlags waitStage = vk::PipelineStageFlagBits::eComputeShader;
+
+    // The graphics work that last read this frame's particle buffers must be done before they are overwritten,
+    // and uploads recorded on the graphics queue must land before compute reads them
+    const uint64_t waitValue = std::max(m_graphicsFrameTimelineValues[currentFrame], m_uploadTimelineValue);
+    const uint64_t signalValue = ++m_computeTimelineValue;
+
+    const vk::TimelineSemaphoreSubmitInfo timelineSemaphoreSubmitInfo {
+      .waitSemaphoreValueCount = 1,
+      .pWaitSemaphoreValues = &waitValue,
+      .signalSemaphoreValueCount = 1,
+      .pSignalSemaphoreValues = &signalValue
+    };
+
     const vk::SubmitInfo submitInfo {
+      .pNext = &timelineSemaphoreSubmitInfo,
+      .waitSemaphoreCount = 1,
+      .pWaitSemaphores = &*m_graphicsTimelineSemaphore,
+      .pWaitDstStageMask = &waitStage,
       .commandBufferCount = 1,
       .pCommandBuffers = &commandBuffer,
       .signalSemaphoreCount = 1,
-      .pSignalSemaphores = &*m_computeFinishedSemaphores[currentFrame]
+      .pSignalSemaphores = &*m_computeTimelineSemaphore
     };
 
-    m_computeQueue.submit(submitInfo, m_computeInFlightFences[currentFrame]);
+    m_computeQueue.submit(submitInfo);
+
+    m_computeFrameTimelineValues[currentFrame] = signalValue;
   }
 
-  void LogicalDevice::waitForOffscreenFence(const uint32_t currentFrame) const
+  uint64_t LogicalDevice::submitTransferCommandBuffer(const vk::CommandBuffer commandBuffer)
   {
-    const auto result = m_device.waitForFences(*m_offscreenInFlightFences[currentFrame], vk::True, UINT64_MAX);
-    assert(result == vk::Result::eSuccess);
+    if (!hasDedicatedTransferQueue())
+    {
+      throw std::runtime_error("device has no dedicated transfer queue!");
+    }
+
+    const uint64_t signalValue = ++m_transferTimelineValue;
+
+    const vk::TimelineSemaphoreSubmitInfo timelineSemaphoreSubmitInfo {
+      .signalSemaphoreValueCount = 1,
+      .pSignalSemaphoreValues = &signalValue
+    };
+
+    const vk::SubmitInfo submitInfo {
+      .pNext = &timelineSemaphoreSubmitInfo,
+      .commandBufferCount = 1,
+      .pCommandBuffers = &commandBuffer,
+      .signalSemaphoreCount = 1,
+      .pSignalSemaphores = &*m_transferTimelineSemaphore
+    };
+
+    m_transferQueue.submit(submitInfo);
+
+    return signalValue;
   }
 
-  void LogicalDevice::waitForGraphicsFences(const uint32_t currentFrame) const
+  uint64_t LogicalDevice::submitUploadCommandBuffers(const std::vector<vk::CommandBuffer>& commandBuffers,
+                                                     const uint64_t transferWaitValue)
   {
-    const std::array fences = {
-      *m_inFlightFences[currentFrame],
-      *m_offscreenInFlightFences[currentFrame]
+    constexpr vk::PipelineStageFlags waitStage = vk::PipelineStageFlagBits::eAllCommands;
+
+    const uint64_t signalValue = ++m_graphicsTimelineValue;
+
+    // Batches without transfer queue work pass zero and skip the wait
+    const uint32_t waitSemaphoreCount = transferWaitValue > 0 ? 1 : 0;
+
+    const vk::TimelineSemaphoreSubmitInfo timelineSemaphoreSubmitInfo {
+      .waitSemaphoreValueCount = waitSemaphoreCount,
+      .pWaitSemaphoreValues = &transferWaitValue,
+      .signalSemaphoreValueCount = 1,
+      .pSignalSemaphoreValues = &signalValue
     };
 
-    const auto result = m_device.waitForFences(fences, vk::True, UINT64_MAX);
-    assert(result == vk::Result::eSuccess);
+    const vk::SubmitInfo submitInfo {
+      .pNext = &timelineSemaphoreSubmitInfo,
+      .waitSemaphoreCount = waitSemaphoreCount,
+      .pWaitSemaphores = &*m_transferTimelineSemaphore,
+      .pWaitDstStageMask = &waitStage,
+      .commandBufferCount = static_cast<uint32_t>(commandBuffers.size()),
+      .pCommandBuffers = commandBuffers.data(),
+      .signalSemaphoreCount = 1,
+      .pSignalSemaphores = &*m_graphicsTimelineSemaphore
+    };
+
+    m_graphicsQueue.submit(submitInfo);
+
+    m_uploadTimelineValue = signalValue;
+
+    return signalValue;
   }
 
-  void LogicalDevice::waitForComputeFences(const uint32_t currentFrame) const
+  void LogicalDevice::waitForGraphicsFrame(const uint32_t currentFrame) const
   {
-    const auto result = m_device.waitForFences(*m_computeInFlightFences[currentFrame], vk::True, UINT64_MAX);
-    assert(result == vk::Result::eSuccess);
+    VKE_PROFILE_ZONE("LogicalDevice::waitForGraphicsFrame");
+
+    waitForTimelineValue(m_graphicsTimelineSemaphore, m_graphicsFrameTimelineValues[currentFrame]);
   }
 
-  void LogicalDevice::resetGraphicsFences(const uint32_t currentFrame) const
+  void LogicalDevice::waitForComputeFrame(const uint32_t currentFrame) const
   {
-    const std::array fences = {
-      *m_inFlightFences[currentFrame],
-      *m_offscreenInFlightFences[currentFrame]
-    };
+    VKE_PROFILE_ZONE("LogicalDevice::waitForComputeFrame");
 
-    m_device.resetFences(fences);
+    waitForTimelineValue(m_computeTimelineSemaphore, m_computeFrameTimelineValues[currentFrame]);
   }
 
-  void LogicalDevice::resetComputeFences(const uint32_t currentFrame) const
+  void LogicalDevice::waitForGraphicsTimelineValue(const uint64_t value) const
   {
-    m_device.resetFences(*m_computeInFlightFences[currentFrame]);
+    VKE_PROFILE_ZONE("LogicalDevice::waitForGraphicsTimelineValue");
+
+    waitForTimelineValue(m_graphicsTimelineSemaphore, value);
   }
 
   vk::Result LogicalDevice::queuePresent(const uint32_t currentFrame,
                                          const vk::SwapchainKHR swapchain,
                                          const uint32_t* imageIndex) const
   {
-    const std::array waitSemaphores = {
-      *m_renderFinishedSemaphores[currentFrame],
-      *m_offscreenRenderFinishedSemaphores[currentFrame]
-    };
-
     const vk::PresentInfoKHR presentInfo {
-      .waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores.size()),
-      .pWaitSemaphores = waitSemaphores.data(),
+      .waitSemaphoreCount = 1,
+      .pWaitSemaphores = &*m_renderFinishedSemaphores[currentFrame],
       .swapchainCount = 1,
       .pSwapchains = &swapchain,
       .pImageIndices = imageIndex,
@@ -176,6 +323,16 @@ namespace vke {
     return m_maxFramesInFlight;
   }
 
+  uint64_t LogicalDevice::getSubmittedGraphicsTimelineValue() const
+  {
+    return m_graphicsTimelineValue;
+  }
+
+  uint64_t LogicalDevice::getCompletedGraphicsTimelineValue() const
+  {
+    return m_graphicsTimelineSemaphore.getCounterValue();
+  }
+
   vk::raii::CommandPool LogicalDevice::createCommandPool(const vk::CommandPoolCreateInfo& commandPoolCreateInfo) const
   {
     return m_device.createCommandPool(commandPoolCreateInfo);
@@ -207,6 +364,11 @@ namespace vke {
     return m_device.createSampler(samplerCreateInfo);
   }
 
+  vk::raii::QueryPool LogicalDevice::createQueryPool(const vk::QueryPoolCreateInfo& queryPoolCreateInfo) const
+  {
+    return m_device.createQueryPool(queryPoolCreateInfo);
+  }
+
   vk::raii::ImageView LogicalDevice::createImageView(const vk::ImageViewCreateInfo& imageViewCreateInfo) const
   {
     return m_device.createImageView(imageViewCreateInfo);
@@ -304,10 +466,19 @@ namespace vke {
 
     std::vector<vk::DeviceQueueCreateInfo> queueCreateInfos;
     std::set uniqueQueueFamilies = {
-      queueFamilyIndices.graphicsFamily.value(),
-      queueFamilyIndices.presentFamily.value()
+      queueFamilyIndices.graphicsFamily.value()
     };
 
+    if (queueFamilyIndices.presentFamily.has_value())
+    {
+      uniqueQueueFamilies.insert(queueFamilyIndices.presentFamily.value());
+    }
+
+    if (queueFamilyIndices.transferFamily.has_value())
+    {
+      uniqueQueueFamilies.insert(queueFamilyIndices.transferFamily.value());
+    }
+
     float queuePriority = 1.0f;
     for (uint32_t queueFamily : uniqueQueueFamilies)
     {
@@ -340,6 +511,8 @@ namespace vke {
       .descriptorBindingPartiallyBound = vk::True,
       .descriptorBindingVariableDescriptorCount = getPhysicalDevice()->supportsRayTracing() ? vk::True : vk::False,
       .runtimeDescriptorArray = vk::True,
+      .hostQueryReset = vk::True,
+      .timelineSemaphore = vk::True,
       .bufferDeviceAddress = getPhysicalDevice()->supportsRayTracing() ? vk::True : vk::False
     };
 
@@ -351,18 +524,15 @@ namespace vke {
     vk::PhysicalDeviceFeatures2 deviceFeatures2 {
       .pNext = &vulkan11Features,
       .features {
+        .imageCubeArray = vk::True,
         .geometryShader = vk::True,
         .fillModeNonSolid = vk::True,
-        .samplerAnisotropy = vk::True
+        .samplerAnisotropy = vk::True,
+        .pipelineStatisticsQuery = getPhysicalDevice()->supportsPipelineStatistics() ? vk::True : vk::False
       }
     };
 
-    auto extensions = std::vector(deviceExtensions.begin(), deviceExtensions.end());
-
-    if (m_physicalDevice->supportsRayTracing())
-    {
-      extensions.insert(extensions.end(), rayTracingDeviceExtensions.begin(), rayTracingDeviceExtensions.end());
-    }
+    const auto extensions = m_physicalDevice->getDeviceExtensions();
 
     const vk::DeviceCreateInfo createInfo {
       .pNext = &deviceFeatures2,
@@ -377,25 +547,22 @@ namespace vke {
 
     m_computeQueue = m_device.getQueue(queueFamilyIndices.computeFamily.value(), 0);
     m_graphicsQueue = m_device.getQueue(queueFamilyIndices.graphicsFamily.value(), 0);
-    m_presentQueue = m_device.getQueue(queueFamilyIndices.presentFamily.value(), 0);
+
+    if (queueFamilyIndices.transferFamily.has_value())
+    {
+      m_transferQueue = m_device.getQueue(queueFamilyIndices.transferFamily.value(), 0);
+    }
+
+    if (queueFamilyIndices.presentFamily.has_value())
+    {
+      m_presentQueue = m_device.getQueue(queueFamilyIndices.presentFamily.value(), 0);
+    }
   }
 
   void LogicalDevice::createSyncObjects()
   {
     m_imageAvailableSemaphores.reserve(m_maxFramesInFlight);
-
     m_renderFinishedSemaphores.reserve(m_maxFramesInFlight);
-    m_offscreenRenderFinishedSemaphores.reserve(m_maxFramesInFlight);
-
-    m_computeFinishedSemaphores.reserve(m_maxFramesInFlight);
-
-    m_inFlightFences.reserve(m_maxFramesInFlight);
-    m_offscreenInFlightFences.reserve(m_maxFramesInFlight);
-    m_computeInFlightFences.reserve(m_maxFramesInFlight);
-
-    constexpr vk::FenceCreateInfo fenceInfo {
-      .flags = vk::FenceCreateFlagBits::eSignaled
-    };
 
     for (size_t i = 0; i < m_maxFramesInFlight; i++)
     {
@@ -403,12 +570,41 @@ namespace vke {
 
       m_imageAvailableSemaphores.emplace_back(m_device.createSemaphore(semaphoreInfo));
       m_renderFinishedSemaphores.emplace_back(m_device.createSemaphore(semaphoreInfo));
-      m_offscreenRenderFinishedSemaphores.emplace_back(m_device.createSemaphore(semaphoreInfo));
-      m_inFlightFences.emplace_back(m_device.createFence(fenceInfo));
-      m_offscreenInFlightFences.emplace_back(m_device.createFence(fenceInfo));
-
-      m_computeFinishedSemaphores.emplace_back(m_device.createSemaphore(semaphoreInfo));
-      m_computeInFlightFences.emplace_back(m_device.createFence(fenceInfo));
     }
+
+    m_graphicsTimelineSemaphore = createTimelineSemaphore();
+    m_computeTimelineSemaphore = createTimelineSemaphore();
+    m_transferTimelineSemaphore = createTimelineSemaphore();
+
+    m_offscreenFrameTimelineValues.resize(m_maxFramesInFlight, 0);
+    m_graphicsFrameTimelineValues.resize(m_maxFramesInFlight, 0);
+    m_computeFrameTimelineValues.resize(m_maxFramesInFlight, 0);
+  }
+
+  vk::raii::Semaphore LogicalDevice::createTimelineSemaphore() const
+  {
+    constexpr vk::SemaphoreTypeCreateInfo semaphoreTypeInfo {
+      .semaphoreType = vk::SemaphoreType::eTimeline,
+      .initialValue = 0
+    };
+
+    const vk::SemaphoreCreateInfo semaphoreInfo {
+      .pNext = &semaphoreTypeInfo
+    };
+
+    return m_device.createSemaphore(semaphoreInfo);
+  }
+
+  void LogicalDevice::waitForTimelineValue(const vk::raii::Semaphore& timelineSemaphore,
+                                           const uint64_t value) const
+  {
+    const vk::SemaphoreWaitInfo semaphoreWaitInfo {
+      .semaphoreCount = 1,
+      .pSemaphores = &*timelineSemaphore,
+      .pValues = &value
+    };
+
+    const auto result = m_device.waitSemaphores(semaphoreWaitInfo, UINT64_MAX);
+    assert(result == vk::Result::eSuccess);
   }
 } // namespace vke
\ No newline at end of file
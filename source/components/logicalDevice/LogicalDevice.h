@@ -1,42 +1,67 @@
 #ifndef VKE_LOGICALDEVICE_H
 #define VKE_LOGICALDEVICE_H
 
+#include "DeletionQueue.h"
 #include <vulkan/vulkan_raii.hpp>
 #include <memory>
 #include <vector>
 
 namespace vke {
 
+  class MemoryAllocator;
   class PhysicalDevice;
 
   class LogicalDevice {
   public:
-    explicit LogicalDevice(const std::shared_ptr<PhysicalDevice>& physicalDevice);
+    LogicalDevice(const std::shared_ptr<PhysicalDevice>& physicalDevice,
+                  uint32_t maxFramesInFlight);
+
+    ~LogicalDevice();
 
     [[nodiscard]] std::shared_ptr<PhysicalDevice> getPhysicalDevice() const;
 
+    [[nodiscard]] MemoryAllocator& getMemoryAllocator() const;
+
     void waitIdle() const;
 
+    // Destroys the objects once every graphics and compute submission made so far has completed
+    template<typename... Objects>
+    void retire(Objects&&... objects)
+    {
+      m_deletionQueue.push(m_graphicsTimelineValue, m_computeTimelineValue, std::forward<Objects>(objects)...);
+    }
+
+    void collectRetiredObjects();
+
     [[nodiscard]] vk::Queue getGraphicsQueue() const;
     [[nodiscard]] vk::Queue getPresentQueue() const;
     [[nodiscard]] vk::Queue getComputeQueue() const;
 
+    // The graphics queue when the device has no dedicated transfer family
+    [[nodiscard]] vk::Queue getTransferQueue() const;
+
+    [[nodiscard]] bool hasDedicatedTransferQueue() const;
+
     void submitOffscreenCommandBuffer(uint32_t currentFrame,
-                                      vk::CommandBuffer commandBuffer) const;
+                                      vk::CommandBuffer commandBuffer);
 
     void submitSwapchainCommandBuffer(uint32_t currentFrame,
-                                      vk::CommandBuffer commandBuffer) const;
+                                      vk::CommandBuffer commandBuffer);
 
     void submitComputeCommandBuffer(uint32_t currentFrame,
-                                    vk::CommandBuffer commandBuffer) const;
+                                    vk::CommandBuffer commandBuffer);
+
+    // Submits on the dedicated transfer queue, returning the transfer timeline value signaled once the copies complete
+    [[nodiscard]] uint64_t submitTransferCommandBuffer(vk::CommandBuffer commandBuffer);
 
-    void waitForOffscreenFence(uint32_t currentFrame) const;
+    // Submits on the graphics queue after transferWaitValue, returning the graphics timeline value signaled once the uploads complete
+    [[nodiscard]] uint64_t submitUploadCommandBuffers(const std::vector<vk::CommandBuffer>& commandBuffers,
+                                                      uint64_t transferWaitValue = 0);
 
-    void waitForGraphicsFences(uint32_t currentFrame) const;
-    void waitForComputeFences(uint32_t currentFrame) const;
+    void waitForGraphicsFrame(uint32_t currentFrame) const;
+    void waitForComputeFrame(uint32_t currentFrame) const;
 
-    void resetGraphicsFences(uint32_t currentFrame) const;
-    void resetComputeFences(uint32_t currentFrame) const;
+    void waitForGraphicsTimelineValue(uint64_t value) const;
 
     vk::Result queuePresent(uint32_t currentFrame,
                             vk::SwapchainKHR swapchain,
@@ -48,6 +73,10 @@ namespace vke {
 
     [[nodiscard]] uint32_t getMaxFramesInFlight() const;
 
+    [[nodiscard]] uint64_t getSubmittedGraphicsTimelineValue() const;
+
+    [[nodiscard]] uint64_t getCompletedGraphicsTimelineValue() const;
+
     [[nodiscard]] vk::raii::CommandPool createCommandPool(const vk::CommandPoolCreateInfo& commandPoolCreateInfo) const;
 
     void allocateCommandBuffers(const vk::CommandBufferAllocateInfo& commandBufferAllocateInfo,
@@ -68,6 +97,8 @@ namespace vke {
 
     [[nodiscard]] vk::raii::Sampler createSampler(const vk::SamplerCreateInfo& samplerCreateInfo) const;
 
+    [[nodiscard]] vk::raii::QueryPool createQueryPool(const vk::QueryPoolCreateInfo& queryPoolCreateInfo) const;
+
     [[nodiscard]] vk::raii::ImageView createImageView(const vk::ImageViewCreateInfo& imageViewCreateInfo) const;
 
     [[nodiscard]] vk::raii::Image createImage(const vk::ImageCreateInfo& imageCreateInfo) const;
@@ -103,26 +134,47 @@ namespace vke {
 
     vk::raii::Device m_device = nullptr;
 
+    // Declared after the device so it releases its blocks before the device is destroyed
+    std::unique_ptr<MemoryAllocator> m_memoryAllocator;
+
+    // Declared after the allocator so retired allocations are returned to it before it is destroyed
+    DeletionQueue m_deletionQueue;
+
     vk::raii::Queue m_graphicsQueue = nullptr;
     vk::raii::Queue m_presentQueue = nullptr;
     vk::raii::Queue m_computeQueue = nullptr;
+    vk::raii::Queue m_transferQueue = nullptr;
 
     std::vector<vk::raii::Semaphore> m_imageAvailableSemaphores;
-
     std::vector<vk::raii::Semaphore> m_renderFinishedSemaphores;
-    std::vector<vk::raii::Semaphore> m_offscreenRenderFinishedSemaphores;
 
-    std::vector<vk::raii::Fence> m_inFlightFences;
-    std::vector<vk::raii::Fence> m_offscreenInFlightFences;
+    // One timeline per queue, each submission signals the next value
+    vk::raii::Semaphore m_graphicsTimelineSemaphore = nullptr;
+    vk::raii::Semaphore m_computeTimelineSemaphore = nullptr;
+    vk::raii::Semaphore m_transferTimelineSemaphore = nullptr;
 
-    std::vector<vk::raii::Semaphore> m_computeFinishedSemaphores;
-    std::vector<vk::raii::Fence> m_computeInFlightFences;
+    uint64_t m_graphicsTimelineValue = 0;
+    uint64_t m_computeTimelineValue = 0;
+    uint64_t m_transferTimelineValue = 0;
 
-    uint8_t m_maxFramesInFlight = 2;
+    // Graphics timeline value signaled by the most recent upload submission
+    uint64_t m_uploadTimelineValue = 0;
+
+    // Timeline values signaled by the most recent submissions of each frame in flight
+    std::vector<uint64_t> m_offscreenFrameTimelineValues;
+    std::vector<uint64_t> m_graphicsFrameTimelineValues;
+    std::vector<uint64_t> m_computeFrameTimelineValues;
+
+    uint32_t m_maxFramesInFlight;
 
     void createDevice();
 
     void createSyncObjects();
+
+    [[nodiscard]] vk::raii::Semaphore createTimelineSemaphore() const;
+
+    void waitForTimelineValue(const vk::raii::Semaphore& timelineSemaphore,
+                              uint64_t value) const;
   };
 
 } // namespace vke
@@ -0,0 +1,93 @@
+#include "MemoryAllocation.h"
+#include "MemoryAllocator.h"
+#include <utility>
+
+namespace vke {
+
+  MemoryAllocation::MemoryAllocation(MemoryAllocator* allocator,
+                                     MemoryBlock* block,
+                                     const vk::DeviceSize offset,
+                                     const vk::DeviceSize size,
+                                     const uint32_t sizeClass)
+    : m_allocator(allocator), m_block(block), m_offset(offset), m_size(size), m_sizeClass(sizeClass)
+  {}
+
+  MemoryAllocation::~MemoryAllocation()
+  {
+    release();
+  }
+
+  MemoryAllocation::MemoryAllocation(MemoryAllocation&& other) noexcept
+    : m_allocator(std::exchange(other.m_allocator, nullptr)), m_block(std::exchange(other.m_block, nullptr)),
+      m_offset(std::exchange(other.m_offset, 0)), m_size(std::exchange(other.m_size, 0)),
+      m_sizeClass(std::exchange(other.m_sizeClass, 0))
+  {}
+
+  MemoryAllocation& MemoryAllocation::operator=(MemoryAllocation&& other) noexcept
+  {
+    if (this != &other)
+    {
+      release();
+
+      m_allocator = std::exchange(other.m_allocator, nullptr);
+      m_block = std::exchange(other.m_block, nullptr);
+      m_offset = std::exchange(other.m_offset, 0);
+      m_size = std::exchange(other.m_size, 0);
+      m_sizeClass = std::exchange(other.m_sizeClass, 0);
+    }
+
+    return *this;
+  }
+
+  vk::DeviceMemory MemoryAllocation::getMemory() const
+  {
+    return m_block ? *m_block->memory : vk::DeviceMemory{};
+  }
+
+  vk::DeviceSize MemoryAllocation::getOffset() const
+  {
+    return m_offset;
+  }
+
+  vk::DeviceSize MemoryAllocation::getSize() const
+  {
+    return m_size;
+  }
+
+  uint32_t MemoryAllocation::getSizeClass() const
+  {
+    return m_sizeClass;
+  }
+
+  MemoryBlock* MemoryAllocation::getBlock() const
+  {
+    return m_block;
+  }
+
+  void* MemoryAllocation::getMappedData() const
+  {
+    if (!m_block || !m_block->mappedData)
+    {
+      return nullptr;
+    }
+
+    return static_cast<std::byte*>(m_block->mappedData) + m_offset;
+  }
+
+  MemoryAllocation::operator bool() const
+  {
+    return m_block != nullptr;
+  }
+
+  void MemoryAllocation::release()
+  {
+    if (m_allocator && m_block)
+    {
+      m_allocator->free(*this);
+    }
+
+    m_allocator = nullptr;
+    m_block = nullptr;
+  }
+
+} // namespace vke
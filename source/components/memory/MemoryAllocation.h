@@ -0,0 +1,65 @@
+#ifndef VKE_MEMORYALLOCATION_H
+#define VKE_MEMORYALLOCATION_H
+
+#include <vulkan/vulkan_raii.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace vke {
+
+  class MemoryAllocator;
+  struct MemoryBlock;
+
+  // A range of a device memory block, handed back to its allocator when destroyed
+  class MemoryAllocation {
+  public:
+    MemoryAllocation() = default;
+
+    MemoryAllocation(std::nullptr_t) {}
+
+    MemoryAllocation(MemoryAllocator* allocator,
+                     MemoryBlock* block,
+                     vk::DeviceSize offset,
+                     vk::DeviceSize size,
+                     uint32_t sizeClass);
+
+    ~MemoryAllocation();
+
+    MemoryAllocation(const MemoryAllocation&) = delete;
+    MemoryAllocation& operator=(const MemoryAllocation&) = delete;
+
+    MemoryAllocation(MemoryAllocation&& other) noexcept;
+    MemoryAllocation& operator=(MemoryAllocation&& other) noexcept;
+
+    [[nodiscard]] vk::DeviceMemory getMemory() const;
+
+    [[nodiscard]] vk::DeviceSize getOffset() const;
+
+    [[nodiscard]] vk::DeviceSize getSize() const;
+
+    [[nodiscard]] uint32_t getSizeClass() const;
+
+    [[nodiscard]] MemoryBlock* getBlock() const;
+
+    // Host visible memory stays mapped for the lifetime of its block, nullptr otherwise
+    [[nodiscard]] void* getMappedData() const;
+
+    explicit operator bool() const;
+
+  private:
+    MemoryAllocator* m_allocator = nullptr;
+
+    MemoryBlock* m_block = nullptr;
+
+    vk::DeviceSize m_offset = 0;
+
+    vk::DeviceSize m_size = 0;
+
+    uint32_t m_sizeClass = 0;
+
+    void release();
+  };
+
+} // namespace vke
+
+#endif //VKE_MEMORYALLOCATION_H
@@ -0,0 +1,310 @@
+#include "MemoryAllocator.h"
+#include "../logicalDevice/LogicalDevice.h"
+#include "../physicalDevice/PhysicalDevice.h"
+#include "../profiler/CpuProfiler.h"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace vke {
+
+  // A host visible device local heap this small is the fixed PCIe BAR window rather than resizable BAR
+  constexpr vk::DeviceSize SMALL_BAR_HEAP_SIZE = 256 * 1024 * 1024;
+
+  // Blocks are capped at this fraction of their heap so small heaps are not claimed by a single block
+  constexpr vk::DeviceSize HEAP_BLOCK_DIVISOR = 8;
+
+  MemoryAllocator::MemoryAllocator(const LogicalDevice& logicalDevice,
+                                   const std::shared_ptr<PhysicalDevice>& physicalDevice)
+    : m_logicalDevice(logicalDevice), m_memoryProperties(physicalDevice->getMemoryProperties()),
+      m_deviceAddressMemory(physicalDevice->supportsRayTracing())
+  {
+    createPools();
+  }
+
+  MemoryAllocation MemoryAllocator::allocate(const vk::MemoryRequirements& memoryRequirements,
+                                             const vk::MemoryPropertyFlags requiredProperties,
+                                             const vk::MemoryPropertyFlags preferredProperties,
+                                             const ResourceTiling tiling)
+  {
+    VKE_PROFILE_ZONE("MemoryAllocator::allocate");
+
+    const auto optionalProperties = preferredProperties & ~requiredProperties;
+
+    for (const auto memoryTypeIndex : getCandidateMemoryTypes(memoryRequirements.memoryTypeBits, requiredProperties,
+                                                              preferredProperties))
+    {
+      // Placements only made because of a preference have to leave room in the heap for everything else
+      const bool withinBudget = static_cast<bool>(m_memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & optionalProperties);
+
+      if (auto allocation = allocateFromMemoryType(memoryTypeIndex, memoryRequirements, tiling, withinBudget))
+      {
+        return std::move(*allocation);
+      }
+    }
+
+    throw std::runtime_error("failed to allocate device memory!");
+  }
+
+  void MemoryAllocator::free(const MemoryAllocation& allocation)
+  {
+    auto* block = allocation.getBlock();
+
+    if (!block->pool)
+    {
+      releaseBlock(*block);
+      return;
+    }
+
+    freeToBlock(*block, allocation.getOffset(), allocation.getSizeClass());
+
+    // Each pool keeps one block around even when it empties, so the next allocation does not have to wait on the driver
+    if (block->usedBytes == 0 && block->pool->blocks.size() > 1)
+    {
+      releaseBlock(*block);
+    }
+  }
+
+  void MemoryAllocator::createPools()
+  {
+    m_heapUsage.resize(m_memoryProperties.memoryHeapCount, 0);
+    m_heapBudgets.resize(m_memoryProperties.memoryHeapCount);
+
+    for (uint32_t i = 0; i < m_memoryProperties.memoryHeapCount; ++i)
+    {
+      m_heapBudgets[i] = m_memoryProperties.memoryHeaps[i].size;
+    }
+
+    m_pools.resize(m_memoryProperties.memoryTypeCount);
+
+    for (uint32_t i = 0; i < m_memoryProperties.memoryTypeCount; ++i)
+    {
+      const auto& memoryType = m_memoryProperties.memoryTypes[i];
+      const vk::DeviceSize heapSize = m_memoryProperties.memoryHeaps[memoryType.heapIndex].size;
+
+      constexpr auto barProperties = vk::MemoryPropertyFlagBits::eDeviceLocal | vk::MemoryPropertyFlagBits::eHostVisible;
+
+      if ((memoryType.propertyFlags & barProperties) == barProperties && heapSize <= SMALL_BAR_HEAP_SIZE)
+      {
+        m_heapBudgets[memoryType.heapIndex] = heapSize / 2;
+      }
+
+      const vk::DeviceSize blockSize = std::max(
+        MIN_ALLOCATION_SIZE,
+        std::min(DEFAULT_BLOCK_SIZE, std::bit_floor(heapSize / HEAP_BLOCK_DIVISOR))
+      );
+
+      for (auto& pool : m_pools[i])
+      {
+        pool.memoryTypeIndex = i;
+        pool.blockSize = blockSize;
+      }
+    }
+  }
+
+  std::vector<uint32_t> MemoryAllocator::getCandidateMemoryTypes(const uint32_t memoryTypeBits,
+                                                                 const vk::MemoryPropertyFlags requiredProperties,
+                                                                 const vk::MemoryPropertyFlags preferredProperties) const
+  {
+    std::vector<uint32_t> preferredMemoryTypes;
+    std::vector<uint32_t> requiredMemoryTypes;
+
+    for (uint32_t i = 0; i < m_memoryProperties.memoryTypeCount; ++i)
+    {
+      const auto propertyFlags = m_memoryProperties.memoryTypes[i].propertyFlags;
+
+      if (!(memoryTypeBits & (1 << i)) || (propertyFlags & requiredProperties) != requiredProperties)
+      {
+        continue;
+      }
+
+      if ((propertyFlags & preferredProperties) == preferredProperties)
+      {
+        preferredMemoryTypes.push_back(i);
+      }
+      else
+      {
+        requiredMemoryTypes.push_back(i);
+      }
+    }
+
+    preferredMemoryTypes.insert(preferredMemoryTypes.end(), requiredMemoryTypes.begin(), requiredMemoryTypes.end());
+
+    return preferredMemoryTypes;
+  }
+
+  std::optional<MemoryAllocation> MemoryAllocator::allocateFromMemoryType(const uint32_t memoryTypeIndex,
+                                                                          const vk::MemoryRequirements& memoryRequirements,
+                                                                          const ResourceTiling tiling,
+                                                                          const bool withinBudget)
+  {
+    auto& pool = m_pools[memoryTypeIndex][static_cast<size_t>(tiling)];
+
+    // Size classes are powers of two and offsets are multiples of their class, which covers the alignment
+    const vk::DeviceSize allocationSize = std::max({ memoryRequirements.size, memoryRequirements.alignment, MIN_ALLOCATION_SIZE });
+
+    // Large resources get memory of their own instead of taking half of a shared block
+    if (allocationSize > pool.blockSize / 2)
+    {
+      auto block = allocateBlock(memoryTypeIndex, memoryRequirements.size, withinBudget);
+
+      if (!block)
+      {
+        return std::nullopt;
+      }
+
+      block->usedBytes = block->size;
+
+      auto& dedicatedBlock = m_dedicatedBlocks.emplace_back(std::move(block));
+
+      return MemoryAllocation(this, dedicatedBlock.get(), 0, memoryRequirements.size, 0);
+    }
+
+    const uint32_t sizeClass = getSizeClass(allocationSize);
+
+    for (const auto& block : pool.blocks)
+    {
+      if (const auto offset = allocateFromBlock(*block, sizeClass))
+      {
+        return MemoryAllocation(this, block.get(), *offset, memoryRequirements.size, sizeClass);
+      }
+    }
+
+    auto block = allocateBlock(memoryTypeIndex, pool.blockSize, withinBudget);
+
+    if (!block)
+    {
+      return std::nullopt;
+    }
+
+    block->pool = &pool;
+    block->freeOffsets.resize(getSizeClass(pool.blockSize) + 1);
+    block->freeOffsets.back().insert(0);
+
+    auto& pooledBlock = pool.blocks.emplace_back(std::move(block));
+
+    return MemoryAllocation(this, pooledBlock.get(), allocateFromBlock(*pooledBlock, sizeClass).value(),
+                            memoryRequirements.size, sizeClass);
+  }
+
+  std::unique_ptr<MemoryBlock> MemoryAllocator::allocateBlock(const uint32_t memoryTypeIndex,
+                                                              const vk::DeviceSize size,
+                                                              const bool withinBudget)
+  {
+    const auto& memoryType = m_memoryProperties.memoryTypes[memoryTypeIndex];
+
+    if (withinBudget && m_heapUsage[memoryType.heapIndex] + size > m_heapBudgets[memoryType.heapIndex])
+    {
+      return nullptr;
+    }
+
+    const vk::MemoryAllocateFlagsInfo allocateFlagsInfo {
+      .flags = m_deviceAddressMemory ? vk::MemoryAllocateFlagBits::eDeviceAddress : vk::MemoryAllocateFlags{}
+    };
+
+    const vk::MemoryAllocateInfo allocateInfo {
+      .pNext = &allocateFlagsInfo,
+      .allocationSize = size,
+      .memoryTypeIndex = memoryTypeIndex
+    };
+
+    auto block = std::make_unique<MemoryBlock>();
+    block->heapIndex = memoryType.heapIndex;
+    block->size = size;
+
+    try
+    {
+      m_logicalDevice.allocateMemory(allocateInfo, block->memory);
+    }
+    catch (const vk::OutOfDeviceMemoryError&)
+    {
+      // The heap is full, the caller moves on to the next candidate memory type
+      return nullptr;
+    }
+
+    if (memoryType.propertyFlags & vk::MemoryPropertyFlagBits::eHostVisible)
+    {
+      block->mappedData = block->memory.mapMemory(0, vk::WholeSize);
+    }
+
+    m_heapUsage[memoryType.heapIndex] += size;
+
+    return block;
+  }
+
+  std::optional<vk::DeviceSize> MemoryAllocator::allocateFromBlock(MemoryBlock& block,
+                                                                   const uint32_t sizeClass)
+  {
+    for (uint32_t i = sizeClass; i < block.freeOffsets.size(); ++i)
+    {
+      if (block.freeOffsets[i].empty())
+      {
+        continue;
+      }
+
+      const vk::DeviceSize offset = *block.freeOffsets[i].begin();
+      block.freeOffsets[i].erase(block.freeOffsets[i].begin());
+
+      // Split down to the requested class, the upper half of every split stays free
+      for (uint32_t j = i; j > sizeClass; --j)
+      {
+        block.freeOffsets[j - 1].insert(offset + getSizeClassBytes(j - 1));
+      }
+
+      block.usedBytes += getSizeClassBytes(sizeClass);
+
+      return offset;
+    }
+
+    return std::nullopt;
+  }
+
+  void MemoryAllocator::freeToBlock(MemoryBlock& block,
+                                    vk::DeviceSize offset,
+                                    uint32_t sizeClass)
+  {
+    block.usedBytes -= getSizeClassBytes(sizeClass);
+
+    while (sizeClass + 1 < block.freeOffsets.size())
+    {
+      const vk::DeviceSize buddyOffset = offset ^ getSizeClassBytes(sizeClass);
+
+      auto& freeOffsets = block.freeOffsets[sizeClass];
+      const auto buddy = freeOffsets.find(buddyOffset);
+
+      if (buddy == freeOffsets.end())
+      {
+        break;
+      }
+
+      freeOffsets.erase(buddy);
+
+      offset = std::min(offset, buddyOffset);
+      ++sizeClass;
+    }
+
+    block.freeOffsets[sizeClass].insert(offset);
+  }
+
+  void MemoryAllocator::releaseBlock(MemoryBlock& block)
+  {
+    m_heapUsage[block.heapIndex] -= block.size;
+
+    auto& blocks = block.pool ? block.pool->blocks : m_dedicatedBlocks;
+
+    std::erase_if(blocks, [&block](const auto& ownedBlock) {
+      return ownedBlock.get() == &block;
+    });
+  }
+
+  uint32_t MemoryAllocator::getSizeClass(const vk::DeviceSize size)
+  {
+    return std::countr_zero(std::bit_ceil(std::max(size, MIN_ALLOCATION_SIZE))) - std::countr_zero(MIN_ALLOCATION_SIZE);
+  }
+
+  vk::DeviceSize MemoryAllocator::getSizeClassBytes(const uint32_t sizeClass)
+  {
+    return MIN_ALLOCATION_SIZE << sizeClass;
+  }
+
+} // namespace vke
@@ -0,0 +1,117 @@
+#ifndef VKE_MEMORYALLOCATOR_H
+#define VKE_MEMORYALLOCATOR_H
+
+#include "MemoryAllocation.h"
+#include <vulkan/vulkan_raii.hpp>
+#include <array>
+#include <memory>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace vke {
+
+  class LogicalDevice;
+  class PhysicalDevice;
+
+  // Smallest size class, every sub-allocation is rounded up to a power of two no smaller than this
+  constexpr vk::DeviceSize MIN_ALLOCATION_SIZE = 256;
+
+  constexpr vk::DeviceSize DEFAULT_BLOCK_SIZE = 64 * 1024 * 1024;
+
+  // Buffers and linear images are kept apart from optimal images so bufferImageGranularity never applies
+  enum class ResourceTiling {
+    linear,
+    optimal
+  };
+
+  struct MemoryPool;
+
+  struct MemoryBlock {
+    vk::raii::DeviceMemory memory = nullptr;
+
+    // Mapped once for the whole block when the memory type is host visible
+    void* mappedData = nullptr;
+
+    // The pool sub-allocating the block, nullptr for dedicated allocations
+    MemoryPool* pool = nullptr;
+
+    uint32_t heapIndex = 0;
+
+    vk::DeviceSize size = 0;
+    vk::DeviceSize usedBytes = 0;
+
+    // Free offsets per size class, a freed range merges with its buddy when both halves are free
+    std::vector<std::set<vk::DeviceSize>> freeOffsets;
+  };
+
+  struct MemoryPool {
+    uint32_t memoryTypeIndex = 0;
+
+    vk::DeviceSize blockSize = 0;
+
+    std::vector<std::unique_ptr<MemoryBlock>> blocks;
+  };
+
+  class MemoryAllocator {
+  public:
+    MemoryAllocator(const LogicalDevice& logicalDevice,
+                    const std::shared_ptr<PhysicalDevice>& physicalDevice);
+
+    // Places the resource in a memory type with every required property, favoring ones that also have the preferred properties
+    [[nodiscard]] MemoryAllocation allocate(const vk::MemoryRequirements& memoryRequirements,
+                                            vk::MemoryPropertyFlags requiredProperties,
+                                            vk::MemoryPropertyFlags preferredProperties,
+                                            ResourceTiling tiling);
+
+    void free(const MemoryAllocation& allocation);
+
+  private:
+    const LogicalDevice& m_logicalDevice;
+
+    vk::PhysicalDeviceMemoryProperties m_memoryProperties;
+
+    // Set when buffer device addresses are enabled, every block is allocated so any buffer in it can use them
+    bool m_deviceAddressMemory = false;
+
+    // Indexed by memory type, then by ResourceTiling
+    std::vector<std::array<MemoryPool, 2>> m_pools;
+
+    std::vector<std::unique_ptr<MemoryBlock>> m_dedicatedBlocks;
+
+    // Bytes allocated from each heap, and how much of it preferred placements may take
+    std::vector<vk::DeviceSize> m_heapUsage;
+    std::vector<vk::DeviceSize> m_heapBudgets;
+
+    void createPools();
+
+    [[nodiscard]] std::vector<uint32_t> getCandidateMemoryTypes(uint32_t memoryTypeBits,
+                                                                vk::MemoryPropertyFlags requiredProperties,
+                                                                vk::MemoryPropertyFlags preferredProperties) const;
+
+    [[nodiscard]] std::optional<MemoryAllocation> allocateFromMemoryType(uint32_t memoryTypeIndex,
+                                                                         const vk::MemoryRequirements& memoryRequirements,
+                                                                         ResourceTiling tiling,
+                                                                         bool withinBudget);
+
+    [[nodiscard]] std::unique_ptr<MemoryBlock> allocateBlock(uint32_t memoryTypeIndex,
+                                                             vk::DeviceSize size,
+                                                             bool withinBudget);
+
+    [[nodiscard]] static std::optional<vk::DeviceSize> allocateFromBlock(MemoryBlock& block,
+                                                                         uint32_t sizeClass);
+
+    static void freeToBlock(MemoryBlock& block,
+                            vk::DeviceSize offset,
+                            uint32_t sizeClass);
+
+    void releaseBlock(MemoryBlock& block);
+
+    [[nodiscard]] static uint32_t getSizeClass(vk::DeviceSize size);
+
+    [[nodiscard]] static vk::DeviceSize getSizeClassBytes(uint32_t sizeClass);
+  };
+
+} // namespace vke
+
+#endif //VKE_MEMORYALLOCATOR_H
@@ -1,9 +1,11 @@
 #include "PhysicalDevice.h"
 #include "../instance/Instance.h"
 #include "../window/Surface.h"
+#include <algorithm>
 #include <array>
 #include <set>
 #include <stdexcept>
+#include <string_view>
 
 namespace vke {
   PhysicalDevice::PhysicalDevice(const std::shared_ptr<Instance>& instance,
@@ -14,7 +16,10 @@ namespace vke {
 
     m_queueFamilyIndices = findQueueFamilies(m_physicalDevice);
 
-    updateSwapChainSupportDetails();
+    if (!isHeadless())
+    {
+      updateSwapChainSupportDetails();
+    }
   }
 
   QueueFamilyIndices PhysicalDevice::getQueueFamilies() const
@@ -32,6 +37,11 @@ namespace vke {
     return m_msaaSamples;
   }
 
+  vk::PhysicalDeviceMemoryProperties PhysicalDevice::getMemoryProperties() const
+  {
+    return m_physicalDevice.getMemoryProperties();
+  }
+
   uint32_t PhysicalDevice::findMemoryType(const uint32_t typeFilter,
                                           const vk::MemoryPropertyFlags& properties) const
   {
@@ -63,6 +73,16 @@ namespace vke {
     return m_physicalDevice.getProperties();
   }
 
+  bool PhysicalDevice::supportsPipelineStatistics() const
+  {
+    return m_physicalDevice.getFeatures().pipelineStatisticsQuery;
+  }
+
+  uint32_t PhysicalDevice::getTimestampValidBits(const uint32_t queueFamilyIndex) const
+  {
+    return m_physicalDevice.getQueueFamilyProperties().at(queueFamilyIndex).timestampValidBits;
+  }
+
   vk::raii::Device PhysicalDevice::createLogicalDevice(const vk::DeviceCreateInfo& deviceCreateInfo) const
   {
     return m_physicalDevice.createDevice(deviceCreateInfo);
@@ -100,6 +120,70 @@ namespace vke {
     return m_supportsRayTracing;
   }
 
+  bool PhysicalDevice::supportsMemoryBudget() const
+  {
+    return m_supportsMemoryBudget;
+  }
+
+  std::optional<vk::DeviceSize> PhysicalDevice::getDeviceLocalMemoryUsage() const
+  {
+    if (!m_supportsMemoryBudget)
+    {
+      return std::nullopt;
+    }
+
+    const auto memoryProperties = m_physicalDevice.getMemoryProperties2<
+      vk::PhysicalDeviceMemoryProperties2,
+      vk::PhysicalDeviceMemoryBudgetPropertiesEXT
+    >();
+
+    const auto& heaps = memoryProperties.get<vk::PhysicalDeviceMemoryProperties2>().memoryProperties;
+    const auto& budget = memoryProperties.get<vk::PhysicalDeviceMemoryBudgetPropertiesEXT>();
+
+    vk::DeviceSize usage = 0;
+    for (uint32_t i = 0; i < heaps.memoryHeapCount; ++i)
+    {
+      if (heaps.memoryHeaps[i].flags & vk::MemoryHeapFlagBits::eDeviceLocal)
+      {
+        usage += budget.heapUsage[i];
+      }
+    }
+
+    return usage;
+  }
+
+  bool PhysicalDevice::isHeadless() const
+  {
+    return m_surface == nullptr;
+  }
+
+  std::vector<const char*> PhysicalDevice::getDeviceExtensions() const
+  {
+    std::vector<const char*> extensions;
+
+    for (const auto& extension : deviceExtensions)
+    {
+      if (isHeadless() && std::string_view(extension) == vk::KHRSwapchainExtensionName)
+      {
+        continue;
+      }
+
+      extensions.push_back(extension);
+    }
+
+    if (m_supportsRayTracing)
+    {
+      extensions.insert(extensions.end(), rayTracingDeviceExtensions.begin(), rayTracingDeviceExtensions.end());
+    }
+
+    if (m_supportsMemoryBudget)
+    {
+      extensions.push_back(vk::EXTMemoryBudgetExtensionName);
+    }
+
+    return extensions;
+  }
+
   vk::PhysicalDeviceRayTracingPipelinePropertiesKHR PhysicalDevice::getRayTracingPipelineProperties() const
   {
     return m_physicalDevice.getProperties2<
@@ -126,6 +210,8 @@ namespace vke {
     }
 
     m_supportsRayTracing = checkDeviceRayTracingExtensionSupport(m_physicalDevice);
+
+    m_supportsMemoryBudget = checkDeviceMemoryBudgetExtensionSupport(m_physicalDevice);
   }
 
   bool PhysicalDevice::isDeviceSuitable(const vk::raii::PhysicalDevice& device) const
@@ -134,8 +220,8 @@ namespace vke {
 
     bool extensionsSupported = checkDeviceExtensionSupport(device);
 
-    bool swapChainAdequate = false;
-    if (extensionsSupported)
+    bool swapChainAdequate = isHeadless();
+    if (extensionsSupported && !isHeadless())
     {
       SwapChainSupportDetails swapChainSupport = querySwapChainSupport(device);
       swapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
@@ -143,7 +229,8 @@ namespace vke {
 
     const auto supportedFeatures = device.getFeatures();
 
-    return indices.isComplete() && extensionsSupported && swapChainAdequate && supportedFeatures.samplerAnisotropy;
+    return indices.isComplete(!isHeadless()) && extensionsSupported && swapChainAdequate && supportedFeatures.samplerAnisotropy &&
+           supportedFeatures.imageCubeArray;
   }
 
   QueueFamilyIndices PhysicalDevice::findQueueFamilies(const vk::raii::PhysicalDevice& device) const
@@ -155,22 +242,20 @@ namespace vke {
     int i = 0;
     for (const auto& queueFamily : queueFamilies)
     {
-      if (queueFamily.queueFlags & vk::QueueFlagBits::eGraphics)
+      // Light clusters are computed in the graphics command buffers, ahead of the passes shading with them.
+      // Compute uses the same family, so buffers uploaded on the graphics queue need no ownership transfer
+      if ((queueFamily.queueFlags & vk::QueueFlagBits::eGraphics) && (queueFamily.queueFlags & vk::QueueFlagBits::eCompute))
       {
         indices.graphicsFamily = i;
-      }
-
-      if (queueFamily.queueFlags & vk::QueueFlagBits::eCompute)
-      {
         indices.computeFamily = i;
       }
 
-      if (device.getSurfaceSupportKHR(i, m_surface->getSurface()))
+      if (!isHeadless() && device.getSurfaceSupportKHR(i, m_surface->getSurface()))
       {
         indices.presentFamily = i;
       }
 
-      if (indices.isComplete())
+      if (indices.isComplete(!isHeadless()))
       {
         break;
       }
@@ -178,15 +263,38 @@ namespace vke {
       i++;
     }
 
+    indices.transferFamily = findDedicatedTransferFamily(queueFamilies);
+
     return indices;
   }
 
-  bool PhysicalDevice::checkDeviceExtensionSupport(const vk::raii::PhysicalDevice& device)
+  std::optional<uint32_t> PhysicalDevice::findDedicatedTransferFamily(const std::vector<vk::QueueFamilyProperties>& queueFamilies)
+  {
+    constexpr auto excludedFlags = vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eCompute;
+
+    // Transfer only families are usually backed by copy engines that run alongside rendering
+    for (uint32_t i = 0; i < queueFamilies.size(); ++i)
+    {
+      if ((queueFamilies[i].queueFlags & vk::QueueFlagBits::eTransfer) && !(queueFamilies[i].queueFlags & excludedFlags))
+      {
+        return i;
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  bool PhysicalDevice::checkDeviceExtensionSupport(const vk::raii::PhysicalDevice& device) const
   {
     const auto availableExtensions = device.enumerateDeviceExtensionProperties();
 
     std::set<std::string> requiredExtensions(deviceExtensions.begin(), deviceExtensions.end());
 
+    if (isHeadless())
+    {
+      requiredExtensions.erase(vk::KHRSwapchainExtensionName);
+    }
+
     for (const auto& extension : availableExtensions)
     {
       requiredExtensions.erase(extension.extensionName);
@@ -209,6 +317,15 @@ namespace vke {
     return requiredExtensions.empty();
   }
 
+  bool PhysicalDevice::checkDeviceMemoryBudgetExtensionSupport(const vk::raii::PhysicalDevice& device)
+  {
+    const auto availableExtensions = device.enumerateDeviceExtensionProperties();
+
+    return std::ranges::any_of(availableExtensions, [](const vk::ExtensionProperties& extension) {
+      return std::string_view(extension.extensionName) == vk::EXTMemoryBudgetExtensionName;
+    });
+  }
+
   SwapChainSupportDetails PhysicalDevice::querySwapChainSupport(const vk::raii::PhysicalDevice& device) const
   {
     const auto surface = m_surface->getSurface();
@@ -37,10 +37,13 @@ namespace vke {
     std::optional<uint32_t> presentFamily;
     std::optional<uint32_t> computeFamily;
 
-    [[nodiscard]] bool isComplete() const
+    // Only set for a family without graphics or compute support, uploads fall back to the graphics queue otherwise
+    std::optional<uint32_t> transferFamily;
+
+    [[nodiscard]] bool isComplete(const bool requiresPresentFamily) const
     {
       return graphicsFamily.has_value() &&
-             presentFamily.has_value() &&
+             (presentFamily.has_value() || !requiresPresentFamily) &&
              computeFamily.has_value();
     }
   };
@@ -62,6 +65,8 @@ namespace vke {
 
     [[nodiscard]] vk::SampleCountFlagBits getMsaaSamples() const;
 
+    [[nodiscard]] vk::PhysicalDeviceMemoryProperties getMemoryProperties() const;
+
     [[nodiscard]] uint32_t findMemoryType(uint32_t typeFilter,
                                           const vk::MemoryPropertyFlags& properties) const;
 
@@ -71,6 +76,10 @@ namespace vke {
 
     [[nodiscard]] vk::PhysicalDeviceProperties getDeviceProperties() const;
 
+    [[nodiscard]] bool supportsPipelineStatistics() const;
+
+    [[nodiscard]] uint32_t getTimestampValidBits(uint32_t queueFamilyIndex) const;
+
     [[nodiscard]] vk::raii::Device createLogicalDevice(const vk::DeviceCreateInfo& deviceCreateInfo) const;
 
     [[nodiscard]] vk::Format findDepthFormat() const;
@@ -81,6 +90,15 @@ namespace vke {
 
     [[nodiscard]] bool supportsRayTracing() const;
 
+    [[nodiscard]] bool supportsMemoryBudget() const;
+
+    // Bytes this process has allocated from device local heaps, empty without VK_EXT_memory_budget
+    [[nodiscard]] std::optional<vk::DeviceSize> getDeviceLocalMemoryUsage() const;
+
+    [[nodiscard]] bool isHeadless() const;
+
+    [[nodiscard]] std::vector<const char*> getDeviceExtensions() const;
+
     [[nodiscard]] vk::PhysicalDeviceRayTracingPipelinePropertiesKHR getRayTracingPipelineProperties() const;
 
     friend class ImGuiInstance;
@@ -98,16 +116,22 @@ namespace vke {
 
     bool m_supportsRayTracing = false;
 
+    bool m_supportsMemoryBudget = false;
+
     void pickPhysicalDevice(const std::shared_ptr<Instance>& instance);
 
     [[nodiscard]] bool isDeviceSuitable(const vk::raii::PhysicalDevice& device) const;
 
     [[nodiscard]] QueueFamilyIndices findQueueFamilies(const vk::raii::PhysicalDevice& device) const;
 
-    static bool checkDeviceExtensionSupport(const vk::raii::PhysicalDevice& device);
+    [[nodiscard]] static std::optional<uint32_t> findDedicatedTransferFamily(const std::vector<vk::QueueFamilyProperties>& queueFamilies);
+
+    [[nodiscard]] bool checkDeviceExtensionSupport(const vk::raii::PhysicalDevice& device) const;
 
     static bool checkDeviceRayTracingExtensionSupport(const vk::raii::PhysicalDevice& device);
 
+    static bool checkDeviceMemoryBudgetExtensionSupport(const vk::raii::PhysicalDevice& device);
+
     [[nodiscard]] SwapChainSupportDetails querySwapChainSupport(const vk::raii::PhysicalDevice& device) const;
 
     [[nodiscard]] vk::SampleCountFlagBits getMaxUsableSampleCount() const;
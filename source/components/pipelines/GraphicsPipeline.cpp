@@ -18,13 +18,15 @@ namespace vke {
 
   void GraphicsPipeline::bindDescriptorSet(const std::shared_ptr<CommandBuffer>& commandBuffer,
                                            const vk::DescriptorSet descriptorSet,
-                                           const uint32_t location) const
+                                           const uint32_t location,
+                                           const std::vector<uint32_t>& dynamicOffsets) const
   {
     commandBuffer->bindDescriptorSets(
       vk::PipelineBindPoint::eGraphics,
       m_pipelineLayout,
       location,
-      { descriptorSet }
+      { descriptorSet },
+      dynamicOffsets
     );
   }
 
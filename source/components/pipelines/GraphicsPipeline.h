@@ -21,6 +21,12 @@ namespace vke {
     const glm::mat4& viewMatrix;
     vk::Extent2D extent;
 
+    // Seconds simulated since the previous frame
+    float deltaTime = 0.0f;
+
+    // Dynamic offset of the pass's camera in the frame's scene view buffer
+    uint32_t viewOffset = 0;
+
     mutable glm::mat4 projectionMatrix;
     mutable bool shouldCreateProjectionMatrix = true;
 
@@ -129,7 +135,8 @@ namespace vke {
 
     void bindDescriptorSet(const std::shared_ptr<CommandBuffer>& commandBuffer,
                            vk::DescriptorSet descriptorSet,
-                           uint32_t location) const;
+                           uint32_t location,
+                           const std::vector<uint32_t>& dynamicOffsets = {}) const;
 
   protected:
     void createPipelineLayout(const std::shared_ptr<LogicalDevice>& logicalDevice,
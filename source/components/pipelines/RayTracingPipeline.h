@@ -3,6 +3,7 @@
 
 #include "Pipeline.h"
 #include "shaderModules/ShaderModule.h"
+#include "../memory/MemoryAllocation.h"
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -93,7 +94,7 @@ namespace vke {
 
   protected:
     vk::raii::Buffer m_shaderBindingTableBuffer = nullptr;
-    vk::raii::DeviceMemory m_shaderBindingTableMemory = nullptr;
+    MemoryAllocation m_shaderBindingTableMemory = nullptr;
 
     vk::StridedDeviceAddressRegionKHR m_rayGenerationRegion{};
     vk::StridedDeviceAddressRegionKHR m_missRegion{};
@@ -53,12 +53,12 @@ namespace {
 namespace vke {
 
   BendyPipeline::BendyPipeline(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                               const vk::raii::CommandPool& commandPool,
+                               const std::shared_ptr<UploadManager>& uploadManager,
                                const vk::DescriptorPool descriptorPool,
                                const std::shared_ptr<DescriptorSet>& lightingDescriptorSet)
-    : m_lightingDescriptorSet(lightingDescriptorSet), m_previousTime(std::chrono::steady_clock::now())
+    : m_lightingDescriptorSet(lightingDescriptorSet)
   {
-    createUniforms(logicalDevice, commandPool);
+    createUniforms(logicalDevice, uploadManager);
 
     createDescriptorSets(logicalDevice, descriptorPool);
 
@@ -128,13 +128,13 @@ namespace vke {
   }
 
   void BendyPipeline::createUniforms(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                     const vk::raii::CommandPool& commandPool)
+                                     const std::shared_ptr<UploadManager>& uploadManager)
   {
     m_transformUniform = std::make_shared<UniformBuffer>(logicalDevice, sizeof(VPTransformUniform));
 
     m_timeUniform = std::make_shared<UniformBuffer>(logicalDevice, sizeof(float));
 
-    m_texture = std::make_shared<Texture2D>(logicalDevice, commandPool, "assets/bendy/leaf.png", vk::SamplerAddressMode::eClampToEdge);
+    m_texture = std::make_shared<Texture2D>(logicalDevice, uploadManager, "assets/bendy/leaf.png", vk::SamplerAddressMode::eClampToEdge);
   }
 
   void BendyPipeline::createDescriptorSets(const std::shared_ptr<LogicalDevice>& logicalDevice,
@@ -159,11 +159,7 @@ namespace vke {
 
     m_transformUniform->update(renderInfo->currentFrame, &transformUBO);
 
-    const auto currentTime = std::chrono::steady_clock::now();
-    const float dt = std::chrono::duration<float>(currentTime - m_previousTime).count();
-    m_previousTime = currentTime;
-
-    m_time += dt;
+    m_time += renderInfo->deltaTime;
 
     m_timeUniform->update(renderInfo->currentFrame, &m_time);
   }
@@ -2,20 +2,20 @@
 #define VKE_BENDYPIPELINE_H
 
 #include "../GraphicsPipeline.h"
-#include <chrono>
 
 namespace vke {
 
   class UniformBuffer;
   class DescriptorSet;
   class Texture2D;
+  class UploadManager;
 
   struct BendyPlant;
 
   class BendyPipeline final : public GraphicsPipeline {
   public:
     BendyPipeline(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                  const vk::raii::CommandPool& commandPool,
+                  const std::shared_ptr<UploadManager>& uploadManager,
                   vk::DescriptorPool descriptorPool,
                   const std::shared_ptr<DescriptorSet>& lightingDescriptorSet);
 
@@ -33,10 +33,8 @@ namespace vke {
 
     std::shared_ptr<Texture2D> m_texture;
 
-    std::chrono::time_point<std::chrono::steady_clock> m_previousTime;
-
     void createUniforms(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                        const vk::raii::CommandPool& commandPool);
+                        const std::shared_ptr<UploadManager>& uploadManager);
 
     void createDescriptorSets(const std::shared_ptr<LogicalDevice>& logicalDevice,
                               vk::DescriptorPool descriptorPool);
@@ -4,6 +4,7 @@
 #include "../descriptorSets/DescriptorSet.h"
 #include "../../commandBuffer/CommandBuffer.h"
 #include "../../logicalDevice/LogicalDevice.h"
+#include "../../uploadManager/UploadManager.h"
 #include "../../../utilities/Buffers.h"
 #include <cmath>
 #include <cstring>
@@ -33,13 +34,12 @@ namespace vke {
   }};
 
   DotsPipeline::DotsPipeline(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                             const vk::raii::CommandPool& commandPool,
+                             const std::shared_ptr<UploadManager>& uploadManager,
                              const vk::DescriptorPool descriptorPool)
-    : m_previousTime(std::chrono::steady_clock::now())
   {
     createUniforms(logicalDevice);
 
-    createShaderStorageBuffers(logicalDevice, commandPool);
+    createShaderStorageBuffers(logicalDevice, uploadManager);
 
     createDescriptorSets(logicalDevice, descriptorPool);
 
@@ -110,7 +110,7 @@ namespace vke {
   }
 
   void DotsPipeline::createShaderStorageBuffers(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                                const vk::raii::CommandPool& commandPool)
+                                                const std::shared_ptr<UploadManager>& uploadManager)
   {
     m_shaderStorageBuffers.reserve(logicalDevice->getMaxFramesInFlight());
     m_shaderStorageBuffersMemory.reserve(logicalDevice->getMaxFramesInFlight());
@@ -134,30 +134,15 @@ namespace vke {
 
     constexpr vk::DeviceSize bufferSize = sizeof(Particle) * PARTICLE_COUNT;
 
-    vk::raii::Buffer stagingBuffer{nullptr};
-    vk::raii::DeviceMemory stagingBufferMemory{nullptr};
-
-    Buffers::createBuffer(logicalDevice, bufferSize,
-                          vk::BufferUsageFlagBits::eTransferSrc,
-                          vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
-                          stagingBuffer, stagingBufferMemory);
-
-    Buffers::doMappedMemoryOperation(stagingBufferMemory, [particles](void* data) {
-      memcpy(data, particles.data(), bufferSize);
-    });
-
     for (size_t i = 0; i < logicalDevice->getMaxFramesInFlight(); i++)
     {
       vk::raii::Buffer buffer{nullptr};
-      vk::raii::DeviceMemory memory{nullptr};
+      MemoryAllocation memory{nullptr};
 
       Buffers::createBuffer(logicalDevice, bufferSize,
                             vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eTransferDst,
                             vk::MemoryPropertyFlagBits::eDeviceLocal, buffer, memory);
 
-      Buffers::copyBuffer(logicalDevice, commandPool, logicalDevice->getComputeQueue(),
-                          stagingBuffer, buffer, bufferSize);
-
       const vk::DescriptorBufferInfo bufferInfo {
         .buffer = *buffer,
         .offset = 0,
@@ -168,6 +153,20 @@ namespace vke {
       m_shaderStorageBuffersMemory.push_back(std::move(memory));
       m_shaderStorageBufferInfos.push_back(bufferInfo);
     }
+
+    uploadManager->upload(bufferSize, [&particles](void* data) {
+      memcpy(data, particles.data(), bufferSize);
+    }, [this](const CommandBuffer& commandBuffer, const StagingRegion& stagingRegion) {
+      for (const auto& shaderStorageBuffer : m_shaderStorageBuffers)
+      {
+        Buffers::copyBuffer(commandBuffer, stagingRegion.buffer, shaderStorageBuffer, bufferSize, stagingRegion.offset);
+      }
+    });
+
+    for (const auto& shaderStorageBuffer : m_shaderStorageBuffers)
+    {
+      uploadManager->releaseBuffer(shaderStorageBuffer);
+    }
   }
 
   void DotsPipeline::createDescriptorSets(const std::shared_ptr<LogicalDevice>& logicalDevice,
@@ -205,11 +204,7 @@ namespace vke {
 
   void DotsPipeline::updateUniformVariables(const RenderInfo* renderInfo)
   {
-    const auto currentTime = std::chrono::steady_clock::now();
-    const float dt = std::chrono::duration<float>(currentTime - m_previousTime).count();
-    m_previousTime = currentTime;
-
-    const float deltaTimeUBO = m_dotSpeed * dt;
+    const float deltaTimeUBO = m_dotSpeed * renderInfo->deltaTime;
 
     m_deltaTimeUniform->update(renderInfo->currentFrame, &deltaTimeUBO);
   }
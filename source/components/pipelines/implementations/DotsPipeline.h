@@ -4,8 +4,8 @@
 #include "../ComputePipeline.h"
 #include "../GraphicsPipeline.h"
 #include "../uniformBuffers/UniformBuffer.h"
+#include "../../memory/MemoryAllocation.h"
 #include <vulkan/vulkan_raii.hpp>
-#include <chrono>
 #include <memory>
 #include <vector>
 
@@ -13,13 +13,14 @@ namespace vke {
 
   class DescriptorSet;
   class UniformBuffer;
+  class UploadManager;
 
   constexpr int PARTICLE_COUNT = 8192;
 
   class DotsPipeline final : public ComputePipeline, public GraphicsPipeline {
   public:
     DotsPipeline(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                 const vk::raii::CommandPool& commandPool,
+                 const std::shared_ptr<UploadManager>& uploadManager,
                  vk::DescriptorPool descriptorPool);
 
     void compute(const std::shared_ptr<CommandBuffer>& commandBuffer,
@@ -29,7 +30,7 @@ namespace vke {
 
   private:
     std::vector<vk::raii::Buffer> m_shaderStorageBuffers;
-    std::vector<vk::raii::DeviceMemory> m_shaderStorageBuffersMemory;
+    std::vector<MemoryAllocation> m_shaderStorageBuffersMemory;
     std::vector<vk::DescriptorBufferInfo> m_shaderStorageBufferInfos;
 
     std::shared_ptr<DescriptorSet> m_dotsDescriptorSet;
@@ -37,12 +38,11 @@ namespace vke {
     std::unique_ptr<UniformBuffer> m_deltaTimeUniform;
 
     float m_dotSpeed = 1000.0f;
-    std::chrono::time_point<std::chrono::steady_clock> m_previousTime;
 
     void createUniforms(const std::shared_ptr<LogicalDevice>& logicalDevice);
 
     void createShaderStorageBuffers(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                    const vk::raii::CommandPool& commandPool);
+                                    const std::shared_ptr<UploadManager>& uploadManager);
 
     void createDescriptorSets(const std::shared_ptr<LogicalDevice>& logicalDevice,
                               vk::DescriptorPool descriptorPool);
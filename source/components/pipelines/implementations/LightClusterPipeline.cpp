@@ -0,0 +1,42 @@
+#include "LightClusterPipeline.h"
+#include "../descriptorSets/DescriptorSet.h"
+#include "../../commandBuffer/CommandBuffer.h"
+#include "../../lighting/LightingManager.h"
+
+namespace vke {
+
+  // Matches the local size of LightClusters.comp
+  constexpr uint32_t LIGHT_CLUSTER_GROUP_SIZE = 64;
+
+  LightClusterPipeline::LightClusterPipeline(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                                             const std::shared_ptr<DescriptorSet>& lightingDescriptorSet)
+    : m_lightingDescriptorSet(lightingDescriptorSet)
+  {
+    const ComputePipelineOptions computePipelineOptions {
+      .shaders {
+        .computeShader = "assets/shaders/LightClusters.comp.spv",
+      },
+      .descriptorSetLayouts {
+        m_lightingDescriptorSet->getDescriptorSetLayout()
+      },
+    };
+
+    ComputePipeline::createPipeline(logicalDevice, computePipelineOptions);
+  }
+
+  void LightClusterPipeline::compute(const std::shared_ptr<CommandBuffer>& commandBuffer,
+                                     const uint32_t currentFrame) const
+  {
+    commandBuffer->bindPipeline(vk::PipelineBindPoint::eCompute, m_pipeline);
+
+    commandBuffer->bindDescriptorSets(
+      vk::PipelineBindPoint::eCompute,
+      m_pipelineLayout,
+      0,
+      { m_lightingDescriptorSet->getDescriptorSet(currentFrame) }
+    );
+
+    commandBuffer->dispatch((LIGHT_CLUSTER_COUNT + LIGHT_CLUSTER_GROUP_SIZE - 1) / LIGHT_CLUSTER_GROUP_SIZE, 1, 1);
+  }
+
+} // namespace vke
@@ -0,0 +1,26 @@
+#ifndef VKE_LIGHTCLUSTERPIPELINE_H
+#define VKE_LIGHTCLUSTERPIPELINE_H
+
+#include "../ComputePipeline.h"
+#include <memory>
+
+namespace vke {
+
+  class DescriptorSet;
+
+  // Bins the lights into the clusters of the camera's frustum, one invocation per cluster
+  class LightClusterPipeline final : public ComputePipeline {
+  public:
+    LightClusterPipeline(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                         const std::shared_ptr<DescriptorSet>& lightingDescriptorSet);
+
+    void compute(const std::shared_ptr<CommandBuffer>& commandBuffer,
+                 uint32_t currentFrame) const;
+
+  private:
+    std::shared_ptr<DescriptorSet> m_lightingDescriptorSet;
+  };
+
+} // namespace vke
+
+#endif //VKE_LIGHTCLUSTERPIPELINE_H
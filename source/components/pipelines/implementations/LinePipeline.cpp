@@ -3,6 +3,7 @@
 #include "../descriptorSets/DescriptorSet.h"
 #include "../../commandBuffer/CommandBuffer.h"
 #include "../../logicalDevice/LogicalDevice.h"
+#include "../../uploadManager/UploadManager.h"
 #include "../../../utilities/Buffers.h"
 #include <stdexcept>
 
@@ -45,9 +46,8 @@ namespace vke {
     createVertexBuffer(logicalDevice);
   }
 
-  void LinePipeline::render(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                            const RenderInfo* renderInfo,
-                            const vk::raii::CommandPool& commandPool,
+  void LinePipeline::render(const RenderInfo* renderInfo,
+                            const std::shared_ptr<UploadManager>& uploadManager,
                             const std::vector<LineVertex>* vertices) const
   {
     if (vertices->empty())
@@ -64,12 +64,8 @@ namespace vke {
       throw std::runtime_error("Vertex data exceeds maximum buffer size");
     }
 
-    Buffers::doMappedMemoryOperation(m_stagingBufferMemory, [vertices, bufferSize](void* data) {
-      memcpy(data, vertices->data(), bufferSize);
-    });
-
-    Buffers::copyBuffer(logicalDevice, commandPool, logicalDevice->getGraphicsQueue(), m_stagingBuffer,
-                        m_vertexBuffer, bufferSize);
+    // Lands before the frame is submitted, the upload batch is flushed ahead of it
+    uploadManager->updateBuffer(m_vertexBuffer, vertices->data(), bufferSize);
 
     const std::vector<vk::DeviceSize> offsets = {0};
     renderInfo->commandBuffer->bindVertexBuffers(0, { m_vertexBuffer }, offsets);
@@ -91,10 +87,6 @@ namespace vke {
     Buffers::createBuffer(logicalDevice, m_maxVertexBufferSize,
                           vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eVertexBuffer,
                           vk::MemoryPropertyFlagBits::eDeviceLocal, m_vertexBuffer, m_vertexBufferMemory);
-
-    Buffers::createBuffer(logicalDevice, m_maxVertexBufferSize, vk::BufferUsageFlagBits::eTransferSrc,
-                          vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
-                          m_stagingBuffer, m_stagingBufferMemory);
   }
 
 } // namespace vke
\ No newline at end of file
@@ -8,6 +8,7 @@
 namespace vke::PipelineConfig {
 
   inline GraphicsPipelineOptions createTexturedPlanePipelineOptions(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                                                                    vk::DescriptorSetLayout sceneDescriptorSetLayout,
                                                                     vk::DescriptorSetLayout objectDescriptorSetLayout)
   {
     return {
@@ -26,12 +27,14 @@ namespace vke::PipelineConfig {
         .viewportState = gps::viewportState
       },
       .descriptorSetLayouts {
+        sceneDescriptorSetLayout,
         objectDescriptorSetLayout
       }
     };
   }
 
   inline GraphicsPipelineOptions createObjectHighlightPipelineOptions(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                                                                      vk::DescriptorSetLayout sceneDescriptorSetLayout,
                                                                       vk::DescriptorSetLayout objectDescriptorSetLayout)
   {
     return {
@@ -50,12 +53,14 @@ namespace vke::PipelineConfig {
         .viewportState = gps::viewportState
       },
       .descriptorSetLayouts {
+        sceneDescriptorSetLayout,
         objectDescriptorSetLayout
       }
     };
   }
 
   inline GraphicsPipelineOptions createMagnifyWhirlMosaicPipelineOptions(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                                                                         vk::DescriptorSetLayout sceneDescriptorSetLayout,
                                                                          vk::DescriptorSetLayout objectDescriptorSetLayout)
   {
     return {
@@ -81,12 +86,13 @@ namespace vke::PipelineConfig {
         }
       },
       .descriptorSetLayouts {
+        sceneDescriptorSetLayout,
         objectDescriptorSetLayout
       }
     };
   }
 
-  inline GraphicsPipelineOptions createMousePickingPipelineOptions(vk::DescriptorSetLayout objectDescriptorSetLayout)
+  inline GraphicsPipelineOptions createMousePickingPipelineOptions(vk::DescriptorSetLayout sceneDescriptorSetLayout)
   {
     return {
       .shaders {
@@ -103,21 +109,14 @@ namespace vke::PipelineConfig {
         .vertexInputState = gps::vertexInputStateVertexPositionOnly,
         .viewportState = gps::viewportState
       },
-      .pushConstantRanges {
-        {
-          .stageFlags = vk::ShaderStageFlagBits::eFragment,
-          .offset = 0,
-          .size = sizeof(uint32_t)
-        }
-      },
       .descriptorSetLayouts {
-        objectDescriptorSetLayout
+        sceneDescriptorSetLayout
       },
       .colorFormat = vk::Format::eR8G8B8A8Uint
     };
   }
 
-  inline GraphicsPipelineOptions createShadowMapPipelineOptions(vk::DescriptorSetLayout objectDescriptorSetLayout)
+  inline GraphicsPipelineOptions createShadowMapPipelineOptions(vk::DescriptorSetLayout sceneDescriptorSetLayout)
   {
     return {
       .shaders {
@@ -141,13 +140,13 @@ namespace vke::PipelineConfig {
         }
       },
       .descriptorSetLayouts {
-        objectDescriptorSetLayout
+        sceneDescriptorSetLayout
       },
       .colorFormat = vk::Format::eUndefined
     };
   }
 
-  inline GraphicsPipelineOptions createPointLightShadowMapPipelineOptions(vk::DescriptorSetLayout objectDescriptorSetLayout,
+  inline GraphicsPipelineOptions createPointLightShadowMapPipelineOptions(vk::DescriptorSetLayout sceneDescriptorSetLayout,
                                                                           vk::DescriptorSetLayout pointLightDescriptorSetLayout)
   {
     return {
@@ -169,11 +168,11 @@ namespace vke::PipelineConfig {
         {
           .stageFlags = vk::ShaderStageFlagBits::eFragment,
           .offset = 0,
-          .size = sizeof(glm::vec3)
+          .size = sizeof(glm::vec4)
         }
       },
       .descriptorSetLayouts {
-        objectDescriptorSetLayout,
+        sceneDescriptorSetLayout,
         pointLightDescriptorSetLayout
       },
       .colorFormat = vk::Format::eUndefined,
@@ -182,6 +181,7 @@ namespace vke::PipelineConfig {
   }
 
   inline GraphicsPipelineOptions createEllipticalDotsPipelineOptions(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                                                                     vk::DescriptorSetLayout sceneDescriptorSetLayout,
                                                                      vk::DescriptorSetLayout objectDescriptorSetLayout,
                                                                      vk::DescriptorSetLayout lightingDescriptorSetLayout)
   {
@@ -208,6 +208,7 @@ namespace vke::PipelineConfig {
         }
       },
       .descriptorSetLayouts {
+        sceneDescriptorSetLayout,
         objectDescriptorSetLayout,
         lightingDescriptorSetLayout
       }
@@ -215,6 +216,7 @@ namespace vke::PipelineConfig {
   }
 
   inline GraphicsPipelineOptions createCrossesPipelineOptions(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                                                              vk::DescriptorSetLayout sceneDescriptorSetLayout,
                                                               vk::DescriptorSetLayout objectDescriptorSetLayout,
                                                               vk::DescriptorSetLayout lightingDescriptorSetLayout)
   {
@@ -242,6 +244,7 @@ namespace vke::PipelineConfig {
         }
       },
       .descriptorSetLayouts {
+        sceneDescriptorSetLayout,
         objectDescriptorSetLayout,
         lightingDescriptorSetLayout
       }
@@ -249,6 +252,7 @@ namespace vke::PipelineConfig {
   }
 
   inline GraphicsPipelineOptions createCurtainPipelineOptions(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                                                              vk::DescriptorSetLayout sceneDescriptorSetLayout,
                                                               vk::DescriptorSetLayout objectDescriptorSetLayout,
                                                               vk::DescriptorSetLayout lightingDescriptorSetLayout)
   {
@@ -275,6 +279,7 @@ namespace vke::PipelineConfig {
         }
       },
       .descriptorSetLayouts {
+        sceneDescriptorSetLayout,
         objectDescriptorSetLayout,
         lightingDescriptorSetLayout
       }
@@ -282,6 +287,7 @@ namespace vke::PipelineConfig {
   }
 
   inline GraphicsPipelineOptions createObjectsPipelineOptions(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                                                              vk::DescriptorSetLayout sceneDescriptorSetLayout,
                                                               vk::DescriptorSetLayout objectDescriptorSetLayout,
                                                               vk::DescriptorSetLayout lightingDescriptorSetLayout)
   {
@@ -301,6 +307,7 @@ namespace vke::PipelineConfig {
         .viewportState = gps::viewportState
       },
       .descriptorSetLayouts {
+        sceneDescriptorSetLayout,
         objectDescriptorSetLayout,
         lightingDescriptorSetLayout
       }
@@ -308,6 +315,7 @@ namespace vke::PipelineConfig {
   }
 
   inline GraphicsPipelineOptions createSnakePipelineOptions(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                                                            vk::DescriptorSetLayout sceneDescriptorSetLayout,
                                                             vk::DescriptorSetLayout objectDescriptorSetLayout,
                                                             vk::DescriptorSetLayout lightingDescriptorSetLayout)
   {
@@ -335,6 +343,7 @@ namespace vke::PipelineConfig {
         }
       },
       .descriptorSetLayouts {
+        sceneDescriptorSetLayout,
         objectDescriptorSetLayout,
         lightingDescriptorSetLayout
       }
@@ -342,6 +351,7 @@ namespace vke::PipelineConfig {
   }
 
   inline GraphicsPipelineOptions createNoisyEllipticalDotsPipelineOptions(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                                                                          vk::DescriptorSetLayout sceneDescriptorSetLayout,
                                                                           vk::DescriptorSetLayout objectDescriptorSetLayout,
                                                                           vk::DescriptorSetLayout lightingDescriptorSetLayout,
                                                                           vk::DescriptorSetLayout noiseDescriptorSetLayout)
@@ -369,6 +379,7 @@ namespace vke::PipelineConfig {
         }
       },
       .descriptorSetLayouts {
+        sceneDescriptorSetLayout,
         objectDescriptorSetLayout,
         lightingDescriptorSetLayout,
         noiseDescriptorSetLayout
@@ -377,6 +388,7 @@ namespace vke::PipelineConfig {
   }
 
   inline GraphicsPipelineOptions createBumpyCurtainPipelineOptions(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                                                                   vk::DescriptorSetLayout sceneDescriptorSetLayout,
                                                                    vk::DescriptorSetLayout objectDescriptorSetLayout,
                                                                    vk::DescriptorSetLayout lightingDescriptorSetLayout,
                                                                    vk::DescriptorSetLayout noiseDescriptorSetLayout)
@@ -404,6 +416,7 @@ namespace vke::PipelineConfig {
         }
       },
       .descriptorSetLayouts {
+        sceneDescriptorSetLayout,
         objectDescriptorSetLayout,
         lightingDescriptorSetLayout,
         noiseDescriptorSetLayout
@@ -412,6 +425,7 @@ namespace vke::PipelineConfig {
   }
 
   inline GraphicsPipelineOptions createCubeMapPipelineOptions(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                                                              vk::DescriptorSetLayout sceneDescriptorSetLayout,
                                                               vk::DescriptorSetLayout objectDescriptorSetLayout,
                                                               vk::DescriptorSetLayout cubeMapDescriptorSetLayout)
   {
@@ -438,6 +452,7 @@ namespace vke::PipelineConfig {
         }
       },
       .descriptorSetLayouts {
+        sceneDescriptorSetLayout,
         objectDescriptorSetLayout,
         cubeMapDescriptorSetLayout
       }
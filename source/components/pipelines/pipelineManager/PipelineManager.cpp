@@ -15,11 +15,10 @@ namespace vke {
   PipelineManager::PipelineManager(std::shared_ptr<LogicalDevice> logicalDevice,
                                    const std::shared_ptr<RenderingManager>& renderingManager,
                                    const std::shared_ptr<LightingManager>& lightingManager,
-                                   const std::shared_ptr<AssetManager>& assetManager)
-    : m_logicalDevice(std::move(logicalDevice))
+                                   const std::shared_ptr<AssetManager>& assetManager,
+                                   std::shared_ptr<UploadManager> uploadManager)
+    : m_logicalDevice(std::move(logicalDevice)), m_uploadManager(std::move(uploadManager))
   {
-    createCommandPool();
-
     createDescriptorPool();
 
     createPipelines(assetManager, renderingManager, lightingManager);
@@ -36,11 +35,12 @@ namespace vke {
   void PipelineManager::bindGraphicsPipelineDescriptorSet(const std::shared_ptr<CommandBuffer>& commandBuffer,
                                                           const PipelineType pipelineType,
                                                           const vk::DescriptorSet descriptorSet,
-                                                          const uint32_t location) const
+                                                          const uint32_t location,
+                                                          const std::vector<uint32_t>& dynamicOffsets) const
   {
     const auto& graphicsPipeline = getGraphicsPipeline(pipelineType);
 
-    graphicsPipeline.bindDescriptorSet(commandBuffer, descriptorSet, location);
+    graphicsPipeline.bindDescriptorSet(commandBuffer, descriptorSet, location, dynamicOffsets);
   }
 
   void PipelineManager::renderDotsPipeline(const RenderInfo* renderInfo) const
@@ -73,10 +73,16 @@ namespace vke {
     m_smokePipeline->compute(commandBuffer, currentFrame, systems);
   }
 
+  void PipelineManager::computeLightClusterPipeline(const std::shared_ptr<CommandBuffer>& commandBuffer,
+                                                    const uint32_t currentFrame) const
+  {
+    m_lightClusterPipeline->compute(commandBuffer, currentFrame);
+  }
+
   void PipelineManager::renderLinePipeline(const RenderInfo* renderInfo,
                                            const std::vector<LineVertex>* lineVertices) const
   {
-    m_linePipeline->render(m_logicalDevice, renderInfo, m_commandPool, lineVertices);
+    m_linePipeline->render(renderInfo, m_uploadManager, lineVertices);
   }
 
   void PipelineManager::doRayTracing(const std::shared_ptr<CommandBuffer>& commandBuffer,
@@ -127,70 +133,71 @@ namespace vke {
                                                     const std::shared_ptr<RenderingManager>& renderingManager,
                                                     const std::shared_ptr<LightingManager>& lightingManager)
   {
+    const auto sceneDescriptorSetLayout = renderingManager->getRenderer3D()->getSceneDescriptorSetLayout();
     const auto objectDescriptorSetLayout = assetManager->getObjectDescriptorSetLayout();
     const auto lightingDescriptorSetLayout = lightingManager->getLightingDescriptorSet()->getDescriptorSetLayout();
 
     createGraphicsPipeline(PipelineType::object,
-      PipelineConfig::createObjectsPipelineOptions(m_logicalDevice, objectDescriptorSetLayout,
+      PipelineConfig::createObjectsPipelineOptions(m_logicalDevice, sceneDescriptorSetLayout, objectDescriptorSetLayout,
       lightingDescriptorSetLayout));
 
     createGraphicsPipeline(PipelineType::objectHighlight,
-      PipelineConfig::createObjectHighlightPipelineOptions(m_logicalDevice, objectDescriptorSetLayout));
+      PipelineConfig::createObjectHighlightPipelineOptions(m_logicalDevice, sceneDescriptorSetLayout, objectDescriptorSetLayout));
 
     createGraphicsPipeline(PipelineType::ellipticalDots,
-      PipelineConfig::createEllipticalDotsPipelineOptions(m_logicalDevice, objectDescriptorSetLayout,
+      PipelineConfig::createEllipticalDotsPipelineOptions(m_logicalDevice, sceneDescriptorSetLayout, objectDescriptorSetLayout,
       lightingDescriptorSetLayout));
 
     createGraphicsPipeline(PipelineType::noisyEllipticalDots,
-      PipelineConfig::createNoisyEllipticalDotsPipelineOptions(m_logicalDevice, objectDescriptorSetLayout,
+      PipelineConfig::createNoisyEllipticalDotsPipelineOptions(m_logicalDevice, sceneDescriptorSetLayout, objectDescriptorSetLayout,
       lightingDescriptorSetLayout, renderingManager->getRenderer3D()->getNoiseDescriptorSetLayout()));
 
     createGraphicsPipeline(PipelineType::bumpyCurtain,
-      PipelineConfig::createBumpyCurtainPipelineOptions(m_logicalDevice, objectDescriptorSetLayout,
+      PipelineConfig::createBumpyCurtainPipelineOptions(m_logicalDevice, sceneDescriptorSetLayout, objectDescriptorSetLayout,
       lightingDescriptorSetLayout, renderingManager->getRenderer3D()->getNoiseDescriptorSetLayout()));
 
     createGraphicsPipeline(PipelineType::curtain,
-      PipelineConfig::createCurtainPipelineOptions(m_logicalDevice, objectDescriptorSetLayout,
+      PipelineConfig::createCurtainPipelineOptions(m_logicalDevice, sceneDescriptorSetLayout, objectDescriptorSetLayout,
       lightingDescriptorSetLayout));
 
     createGraphicsPipeline(PipelineType::cubeMap,
-      PipelineConfig::createCubeMapPipelineOptions(m_logicalDevice, objectDescriptorSetLayout,
+      PipelineConfig::createCubeMapPipelineOptions(m_logicalDevice, sceneDescriptorSetLayout, objectDescriptorSetLayout,
       renderingManager->getRenderer3D()->getCubeMapDescriptorSetLayout()));
 
     createGraphicsPipeline(PipelineType::texturedPlane,
-      PipelineConfig::createTexturedPlanePipelineOptions(m_logicalDevice, objectDescriptorSetLayout));
+      PipelineConfig::createTexturedPlanePipelineOptions(m_logicalDevice, sceneDescriptorSetLayout, objectDescriptorSetLayout));
 
     createGraphicsPipeline(PipelineType::magnifyWhirlMosaic,
-      PipelineConfig::createMagnifyWhirlMosaicPipelineOptions(m_logicalDevice, objectDescriptorSetLayout));
+      PipelineConfig::createMagnifyWhirlMosaicPipelineOptions(m_logicalDevice, sceneDescriptorSetLayout, objectDescriptorSetLayout));
 
     createGraphicsPipeline(PipelineType::snake,
-      PipelineConfig::createSnakePipelineOptions(m_logicalDevice, objectDescriptorSetLayout,
+      PipelineConfig::createSnakePipelineOptions(m_logicalDevice, sceneDescriptorSetLayout, objectDescriptorSetLayout,
       lightingDescriptorSetLayout));
 
     createGraphicsPipeline(PipelineType::crosses,
-      PipelineConfig::createCrossesPipelineOptions(m_logicalDevice, objectDescriptorSetLayout,
+      PipelineConfig::createCrossesPipelineOptions(m_logicalDevice, sceneDescriptorSetLayout, objectDescriptorSetLayout,
       lightingDescriptorSetLayout));
 
     createGraphicsPipeline(PipelineType::shadow,
-      PipelineConfig::createShadowMapPipelineOptions(objectDescriptorSetLayout));
+      PipelineConfig::createShadowMapPipelineOptions(sceneDescriptorSetLayout));
 
     createGraphicsPipeline(PipelineType::pointLightShadowMap,
-      PipelineConfig::createPointLightShadowMapPipelineOptions(objectDescriptorSetLayout,
+      PipelineConfig::createPointLightShadowMapPipelineOptions(sceneDescriptorSetLayout,
       lightingManager->getPointLightDescriptorSetLayout()));
 
     createGraphicsPipeline(PipelineType::mousePicking,
-      PipelineConfig::createMousePickingPipelineOptions(objectDescriptorSetLayout));
+      PipelineConfig::createMousePickingPipelineOptions(sceneDescriptorSetLayout));
   }
 
   void PipelineManager::createMiscPipelines(const std::shared_ptr<AssetManager>& assetManager,
                                             const std::shared_ptr<LightingManager>& lightingManager)
   {
-    m_dotsPipeline = std::make_unique<DotsPipeline>(m_logicalDevice, m_commandPool, m_descriptorPool);
+    m_dotsPipeline = std::make_unique<DotsPipeline>(m_logicalDevice, m_uploadManager, m_descriptorPool);
 
     m_linePipeline = std::make_unique<LinePipeline>(m_logicalDevice);
 
     m_bendyPipeline = std::make_unique<BendyPipeline>(
-      m_logicalDevice, m_commandPool, m_descriptorPool, lightingManager->getLightingDescriptorSet());
+      m_logicalDevice, m_uploadManager, m_descriptorPool, lightingManager->getLightingDescriptorSet());
 
     createGraphicsPipeline(PipelineType::grid,
       PipelineConfig::createGridPipelineOptions(m_logicalDevice));
@@ -198,15 +205,9 @@ namespace vke {
     m_smokePipeline = std::make_unique<SmokePipeline>(
       m_logicalDevice, lightingManager->getLightingDescriptorSet(),
       assetManager->getSmokeSystemDescriptorSetLayout());
-  }
-
-  void PipelineManager::createCommandPool()
-  {
-    const vk::CommandPoolCreateInfo poolInfo {
-      .queueFamilyIndex = m_logicalDevice->getPhysicalDevice()->getQueueFamilies().graphicsFamily.value()
-    };
 
-    m_commandPool = m_logicalDevice->createCommandPool(poolInfo);
+    m_lightClusterPipeline = std::make_unique<LightClusterPipeline>(
+      m_logicalDevice, lightingManager->getLightingDescriptorSet());
   }
 
   void PipelineManager::createDescriptorPool()
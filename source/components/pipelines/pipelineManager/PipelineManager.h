@@ -4,6 +4,7 @@
 #include "../RayTracingPipeline.h"
 #include "../implementations/BendyPipeline.h"
 #include "../implementations/DotsPipeline.h"
+#include "../implementations/LightClusterPipeline.h"
 #include "../implementations/LinePipeline.h"
 #include "../implementations/SmokePipeline.h"
 #include "../implementations/common/PipelineTypes.h"
@@ -17,13 +18,15 @@ namespace vke {
   class AssetManager;
   class LightingManager;
   class RenderingManager;
+  class UploadManager;
 
   class PipelineManager {
   public:
     PipelineManager(std::shared_ptr<LogicalDevice> logicalDevice,
                     const std::shared_ptr<RenderingManager>& renderingManager,
                     const std::shared_ptr<LightingManager>& lightingManager,
-                    const std::shared_ptr<AssetManager>& assetManager);
+                    const std::shared_ptr<AssetManager>& assetManager,
+                    std::shared_ptr<UploadManager> uploadManager);
 
     void bindGraphicsPipeline(const std::shared_ptr<CommandBuffer>& commandBuffer,
                               PipelineType pipelineType) const;
@@ -38,7 +41,8 @@ namespace vke {
     void bindGraphicsPipelineDescriptorSet(const std::shared_ptr<CommandBuffer>& commandBuffer,
                                            PipelineType pipelineType,
                                            vk::DescriptorSet descriptorSet,
-                                           uint32_t location) const;
+                                           uint32_t location,
+                                           const std::vector<uint32_t>& dynamicOffsets = {}) const;
 
     void renderDotsPipeline(const RenderInfo* renderInfo) const;
 
@@ -55,6 +59,9 @@ namespace vke {
                               uint32_t currentFrame,
                               const std::vector<std::shared_ptr<SmokeSystem>>* systems) const;
 
+    void computeLightClusterPipeline(const std::shared_ptr<CommandBuffer>& commandBuffer,
+                                     uint32_t currentFrame) const;
+
     void renderLinePipeline(const RenderInfo* renderInfo,
                             const std::vector<LineVertex>* lineVertices) const;
 
@@ -74,7 +81,7 @@ namespace vke {
   private:
     std::shared_ptr<LogicalDevice> m_logicalDevice;
 
-    vk::raii::CommandPool m_commandPool = nullptr;
+    std::shared_ptr<UploadManager> m_uploadManager;
 
     vk::raii::DescriptorPool m_descriptorPool = nullptr;
 
@@ -82,6 +89,8 @@ namespace vke {
 
     std::unique_ptr<SmokePipeline> m_smokePipeline;
 
+    std::unique_ptr<LightClusterPipeline> m_lightClusterPipeline;
+
     std::unique_ptr<LinePipeline> m_linePipeline;
 
     std::unique_ptr<BendyPipeline> m_bendyPipeline;
@@ -106,8 +115,6 @@ namespace vke {
     void createMiscPipelines(const std::shared_ptr<AssetManager>& assetManager,
                              const std::shared_ptr<LightingManager>& lightingManager);
 
-    void createCommandPool();
-
     void createDescriptorPool();
 
     [[nodiscard]] const GraphicsPipeline& getGraphicsPipeline(PipelineType pipelineType) const;
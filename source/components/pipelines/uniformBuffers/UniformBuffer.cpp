@@ -1,7 +1,9 @@
 #include "UniformBuffer.h"
 #include "../../logicalDevice/LogicalDevice.h"
 #include "../../../utilities/Buffers.h"
+#include <cstddef>
 #include <cstring>
+#include <stdexcept>
 
 namespace vke {
 
@@ -23,7 +25,7 @@ namespace vke {
                             m_uniformBuffers.emplace_back(nullptr),
                             m_uniformBuffersMemory.emplace_back(nullptr));
 
-      m_uniformBuffersMapped[i] = m_uniformBuffersMemory[i].mapMemory(0, m_bufferSize, vk::MemoryMapFlags{});
+      m_uniformBuffersMapped[i] = m_uniformBuffersMemory[i].getMappedData();
 
       m_bufferInfos.push_back({
         .buffer = *m_uniformBuffers[i],
@@ -35,7 +37,7 @@ namespace vke {
 
   UniformBuffer::~UniformBuffer()
   {
-    m_logicalDevice->waitIdle();
+    m_logicalDevice->retire(std::move(m_uniformBuffers), std::move(m_uniformBuffersMemory));
   }
 
   vk::WriteDescriptorSet UniformBuffer::getDescriptorSet(const uint32_t binding,
@@ -60,4 +62,22 @@ namespace vke {
     memcpy(m_uniformBuffersMapped[frame], data, m_bufferSize);
   }
 
+  void UniformBuffer::update(const uint32_t frame,
+                             const void* data,
+                             const vk::DeviceSize size,
+                             const vk::DeviceSize offset) const
+  {
+    if (offset > m_bufferSize || size > m_bufferSize - offset)
+    {
+      throw std::runtime_error("uniform buffer write out of range!");
+    }
+
+    memcpy(static_cast<std::byte*>(m_uniformBuffersMapped[frame]) + offset, data, size);
+  }
+
+  vk::Buffer UniformBuffer::getBuffer(const size_t frame) const
+  {
+    return *m_uniformBuffers[frame];
+  }
+
 } // namespace vke
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef VKE_UNIFORMBUFFER_H
 #define VKE_UNIFORMBUFFER_H
 
+#include "../../memory/MemoryAllocation.h"
 #include <vulkan/vulkan_raii.hpp>
 #include <memory>
 #include <vector>
@@ -23,11 +24,20 @@ namespace vke {
     void update(uint32_t frame,
                 const void* data) const;
 
+    // Writes size bytes of the frame's buffer starting at offset, for buffers sized to a capacity rather than their contents.
+    // Throws if the write would run past the end of the buffer
+    void update(uint32_t frame,
+                const void* data,
+                vk::DeviceSize size,
+                vk::DeviceSize offset = 0) const;
+
+    [[nodiscard]] vk::Buffer getBuffer(size_t frame) const;
+
   protected:
     std::shared_ptr<LogicalDevice> m_logicalDevice;
 
     std::vector<vk::raii::Buffer> m_uniformBuffers;
-    std::vector<vk::raii::DeviceMemory> m_uniformBuffersMemory;
+    std::vector<MemoryAllocation> m_uniformBuffersMemory;
     std::vector<void*> m_uniformBuffersMapped;
 
     std::vector<vk::DescriptorBufferInfo> m_bufferInfos;
@@ -0,0 +1,219 @@
+#include "CpuProfiler.h"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace vke {
+
+  namespace {
+
+    struct CpuTraceEvent {
+      const char* name;
+      int64_t start;
+      int64_t end;
+    };
+
+    // Only its owning thread writes events, readers see everything published through count
+    struct ThreadTraceBuffer {
+      explicit ThreadTraceBuffer(const uint32_t capacity, const uint32_t threadId)
+        : events(std::make_unique<CpuTraceEvent[]>(capacity)), capacity(capacity), threadId(threadId)
+      {}
+
+      std::unique_ptr<CpuTraceEvent[]> events;
+      uint32_t capacity;
+      std::atomic<uint32_t> count = 0;
+
+      uint32_t threadId;
+      std::atomic<const char*> threadName = nullptr;
+    };
+
+    struct CpuProfilerState {
+      std::mutex registryMutex;
+      std::vector<std::shared_ptr<ThreadTraceBuffer>> threadBuffers;
+
+      std::atomic<bool> recording = true;
+      std::atomic<uint32_t> threadEventCapacity = 1 << 18;
+      std::atomic<uint64_t> droppedEvents = 0;
+
+      const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    };
+
+    CpuProfilerState& getState()
+    {
+      static CpuProfilerState state;
+      return state;
+    }
+
+    int64_t now()
+    {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - getState().epoch).count();
+    }
+
+    ThreadTraceBuffer& getThreadBuffer()
+    {
+      // The registry lock is only taken the first time a thread records
+      thread_local const std::shared_ptr<ThreadTraceBuffer> threadBuffer = [] {
+        auto& state = getState();
+
+        const std::lock_guard lock(state.registryMutex);
+
+        auto buffer = std::make_shared<ThreadTraceBuffer>(state.threadEventCapacity.load(),
+                                                          static_cast<uint32_t>(state.threadBuffers.size()));
+        state.threadBuffers.push_back(buffer);
+
+        return buffer;
+      }();
+
+      return *threadBuffer;
+    }
+
+    void writeEscapedString(std::ofstream& file,
+                            const char* string)
+    {
+      for (const char* c = string; *c != '\0'; ++c)
+      {
+        if (*c == '"' || *c == '\\')
+        {
+          file << '\\';
+        }
+
+        file << *c;
+      }
+    }
+
+  } // namespace
+
+  namespace CpuProfiler {
+
+    void setThreadEventCapacity(const uint32_t capacity)
+    {
+      getState().threadEventCapacity = capacity;
+    }
+
+    void startRecording()
+    {
+      getState().recording = true;
+    }
+
+    void stopRecording()
+    {
+      getState().recording = false;
+    }
+
+    bool isRecording()
+    {
+      return getState().recording.load(std::memory_order_relaxed);
+    }
+
+    void clear()
+    {
+      auto& state = getState();
+
+      const std::lock_guard lock(state.registryMutex);
+
+      for (const auto& threadBuffer : state.threadBuffers)
+      {
+        threadBuffer->count.store(0, std::memory_order_release);
+      }
+
+      state.droppedEvents = 0;
+    }
+
+    void setThreadName(const char* name)
+    {
+      getThreadBuffer().threadName = name;
+    }
+
+    uint64_t getDroppedEventCount()
+    {
+      return getState().droppedEvents.load();
+    }
+
+    void writeChromeTrace(const std::string& path)
+    {
+      std::ofstream file(path);
+
+      if (!file.is_open())
+      {
+        throw std::runtime_error("Failed to open CPU trace file: " + path);
+      }
+
+      auto& state = getState();
+
+      const std::lock_guard lock(state.registryMutex);
+
+      file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+      bool first = true;
+
+      for (const auto& threadBuffer : state.threadBuffers)
+      {
+        if (const char* threadName = threadBuffer->threadName.load())
+        {
+          file << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+               << threadBuffer->threadId << ",\"args\":{\"name\":\"";
+          writeEscapedString(file, threadName);
+          file << "\"}}";
+
+          first = false;
+        }
+
+        const uint32_t count = threadBuffer->count.load(std::memory_order_acquire);
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+          const auto& event = threadBuffer->events[i];
+
+          file << (first ? "" : ",") << "\n{\"name\":\"";
+          writeEscapedString(file, event.name);
+          file << "\",\"cat\":\"vke\",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadBuffer->threadId
+               << ",\"ts\":" << static_cast<double>(event.start) / 1000.0
+               << ",\"dur\":" << static_cast<double>(event.end - event.start) / 1000.0 << "}";
+
+          first = false;
+        }
+      }
+
+      file << "\n]}\n";
+    }
+
+  } // namespace CpuProfiler
+
+  CpuProfilerZone::CpuProfilerZone(const char* name)
+    : m_name(name), m_start(CpuProfiler::isRecording() ? now() : -1)
+  {}
+
+  CpuProfilerZone::~CpuProfilerZone()
+  {
+    if (m_start < 0)
+    {
+      return;
+    }
+
+    const int64_t end = now();
+
+    auto& threadBuffer = getThreadBuffer();
+
+    const uint32_t index = threadBuffer.count.load(std::memory_order_relaxed);
+
+    if (index >= threadBuffer.capacity)
+    {
+      getState().droppedEvents.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    threadBuffer.events[index] = CpuTraceEvent {
+      .name = m_name,
+      .start = m_start,
+      .end = end
+    };
+
+    threadBuffer.count.store(index + 1, std::memory_order_release);
+  }
+
+} // namespace vke
@@ -0,0 +1,59 @@
+#ifndef VKE_CPUPROFILER_H
+#define VKE_CPUPROFILER_H
+
+#include <cstdint>
+#include <string>
+
+// Zones compile away entirely unless the engine is built with VKE_ENABLE_CPU_PROFILING
+#ifdef VKE_ENABLE_CPU_PROFILING
+  #define VKE_PROFILE_CONCAT_INNER(a, b) a##b
+  #define VKE_PROFILE_CONCAT(a, b) VKE_PROFILE_CONCAT_INNER(a, b)
+  #define VKE_PROFILE_ZONE(name) const vke::CpuProfilerZone VKE_PROFILE_CONCAT(vkeProfilerZone, __LINE__)(name)
+#else
+  #define VKE_PROFILE_ZONE(name) static_cast<void>(0)
+#endif
+
+namespace vke {
+
+  namespace CpuProfiler {
+
+    // Events recorded per thread before further zones are dropped, takes effect for threads that have not recorded yet
+    void setThreadEventCapacity(uint32_t capacity);
+
+    void startRecording();
+
+    void stopRecording();
+
+    [[nodiscard]] bool isRecording();
+
+    // Must not race with zones being recorded on other threads
+    void clear();
+
+    void setThreadName(const char* name);
+
+    [[nodiscard]] uint64_t getDroppedEventCount();
+
+    // Writes every recorded zone as Chrome trace_event JSON, viewable in chrome://tracing or Perfetto
+    void writeChromeTrace(const std::string& path);
+
+  } // namespace CpuProfiler
+
+  class CpuProfilerZone {
+  public:
+    // The name must outlive the recording, string literals are expected
+    explicit CpuProfilerZone(const char* name);
+
+    ~CpuProfilerZone();
+
+    CpuProfilerZone(const CpuProfilerZone&) = delete;
+    CpuProfilerZone& operator=(const CpuProfilerZone&) = delete;
+
+  private:
+    const char* m_name;
+
+    int64_t m_start;
+  };
+
+} // namespace vke
+
+#endif //VKE_CPUPROFILER_H
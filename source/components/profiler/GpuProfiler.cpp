@@ -0,0 +1,377 @@
+#include "GpuProfiler.h"
+#include "../commandBuffer/CommandBuffer.h"
+#include "../logicalDevice/LogicalDevice.h"
+#include "../physicalDevice/PhysicalDevice.h"
+#include <imgui.h>
+
+namespace vke {
+
+  constexpr uint32_t MAX_GPU_ZONES = 64;
+
+  constexpr vk::QueryPipelineStatisticFlags PIPELINE_STATISTICS =
+    vk::QueryPipelineStatisticFlagBits::eInputAssemblyPrimitives |
+    vk::QueryPipelineStatisticFlagBits::eVertexShaderInvocations |
+    vk::QueryPipelineStatisticFlagBits::eClippingPrimitives |
+    vk::QueryPipelineStatisticFlagBits::eFragmentShaderInvocations;
+
+  // Statistics are written in bit order, one value per enabled flag
+  constexpr uint32_t PIPELINE_STATISTICS_COUNT = 4;
+
+  GpuProfiler::GpuProfiler(std::shared_ptr<LogicalDevice> logicalDevice,
+                           const bool enabled,
+                           const bool collectPipelineStatistics,
+                           const bool displayOverlay)
+    : m_logicalDevice(std::move(logicalDevice)),
+      m_enabled(enabled),
+      m_pipelineStatisticsSupported(m_logicalDevice->getPhysicalDevice()->supportsPipelineStatistics()),
+      m_pipelineStatisticsEnabled(collectPipelineStatistics && m_pipelineStatisticsSupported),
+      m_overlayEnabled(displayOverlay)
+  {
+    const auto physicalDevice = m_logicalDevice->getPhysicalDevice();
+
+    m_timestampPeriod = physicalDevice->getDeviceProperties().limits.timestampPeriod;
+
+    const auto queueFamilies = physicalDevice->getQueueFamilies();
+
+    const std::array<std::pair<GpuQueue, uint32_t>, 2> queues {{
+      { GpuQueue::graphics, queueFamilies.graphicsFamily.value() },
+      { GpuQueue::compute, queueFamilies.computeFamily.value() }
+    }};
+
+    for (const auto& [queue, queueFamilyIndex] : queues)
+    {
+      auto& queueProfiler = getQueueProfiler(queue);
+
+      const uint32_t validBits = physicalDevice->getTimestampValidBits(queueFamilyIndex);
+
+      if (validBits == 0)
+      {
+        continue;
+      }
+
+      queueProfiler.timestampMask = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+
+      createQueryPools(queueProfiler, queue);
+    }
+  }
+
+  void GpuProfiler::beginFrame(const GpuQueue queue,
+                               const uint32_t currentFrame)
+  {
+    auto& queueProfiler = getQueueProfiler(queue);
+
+    queueProfiler.currentFrame = currentFrame;
+    queueProfiler.zoneStack.clear();
+    queueProfiler.statisticsQueryActive = false;
+
+    if (queueProfiler.timestampMask == 0)
+    {
+      return;
+    }
+
+    collectResults(queueProfiler);
+
+    auto& frame = queueProfiler.frames.at(currentFrame);
+
+    frame.timestampQueryPool.reset(0, MAX_GPU_ZONES * 2);
+
+    if (*frame.statisticsQueryPool)
+    {
+      frame.statisticsQueryPool.reset(0, MAX_GPU_ZONES);
+    }
+
+    frame.zones.clear();
+    frame.statisticsQueryCount = 0;
+  }
+
+  void GpuProfiler::beginZone(const std::shared_ptr<CommandBuffer>& commandBuffer,
+                              const GpuQueue queue,
+                              std::string name,
+                              const bool collectStatistics)
+  {
+    auto& queueProfiler = getQueueProfiler(queue);
+
+    if (!m_enabled || queueProfiler.timestampMask == 0 ||
+        queueProfiler.frames.at(queueProfiler.currentFrame).zones.size() >= MAX_GPU_ZONES)
+    {
+      queueProfiler.zoneStack.emplace_back(std::nullopt);
+      return;
+    }
+
+    auto& frame = queueProfiler.frames.at(queueProfiler.currentFrame);
+
+    GpuProfilerZone zone {
+      .name = std::move(name),
+      .depth = static_cast<uint32_t>(queueProfiler.zoneStack.size()),
+      .timestampQuery = static_cast<uint32_t>(frame.zones.size() * 2)
+    };
+
+    commandBuffer->writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, *frame.timestampQueryPool, zone.timestampQuery);
+
+    // Only one pipeline statistics query can be active at a time, so nested zones go without
+    if (collectStatistics && m_pipelineStatisticsEnabled && *frame.statisticsQueryPool &&
+        !queueProfiler.statisticsQueryActive)
+    {
+      zone.statisticsQuery = frame.statisticsQueryCount++;
+      queueProfiler.statisticsQueryActive = true;
+
+      commandBuffer->beginQuery(*frame.statisticsQueryPool, zone.statisticsQuery.value());
+    }
+
+    queueProfiler.zoneStack.emplace_back(static_cast<uint32_t>(frame.zones.size()));
+    frame.zones.push_back(std::move(zone));
+  }
+
+  void GpuProfiler::endZone(const std::shared_ptr<CommandBuffer>& commandBuffer,
+                            const GpuQueue queue)
+  {
+    auto& queueProfiler = getQueueProfiler(queue);
+
+    if (queueProfiler.zoneStack.empty())
+    {
+      return;
+    }
+
+    const auto zoneIndex = queueProfiler.zoneStack.back();
+    queueProfiler.zoneStack.pop_back();
+
+    if (!zoneIndex.has_value())
+    {
+      return;
+    }
+
+    auto& frame = queueProfiler.frames.at(queueProfiler.currentFrame);
+    auto& zone = frame.zones.at(zoneIndex.value());
+
+    if (zone.statisticsQuery.has_value())
+    {
+      commandBuffer->endQuery(*frame.statisticsQueryPool, zone.statisticsQuery.value());
+      queueProfiler.statisticsQueryActive = false;
+    }
+
+    commandBuffer->writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, *frame.timestampQueryPool, zone.timestampQuery + 1);
+
+    zone.ended = true;
+  }
+
+  const std::vector<GpuZoneResult>& GpuProfiler::getResults(const GpuQueue queue) const
+  {
+    return getQueueProfiler(queue).results;
+  }
+
+  double GpuProfiler::getFrameTime(const GpuQueue queue) const
+  {
+    double frameTime = 0.0;
+
+    for (const auto& result : getQueueProfiler(queue).results)
+    {
+      if (result.depth == 0)
+      {
+        frameTime += result.durationMs;
+      }
+    }
+
+    return frameTime;
+  }
+
+  void GpuProfiler::enable()
+  {
+    m_enabled = true;
+  }
+
+  void GpuProfiler::disable()
+  {
+    m_enabled = false;
+  }
+
+  bool GpuProfiler::isEnabled() const
+  {
+    return m_enabled;
+  }
+
+  void GpuProfiler::setPipelineStatisticsEnabled(const bool enabled)
+  {
+    m_pipelineStatisticsEnabled = enabled && m_pipelineStatisticsSupported;
+  }
+
+  bool GpuProfiler::isPipelineStatisticsEnabled() const
+  {
+    return m_pipelineStatisticsEnabled;
+  }
+
+  void GpuProfiler::setOverlayEnabled(const bool enabled)
+  {
+    m_overlayEnabled = enabled;
+  }
+
+  bool GpuProfiler::isOverlayEnabled() const
+  {
+    return m_overlayEnabled;
+  }
+
+  void GpuProfiler::displayGui() const
+  {
+    if (!m_overlayEnabled)
+    {
+      return;
+    }
+
+    ImGui::Begin("GPU Profiler");
+
+    displayQueueGui("Graphics", getQueueProfiler(GpuQueue::graphics));
+
+    displayQueueGui("Compute", getQueueProfiler(GpuQueue::compute));
+
+    ImGui::End();
+  }
+
+  void GpuProfiler::createQueryPools(QueueProfiler& queueProfiler,
+                                     const GpuQueue queue) const
+  {
+    const auto numFrames = m_logicalDevice->getMaxFramesInFlight();
+
+    queueProfiler.frames.resize(numFrames);
+
+    for (auto& frame : queueProfiler.frames)
+    {
+      constexpr vk::QueryPoolCreateInfo timestampQueryPoolCreateInfo {
+        .queryType = vk::QueryType::eTimestamp,
+        .queryCount = MAX_GPU_ZONES * 2
+      };
+
+      frame.timestampQueryPool = m_logicalDevice->createQueryPool(timestampQueryPoolCreateInfo);
+      frame.timestampQueryPool.reset(0, MAX_GPU_ZONES * 2);
+
+      // Graphics pipeline statistics can only be queried on a graphics queue
+      if (!m_pipelineStatisticsSupported || queue != GpuQueue::graphics)
+      {
+        continue;
+      }
+
+      constexpr vk::QueryPoolCreateInfo statisticsQueryPoolCreateInfo {
+        .queryType = vk::QueryType::ePipelineStatistics,
+        .queryCount = MAX_GPU_ZONES,
+        .pipelineStatistics = PIPELINE_STATISTICS
+      };
+
+      frame.statisticsQueryPool = m_logicalDevice->createQueryPool(statisticsQueryPoolCreateInfo);
+      frame.statisticsQueryPool.reset(0, MAX_GPU_ZONES);
+    }
+  }
+
+  void GpuProfiler::collectResults(QueueProfiler& queueProfiler) const
+  {
+    const auto& frame = queueProfiler.frames.at(queueProfiler.currentFrame);
+
+    if (frame.zones.empty())
+    {
+      queueProfiler.results.clear();
+      return;
+    }
+
+    for (const auto& zone : frame.zones)
+    {
+      if (!zone.ended)
+      {
+        return;
+      }
+    }
+
+    const auto timestampCount = static_cast<uint32_t>(frame.zones.size() * 2);
+
+    // The frame has already been waited on, so this never blocks
+    const auto [timestampResult, timestamps] = frame.timestampQueryPool.getResults<uint64_t>(
+      0, timestampCount, timestampCount * sizeof(uint64_t), sizeof(uint64_t), vk::QueryResultFlagBits::e64);
+
+    if (timestampResult != vk::Result::eSuccess)
+    {
+      return;
+    }
+
+    std::vector<uint64_t> statistics;
+
+    if (frame.statisticsQueryCount > 0)
+    {
+      constexpr auto stride = PIPELINE_STATISTICS_COUNT * sizeof(uint64_t);
+
+      auto [statisticsResult, statisticsValues] = frame.statisticsQueryPool.getResults<uint64_t>(
+        0, frame.statisticsQueryCount, frame.statisticsQueryCount * stride, stride, vk::QueryResultFlagBits::e64);
+
+      if (statisticsResult == vk::Result::eSuccess)
+      {
+        statistics = std::move(statisticsValues);
+      }
+    }
+
+    queueProfiler.results.clear();
+    queueProfiler.results.reserve(frame.zones.size());
+
+    for (const auto& zone : frame.zones)
+    {
+      const uint64_t begin = timestamps[zone.timestampQuery] & queueProfiler.timestampMask;
+      const uint64_t end = timestamps[zone.timestampQuery + 1] & queueProfiler.timestampMask;
+      const uint64_t ticks = (end - begin) & queueProfiler.timestampMask;
+
+      GpuZoneResult result {
+        .name = zone.name,
+        .depth = zone.depth,
+        .durationMs = static_cast<double>(ticks) * m_timestampPeriod / 1000000.0
+      };
+
+      if (zone.statisticsQuery.has_value() && !statistics.empty())
+      {
+        const auto offset = zone.statisticsQuery.value() * PIPELINE_STATISTICS_COUNT;
+
+        result.statistics = GpuPipelineStatistics {
+          .inputAssemblyPrimitives = statistics[offset],
+          .vertexShaderInvocations = statistics[offset + 1],
+          .clippingPrimitives = statistics[offset + 2],
+          .fragmentShaderInvocations = statistics[offset + 3]
+        };
+      }
+
+      queueProfiler.results.push_back(std::move(result));
+    }
+  }
+
+  GpuProfiler::QueueProfiler& GpuProfiler::getQueueProfiler(const GpuQueue queue)
+  {
+    return m_queueProfilers.at(static_cast<size_t>(queue));
+  }
+
+  const GpuProfiler::QueueProfiler& GpuProfiler::getQueueProfiler(const GpuQueue queue) const
+  {
+    return m_queueProfilers.at(static_cast<size_t>(queue));
+  }
+
+  void GpuProfiler::displayQueueGui(const char* label,
+                                    const QueueProfiler& queueProfiler)
+  {
+    ImGui::SeparatorText(label);
+
+    if (queueProfiler.timestampMask == 0)
+    {
+      ImGui::Text("Timestamps are not supported on this queue");
+      return;
+    }
+
+    for (const auto& result : queueProfiler.results)
+    {
+      const auto indent = static_cast<int>(result.depth * 2);
+
+      ImGui::Text("%*s%s: %.3f ms", indent, "", result.name.c_str(), result.durationMs);
+
+      if (result.statistics.has_value())
+      {
+        ImGui::Text("%*s  primitives: %llu, clipped: %llu", indent, "",
+                    static_cast<unsigned long long>(result.statistics->inputAssemblyPrimitives),
+                    static_cast<unsigned long long>(result.statistics->clippingPrimitives));
+
+        ImGui::Text("%*s  vertex invocations: %llu, fragment invocations: %llu", indent, "",
+                    static_cast<unsigned long long>(result.statistics->vertexShaderInvocations),
+                    static_cast<unsigned long long>(result.statistics->fragmentShaderInvocations));
+      }
+    }
+  }
+
+} // namespace vke
@@ -0,0 +1,137 @@
+#ifndef VKE_GPUPROFILER_H
+#define VKE_GPUPROFILER_H
+
+#include <vulkan/vulkan_raii.hpp>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace vke {
+
+  class CommandBuffer;
+  class LogicalDevice;
+
+  enum class GpuQueue {
+    graphics,
+    compute
+  };
+
+  struct GpuPipelineStatistics {
+    uint64_t inputAssemblyPrimitives = 0;
+    uint64_t vertexShaderInvocations = 0;
+    uint64_t clippingPrimitives = 0;
+    uint64_t fragmentShaderInvocations = 0;
+  };
+
+  struct GpuZoneResult {
+    std::string name;
+    uint32_t depth = 0;
+    double durationMs = 0.0;
+    std::optional<GpuPipelineStatistics> statistics;
+  };
+
+  struct GpuProfilerZone {
+    std::string name;
+    uint32_t depth = 0;
+    uint32_t timestampQuery = 0;
+    std::optional<uint32_t> statisticsQuery;
+    bool ended = false;
+  };
+
+  struct GpuProfilerFrame {
+    vk::raii::QueryPool timestampQueryPool = nullptr;
+    vk::raii::QueryPool statisticsQueryPool = nullptr;
+
+    std::vector<GpuProfilerZone> zones;
+
+    uint32_t statisticsQueryCount = 0;
+  };
+
+  class GpuProfiler {
+  public:
+    GpuProfiler(std::shared_ptr<LogicalDevice> logicalDevice,
+                bool enabled,
+                bool collectPipelineStatistics,
+                bool displayOverlay);
+
+    // Collects the results of the last use of this frame's queries, the frame must already have been waited on
+    void beginFrame(GpuQueue queue,
+                    uint32_t currentFrame);
+
+    void beginZone(const std::shared_ptr<CommandBuffer>& commandBuffer,
+                   GpuQueue queue,
+                   std::string name,
+                   bool collectStatistics = false);
+
+    void endZone(const std::shared_ptr<CommandBuffer>& commandBuffer,
+                 GpuQueue queue);
+
+    [[nodiscard]] const std::vector<GpuZoneResult>& getResults(GpuQueue queue) const;
+
+    [[nodiscard]] double getFrameTime(GpuQueue queue) const;
+
+    void enable();
+
+    void disable();
+
+    [[nodiscard]] bool isEnabled() const;
+
+    void setPipelineStatisticsEnabled(bool enabled);
+
+    [[nodiscard]] bool isPipelineStatisticsEnabled() const;
+
+    void setOverlayEnabled(bool enabled);
+
+    [[nodiscard]] bool isOverlayEnabled() const;
+
+    void displayGui() const;
+
+  private:
+    struct QueueProfiler {
+      std::vector<GpuProfilerFrame> frames;
+
+      uint32_t currentFrame = 0;
+
+      std::vector<std::optional<uint32_t>> zoneStack;
+
+      bool statisticsQueryActive = false;
+
+      std::vector<GpuZoneResult> results;
+
+      // Zero when the queue family does not support timestamps
+      uint64_t timestampMask = 0;
+    };
+
+    std::shared_ptr<LogicalDevice> m_logicalDevice;
+
+    std::array<QueueProfiler, 2> m_queueProfilers;
+
+    double m_timestampPeriod = 1.0;
+
+    bool m_enabled;
+
+    bool m_pipelineStatisticsSupported;
+
+    bool m_pipelineStatisticsEnabled;
+
+    bool m_overlayEnabled;
+
+    void createQueryPools(QueueProfiler& queueProfiler,
+                          GpuQueue queue) const;
+
+    void collectResults(QueueProfiler& queueProfiler) const;
+
+    [[nodiscard]] QueueProfiler& getQueueProfiler(GpuQueue queue);
+
+    [[nodiscard]] const QueueProfiler& getQueueProfiler(GpuQueue queue) const;
+
+    static void displayQueueGui(const char* label,
+                                const QueueProfiler& queueProfiler);
+  };
+
+} // namespace vke
+
+#endif //VKE_GPUPROFILER_H
@@ -1,4 +1,5 @@
 #include "ImageResource.h"
+#include "../commandBuffer/SingleUseCommandBuffer.h"
 #include "../logicalDevice/LogicalDevice.h"
 #include "../../utilities/Images.h"
 #include <backends/imgui_impl_vulkan.h>
@@ -172,16 +173,20 @@ namespace vke {
         imageLayout = vk::ImageLayout::eGeneral;
       }
 
-      Images::transitionImageLayout(
-        config.logicalDevice,
-        config.commandPool,
-        m_image,
-        getFormat(config),
-        vk::ImageLayout::eUndefined,
-        imageLayout,
-        1,
-        config.isCubeMap ? 6 : 1
-      );
+      const SingleUseCommandBuffer commandBuffer(config.logicalDevice, config.commandPool,
+                                                 config.logicalDevice->getGraphicsQueue());
+
+      commandBuffer.record([&] {
+        Images::transitionImageLayout(
+          commandBuffer,
+          m_image,
+          getFormat(config),
+          vk::ImageLayout::eUndefined,
+          imageLayout,
+          1,
+          config.isCubeMap ? 6 : 1
+        );
+      });
     }
 
     vk::Format ImageResource::getFormat(const ImageResourceConfig& config)
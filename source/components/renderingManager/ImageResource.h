@@ -1,6 +1,7 @@
 #ifndef VULKANPROJECT_IMAGERESOURCE_H
 #define VULKANPROJECT_IMAGERESOURCE_H
 
+#include "../memory/MemoryAllocation.h"
 #include <vulkan/vulkan_raii.hpp>
 #include <memory>
 
@@ -53,7 +54,7 @@ namespace vke {
   private:
     vk::raii::Image m_image = nullptr;
     vk::raii::ImageView m_imageView = nullptr;
-    vk::raii::DeviceMemory m_imageMemory = nullptr;
+    MemoryAllocation m_imageMemory = nullptr;
 
     vk::DescriptorSet m_descriptorSet = nullptr;
 
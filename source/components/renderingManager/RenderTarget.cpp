@@ -1,8 +1,11 @@
 #include "RenderTarget.h"
 #include "ImageResource.h"
-#include "../commandBuffer/CommandBuffer.h"
+#include "../commandBuffer/SingleUseCommandBuffer.h"
 #include "../logicalDevice/LogicalDevice.h"
 #include "../physicalDevice/PhysicalDevice.h"
+#include "../../utilities/Buffers.h"
+#include "../../utilities/Images.h"
+#include <cstring>
 
 namespace vke {
 
@@ -30,6 +33,16 @@ namespace vke {
 
   void RenderTarget::recreateImageResources(const vk::Extent2D extent)
   {
+    // Frames still in flight may be rendering to or sampling the old images
+    m_logicalDevice->retire(
+      std::move(m_offscreenColorImageResources),
+      std::move(m_offscreenDepthImageResources),
+      std::move(m_offscreenResolveImageResources),
+      std::move(m_offscreenRayTracingImageResources),
+      std::move(m_mousePickingColorImageResources),
+      std::move(m_mousePickingDepthImageResources)
+    );
+
     m_offscreenColorImageResources.clear();
     m_offscreenDepthImageResources.clear();
     m_offscreenResolveImageResources.clear();
@@ -82,7 +95,8 @@ namespace vke {
   }
 
   void RenderTarget::beginMousePickingRendering(const std::shared_ptr<CommandBuffer>& commandBuffer,
-                                                const uint32_t currentFrame) const
+                                                const uint32_t currentFrame,
+                                                const vk::Rect2D& renderArea) const
   {
     vk::RenderingAttachmentInfo colorRenderingAttachmentInfo {
       .imageView = m_mousePickingColorImageResources.at(currentFrame).getImageView(),
@@ -102,10 +116,7 @@ namespace vke {
     };
 
     const vk::RenderingInfo renderingInfo {
-      .renderArea = {
-        .offset = {0, 0},
-        .extent = m_extent,
-      },
+      .renderArea = renderArea,
       .layerCount = 1,
       .colorAttachmentCount = 1,
       .pColorAttachments = &colorRenderingAttachmentInfo,
@@ -155,6 +166,41 @@ namespace vke {
     transitionRayTracingImagePostCopy(commandBuffer, currentFrame);
   }
 
+  std::vector<uint8_t> RenderTarget::readOffscreenResolveImage(const uint32_t currentFrame,
+                                                               const vk::ImageLayout currentLayout) const
+  {
+    constexpr vk::DeviceSize bytesPerPixel = 4;
+    const vk::DeviceSize bufferSize = static_cast<vk::DeviceSize>(m_extent.width) * m_extent.height * bytesPerPixel;
+
+    vk::raii::Buffer stagingBuffer = nullptr;
+    MemoryAllocation stagingBufferMemory = nullptr;
+
+    Buffers::createBuffer(m_logicalDevice, bufferSize, vk::BufferUsageFlagBits::eTransferDst,
+                          vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+                          stagingBuffer, stagingBufferMemory);
+
+    const auto image = m_offscreenResolveImageResources.at(currentFrame).getImage();
+
+    const SingleUseCommandBuffer commandBuffer(m_logicalDevice, m_commandPool, m_logicalDevice->getGraphicsQueue());
+
+    commandBuffer.record([&] {
+      transitionOffscreenResolveImage(commandBuffer, image, currentLayout, vk::ImageLayout::eTransferSrcOptimal);
+
+      Images::copyImageToBuffer(image, { 0, 0, 0 }, { m_extent.width, m_extent.height, 1 }, commandBuffer,
+                                *stagingBuffer);
+
+      transitionOffscreenResolveImage(commandBuffer, image, vk::ImageLayout::eTransferSrcOptimal, currentLayout);
+    });
+
+    std::vector<uint8_t> pixels(bufferSize);
+
+    Buffers::doMappedMemoryOperation(stagingBufferMemory, [&pixels, bufferSize](const void* data) {
+      std::memcpy(pixels.data(), data, bufferSize);
+    });
+
+    return pixels;
+  }
+
   void RenderTarget::createSampler()
   {
     constexpr vk::SamplerCreateInfo samplerInfo {
@@ -388,4 +434,36 @@ namespace vke {
     );
   }
 
+  void RenderTarget::transitionOffscreenResolveImage(const CommandBuffer& commandBuffer,
+                                                     const vk::Image image,
+                                                     const vk::ImageLayout oldLayout,
+                                                     const vk::ImageLayout newLayout)
+  {
+    const vk::ImageMemoryBarrier imageMemoryBarrier {
+      .srcAccessMask = vk::AccessFlagBits::eMemoryWrite,
+      .dstAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite,
+      .oldLayout = oldLayout,
+      .newLayout = newLayout,
+      .srcQueueFamilyIndex = vk::QueueFamilyIgnored,
+      .dstQueueFamilyIndex = vk::QueueFamilyIgnored,
+      .image = image,
+      .subresourceRange = {
+        .aspectMask = vk::ImageAspectFlagBits::eColor,
+        .baseMipLevel = 0,
+        .levelCount = 1,
+        .baseArrayLayer = 0,
+        .layerCount = 1
+      }
+    };
+
+    commandBuffer.pipelineBarrier(
+      vk::PipelineStageFlagBits::eAllCommands,
+      vk::PipelineStageFlagBits::eAllCommands,
+      {},
+      {},
+      {},
+      { imageMemoryBarrier }
+    );
+  }
+
 } // namespace vke
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "ImageResource.h"
 #include <vulkan/vulkan_raii.hpp>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -28,7 +29,8 @@ namespace vke {
                                  uint32_t currentFrame) const;
 
     void beginMousePickingRendering(const std::shared_ptr<CommandBuffer>& commandBuffer,
-                                    uint32_t currentFrame) const;
+                                    uint32_t currentFrame,
+                                    const vk::Rect2D& renderArea) const;
 
     void beginRayTracingRendering(const std::shared_ptr<CommandBuffer>& commandBuffer,
                                   uint32_t currentFrame) const;
@@ -36,6 +38,9 @@ namespace vke {
     void endRayTracingRendering(const std::shared_ptr<CommandBuffer>& commandBuffer,
                                 uint32_t currentFrame) const;
 
+    [[nodiscard]] std::vector<uint8_t> readOffscreenResolveImage(uint32_t currentFrame,
+                                                                 vk::ImageLayout currentLayout) const;
+
   protected:
     static constexpr vk::ClearValue s_clearColor = vk::ClearColorValue(0.0f, 0.0f, 0.0f, 1.0f);
     static constexpr vk::ClearValue s_clearDepth = vk::ClearDepthStencilValue{
@@ -74,6 +79,11 @@ namespace vke {
 
     void copyRayTracingImageToOffscreenImage(const std::shared_ptr<CommandBuffer>& commandBuffer,
                                              uint32_t currentFrame) const;
+
+    static void transitionOffscreenResolveImage(const CommandBuffer& commandBuffer,
+                                                vk::Image image,
+                                                vk::ImageLayout oldLayout,
+                                                vk::ImageLayout newLayout);
   };
 
 } // namespace vke
@@ -3,11 +3,15 @@
 #include "RenderTarget.h"
 #include "renderer2D/Renderer2D.h"
 #include "renderer3D/Renderer3D.h"
+#include "../../EngineConfig.h"
 #include "../commandBuffer/CommandBuffer.h"
 #include "../imGui/ImGuiInstance.h"
 #include "../logicalDevice/LogicalDevice.h"
 #include "../physicalDevice/PhysicalDevice.h"
 #include "../pipelines/pipelineManager/PipelineManager.h"
+#include "../profiler/CpuProfiler.h"
+#include "../profiler/GpuProfiler.h"
+#include "../uploadManager/UploadManager.h"
 #include "../lighting/LightingManager.h"
 #include "../window/SwapChain.h"
 #include "../window/Window.h"
@@ -21,26 +25,43 @@ namespace vke {
   RenderingManager::RenderingManager(std::shared_ptr<LogicalDevice> logicalDevice,
                                      std::shared_ptr<Surface> surface,
                                      std::shared_ptr<Window> window,
-                                     std::string sceneViewName,
-                                     const std::shared_ptr<AssetManager>& assetManager)
+                                     const EngineConfig& engineConfig,
+                                     const std::shared_ptr<AssetManager>& assetManager,
+                                     std::shared_ptr<GpuProfiler> gpuProfiler,
+                                     std::shared_ptr<UploadManager> uploadManager)
     : m_logicalDevice(std::move(logicalDevice)),
       m_surface(std::move(surface)),
       m_window(std::move(window)),
-      m_sceneViewName(std::move(sceneViewName)),
+      m_gpuProfiler(std::move(gpuProfiler)),
+      m_uploadManager(std::move(uploadManager)),
+      m_sceneViewName(engineConfig.imGui.sceneViewName),
       m_renderer2D(std::make_shared<Renderer2D>(assetManager)),
       m_rayTracingEnabled(m_logicalDevice->getPhysicalDevice()->supportsRayTracing())
   {
     createCommandPool();
 
-    m_renderer3D = std::make_shared<Renderer3D>(m_logicalDevice, assetManager, m_window);
+    m_renderer3D = std::make_shared<Renderer3D>(m_logicalDevice, assetManager, m_uploadManager, m_window);
 
     m_offscreenCommandBuffer = std::make_shared<CommandBuffer>(m_logicalDevice, m_commandPool);
     m_swapchainCommandBuffer = std::make_shared<CommandBuffer>(m_logicalDevice, m_commandPool);
 
-    m_swapChain = std::make_shared<SwapChain>(m_logicalDevice, m_window, m_surface, m_commandPool);
-
     m_renderTarget = std::make_shared<RenderTarget>(m_logicalDevice, m_commandPool);
 
+    if (!m_window)
+    {
+      m_offscreenViewportExtent = vk::Extent2D{
+        .width = engineConfig.window.width,
+        .height = engineConfig.window.height
+      };
+
+      m_renderTarget->recreateImageResources(m_offscreenViewportExtent);
+      m_renderer3D->getMousePicker()->setViewportExtent(m_offscreenViewportExtent);
+
+      return;
+    }
+
+    m_swapChain = std::make_shared<SwapChain>(m_logicalDevice, m_window, m_surface, m_commandPool);
+
     m_framebufferResizeEventListener = m_window->on<FramebufferResizeEvent>([this]([[maybe_unused]] const FramebufferResizeEvent& e) {
       m_framebufferResized = true;
     });
@@ -48,14 +69,31 @@ namespace vke {
 
   RenderingManager::~RenderingManager()
   {
-    m_window->removeListener(m_framebufferResizeEventListener);
+    if (m_window)
+    {
+      m_window->removeListener(m_framebufferResizeEventListener);
+    }
   }
 
   void RenderingManager::doRendering(const std::shared_ptr<PipelineManager>& pipelineManager,
                                      const std::shared_ptr<LightingManager>& lightingManager,
                                      const uint32_t currentFrame)
   {
-    m_logicalDevice->waitForGraphicsFences(currentFrame);
+    VKE_PROFILE_ZONE("RenderingManager::doRendering");
+
+    m_logicalDevice->waitForGraphicsFrame(currentFrame);
+
+    m_logicalDevice->collectRetiredObjects();
+
+    m_gpuProfiler->beginFrame(GpuQueue::graphics, currentFrame);
+
+    m_renderer3D->handleMousePickingReadback(currentFrame);
+
+    if (!m_window)
+    {
+      doHeadlessRendering(pipelineManager, lightingManager, currentFrame);
+      return;
+    }
 
     uint32_t imageIndex;
     auto result = m_logicalDevice->acquireNextImage(currentFrame, m_swapChain->getSwapChain(), &imageIndex);
@@ -72,14 +110,18 @@ namespace vke {
       throw std::runtime_error("failed to acquire swap chain image!");
     }
 
-    m_renderer3D->updateLightingManager(lightingManager, currentFrame);
+    m_gpuProfiler->displayGui();
 
     renderGuiScene(currentFrame);
 
-    m_logicalDevice->resetGraphicsFences(currentFrame);
+    // After the scene window has settled the frame's extent, so lights are culled against the frustum it renders
+    updateLightingManager(lightingManager, currentFrame);
 
     recordOffscreenCommandBuffer(pipelineManager, lightingManager, currentFrame);
 
+    m_lastRenderedFrame = currentFrame;
+    m_lastRenderedFrameRayTraced = m_rayTracingEnabled;
+
     recordSwapchainCommandBuffer(currentFrame, imageIndex);
 
     result = m_logicalDevice->queuePresent(currentFrame, m_swapChain->getSwapChain(), &imageIndex);
@@ -102,6 +144,13 @@ namespace vke {
 
   void RenderingManager::recreateSwapChain()
   {
+    VKE_PROFILE_ZONE("RenderingManager::recreateSwapChain");
+
+    if (!m_window)
+    {
+      return;
+    }
+
     int width = 0, height = 0;
     m_window->getFramebufferSize(&width, &height);
     while (width == 0 || height == 0)
@@ -134,6 +183,11 @@ namespace vke {
     m_renderer3D->createNewFrame();
   }
 
+  void RenderingManager::setDeltaTime(const float deltaTime)
+  {
+    m_deltaTime = deltaTime;
+  }
+
   std::shared_ptr<Renderer2D> RenderingManager::getRenderer2D() const
   {
     return m_renderer2D;
@@ -169,6 +223,44 @@ namespace vke {
     return m_rayTracingEnabled;
   }
 
+  std::vector<uint8_t> RenderingManager::readRenderedImage() const
+  {
+    if (m_offscreenViewportExtent.width == 0 || m_offscreenViewportExtent.height == 0)
+    {
+      return {};
+    }
+
+    m_logicalDevice->waitForGraphicsFrame(m_lastRenderedFrame);
+
+    const auto currentLayout = m_lastRenderedFrameRayTraced
+      ? vk::ImageLayout::eShaderReadOnlyOptimal
+      : vk::ImageLayout::eColorAttachmentOptimal;
+
+    return m_renderTarget->readOffscreenResolveImage(m_lastRenderedFrame, currentLayout);
+  }
+
+  vk::Extent2D RenderingManager::getRenderedImageExtent() const
+  {
+    return m_offscreenViewportExtent;
+  }
+
+  void RenderingManager::doHeadlessRendering(const std::shared_ptr<PipelineManager>& pipelineManager,
+                                             const std::shared_ptr<LightingManager>& lightingManager,
+                                             const uint32_t currentFrame)
+  {
+    updateLightingManager(lightingManager, currentFrame);
+
+    recordOffscreenCommandBuffer(pipelineManager, lightingManager, currentFrame);
+
+    m_lastRenderedFrame = currentFrame;
+    m_lastRenderedFrameRayTraced = m_rayTracingEnabled;
+  }
+
+  float RenderingManager::getContentScale() const
+  {
+    return m_window ? m_window->getContentScale() : 1.0f;
+  }
+
   void RenderingManager::renderGuiScene(const uint32_t currentFrame)
   {
     ImGui::Begin(m_sceneViewName.c_str());
@@ -194,8 +286,6 @@ namespace vke {
     {
       m_offscreenViewportExtent = currentOffscreenViewportExtent;
 
-      m_logicalDevice->waitIdle();
-
       m_renderTarget->recreateImageResources(m_offscreenViewportExtent);
       m_renderer3D->getMousePicker()->setViewportExtent(m_offscreenViewportExtent);
     }
@@ -209,6 +299,13 @@ namespace vke {
     ImGui::End();
   }
 
+  void RenderingManager::updateLightingManager(const std::shared_ptr<LightingManager>& lightingManager,
+                                               const uint32_t currentFrame) const
+  {
+    // Reflected and refracted rays reach lights the camera cannot see, so lights are only culled when rasterizing
+    m_renderer3D->updateLightingManager(lightingManager, currentFrame, m_offscreenViewportExtent, !m_rayTracingEnabled);
+  }
+
   void RenderingManager::recordOffscreenCommandBuffer(const std::shared_ptr<PipelineManager>& pipelineManager,
                                                       const std::shared_ptr<LightingManager>& lightingManager,
                                                       const uint32_t currentFrame) const
@@ -219,31 +316,80 @@ namespace vke {
         return;
       }
 
+      m_gpuProfiler->beginZone(m_offscreenCommandBuffer, GpuQueue::graphics, "Shadow Maps", true);
+
       m_renderer3D->renderShadowMaps(lightingManager, m_offscreenCommandBuffer, pipelineManager, currentFrame);
+
+      m_gpuProfiler->endZone(m_offscreenCommandBuffer, GpuQueue::graphics);
+    };
+
+    auto computeLightClusters = [this, currentFrame, lightingManager, pipelineManager] {
+      if (m_rayTracingEnabled)
+      {
+        return;
+      }
+
+      m_gpuProfiler->beginZone(m_offscreenCommandBuffer, GpuQueue::graphics, "Light Clusters");
+
+      lightingManager->computeLightClusters(m_offscreenCommandBuffer, pipelineManager, currentFrame);
+
+      m_gpuProfiler->endZone(m_offscreenCommandBuffer, GpuQueue::graphics);
     };
 
     auto recordMousePicking = [this, currentFrame, pipelineManager](const RenderInfo& renderInfo) {
-      m_renderTarget->beginMousePickingRendering(renderInfo.commandBuffer, currentFrame);
+      if (!m_renderer3D->prepareMousePicking())
+      {
+        return;
+      }
+
+      const auto mousePickingArea = m_renderer3D->getMousePicker()->getMousePickingArea();
+
+      m_gpuProfiler->beginZone(renderInfo.commandBuffer, GpuQueue::graphics, "Mouse Picking", true);
+
+      m_renderTarget->beginMousePickingRendering(renderInfo.commandBuffer, currentFrame, mousePickingArea);
+
+      renderInfo.commandBuffer->setScissor(mousePickingArea);
 
       m_renderer3D->renderMousePicking(&renderInfo, pipelineManager);
 
       renderInfo.commandBuffer->endRendering();
+
+      const vk::Rect2D scissor = {
+        .offset = {0, 0},
+        .extent = renderInfo.extent
+      };
+      renderInfo.commandBuffer->setScissor(scissor);
+
+      m_renderer3D->recordMousePickingReadback(renderInfo.commandBuffer,
+        m_renderTarget->getMousePickingColorImageResource(currentFrame).getImage(), currentFrame);
+
+      m_gpuProfiler->endZone(renderInfo.commandBuffer, GpuQueue::graphics);
     };
 
     auto recordOffscreenRendering = [this, currentFrame, lightingManager, pipelineManager](const RenderInfo& renderInfo) {
       if (m_rayTracingEnabled)
       {
+        m_gpuProfiler->beginZone(renderInfo.commandBuffer, GpuQueue::graphics, "Ray Tracing");
+
         m_renderTarget->beginRayTracingRendering(renderInfo.commandBuffer, currentFrame);
         m_renderer3D->doRayTracing(&renderInfo, pipelineManager, lightingManager, m_renderTarget->getOffscreenRayTracingImageResource(currentFrame));
         m_renderTarget->endRayTracingRendering(renderInfo.commandBuffer, currentFrame);
 
+        m_gpuProfiler->endZone(renderInfo.commandBuffer, GpuQueue::graphics);
+
         return;
       }
 
+      m_gpuProfiler->beginZone(renderInfo.commandBuffer, GpuQueue::graphics, "Scene");
+
       m_renderTarget->beginOffscreenRendering(renderInfo.commandBuffer, currentFrame);
 
+      m_gpuProfiler->beginZone(renderInfo.commandBuffer, GpuQueue::graphics, "3D", true);
+
       m_renderer3D->render(&renderInfo, pipelineManager, lightingManager);
 
+      m_gpuProfiler->endZone(renderInfo.commandBuffer, GpuQueue::graphics);
+
       constexpr vk::ClearAttachment clearAttachment{
         .aspectMask = vk::ImageAspectFlagBits::eDepth,
         .clearValue = vk::ClearValue{ {1.0f, 0} }
@@ -262,27 +408,35 @@ namespace vke {
 
       RenderInfo renderInfo2D = renderInfo;
       renderInfo2D.extent = vk::Extent2D{
-        .width = static_cast<uint32_t>(static_cast<float>(m_offscreenViewportExtent.width) / m_window->getContentScale()),
-        .height = static_cast<uint32_t>(static_cast<float>(m_offscreenViewportExtent.height) / m_window->getContentScale()),
+        .width = static_cast<uint32_t>(static_cast<float>(m_offscreenViewportExtent.width) / getContentScale()),
+        .height = static_cast<uint32_t>(static_cast<float>(m_offscreenViewportExtent.height) / getContentScale()),
       };
 
+      m_gpuProfiler->beginZone(renderInfo.commandBuffer, GpuQueue::graphics, "2D", true);
+
       m_renderer2D->render(&renderInfo2D, pipelineManager);
 
+      m_gpuProfiler->endZone(renderInfo.commandBuffer, GpuQueue::graphics);
+
       renderInfo2D.commandBuffer->endRendering();
+
+      m_gpuProfiler->endZone(renderInfo.commandBuffer, GpuQueue::graphics);
     };
 
     m_offscreenCommandBuffer->setCurrentFrame(currentFrame);
 
     m_offscreenCommandBuffer->resetCommandBuffer();
 
-    m_offscreenCommandBuffer->record([this, currentFrame, renderShadowMaps, recordMousePicking, recordOffscreenRendering]
+    m_offscreenCommandBuffer->record([this, currentFrame, lightingManager, renderShadowMaps, computeLightClusters,
+                                      recordMousePicking, recordOffscreenRendering]
     {
       const RenderInfo renderInfo {
         .commandBuffer = m_offscreenCommandBuffer,
         .currentFrame = currentFrame,
         .viewPosition = {},
         .viewMatrix = {},
-        .extent = m_offscreenViewportExtent
+        .extent = m_offscreenViewportExtent,
+        .deltaTime = m_deltaTime
       };
 
       if (renderInfo.extent.width == 0 ||
@@ -291,6 +445,11 @@ namespace vke {
         return;
       }
 
+      // Shadow maps are not rendered while ray tracing, so their casters are not culled either
+      m_renderer3D->updateSceneBuffers(&renderInfo, m_rayTracingEnabled ? nullptr : lightingManager);
+
+      computeLightClusters();
+
       renderShadowMaps();
 
       const vk::Viewport viewport = {
@@ -314,14 +473,10 @@ namespace vke {
       recordOffscreenRendering(renderInfo);
     });
 
-    m_logicalDevice->submitOffscreenCommandBuffer(currentFrame, m_offscreenCommandBuffer->getCommandBuffer());
+    // Uploads recorded while building the frame have to land before it executes
+    m_uploadManager->flush();
 
-    if (m_offscreenViewportExtent.width != 0 &&
-        m_offscreenViewportExtent.height != 0)
-    {
-      m_logicalDevice->waitForOffscreenFence(currentFrame);
-      m_renderer3D->handleRenderedMousePickingImage(m_renderTarget->getMousePickingColorImageResource(currentFrame).getImage());
-    }
+    m_logicalDevice->submitOffscreenCommandBuffer(currentFrame, m_offscreenCommandBuffer->getCommandBuffer());
   }
 
   void RenderingManager::recordSwapchainCommandBuffer(uint32_t currentFrame,
@@ -359,11 +514,17 @@ namespace vke {
 
       m_swapChain->beginRendering(imageIndex, renderInfo.commandBuffer);
 
+      m_gpuProfiler->beginZone(renderInfo.commandBuffer, GpuQueue::graphics, "ImGui");
+
       ImGuiInstance::render(renderInfo.commandBuffer);
 
+      m_gpuProfiler->endZone(renderInfo.commandBuffer, GpuQueue::graphics);
+
       m_swapChain->endRendering(imageIndex, renderInfo.commandBuffer);
     });
 
+    m_uploadManager->flush();
+
     m_logicalDevice->submitSwapchainCommandBuffer(currentFrame, m_swapchainCommandBuffer->getCommandBuffer());
   }
 
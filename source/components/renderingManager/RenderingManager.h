@@ -3,14 +3,18 @@
 
 #include "../../utilities/EventSystem.h"
 #include <vulkan/vulkan_raii.hpp>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace vke {
 
   class AssetManager;
   class CommandBuffer;
+  struct EngineConfig;
   struct FramebufferResizeEvent;
+  class GpuProfiler;
   class LightingManager;
   class LogicalDevice;
   class PipelineManager;
@@ -19,6 +23,7 @@ namespace vke {
   class Renderer3D;
   class Surface;
   class SwapChain;
+  class UploadManager;
   class Window;
 
   class RenderingManager {
@@ -26,8 +31,10 @@ namespace vke {
     RenderingManager(std::shared_ptr<LogicalDevice> logicalDevice,
                      std::shared_ptr<Surface> surface,
                      std::shared_ptr<Window> window,
-                     std::string sceneViewName,
-                     const std::shared_ptr<AssetManager>& assetManager);
+                     const EngineConfig& engineConfig,
+                     const std::shared_ptr<AssetManager>& assetManager,
+                     std::shared_ptr<GpuProfiler> gpuProfiler,
+                     std::shared_ptr<UploadManager> uploadManager);
 
     ~RenderingManager();
 
@@ -41,6 +48,8 @@ namespace vke {
 
     void createNewFrame() const;
 
+    void setDeltaTime(float deltaTime);
+
     [[nodiscard]] std::shared_ptr<Renderer2D> getRenderer2D() const;
 
     [[nodiscard]] std::shared_ptr<Renderer3D> getRenderer3D() const;
@@ -53,6 +62,11 @@ namespace vke {
 
     [[nodiscard]] bool isRayTracingEnabled() const;
 
+    // Waits for the most recently rendered frame and returns its scene image as tightly packed RGBA8 pixels
+    [[nodiscard]] std::vector<uint8_t> readRenderedImage() const;
+
+    [[nodiscard]] vk::Extent2D getRenderedImageExtent() const;
+
   private:
     std::shared_ptr<LogicalDevice> m_logicalDevice;
 
@@ -60,6 +74,10 @@ namespace vke {
 
     std::shared_ptr<Window> m_window;
 
+    std::shared_ptr<GpuProfiler> m_gpuProfiler;
+
+    std::shared_ptr<UploadManager> m_uploadManager;
+
     std::shared_ptr<RenderTarget> m_renderTarget;
 
     vk::raii::CommandPool m_commandPool = nullptr;
@@ -86,8 +104,23 @@ namespace vke {
 
     bool m_rayTracingEnabled;
 
+    uint32_t m_lastRenderedFrame = 0;
+
+    bool m_lastRenderedFrameRayTraced = false;
+
+    float m_deltaTime = 0.0f;
+
+    void doHeadlessRendering(const std::shared_ptr<PipelineManager>& pipelineManager,
+                             const std::shared_ptr<LightingManager>& lightingManager,
+                             uint32_t currentFrame);
+
+    [[nodiscard]] float getContentScale() const;
+
     void renderGuiScene(uint32_t currentFrame);
 
+    void updateLightingManager(const std::shared_ptr<LightingManager>& lightingManager,
+                               uint32_t currentFrame) const;
+
     void recordOffscreenCommandBuffer(const std::shared_ptr<PipelineManager>& pipelineManager,
                                       const std::shared_ptr<LightingManager>& lightingManager,
                                       uint32_t currentFrame) const;
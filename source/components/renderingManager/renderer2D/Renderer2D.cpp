@@ -3,6 +3,7 @@
 #include "../../assets/fonts/Font.h"
 #include "../../commandBuffer/CommandBuffer.h"
 #include "../../pipelines/pipelineManager/PipelineManager.h"
+#include "../../profiler/CpuProfiler.h"
 #include <glm/gtc/matrix_transform.hpp>
 
 namespace vke {
@@ -13,6 +14,8 @@ namespace vke {
   void Renderer2D::render(const RenderInfo* renderInfo,
                           const std::shared_ptr<PipelineManager>& pipelineManager)
   {
+    VKE_PROFILE_ZONE("Renderer2D::render");
+
     normalizeZValues();
 
     renderRects(pipelineManager, renderInfo);
@@ -188,39 +191,50 @@ namespace vke {
                         const float x,
                         const float y)
   {
-    const float maxGlyphHeight = m_currentFont->getMaxGlyphHeight();
+    layoutText(m_currentFont->getAtlas(), text, x, y, m_currentFill, m_currentTransform, m_currentZ,
+               m_glyphsToRender[m_currentFontName][m_currentFontSize]);
+
+    increaseCurrentZ();
+  }
 
+  void Renderer2D::layoutText(const FontAtlas& atlas,
+                              const std::string& text,
+                              const float x,
+                              const float y,
+                              const glm::vec4& color,
+                              const glm::mat4& transform,
+                              const float z,
+                              std::vector<Glyph>& glyphs)
+  {
     float currentX = x;
 
     const auto codepoints = decodeUTF8(text);
 
     for (const auto& codepoint : codepoints)
     {
-      if (const auto glyphInfo = m_currentFont->getGlyphInfo(codepoint))
+      if (const auto glyphInfo = atlas.getGlyphInfo(codepoint))
       {
-        m_glyphsToRender[m_currentFontName][m_currentFontSize].push_back({
+        glyphs.push_back({
           .bounds = glm::vec4(
             currentX + glyphInfo->bearingX,
-            y - glyphInfo->bearingY + maxGlyphHeight,
+            y - glyphInfo->bearingY + atlas.maxGlyphHeight,
             glyphInfo->width,
             glyphInfo->height
           ),
-          .color = m_currentFill,
-          .transform = m_currentTransform,
+          .color = color,
+          .transform = transform,
           .uv = glm::vec4(
             glyphInfo->u0,
             glyphInfo->v0,
             glyphInfo->u1,
             glyphInfo->v1
             ),
-          .z = m_currentZ
+          .z = z
         });
 
         currentX += glyphInfo->advance;
       }
     }
-
-    increaseCurrentZ();
   }
 
   void Renderer2D::updateCurrentFont()
@@ -13,6 +13,7 @@ namespace vke {
 
   class AssetManager;
   class Font;
+  struct FontAtlas;
   class PipelineManager;
   struct RenderInfo;
 
@@ -78,6 +79,19 @@ namespace vke {
               float x,
               float y);
 
+    // Converts the submitted depth order into [0, 1] depths, done once per frame before recording draws
+    void normalizeZValues();
+
+    // Lays out a single line of text against an atlas, appending one glyph per drawable codepoint
+    static void layoutText(const FontAtlas& atlas,
+                           const std::string& text,
+                           float x,
+                           float y,
+                           const glm::vec4& color,
+                           const glm::mat4& transform,
+                           float z,
+                           std::vector<Glyph>& glyphs);
+
   private:
     std::shared_ptr<AssetManager> m_assetManager;
 
@@ -107,8 +121,6 @@ namespace vke {
 
     void increaseCurrentZ();
 
-    void normalizeZValues();
-
     void renderRects(const std::shared_ptr<PipelineManager>& pipelineManager,
                     const RenderInfo* renderInfo) const;
 
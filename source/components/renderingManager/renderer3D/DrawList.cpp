@@ -0,0 +1,209 @@
+#include "DrawList.h"
+#include "FrustumCuller.h"
+#include "../../assets/objects/RenderObject.h"
+#include "../../pipelines/implementations/common/PipelineTypes.h"
+#include "../../profiler/CpuProfiler.h"
+#include <glm/vec4.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+
+namespace {
+
+  // Key fields from the most significant bits down, a field only orders draws its more significant fields tie on
+  constexpr uint32_t PASS_BITS = 1;
+  constexpr uint32_t PIPELINE_BITS = 6;
+  constexpr uint32_t MATERIAL_BITS = 14;
+  constexpr uint32_t MODEL_BITS = 14;
+  constexpr uint32_t DEPTH_BITS = 29;
+
+  static_assert(PASS_BITS + PIPELINE_BITS + MATERIAL_BITS + MODEL_BITS + DEPTH_BITS == 64);
+
+  constexpr uint32_t MODEL_SHIFT = DEPTH_BITS;
+  constexpr uint32_t MATERIAL_SHIFT = MODEL_SHIFT + MODEL_BITS;
+  constexpr uint32_t PIPELINE_SHIFT = MATERIAL_SHIFT + MATERIAL_BITS;
+  constexpr uint32_t PASS_SHIFT = PIPELINE_SHIFT + PIPELINE_BITS;
+
+  constexpr uint32_t MAX_MATERIAL_ID = (1u << MATERIAL_BITS) - 1;
+  constexpr uint32_t MAX_MODEL_ID = (1u << MODEL_BITS) - 1;
+  constexpr uint32_t MAX_DEPTH = (1u << DEPTH_BITS) - 1;
+
+  // Opaque draws go first, blended ones are drawn over them
+  constexpr uint64_t OPAQUE_PASS = 0;
+  constexpr uint64_t BLENDED_PASS = 1;
+
+  // The highlight is the only render object pipeline that blends
+  bool blends(const vke::PipelineType pipelineType)
+  {
+    return pipelineType == vke::PipelineType::objectHighlight;
+  }
+
+  // Non-negative floats order like their bits, the lowest mantissa bits are dropped to fit the key
+  uint32_t quantizeDepth(const float depth)
+  {
+    return std::bit_cast<uint32_t>(std::max(depth, 0.0f)) >> (31 - DEPTH_BITS);
+  }
+
+  // Shaders are free to sample any of the object's textures, so only objects sharing them can be instanced
+  bool sharesBatch(const vke::RenderObject& a,
+                   const vke::RenderObject& b)
+  {
+    return a.getModel() == b.getModel() &&
+           a.getTexture() == b.getTexture() &&
+           a.getSpecularMap() == b.getSpecularMap();
+  }
+
+}
+
+namespace vke {
+
+  void DrawList::clear(const glm::mat4& viewMatrix)
+  {
+    m_viewMatrix = viewMatrix;
+
+    m_items.clear();
+    m_sortEntries.clear();
+    m_drawCommands.clear();
+
+    m_textureIds.clear();
+    m_materialIds.clear();
+    m_modelIds.clear();
+  }
+
+  void DrawList::addObjects(const PipelineType pipelineType,
+                            const std::vector<std::shared_ptr<RenderObject>>& renderObjects,
+                            const FrustumCuller& frustumCuller)
+  {
+    const uint64_t pass = blends(pipelineType) ? BLENDED_PASS : OPAQUE_PASS;
+
+    for (const auto& renderObject : renderObjects)
+    {
+      const glm::vec3 center = frustumCuller.getCenter(renderObject->getObjectIndex());
+
+      // Front to back lets early depth testing skip hidden fragments, blending needs back to front instead
+      uint32_t depth = quantizeDepth(-(m_viewMatrix * glm::vec4(center, 1.0f)).z);
+      if (pass == BLENDED_PASS)
+      {
+        depth = MAX_DEPTH - depth;
+      }
+
+      const uint64_t key = pass << PASS_SHIFT |
+                           static_cast<uint64_t>(pipelineType) << PIPELINE_SHIFT |
+                           static_cast<uint64_t>(getMaterialId(*renderObject)) << MATERIAL_SHIFT |
+                           static_cast<uint64_t>(getModelId(*renderObject)) << MODEL_SHIFT |
+                           depth;
+
+      m_sortEntries.push_back({
+        .key = key,
+        .item = static_cast<uint32_t>(m_items.size())
+      });
+
+      m_items.push_back({
+        .pipelineType = pipelineType,
+        .renderObject = renderObject
+      });
+    }
+  }
+
+  void DrawList::createDrawCommands(SceneBuffers& sceneBuffers)
+  {
+    VKE_PROFILE_ZONE("DrawList::createDrawCommands");
+
+    radixSort();
+
+    const DrawItem* previousItem = nullptr;
+    for (const auto& sortEntry : m_sortEntries)
+    {
+      const auto& item = m_items[sortEntry.item];
+
+      const uint32_t instance = sceneBuffers.addInstance(*item.renderObject);
+
+      // Ids past the key's range are shared, so the objects themselves decide where batches split
+      if (!previousItem || previousItem->pipelineType != item.pipelineType ||
+          !sharesBatch(*previousItem->renderObject, *item.renderObject))
+      {
+        m_drawCommands.push_back({
+          .pipelineType = item.pipelineType,
+          .batch = {
+            .renderObject = item.renderObject,
+            .firstInstance = instance
+          }
+        });
+      }
+
+      ++m_drawCommands.back().batch.instanceCount;
+
+      previousItem = &item;
+    }
+  }
+
+  const std::vector<DrawCommand>& DrawList::getDrawCommands() const
+  {
+    return m_drawCommands;
+  }
+
+  uint32_t DrawList::getMaterialId(const RenderObject& renderObject)
+  {
+    const auto getTextureId = [this](const Texture* texture) {
+      return m_textureIds.try_emplace(texture, static_cast<uint32_t>(m_textureIds.size())).first->second;
+    };
+
+    const uint64_t textures = static_cast<uint64_t>(getTextureId(renderObject.getTexture().get())) << 32 |
+                              getTextureId(renderObject.getSpecularMap().get());
+
+    const uint32_t materialId = m_materialIds.try_emplace(textures, static_cast<uint32_t>(m_materialIds.size())).first->second;
+
+    return std::min(materialId, MAX_MATERIAL_ID);
+  }
+
+  uint32_t DrawList::getModelId(const RenderObject& renderObject)
+  {
+    const uint32_t modelId = m_modelIds.try_emplace(renderObject.getModel().get(), static_cast<uint32_t>(m_modelIds.size())).first->second;
+
+    return std::min(modelId, MAX_MODEL_ID);
+  }
+
+  void DrawList::radixSort()
+  {
+    constexpr uint32_t keyBytes = sizeof(uint64_t);
+
+    // Least significant byte first, each pass is stable so the earlier ones still order ties
+    std::array<std::array<uint32_t, 256>, keyBytes> counts {};
+    for (const auto& sortEntry : m_sortEntries)
+    {
+      for (uint32_t byte = 0; byte < keyBytes; ++byte)
+      {
+        ++counts[byte][sortEntry.key >> byte * 8 & 0xFF];
+      }
+    }
+
+    m_sortScratch.resize(m_sortEntries.size());
+
+    for (uint32_t byte = 0; byte < keyBytes; ++byte)
+    {
+      auto& byteCounts = counts[byte];
+
+      // Bytes every key shares, usually most of the pass and pipeline, leave the order as it is
+      if (std::ranges::find(byteCounts, static_cast<uint32_t>(m_sortEntries.size())) != byteCounts.end())
+      {
+        continue;
+      }
+
+      uint32_t offset = 0;
+      for (auto& count : byteCounts)
+      {
+        const uint32_t bucketSize = count;
+        count = offset;
+        offset += bucketSize;
+      }
+
+      for (const auto& sortEntry : m_sortEntries)
+      {
+        m_sortScratch[byteCounts[sortEntry.key >> byte * 8 & 0xFF]++] = sortEntry;
+      }
+
+      std::swap(m_sortEntries, m_sortScratch);
+    }
+  }
+
+} // namespace vke
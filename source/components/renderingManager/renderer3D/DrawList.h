@@ -0,0 +1,76 @@
+#ifndef VKE_DRAWLIST_H
+#define VKE_DRAWLIST_H
+
+#include "SceneBuffers.h"
+#include <glm/mat4x4.hpp>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace vke {
+
+  class FrustumCuller;
+  class Model;
+  enum class PipelineType;
+  class RenderObject;
+  class Texture;
+
+  // One instanced draw of the camera pass
+  struct DrawCommand {
+    PipelineType pipelineType;
+    DrawBatch batch;
+  };
+
+  // The camera pass's visible objects, ordered by a packed 64 bit key of pass, pipeline, material, model and depth,
+  // so pipelines, textures and buffers are bound as rarely as possible
+  class DrawList {
+  public:
+    // Starts the frame's list, depth is measured along the forward axis of the view
+    void clear(const glm::mat4& viewMatrix);
+
+    void addObjects(PipelineType pipelineType,
+                    const std::vector<std::shared_ptr<RenderObject>>& renderObjects,
+                    const FrustumCuller& frustumCuller);
+
+    // Radix sorts the objects, then batches runs sharing a pipeline, textures and model into instanced draws,
+    // their instances front to back, or back to front for pipelines that blend
+    void createDrawCommands(SceneBuffers& sceneBuffers);
+
+    [[nodiscard]] const std::vector<DrawCommand>& getDrawCommands() const;
+
+  private:
+    struct DrawItem {
+      PipelineType pipelineType;
+      std::shared_ptr<RenderObject> renderObject;
+    };
+
+    struct SortEntry {
+      uint64_t key;
+      uint32_t item;
+    };
+
+    glm::mat4 m_viewMatrix{};
+
+    std::vector<DrawItem> m_items;
+
+    std::vector<SortEntry> m_sortEntries;
+    std::vector<SortEntry> m_sortScratch;
+
+    std::vector<DrawCommand> m_drawCommands;
+
+    // Dense ids handed out in the order things are first seen this frame, small enough to pack into the key
+    std::unordered_map<const Texture*, uint32_t> m_textureIds;
+    std::unordered_map<uint64_t, uint32_t> m_materialIds;
+    std::unordered_map<const Model*, uint32_t> m_modelIds;
+
+    [[nodiscard]] uint32_t getMaterialId(const RenderObject& renderObject);
+
+    [[nodiscard]] uint32_t getModelId(const RenderObject& renderObject);
+
+    void radixSort();
+  };
+
+} // namespace vke
+
+#endif //VKE_DRAWLIST_H
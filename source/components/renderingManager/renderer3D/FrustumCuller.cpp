@@ -0,0 +1,172 @@
+#include "FrustumCuller.h"
+#include "../../assets/objects/Model.h"
+#include "../../assets/objects/RenderObject.h"
+#include "../../profiler/CpuProfiler.h"
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/matrix.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace vke {
+
+  void FrustumCuller::updateBounds(const std::vector<std::shared_ptr<RenderObject>>& renderObjects)
+  {
+    VKE_PROFILE_ZONE("FrustumCuller::updateBounds");
+
+    const size_t objectCount = renderObjects.size();
+
+    m_centerX.resize(objectCount);
+    m_centerY.resize(objectCount);
+    m_centerZ.resize(objectCount);
+    m_extentX.resize(objectCount);
+    m_extentY.resize(objectCount);
+    m_extentZ.resize(objectCount);
+    m_radius.resize(objectCount);
+    m_viewMasks.resize(objectCount);
+    m_insideFrustum.resize(objectCount);
+
+    for (size_t i = 0; i < objectCount; ++i)
+    {
+      const glm::mat4 modelMatrix = renderObjects[i]->getModelMatrix();
+      const ModelBounds& bounds = renderObjects[i]->getModel()->getBounds();
+
+      const glm::vec3 center = modelMatrix * glm::vec4(bounds.center, 1.0f);
+
+      // Extents of the box enclosing the transformed box
+      const glm::mat3 absoluteMatrix {
+        glm::abs(glm::vec3(modelMatrix[0])),
+        glm::abs(glm::vec3(modelMatrix[1])),
+        glm::abs(glm::vec3(modelMatrix[2]))
+      };
+      const glm::vec3 extents = absoluteMatrix * bounds.extents;
+
+      const float scale = std::max({
+        glm::length(glm::vec3(modelMatrix[0])),
+        glm::length(glm::vec3(modelMatrix[1])),
+        glm::length(glm::vec3(modelMatrix[2]))
+      });
+
+      m_centerX[i] = center.x;
+      m_centerY[i] = center.y;
+      m_centerZ[i] = center.z;
+      m_extentX[i] = extents.x;
+      m_extentY[i] = extents.y;
+      m_extentZ[i] = extents.z;
+      m_radius[i] = bounds.radius * scale;
+    }
+  }
+
+  void FrustumCuller::cullFrustum(const glm::mat4& viewProjection)
+  {
+    cullFrusta({ &viewProjection, 1 });
+  }
+
+  void FrustumCuller::cullFrusta(const std::span<const glm::mat4> viewProjections)
+  {
+    VKE_PROFILE_ZONE("FrustumCuller::cullFrusta");
+
+    std::ranges::fill(m_viewMasks, 0);
+
+    const size_t objectCount = m_viewMasks.size();
+
+    for (size_t view = 0; view < viewProjections.size(); ++view)
+    {
+      std::ranges::fill(m_insideFrustum, 1);
+
+      for (const auto& plane : createFrustumPlanes(viewProjections[view]))
+      {
+        const glm::vec3 absoluteNormal = glm::abs(glm::vec3(plane));
+
+        for (size_t i = 0; i < objectCount; ++i)
+        {
+          const float distance = plane.x * m_centerX[i] + plane.y * m_centerY[i] + plane.z * m_centerZ[i] + plane.w;
+
+          // Whichever of the box and the sphere reaches less far towards the plane
+          const float boxRadius = absoluteNormal.x * m_extentX[i] + absoluteNormal.y * m_extentY[i] +
+                                  absoluteNormal.z * m_extentZ[i];
+          const float radius = std::min(boxRadius, m_radius[i]);
+
+          m_insideFrustum[i] &= static_cast<uint8_t>(distance >= -radius);
+        }
+      }
+
+      for (size_t i = 0; i < objectCount; ++i)
+      {
+        m_viewMasks[i] |= static_cast<uint8_t>(m_insideFrustum[i] << view);
+      }
+    }
+  }
+
+  void FrustumCuller::cullSphere(const glm::vec3& center,
+                                 const float radius)
+  {
+    VKE_PROFILE_ZONE("FrustumCuller::cullSphere");
+
+    const size_t objectCount = m_viewMasks.size();
+
+    for (size_t i = 0; i < objectCount; ++i)
+    {
+      const float dx = m_centerX[i] - center.x;
+      const float dy = m_centerY[i] - center.y;
+      const float dz = m_centerZ[i] - center.z;
+      const float reach = radius + m_radius[i];
+
+      // All bits set when inside, none when outside
+      m_viewMasks[i] &= static_cast<uint8_t>(-static_cast<int32_t>(dx * dx + dy * dy + dz * dz <= reach * reach));
+    }
+  }
+
+  void FrustumCuller::getVisibleObjects(const std::vector<std::shared_ptr<RenderObject>>& renderObjects,
+                                        std::vector<std::shared_ptr<RenderObject>>& visibleObjects,
+                                        CullingStats& cullingStats,
+                                        std::vector<uint8_t>* viewMasks) const
+  {
+    for (const auto& renderObject : renderObjects)
+    {
+      const uint8_t viewMask = m_viewMasks[renderObject->getObjectIndex()];
+
+      if (viewMask == 0)
+      {
+        ++cullingStats.culled;
+        continue;
+      }
+
+      visibleObjects.push_back(renderObject);
+      ++cullingStats.visible;
+
+      if (viewMasks)
+      {
+        viewMasks->push_back(viewMask);
+      }
+    }
+  }
+
+  glm::vec3 FrustumCuller::getCenter(const uint32_t objectIndex) const
+  {
+    return { m_centerX[objectIndex], m_centerY[objectIndex], m_centerZ[objectIndex] };
+  }
+
+  std::array<glm::vec4, 6> FrustumCuller::createFrustumPlanes(const glm::mat4& viewProjection)
+  {
+    const glm::mat4 rows = glm::transpose(viewProjection);
+
+    // The camera projects depth to [-1, 1] and the lights to [0, 1], the wider near plane is correct for both
+    std::array planes {
+      rows[3] + rows[0],
+      rows[3] - rows[0],
+      rows[3] + rows[1],
+      rows[3] - rows[1],
+      rows[3] + rows[2],
+      rows[3] - rows[2]
+    };
+
+    for (auto& plane : planes)
+    {
+      plane /= glm::length(glm::vec3(plane));
+    }
+
+    return planes;
+  }
+
+} // namespace vke
@@ -0,0 +1,68 @@
+#ifndef VKE_FRUSTUMCULLER_H
+#define VKE_FRUSTUMCULLER_H
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace vke {
+
+  class RenderObject;
+
+  struct CullingStats {
+    uint32_t visible = 0;
+    uint32_t culled = 0;
+  };
+
+  // Tests the frame's objects against a view, bounds are kept as separate arrays so each test is a flat loop the compiler can vectorize
+  class FrustumCuller {
+  public:
+    // Gathers the world space bounds of the frame's objects, indexed like the scene's object buffer
+    void updateBounds(const std::vector<std::shared_ptr<RenderObject>>& renderObjects);
+
+    // Marks the objects intersecting the frustum of viewProjection as visible
+    void cullFrustum(const glm::mat4& viewProjection);
+
+    // Marks each object with a bit for every view whose frustum it intersects, for passes rendering up to 8 views at once
+    void cullFrusta(std::span<const glm::mat4> viewProjections);
+
+    // Further limits the last cull to objects intersecting the sphere
+    void cullSphere(const glm::vec3& center,
+                    float radius);
+
+    // Appends the objects visible in any view of the last cull, and their view masks when viewMasks is given
+    void getVisibleObjects(const std::vector<std::shared_ptr<RenderObject>>& renderObjects,
+                           std::vector<std::shared_ptr<RenderObject>>& visibleObjects,
+                           CullingStats& cullingStats,
+                           std::vector<uint8_t>* viewMasks = nullptr) const;
+
+    // World space center of the object's bounds, as gathered by updateBounds
+    [[nodiscard]] glm::vec3 getCenter(uint32_t objectIndex) const;
+
+    [[nodiscard]] static std::array<glm::vec4, 6> createFrustumPlanes(const glm::mat4& viewProjection);
+
+  private:
+    std::vector<float> m_centerX;
+    std::vector<float> m_centerY;
+    std::vector<float> m_centerZ;
+
+    std::vector<float> m_extentX;
+    std::vector<float> m_extentY;
+    std::vector<float> m_extentZ;
+
+    std::vector<float> m_radius;
+
+    // One bit per view the object is visible in
+    std::vector<uint8_t> m_viewMasks;
+
+    std::vector<uint8_t> m_insideFrustum;
+  };
+
+} // namespace vke
+
+#endif //VKE_FRUSTUMCULLER_H
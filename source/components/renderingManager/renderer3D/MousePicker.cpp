@@ -1,29 +1,24 @@
 #include "MousePicker.h"
+#include "FrustumCuller.h"
+#include "../../assets/objects/Model.h"
 #include "../../assets/objects/RenderObject.h"
-#include "../../commandBuffer/SingleUseCommandBuffer.h"
+#include "../../commandBuffer/CommandBuffer.h"
 #include "../../logicalDevice/LogicalDevice.h"
 #include "../../pipelines/pipelineManager/PipelineManager.h"
 #include "../../window/Window.h"
 #include "../../../utilities/Buffers.h"
 #include "../../../utilities/Images.h"
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <limits>
 
 namespace vke {
 
   MousePicker::MousePicker(std::shared_ptr<LogicalDevice> logicalDevice,
-                           std::shared_ptr<Window> window,
-                           const vk::CommandPool commandPool)
-    : m_logicalDevice(std::move(logicalDevice)), m_window(std::move(window)), m_commandPool(commandPool)
+                           std::shared_ptr<Window> window)
+    : m_logicalDevice(std::move(logicalDevice)), m_window(std::move(window))
   {
-    constexpr vk::DeviceSize bufferSize = 4;
-
-    Buffers::createBuffer(
-      m_logicalDevice,
-      bufferSize,
-      vk::BufferUsageFlagBits::eTransferDst,
-      vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
-      m_stagingBuffer,
-      m_stagingBufferMemory
-    );
+    createReadbacks();
   }
 
   bool MousePicker::canMousePick() const
@@ -34,18 +29,47 @@ namespace vke {
   void MousePicker::clearObjectsToMousePick()
   {
     m_renderObjectsToMousePick.clear();
+    m_mousePickingItems.clear();
   }
 
   void MousePicker::setViewportExtent(const vk::Extent2D viewportExtent)
   {
+    if (m_viewportExtent != viewportExtent)
+    {
+      m_mousePickingDirty = true;
+    }
+
     m_viewportExtent = viewportExtent;
   }
 
   void MousePicker::setViewportPos(const ImVec2 viewportPos)
   {
+    if (m_viewportPos.x != viewportPos.x || m_viewportPos.y != viewportPos.y)
+    {
+      m_mousePickingDirty = true;
+    }
+
     m_viewportPos = viewportPos;
   }
 
+  void MousePicker::setMousePickingAreaSize(const uint32_t mousePickingAreaSize)
+  {
+    if (mousePickingAreaSize == 0 || mousePickingAreaSize == m_mousePickingAreaSize)
+    {
+      return;
+    }
+
+    // Readbacks still in flight keep their buffers, each is resized the next time its frame records
+    m_mousePickingAreaSize = mousePickingAreaSize;
+
+    m_mousePickingDirty = true;
+  }
+
+  vk::Rect2D MousePicker::getMousePickingArea() const
+  {
+    return m_mousePickingArea;
+  }
+
   void MousePicker::renderObject(const std::shared_ptr<RenderObject>& renderObject,
                                  bool* mousePicked)
   {
@@ -55,60 +79,159 @@ namespace vke {
     *mousePicked = false;
   }
 
+  bool MousePicker::prepareMousePicking(const glm::mat4& viewMatrix)
+  {
+    int32_t mouseX, mouseY;
+    if (m_renderObjectsToMousePick.empty() || !validateMousePickingMousePosition(mouseX, mouseY))
+    {
+      m_mousePickedObject.reset();
+      m_mousePickingDirty = true;
+      return false;
+    }
+
+    const bool mouseMoved = mouseX != m_mouseX || mouseY != m_mouseY;
+    const bool clicked = m_window->buttonIsPressed(GLFW_MOUSE_BUTTON_LEFT);
+    const bool viewChanged = viewMatrix != m_mousePickedViewMatrix;
+    const bool sceneChanged = updateMousePickedScene();
+
+    if (!m_mousePickingDirty && !mouseMoved && !clicked && !viewChanged && !sceneChanged)
+    {
+      // Nothing under the cursor can have changed, so reuse the last result instead of rendering another pass
+      setMousePickedObject(m_mousePickedObject);
+      return false;
+    }
+
+    m_mouseX = mouseX;
+    m_mouseY = mouseY;
+    m_mousePickedViewMatrix = viewMatrix;
+    m_mousePickingDirty = false;
+
+    updateMousePickingArea();
+
+    return true;
+  }
+
+  void MousePicker::updateDrawBatches(const std::shared_ptr<SceneBuffers>& sceneBuffers,
+                                      const std::shared_ptr<FrustumCuller>& frustumCuller)
+  {
+    m_objectsToCull.clear();
+    for (const auto& [object, _] : m_renderObjectsToMousePick)
+    {
+      m_objectsToCull.push_back(object);
+    }
+
+    m_objectsToBatch.clear();
+    CullingStats cullingStats;
+    frustumCuller->getVisibleObjects(m_objectsToCull, m_objectsToBatch, cullingStats);
+
+    sceneBuffers->createDrawBatches(m_objectsToBatch, false, m_drawBatches);
+  }
+
   void MousePicker::render(const RenderInfo* renderInfo,
-                           const std::shared_ptr<PipelineManager>& pipelineManager) const
+                           const std::shared_ptr<PipelineManager>& pipelineManager,
+                           const std::shared_ptr<SceneBuffers>& sceneBuffers) const
   {
     pipelineManager->bindGraphicsPipeline(renderInfo->commandBuffer, PipelineType::mousePicking);
 
-    for (const auto& [object, id] : m_renderObjectsToMousePick)
+    sceneBuffers->bind(pipelineManager, renderInfo->commandBuffer, PipelineType::mousePicking, renderInfo->currentFrame,
+                       renderInfo->viewOffset);
+
+    // Each instance writes its object index + 1 as its ID
+    for (const auto& batch : m_drawBatches)
     {
-      pipelineManager->pushGraphicsPipelineConstants<uint32_t>(
-        renderInfo->commandBuffer,
-        PipelineType::mousePicking,
-        vk::ShaderStageFlagBits::eFragment,
-        0,
-        id
-      );
-
-      pipelineManager->bindGraphicsPipelineDescriptorSet(
-        renderInfo->commandBuffer,
-        PipelineType::mousePicking,
-        object->getDescriptorSet(renderInfo->currentFrame),
-        0
-      );
-
-      object->updateUniformBuffer(renderInfo->currentFrame, renderInfo->viewMatrix, renderInfo->getProjectionMatrix());
-
-      object->draw(renderInfo->commandBuffer);
+      batch.renderObject->getModel()->draw(renderInfo->commandBuffer, batch.firstInstance, batch.instanceCount);
     }
   }
 
-  void MousePicker::handleRenderedMousePickingImage(const vk::Image image)
+  void MousePicker::recordMousePickingReadback(const std::shared_ptr<CommandBuffer>& commandBuffer,
+                                               const vk::Image image,
+                                               const uint32_t currentFrame,
+                                               const std::vector<std::shared_ptr<RenderObject>>& sceneObjects)
   {
-	  if (m_mousePickingItems.empty())
-	  {
-	    return;
-	  }
-    int32_t mouseX, mouseY;
-    if (!validateMousePickingMousePosition(mouseX, mouseY))
+    auto& readback = m_readbacks[currentFrame];
+
+    // The frame's previous pick has already been handled, so its buffer is free to replace
+    if (readback.areaSize != m_mousePickingAreaSize)
     {
-      return;
+      m_logicalDevice->retire(std::move(readback.buffer), std::move(readback.bufferMemory));
+
+      createReadbackBuffer(readback);
     }
 
-    const auto objectID = getIDFromMousePickingImage(image, mouseX, mouseY);
+    readback.regionOffset = m_mousePickingArea.offset;
+    readback.regionExtent = m_mousePickingArea.extent;
+    readback.mouseX = m_mouseX;
+    readback.mouseY = m_mouseY;
+
+    transitionImageForReading(*commandBuffer, image);
+
+    Images::copyImageToBuffer(
+      image,
+      { m_mousePickingArea.offset.x, m_mousePickingArea.offset.y, 0 },
+      { m_mousePickingArea.extent.width, m_mousePickingArea.extent.height, 1 },
+      *commandBuffer,
+      readback.buffer
+    );
+
+    makeReadbackVisibleToHost(*commandBuffer, readback.buffer);
+
+    transitionImageForWriting(*commandBuffer, image);
+
+    readback.objects = sceneObjects;
+
+    readback.pending = true;
+  }
 
-    if (objectID == 0)
+  void MousePicker::handleMousePickingReadback(const uint32_t currentFrame)
+  {
+    auto& readback = m_readbacks[currentFrame];
+    if (!readback.pending)
     {
       return;
     }
 
-    *m_mousePickingItems.at(objectID) = true;
+    readback.pending = false;
+
+    const auto objectID = getClosestObjectIDFromBuffer(readback);
+
+    m_mousePickedObject = objectID != 0 && objectID <= readback.objects.size()
+      ? readback.objects.at(objectID - 1)
+      : nullptr;
+
+    setMousePickedObject(m_mousePickedObject);
+
+    readback.objects.clear();
+  }
+
+  void MousePicker::createReadbacks()
+  {
+    m_readbacks.clear();
+    m_readbacks.resize(m_logicalDevice->getMaxFramesInFlight());
+
+    for (auto& readback : m_readbacks)
+    {
+      createReadbackBuffer(readback);
+    }
+  }
+
+  void MousePicker::createReadbackBuffer(MousePickingReadback& readback) const
+  {
+    Buffers::createBuffer(
+      m_logicalDevice,
+      4 * m_mousePickingAreaSize * m_mousePickingAreaSize,
+      vk::BufferUsageFlagBits::eTransferDst,
+      vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+      readback.buffer,
+      readback.bufferMemory
+    );
+
+    readback.areaSize = m_mousePickingAreaSize;
   }
 
   bool MousePicker::validateMousePickingMousePosition(int32_t& mouseX,
                                                       int32_t& mouseY)
   {
-    if (m_viewportExtent.width == 0 || m_viewportExtent.height == 0)
+    if (!m_window || m_viewportExtent.width == 0 || m_viewportExtent.height == 0)
     {
       m_canMousePick = false;
     }
@@ -129,45 +252,106 @@ namespace vke {
     return m_canMousePick;
   }
 
-  uint32_t MousePicker::getIDFromMousePickingImage(vk::Image image,
-                                                   const int32_t mouseX,
-                                                   const int32_t mouseY) const
+  bool MousePicker::updateMousePickedScene()
   {
-    const auto commandBuffer = SingleUseCommandBuffer(m_logicalDevice, m_commandPool, m_logicalDevice->getGraphicsQueue());
+    bool sceneChanged = m_mousePickedScene.size() != m_renderObjectsToMousePick.size();
 
-    commandBuffer.record([this, &commandBuffer, image, mouseX, mouseY] {
-      transitionImageForReading(commandBuffer, image);
+    m_mousePickedScene.resize(m_renderObjectsToMousePick.size());
 
-      Images::copyImageToBuffer(
-        image,
-        { mouseX, mouseY, 0 },
-        { 1, 1, 1 },
-        commandBuffer,
-        m_stagingBuffer
-      );
+    for (size_t i = 0; i < m_renderObjectsToMousePick.size(); ++i)
+    {
+      const auto& object = m_renderObjectsToMousePick[i].first;
+      const auto modelMatrix = object->getModelMatrix();
+
+      auto& [pickedObject, pickedModelMatrix] = m_mousePickedScene[i];
+      if (pickedObject != object.get() || pickedModelMatrix != modelMatrix)
+      {
+        sceneChanged = true;
+        pickedObject = object.get();
+        pickedModelMatrix = modelMatrix;
+      }
+    }
 
-      transitionImageForWriting(commandBuffer, image);
-    });
+    return sceneChanged;
+  }
 
-    return getObjectIDFromBuffer(m_stagingBufferMemory);
+  void MousePicker::updateMousePickingArea()
+  {
+    const auto halfSize = static_cast<int32_t>(m_mousePickingAreaSize / 2);
+
+    const int32_t minX = std::max(m_mouseX - halfSize, 0);
+    const int32_t minY = std::max(m_mouseY - halfSize, 0);
+    const int32_t maxX = std::min(minX + static_cast<int32_t>(m_mousePickingAreaSize), static_cast<int32_t>(m_viewportExtent.width));
+    const int32_t maxY = std::min(minY + static_cast<int32_t>(m_mousePickingAreaSize), static_cast<int32_t>(m_viewportExtent.height));
+
+    m_mousePickingArea = {
+      .offset = { minX, minY },
+      .extent = {
+        .width = static_cast<uint32_t>(maxX - minX),
+        .height = static_cast<uint32_t>(maxY - minY)
+      }
+    };
   }
 
-  uint32_t MousePicker::getObjectIDFromBuffer(const vk::raii::DeviceMemory& stagingBufferMemory)
+  void MousePicker::setMousePickedObject(const std::shared_ptr<RenderObject>& renderObject) const
+  {
+    if (!renderObject)
+    {
+      return;
+    }
+
+    // The readback was recorded frames ago, so match by object rather than by ID since IDs are reassigned every frame
+    for (const auto& [object, id] : m_renderObjectsToMousePick)
+    {
+      if (object == renderObject)
+      {
+        *m_mousePickingItems.at(id) = true;
+        return;
+      }
+    }
+  }
+
+  uint32_t MousePicker::getClosestObjectIDFromBuffer(const MousePickingReadback& readback)
   {
     uint32_t objectID = 0;
 
-    Buffers::doMappedMemoryOperation(stagingBufferMemory, [&objectID](void* data) {
-      const uint8_t* pixel = static_cast<uint8_t*>(data);
+    Buffers::doMappedMemoryOperation(readback.bufferMemory, [&objectID, &readback](void* data) {
+      const uint8_t* pixels = static_cast<uint8_t*>(data);
+
+      int32_t closestDistance = std::numeric_limits<int32_t>::max();
+
+      for (uint32_t y = 0; y < readback.regionExtent.height; ++y)
+      {
+        for (uint32_t x = 0; x < readback.regionExtent.width; ++x)
+        {
+          const uint8_t* pixel = pixels + 4 * (y * readback.regionExtent.width + x);
+
+          const uint32_t id = static_cast<uint32_t>(pixel[0]) << 16 |
+                              static_cast<uint32_t>(pixel[1]) << 8 |
+                              static_cast<uint32_t>(pixel[2]);
+
+          if (id == 0)
+          {
+            continue;
+          }
 
-      objectID = static_cast<uint32_t>(pixel[0]) << 16 |
-                 static_cast<uint32_t>(pixel[1]) << 8 |
-                 static_cast<uint32_t>(pixel[2]);
+          const int32_t dx = readback.regionOffset.x + static_cast<int32_t>(x) - readback.mouseX;
+          const int32_t dy = readback.regionOffset.y + static_cast<int32_t>(y) - readback.mouseY;
+          const int32_t distance = dx * dx + dy * dy;
+
+          if (distance < closestDistance)
+          {
+            closestDistance = distance;
+            objectID = id;
+          }
+        }
+      }
     });
 
     return objectID;
   }
 
-  void MousePicker::transitionImageForReading(const SingleUseCommandBuffer& commandBuffer,
+  void MousePicker::transitionImageForReading(const CommandBuffer& commandBuffer,
                                               const vk::Image image)
   {
     const vk::ImageMemoryBarrier imageMemoryBarrier {
@@ -197,7 +381,7 @@ namespace vke {
     );
   }
 
-  void MousePicker::transitionImageForWriting(const SingleUseCommandBuffer& commandBuffer,
+  void MousePicker::transitionImageForWriting(const CommandBuffer& commandBuffer,
                                               const vk::Image image)
   {
     const vk::ImageMemoryBarrier imageMemoryBarrier {
@@ -226,4 +410,27 @@ namespace vke {
       { imageMemoryBarrier }
     );
   }
+
+  void MousePicker::makeReadbackVisibleToHost(const CommandBuffer& commandBuffer,
+                                              const vk::Buffer buffer)
+  {
+    const vk::BufferMemoryBarrier bufferMemoryBarrier {
+      .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+      .dstAccessMask = vk::AccessFlagBits::eHostRead,
+      .srcQueueFamilyIndex = vk::QueueFamilyIgnored,
+      .dstQueueFamilyIndex = vk::QueueFamilyIgnored,
+      .buffer = buffer,
+      .offset = 0,
+      .size = vk::WholeSize
+    };
+
+    commandBuffer.pipelineBarrier(
+      vk::PipelineStageFlagBits::eTransfer,
+      vk::PipelineStageFlagBits::eHost,
+      {},
+      {},
+      { bufferMemoryBarrier },
+      {}
+    );
+  }
 } // namespace vke
\ No newline at end of file
@@ -1,6 +1,9 @@
 #ifndef VKE_MOUSEPICKER_H
 #define VKE_MOUSEPICKER_H
 
+#include "SceneBuffers.h"
+#include "../../memory/MemoryAllocation.h"
+#include <glm/mat4x4.hpp>
 #include <imgui.h>
 #include <vulkan/vulkan_raii.hpp>
 #include <memory>
@@ -9,19 +12,38 @@
 
 namespace vke {
 
+  class CommandBuffer;
+  class FrustumCuller;
   class LogicalDevice;
   class PipelineManager;
   enum class PipelineType;
   struct RenderInfo;
   class RenderObject;
-  class SingleUseCommandBuffer;
   class Window;
 
+  struct MousePickingReadback {
+    vk::raii::Buffer buffer = nullptr;
+    MemoryAllocation bufferMemory = nullptr;
+
+    // Side of the square picking area the buffer was sized for
+    uint32_t areaSize = 0;
+
+    // Scene objects of the frame this readback was copied from, IDs are object indices + 1
+    std::vector<std::shared_ptr<RenderObject>> objects;
+
+    vk::Offset2D regionOffset;
+    vk::Extent2D regionExtent;
+
+    int32_t mouseX = 0;
+    int32_t mouseY = 0;
+
+    bool pending = false;
+  };
+
   class MousePicker {
   public:
     MousePicker(std::shared_ptr<LogicalDevice> logicalDevice,
-                std::shared_ptr<Window> window,
-                vk::CommandPool commandPool);
+                std::shared_ptr<Window> window);
 
     [[nodiscard]] bool canMousePick() const;
 
@@ -31,12 +53,28 @@ namespace vke {
 
     void setViewportPos(ImVec2 viewportPos);
 
+    void setMousePickingAreaSize(uint32_t mousePickingAreaSize);
+
+    [[nodiscard]] vk::Rect2D getMousePickingArea() const;
+
     void renderObject(const std::shared_ptr<RenderObject>& renderObject, bool* mousePicked);
 
+    [[nodiscard]] bool prepareMousePicking(const glm::mat4& viewMatrix);
+
+    // Objects are batched by model alone since the picking pass samples no textures
+    void updateDrawBatches(const std::shared_ptr<SceneBuffers>& sceneBuffers,
+                           const std::shared_ptr<FrustumCuller>& frustumCuller);
+
     void render(const RenderInfo* renderInfo,
-                const std::shared_ptr<PipelineManager>& pipelineManager) const;
+                const std::shared_ptr<PipelineManager>& pipelineManager,
+                const std::shared_ptr<SceneBuffers>& sceneBuffers) const;
+
+    void recordMousePickingReadback(const std::shared_ptr<CommandBuffer>& commandBuffer,
+                                    vk::Image image,
+                                    uint32_t currentFrame,
+                                    const std::vector<std::shared_ptr<RenderObject>>& sceneObjects);
 
-    void handleRenderedMousePickingImage(vk::Image image);
+    void handleMousePickingReadback(uint32_t currentFrame);
 
   private:
     std::shared_ptr<LogicalDevice> m_logicalDevice;
@@ -49,27 +87,53 @@ namespace vke {
     std::vector<std::pair<std::shared_ptr<RenderObject>, uint32_t>> m_renderObjectsToMousePick;
     std::unordered_map<uint32_t, bool*> m_mousePickingItems;
 
+    std::vector<std::shared_ptr<RenderObject>> m_objectsToCull;
+    std::vector<std::shared_ptr<RenderObject>> m_objectsToBatch;
+    std::vector<DrawBatch> m_drawBatches;
+
     bool m_canMousePick = false;
 
-    vk::CommandPool m_commandPool = nullptr;
+    // Side length of the square around the cursor that is rasterized and read back, larger sizes give a tolerance area
+    uint32_t m_mousePickingAreaSize = 1;
+
+    vk::Rect2D m_mousePickingArea {};
+
+    int32_t m_mouseX = 0;
+    int32_t m_mouseY = 0;
+
+    bool m_mousePickingDirty = true;
+
+    glm::mat4 m_mousePickedViewMatrix {};
+
+    std::vector<std::pair<const RenderObject*, glm::mat4>> m_mousePickedScene;
 
-    vk::raii::Buffer m_stagingBuffer = nullptr;
-    vk::raii::DeviceMemory m_stagingBufferMemory = nullptr;
+    std::shared_ptr<RenderObject> m_mousePickedObject;
+
+    std::vector<MousePickingReadback> m_readbacks;
+
+    void createReadbacks();
+
+    void createReadbackBuffer(MousePickingReadback& readback) const;
 
     bool validateMousePickingMousePosition(int32_t& mouseX,
                                            int32_t& mouseY);
 
-    [[nodiscard]] uint32_t getIDFromMousePickingImage(vk::Image image,
-                                                      int32_t mouseX,
-                                                      int32_t mouseY) const;
+    [[nodiscard]] bool updateMousePickedScene();
 
-    [[nodiscard]] static uint32_t getObjectIDFromBuffer(const vk::raii::DeviceMemory& stagingBufferMemory);
+    void updateMousePickingArea();
 
-    static void transitionImageForReading(const SingleUseCommandBuffer& commandBuffer,
+    void setMousePickedObject(const std::shared_ptr<RenderObject>& renderObject) const;
+
+    [[nodiscard]] static uint32_t getClosestObjectIDFromBuffer(const MousePickingReadback& readback);
+
+    static void transitionImageForReading(const CommandBuffer& commandBuffer,
                                           vk::Image image);
 
-    static void transitionImageForWriting(const SingleUseCommandBuffer& commandBuffer,
+    static void transitionImageForWriting(const CommandBuffer& commandBuffer,
                                           vk::Image image);
+
+    static void makeReadbackVisibleToHost(const CommandBuffer& commandBuffer,
+                                          vk::Buffer buffer);
   };
 
 } // namespace vke
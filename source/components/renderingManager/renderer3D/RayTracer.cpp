@@ -5,7 +5,7 @@
 #include "../../assets/objects/Model.h"
 #include "../../assets/objects/RenderObject.h"
 #include "../../assets/textures/Texture.h"
-#include "../../commandBuffer/SingleUseCommandBuffer.h"
+#include "../../commandBuffer/CommandBuffer.h"
 #include "../../lighting/LightingManager.h"
 #include "../../logicalDevice/LogicalDevice.h"
 #include "../../physicalDevice/PhysicalDevice.h"
@@ -14,6 +14,8 @@
 #include "../../pipelines/implementations/vertexInputs/Vertex.h"
 #include "../../pipelines/pipelineManager/PipelineManager.h"
 #include "../../pipelines/uniformBuffers/UniformBuffer.h"
+#include "../../profiler/CpuProfiler.h"
+#include "../../uploadManager/UploadManager.h"
 #include "../../../utilities/Buffers.h"
 
 namespace vke {
@@ -28,9 +30,9 @@ namespace vke {
 
   RayTracer::RayTracer(std::shared_ptr<LogicalDevice> logicalDevice,
                        const std::shared_ptr<AssetManager>& assetManager,
-                       const vk::CommandPool commandPool,
+                       std::shared_ptr<UploadManager> uploadManager,
                        const vk::DescriptorPool descriptorPool)
-    : m_logicalDevice(std::move(logicalDevice)), m_commandPool(commandPool)
+    : m_logicalDevice(std::move(logicalDevice)), m_uploadManager(std::move(uploadManager))
   {
     std::vector<uint32_t> maxTextures;
     for (uint32_t i = 0; i < m_logicalDevice->getMaxFramesInFlight(); ++i)
@@ -94,25 +96,40 @@ namespace vke {
     pipelineManager->doRayTracing(renderInfo->commandBuffer, renderInfo->extent);
   }
 
+  MeshInfo RayTracer::mergeMeshGeometry(const std::vector<Vertex>& vertices,
+                                        const std::vector<uint32_t>& indices,
+                                        std::vector<Vertex>& mergedVertices,
+                                        std::vector<uint32_t>& mergedIndices)
+  {
+    const MeshInfo meshInfo {
+      .vertexOffset = static_cast<uint32_t>(mergedVertices.size()),
+      .indexOffset = static_cast<uint32_t>(mergedIndices.size())
+    };
+
+    mergedVertices.insert(mergedVertices.end(), vertices.begin(), vertices.end());
+    mergedIndices.insert(mergedIndices.end(), indices.begin(), indices.end());
+
+    return meshInfo;
+  }
+
   void RayTracer::createTLAS(const std::vector<std::shared_ptr<RenderObject>>& renderObjects,
                              const std::shared_ptr<Cloud>& cloud)
   {
+    VKE_PROFILE_ZONE("RayTracer::createTLAS");
+
     if (!m_logicalDevice->getPhysicalDevice()->supportsRayTracing())
     {
       return;
     }
 
     m_tlas = nullptr;
-    m_tlasBuffer = nullptr;
-    m_tlasBufferMemory = nullptr;
-    m_tlasInstanceBuffer = nullptr;
-    m_tlasInstanceBufferMemory = nullptr;
-    m_mergedVertexBuffer = nullptr;
-    m_mergedVertexBufferMemory = nullptr;
-    m_mergedIndexBuffer = nullptr;
-    m_mergedIndexBufferMemory = nullptr;
-    m_meshInfoBuffer = nullptr;
-    m_meshInfoBufferMemory = nullptr;
+
+    // Earlier frames may still read last frame's buffers, they are released once the next upload batch retires
+    m_uploadManager->retain(std::move(m_tlasBuffer), std::move(m_tlasBufferMemory));
+    m_uploadManager->retain(std::move(m_tlasInstanceBuffer), std::move(m_tlasInstanceBufferMemory));
+    m_uploadManager->retain(std::move(m_mergedVertexBuffer), std::move(m_mergedVertexBufferMemory));
+    m_uploadManager->retain(std::move(m_mergedIndexBuffer), std::move(m_mergedIndexBufferMemory));
+    m_uploadManager->retain(std::move(m_meshInfoBuffer), std::move(m_meshInfoBufferMemory));
 
     const auto primitiveCount = createTLASInstanceBuffer(renderObjects, cloud);
 
@@ -159,22 +176,6 @@ namespace vke {
 
     const vk::DeviceSize instancesBufferSize = instances.size() * sizeof(vk::AccelerationStructureInstanceKHR);
 
-    vk::raii::Buffer stagingBuffer = nullptr;
-    vk::raii::DeviceMemory stagingBufferMemory = nullptr;
-
-    Buffers::createBuffer(
-      m_logicalDevice,
-      instancesBufferSize,
-      vk::BufferUsageFlagBits::eTransferSrc,
-      vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
-      stagingBuffer,
-      stagingBufferMemory
-    );
-
-    Buffers::doMappedMemoryOperation(stagingBufferMemory, [instances, instancesBufferSize](void* data) {
-      memcpy(data, instances.data(), instancesBufferSize);
-    });
-
     Buffers::createBuffer(
       m_logicalDevice,
       instancesBufferSize,
@@ -185,14 +186,7 @@ namespace vke {
       m_tlasInstanceBufferMemory
     );
 
-    Buffers::copyBuffer(
-      m_logicalDevice,
-      m_commandPool,
-      m_logicalDevice->getGraphicsQueue(),
-      *stagingBuffer,
-      *m_tlasInstanceBuffer,
-      instancesBufferSize
-    );
+    m_uploadManager->uploadBuffer(m_tlasInstanceBuffer, instances.data(), instancesBufferSize);
 
     return static_cast<uint32_t>(instances.size());
   }
@@ -262,7 +256,7 @@ namespace vke {
     m_tlas = m_logicalDevice->createAccelerationStructure(accelerationStructureCreateInfo);
 
     vk::raii::Buffer scratchBuffer = nullptr;
-    vk::raii::DeviceMemory scratchBufferMemory = nullptr;
+    MemoryAllocation scratchBufferMemory = nullptr;
 
     Buffers::createBuffer(
       m_logicalDevice,
@@ -283,12 +277,27 @@ namespace vke {
       .transformOffset = 0
     };
 
-    const auto commandBuffer = SingleUseCommandBuffer(m_logicalDevice, m_commandPool, m_logicalDevice->getGraphicsQueue());
+    // Built in the upload batch right after the instance upload, ahead of this frame's ray tracing
+    m_uploadManager->record([&buildGeometryInfo, &buildRangeInfo](const CommandBuffer& commandBuffer) {
+      constexpr vk::MemoryBarrier memoryBarrier {
+        .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+        .dstAccessMask = vk::AccessFlagBits::eAccelerationStructureReadKHR | vk::AccessFlagBits::eShaderRead
+      };
+
+      commandBuffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eTransfer,
+        vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR,
+        {},
+        { memoryBarrier },
+        {},
+        {}
+      );
 
-    commandBuffer.record([&commandBuffer, buildGeometryInfo, buildRangeInfo] {
       commandBuffer.buildAccelerationStructure(buildGeometryInfo, &buildRangeInfo);
     });
 
+    m_uploadManager->retain(std::move(scratchBuffer), std::move(scratchBufferMemory));
+
     m_tlasInfo = {
       .accelerationStructureCount = 1,
       .pAccelerationStructures = &*m_tlas
@@ -297,6 +306,8 @@ namespace vke {
 
   void RayTracer::updateRTSceneInfo(const std::vector<std::shared_ptr<RenderObject>>& renderObjects)
   {
+    VKE_PROFILE_ZONE("RayTracer::updateRTSceneInfo");
+
     std::vector<Vertex> mergedVertices;
     std::vector<uint32_t> mergedIndices;
     std::vector<MeshInfo> meshInfos;
@@ -338,21 +349,14 @@ namespace vke {
         m_textureImageInfos.push_back(specularMap->getImageInfo());
       }
 
-      meshInfos.push_back({
-        .vertexOffset = static_cast<uint32_t>(mergedVertices.size()),
-        .indexOffset = static_cast<uint32_t>(mergedIndices.size()),
-        .textureIndex = textureIndex,
-        .specularIndex = specularIndex,
-        .reflectivity = renderObject->getReflectivity(),
-        .refractivity = renderObject->getRefractivity(),
-        .indexOfRefraction = renderObject->getIndexOfRefraction()
-      });
-
-      const auto& vertices = model->getVertices();
-      const auto& indices = model->getIndices();
-
-      mergedVertices.insert(mergedVertices.end(), vertices.begin(), vertices.end());
-      mergedIndices.insert(mergedIndices.end(), indices.begin(), indices.end());
+      auto meshInfo = mergeMeshGeometry(model->getVertices(), model->getIndices(), mergedVertices, mergedIndices);
+      meshInfo.textureIndex = textureIndex;
+      meshInfo.specularIndex = specularIndex;
+      meshInfo.reflectivity = renderObject->getReflectivity();
+      meshInfo.refractivity = renderObject->getRefractivity();
+      meshInfo.indexOfRefraction = renderObject->getIndexOfRefraction();
+
+      meshInfos.push_back(meshInfo);
     }
 
     if (renderObjects.empty())
@@ -373,7 +377,7 @@ namespace vke {
   {
     auto uploadBuffer = [&]<typename T>(const std::vector<T>& data,
                                         vk::raii::Buffer& outBuffer,
-                                        vk::raii::DeviceMemory& outMemory)
+                                        MemoryAllocation& outMemory)
     {
       if (data.empty())
       {
@@ -382,22 +386,6 @@ namespace vke {
 
       const vk::DeviceSize size = data.size() * sizeof(T);
 
-      vk::raii::Buffer stagingBuffer = nullptr;
-      vk::raii::DeviceMemory stagingMemory = nullptr;
-
-      Buffers::createBuffer(
-        m_logicalDevice,
-        size,
-        vk::BufferUsageFlagBits::eTransferSrc,
-        vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
-        stagingBuffer,
-        stagingMemory
-      );
-
-      Buffers::doMappedMemoryOperation(stagingMemory, [&data, size](void* ptr) {
-        memcpy(ptr, data.data(), size);
-      });
-
       Buffers::createBuffer(
         m_logicalDevice,
         size,
@@ -407,14 +395,7 @@ namespace vke {
         outMemory
       );
 
-      Buffers::copyBuffer(
-        m_logicalDevice,
-        m_commandPool,
-        m_logicalDevice->getGraphicsQueue(),
-        *stagingBuffer,
-        *outBuffer,
-        size
-      );
+      m_uploadManager->uploadBuffer(outBuffer, data.data(), size);
     };
 
     uploadBuffer(mergedVertices, m_mergedVertexBuffer, m_mergedVertexBufferMemory);
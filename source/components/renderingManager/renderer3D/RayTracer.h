@@ -1,6 +1,7 @@
 #ifndef VULKANPROJECT_RAYTRACER_H
 #define VULKANPROJECT_RAYTRACER_H
 
+#include "../../memory/MemoryAllocation.h"
 #include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
 #include <vulkan/vulkan_raii.hpp>
@@ -19,6 +20,7 @@ namespace vke {
   struct RenderInfo;
   class RenderObject;
   class UniformBuffer;
+  class UploadManager;
   struct Vertex;
 
   struct MeshInfo {
@@ -36,7 +38,7 @@ namespace vke {
   public:
     explicit RayTracer(std::shared_ptr<LogicalDevice> logicalDevice,
                        const std::shared_ptr<AssetManager>& assetManager,
-                       vk::CommandPool commandPool,
+                       std::shared_ptr<UploadManager> uploadManager,
                        vk::DescriptorPool descriptorPool);
 
     void doRayTracing(const RenderInfo* renderInfo,
@@ -48,16 +50,22 @@ namespace vke {
                       const glm::vec3& viewPosition,
                       const glm::mat4& viewMatrix);
 
+    // Appends a mesh to the merged scene geometry, returning its offsets into the merged buffers
+    [[nodiscard]] static MeshInfo mergeMeshGeometry(const std::vector<Vertex>& vertices,
+                                                    const std::vector<uint32_t>& indices,
+                                                    std::vector<Vertex>& mergedVertices,
+                                                    std::vector<uint32_t>& mergedIndices);
+
   private:
     std::shared_ptr<LogicalDevice> m_logicalDevice;
 
-    vk::CommandPool m_commandPool;
+    std::shared_ptr<UploadManager> m_uploadManager;
 
     vk::raii::Buffer m_tlasInstanceBuffer = nullptr;
-    vk::raii::DeviceMemory m_tlasInstanceBufferMemory = nullptr;
+    MemoryAllocation m_tlasInstanceBufferMemory = nullptr;
 
     vk::raii::Buffer m_tlasBuffer = nullptr;
-    vk::raii::DeviceMemory m_tlasBufferMemory = nullptr;
+    MemoryAllocation m_tlasBufferMemory = nullptr;
 
     vk::raii::AccelerationStructureKHR m_tlas = nullptr;
     vk::WriteDescriptorSetAccelerationStructureKHR m_tlasInfo{};
@@ -67,13 +75,13 @@ namespace vke {
     std::shared_ptr<DescriptorSet> m_rayTracingDescriptorSet;
 
     vk::raii::Buffer m_mergedVertexBuffer = nullptr;
-    vk::raii::DeviceMemory m_mergedVertexBufferMemory = nullptr;
+    MemoryAllocation m_mergedVertexBufferMemory = nullptr;
 
     vk::raii::Buffer m_mergedIndexBuffer = nullptr;
-    vk::raii::DeviceMemory m_mergedIndexBufferMemory = nullptr;
+    MemoryAllocation m_mergedIndexBufferMemory = nullptr;
 
     vk::raii::Buffer m_meshInfoBuffer = nullptr;
-    vk::raii::DeviceMemory m_meshInfoBufferMemory = nullptr;
+    MemoryAllocation m_meshInfoBufferMemory = nullptr;
 
     vk::DescriptorBufferInfo m_vertexBufferInfo = { nullptr, 0, vk::WholeSize };
     vk::DescriptorBufferInfo m_indexBufferInfo = { nullptr, 0, vk::WholeSize };
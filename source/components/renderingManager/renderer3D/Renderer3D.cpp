@@ -1,5 +1,6 @@
 #include "Renderer3D.h"
 #include "MousePicker.h"
+#include "SceneBuffers.h"
 #include "../../assets/AssetManager.h"
 #include "../../assets/objects/Model.h"
 #include "../../assets/objects/RenderObject.h"
@@ -12,32 +13,115 @@
 #include "../../physicalDevice/PhysicalDevice.h"
 #include "../../pipelines/descriptorSets/DescriptorSet.h"
 #include "../../pipelines/pipelineManager/PipelineManager.h"
+#include "../../profiler/CpuProfiler.h"
 
 namespace vke {
 
   Renderer3D::Renderer3D(std::shared_ptr<LogicalDevice> logicalDevice,
                          std::shared_ptr<AssetManager> assetManager,
+                         std::shared_ptr<UploadManager> uploadManager,
                          std::shared_ptr<Window> window)
-    : m_logicalDevice(std::move(logicalDevice)), m_assetManager(std::move(assetManager))
+    : m_logicalDevice(std::move(logicalDevice)), m_assetManager(std::move(assetManager)),
+      m_uploadManager(std::move(uploadManager))
   {
-    createCommandPool();
-
     createDescriptorPool();
 
-    m_mousePicker = std::make_shared<MousePicker>(m_logicalDevice, std::move(window), m_commandPool);
+    m_sceneBuffers = std::make_shared<SceneBuffers>(m_logicalDevice, m_descriptorPool);
+
+    m_frustumCuller = std::make_shared<FrustumCuller>();
+
+    m_mousePicker = std::make_shared<MousePicker>(m_logicalDevice, std::move(window));
 
     createDescriptorSets();
 
     if (m_logicalDevice->getPhysicalDevice()->supportsRayTracing())
     {
-      m_rayTracer = std::make_unique<RayTracer>(m_logicalDevice, m_assetManager, m_commandPool, m_descriptorPool);
+      m_rayTracer = std::make_unique<RayTracer>(m_logicalDevice, m_assetManager, m_uploadManager, m_descriptorPool);
     }
   }
 
   void Renderer3D::updateLightingManager(const std::shared_ptr<LightingManager>& lightingManager,
-                                         const uint32_t currentFrame) const
+                                         const uint32_t currentFrame,
+                                         const vk::Extent2D extent,
+                                         const bool cullLights) const
   {
-    lightingManager->update(currentFrame, m_viewPosition);
+    if (!cullLights || extent.width == 0 || extent.height == 0)
+    {
+      lightingManager->update(currentFrame, m_viewPosition, nullptr);
+      return;
+    }
+
+    const RenderInfo renderInfo3D {
+      .currentFrame = currentFrame,
+      .viewPosition = m_viewPosition,
+      .viewMatrix = m_viewMatrix,
+      .extent = extent
+    };
+
+    const glm::mat4 viewProjection = renderInfo3D.getProjectionMatrix() * m_viewMatrix;
+
+    lightingManager->update(currentFrame, m_viewPosition, &viewProjection);
+  }
+
+  void Renderer3D::updateSceneBuffers(const RenderInfo* renderInfo,
+                                      const std::shared_ptr<LightingManager>& lightingManager)
+  {
+    VKE_PROFILE_ZONE("Renderer3D::updateSceneBuffers");
+
+    m_sceneBuffers->updateObjects(renderInfo->currentFrame, m_renderObjectsToRenderFlattened);
+
+    m_frustumCuller->updateBounds(m_renderObjectsToRenderFlattened);
+
+    m_elapsedTime += renderInfo->deltaTime;
+
+    const RenderInfo renderInfo3D {
+      .commandBuffer = renderInfo->commandBuffer,
+      .currentFrame = renderInfo->currentFrame,
+      .viewPosition = m_viewPosition,
+      .viewMatrix = m_viewMatrix,
+      .extent = renderInfo->extent
+    };
+
+    const glm::mat4& projectionMatrix = renderInfo3D.getProjectionMatrix();
+
+    const ViewUniform mainView {
+      .view = m_viewMatrix,
+      .proj = projectionMatrix,
+      .viewProj = projectionMatrix * m_viewMatrix,
+      .position = m_viewPosition,
+      .time = m_elapsedTime
+    };
+
+    m_mainViewOffset = m_sceneBuffers->writeView(renderInfo->currentFrame, mainView);
+
+    m_frustumCuller->cullFrustum(mainView.viewProj);
+
+    m_drawList.clear(m_viewMatrix);
+
+    m_cameraCullingStats = {};
+    for (const auto& [pipelineType, objects] : m_renderObjectsToRender)
+    {
+      m_visibleRenderObjects.clear();
+      m_frustumCuller->getVisibleObjects(objects, m_visibleRenderObjects, m_cameraCullingStats);
+
+      m_drawList.addObjects(pipelineType, m_visibleRenderObjects, *m_frustumCuller);
+    }
+
+    m_drawList.createDrawCommands(*m_sceneBuffers);
+
+    // Picking renders from the camera, so it reuses the camera's cull before the lights replace it
+    m_mousePicker->updateDrawBatches(m_sceneBuffers, m_frustumCuller);
+
+    m_shadowCullingStats = {};
+    if (lightingManager)
+    {
+      lightingManager->updateLightClusterUniform(renderInfo->currentFrame, m_viewMatrix, projectionMatrix, renderInfo->extent);
+
+      lightingManager->updateShadowDrawBatches(m_sceneBuffers, m_frustumCuller, m_renderObjectsToRenderFlattened,
+                                               m_shadowCullingStats);
+    }
+
+    m_sceneBuffers->updateInstances(renderInfo->currentFrame);
   }
 
   void Renderer3D::renderShadowMaps(const std::shared_ptr<LightingManager>& lightingManager,
@@ -45,7 +129,12 @@ namespace vke {
                                     const std::shared_ptr<PipelineManager>& pipelineManager,
                                     const uint32_t currentFrame) const
   {
-    lightingManager->renderShadowMaps(commandBuffer, pipelineManager, &m_renderObjectsToRenderFlattened, currentFrame);
+    lightingManager->renderShadowMaps(commandBuffer, pipelineManager, m_sceneBuffers, currentFrame);
+  }
+
+  bool Renderer3D::prepareMousePicking() const
+  {
+    return m_mousePicker->prepareMousePicking(m_viewMatrix);
   }
 
   void Renderer3D::renderMousePicking(const RenderInfo* renderInfo,
@@ -56,21 +145,31 @@ namespace vke {
       .currentFrame = renderInfo->currentFrame,
       .viewPosition = m_viewPosition,
       .viewMatrix = m_viewMatrix,
-      .extent = renderInfo->extent
+      .extent = renderInfo->extent,
+      .viewOffset = m_mainViewOffset
     };
 
-    m_mousePicker->render(&renderInfoMousePicking, pipelineManager);
+    m_mousePicker->render(&renderInfoMousePicking, pipelineManager, m_sceneBuffers);
+  }
+
+  void Renderer3D::recordMousePickingReadback(const std::shared_ptr<CommandBuffer>& commandBuffer,
+                                              const vk::Image image,
+                                              const uint32_t currentFrame) const
+  {
+    m_mousePicker->recordMousePickingReadback(commandBuffer, image, currentFrame, m_renderObjectsToRenderFlattened);
   }
 
-  void Renderer3D::handleRenderedMousePickingImage(const vk::Image image) const
+  void Renderer3D::handleMousePickingReadback(const uint32_t currentFrame) const
   {
-    m_mousePicker->handleRenderedMousePickingImage(image);
+    m_mousePicker->handleMousePickingReadback(currentFrame);
   }
 
   void Renderer3D::render(const RenderInfo* renderInfo,
                           const std::shared_ptr<PipelineManager>& pipelineManager,
                           const std::shared_ptr<LightingManager>& lightingManager)
   {
+    VKE_PROFILE_ZONE("Renderer3D::render");
+
     displayGui();
 
     const RenderInfo renderInfo3D {
@@ -78,13 +177,15 @@ namespace vke {
       .currentFrame = renderInfo->currentFrame,
       .viewPosition = m_viewPosition,
       .viewMatrix = m_viewMatrix,
-      .extent = renderInfo->extent
+      .extent = renderInfo->extent,
+      .deltaTime = renderInfo->deltaTime,
+      .viewOffset = m_mainViewOffset
     };
 
     auto& cubeMapPC = std::get<CubeMapPushConstant>(m_pushConstants.at(PipelineType::cubeMap).data);
     cubeMapPC.position = renderInfo3D.viewPosition;
 
-    renderRenderObjectsByPipeline(&renderInfo3D, pipelineManager, lightingManager);
+    renderDrawCommands(&renderInfo3D, pipelineManager, lightingManager);
 
     pipelineManager->renderBendyPlantPipeline(&renderInfo3D, &m_bendyPlantsToRender);
 
@@ -212,18 +313,14 @@ namespace vke {
     return m_cubeMapDescriptorSet->getDescriptorSetLayout();
   }
 
-  void Renderer3D::setCloudToRender(std::shared_ptr<Cloud> cloud)
+  vk::DescriptorSetLayout Renderer3D::getSceneDescriptorSetLayout() const
   {
-    m_cloudToRender = std::move(cloud);
+    return m_sceneBuffers->getDescriptorSetLayout();
   }
 
-  void Renderer3D::createCommandPool()
+  void Renderer3D::setCloudToRender(std::shared_ptr<Cloud> cloud)
   {
-    const vk::CommandPoolCreateInfo poolInfo {
-      .queueFamilyIndex = m_logicalDevice->getPhysicalDevice()->getQueueFamilies().graphicsFamily.value()
-    };
-
-    m_commandPool = m_logicalDevice->createCommandPool(poolInfo);
+    m_cloudToRender = std::move(cloud);
   }
 
   void Renderer3D::createDescriptorPool()
@@ -232,6 +329,7 @@ namespace vke {
       {vk::DescriptorType::eCombinedImageSampler, m_logicalDevice->getMaxFramesInFlight() * 256},
       {vk::DescriptorType::eStorageImage, m_logicalDevice->getMaxFramesInFlight() * 4},
       {vk::DescriptorType::eStorageBuffer, m_logicalDevice->getMaxFramesInFlight() * 10},
+      {vk::DescriptorType::eUniformBufferDynamic, m_logicalDevice->getMaxFramesInFlight()},
     }};
 
     if (m_logicalDevice->getPhysicalDevice()->supportsRayTracing())
@@ -249,30 +347,54 @@ namespace vke {
     m_descriptorPool = m_logicalDevice->createDescriptorPool(poolCreateInfo);
   }
 
-  void Renderer3D::renderRenderObjectsByPipeline(const RenderInfo* renderInfo,
-                                                 const std::shared_ptr<PipelineManager>& pipelineManager,
-                                                 const std::shared_ptr<LightingManager>& lightingManager) const
+  void Renderer3D::renderDrawCommands(const RenderInfo* renderInfo,
+                                      const std::shared_ptr<PipelineManager>& pipelineManager,
+                                      const std::shared_ptr<LightingManager>& lightingManager) const
   {
-    const std::vector<std::shared_ptr<RenderObject>>* highlightedRenderObjects = nullptr;
-    for (const auto& [pipelineType, objects] : m_renderObjectsToRender)
+    VKE_PROFILE_ZONE("Renderer3D::renderDrawCommands");
+
+    // Commands come sorted, so state is only bound when it differs from the previous command's
+    const DrawCommand* previousCommand = nullptr;
+    for (const auto& drawCommand : m_drawList.getDrawCommands())
     {
-      if (objects.empty())
+      const auto& [pipelineType, batch] = drawCommand;
+      const auto& renderObject = batch.renderObject;
+      const RenderObject* previousObject = previousCommand ? previousCommand->batch.renderObject.get() : nullptr;
+
+      const bool pipelineChanged = !previousCommand || previousCommand->pipelineType != pipelineType;
+      if (pipelineChanged)
       {
-        continue;
+        pipelineManager->bindGraphicsPipeline(renderInfo->commandBuffer, pipelineType);
+
+        bindPushConstant(pipelineManager, renderInfo->commandBuffer, pipelineType);
+
+        m_sceneBuffers->bind(pipelineManager, renderInfo->commandBuffer, pipelineType, renderInfo->currentFrame,
+                             renderInfo->viewOffset);
+
+        bindDescriptorSets(pipelineManager, lightingManager, renderInfo->commandBuffer, pipelineType, renderInfo->currentFrame);
       }
 
-      if (pipelineType == PipelineType::objectHighlight)
+      // The object's set only holds its textures, so any object sharing them can keep the bound one
+      if (pipelineChanged || renderObject->getTexture() != previousObject->getTexture() ||
+          renderObject->getSpecularMap() != previousObject->getSpecularMap())
       {
-        highlightedRenderObjects = &objects;
-        continue;
+        pipelineManager->bindGraphicsPipelineDescriptorSet(
+          renderInfo->commandBuffer,
+          pipelineType,
+          renderObject->getDescriptorSet(renderInfo->currentFrame),
+          1
+        );
       }
 
-      renderRenderObjects(pipelineManager, lightingManager, renderInfo, pipelineType, &objects);
-    }
+      // Vertex and index buffers stay bound across pipeline changes
+      if (!previousObject || renderObject->getModel() != previousObject->getModel())
+      {
+        renderObject->getModel()->bind(renderInfo->commandBuffer);
+      }
 
-    if (highlightedRenderObjects)
-    {
-      renderRenderObjects(pipelineManager, lightingManager, renderInfo, PipelineType::objectHighlight, highlightedRenderObjects);
+      renderObject->getModel()->drawInstances(renderInfo->commandBuffer, batch.firstInstance, batch.instanceCount);
+
+      previousCommand = &drawCommand;
     }
   }
 
@@ -307,33 +429,6 @@ namespace vke {
     renderInfo->commandBuffer->draw(4, 1, 0, 0);
   }
 
-  void Renderer3D::renderRenderObjects(const std::shared_ptr<PipelineManager>& pipelineManager,
-                                       const std::shared_ptr<LightingManager>& lightingManager,
-                                       const RenderInfo* renderInfo,
-                                       const PipelineType pipelineType,
-                                       const std::vector<std::shared_ptr<RenderObject>>* objects) const
-  {
-    pipelineManager->bindGraphicsPipeline(renderInfo->commandBuffer, pipelineType);
-
-    bindPushConstant(pipelineManager, renderInfo->commandBuffer, pipelineType);
-
-    bindDescriptorSets(pipelineManager, lightingManager, renderInfo->commandBuffer, pipelineType, renderInfo->currentFrame);
-
-    for (const auto& object : *objects)
-    {
-      object->updateUniformBuffer(renderInfo->currentFrame, renderInfo->viewMatrix, renderInfo->getProjectionMatrix());
-
-      pipelineManager->bindGraphicsPipelineDescriptorSet(
-        renderInfo->commandBuffer,
-        pipelineType,
-        object->getDescriptorSet(renderInfo->currentFrame),
-        0
-      );
-
-      object->draw(renderInfo->commandBuffer);
-    }
-  }
-
   void Renderer3D::bindPushConstant(const std::shared_ptr<PipelineManager>& pipelineManager,
                                     const std::shared_ptr<CommandBuffer>& commandBuffer,
                                     const PipelineType pipelineType) const
@@ -367,7 +462,7 @@ namespace vke {
         commandBuffer,
         pipelineType,
         m_cubeMapDescriptorSet->getDescriptorSet(currentFrame),
-        1
+        2
       );
     }
 
@@ -378,7 +473,7 @@ namespace vke {
         commandBuffer,
         pipelineType,
         m_noiseDescriptorSet->getDescriptorSet(currentFrame),
-        2
+        3
       );
     }
 
@@ -394,14 +489,14 @@ namespace vke {
         commandBuffer,
         pipelineType,
         lightingManager->getLightingDescriptorSet()->getDescriptorSet(currentFrame),
-        1
+        2
       );
     }
   }
 
   void Renderer3D::createDescriptorSets()
   {
-    m_noiseTexture = std::make_shared<Texture3D>(m_logicalDevice, m_commandPool, "assets/noise/noise3d.064.tex",
+    m_noiseTexture = std::make_shared<Texture3D>(m_logicalDevice, m_uploadManager, "assets/noise/noise3d.064.tex",
                                                  vk::SamplerAddressMode::eRepeat);
 
     std::array<std::string, 6> paths {
@@ -412,7 +507,7 @@ namespace vke {
       "assets/cubeMap/nvposz.bmp",
       "assets/cubeMap/nvnegz.bmp"
     };
-    m_cubeMapTexture = std::make_shared<TextureCubemap>(m_logicalDevice, m_commandPool, paths);
+    m_cubeMapTexture = std::make_shared<TextureCubemap>(m_logicalDevice, m_uploadManager, paths);
 
     constexpr vk::DescriptorSetLayoutBinding noiseSamplerLayout {
       .binding = 0,
@@ -473,6 +568,8 @@ namespace vke {
     displayEllipticalDotsGui();
 
     displayMiscGui();
+
+    displayCullingGui();
   }
 
   void Renderer3D::displayCrossesGui()
@@ -633,4 +730,14 @@ namespace vke {
     }
   }
 
+  void Renderer3D::displayCullingGui() const
+  {
+    ImGui::Begin("Culling");
+
+    ImGui::Text("Camera: %u visible, %u culled", m_cameraCullingStats.visible, m_cameraCullingStats.culled);
+    ImGui::Text("Shadows: %u visible, %u culled", m_shadowCullingStats.visible, m_shadowCullingStats.culled);
+
+    ImGui::End();
+  }
+
 } // vke
\ No newline at end of file
@@ -1,8 +1,11 @@
 #ifndef VULKANPROJECT_RENDERER3D_H
 #define VULKANPROJECT_RENDERER3D_H
 
+#include "DrawList.h"
+#include "FrustumCuller.h"
 #include "RayTracer.h"
 #include "Renderer3DPushConstants.h"
+#include "SceneBuffers.h"
 #include "../../pipelines/implementations/common/PipelineTypes.h"
 #include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
@@ -29,6 +32,7 @@ namespace vke {
   class SmokeSystem;
   class Texture3D;
   class TextureCubemap;
+  class UploadManager;
   class Window;
 
   struct BendyPlant {
@@ -59,20 +63,34 @@ namespace vke {
   public:
     Renderer3D(std::shared_ptr<LogicalDevice> logicalDevice,
                std::shared_ptr<AssetManager> assetManager,
+               std::shared_ptr<UploadManager> uploadManager,
                std::shared_ptr<Window> window);
 
+    // Lights are culled against the camera's frustum when cullLights is set and the extent is not empty
     void updateLightingManager(const std::shared_ptr<LightingManager>& lightingManager,
-                               uint32_t currentFrame) const;
+                               uint32_t currentFrame,
+                               vk::Extent2D extent,
+                               bool cullLights) const;
+
+    // Culls the frame's objects for every pass and writes the camera, object and instance data they read, ahead of recording any of them
+    void updateSceneBuffers(const RenderInfo* renderInfo,
+                            const std::shared_ptr<LightingManager>& lightingManager);
 
     void renderShadowMaps(const std::shared_ptr<LightingManager>& lightingManager,
                           const std::shared_ptr<CommandBuffer>& commandBuffer,
                           const std::shared_ptr<PipelineManager>& pipelineManager,
                           uint32_t currentFrame) const;
 
+    [[nodiscard]] bool prepareMousePicking() const;
+
     void renderMousePicking(const RenderInfo* renderInfo,
                             const std::shared_ptr<PipelineManager>& pipelineManager) const;
 
-    void handleRenderedMousePickingImage(vk::Image image) const;
+    void recordMousePickingReadback(const std::shared_ptr<CommandBuffer>& commandBuffer,
+                                    vk::Image image,
+                                    uint32_t currentFrame) const;
+
+    void handleMousePickingReadback(uint32_t currentFrame) const;
 
     void render(const RenderInfo* renderInfo,
                 const std::shared_ptr<PipelineManager>& pipelineManager,
@@ -114,6 +132,8 @@ namespace vke {
 
     [[nodiscard]] vk::DescriptorSetLayout getCubeMapDescriptorSetLayout() const;
 
+    [[nodiscard]] vk::DescriptorSetLayout getSceneDescriptorSetLayout() const;
+
     void setCloudToRender(std::shared_ptr<Cloud> cloud);
 
   private:
@@ -121,12 +141,19 @@ namespace vke {
 
     std::shared_ptr<AssetManager> m_assetManager;
 
-    vk::raii::CommandPool m_commandPool = nullptr;
+    std::shared_ptr<UploadManager> m_uploadManager;
 
     vk::raii::DescriptorPool m_descriptorPool = nullptr;
 
     std::shared_ptr<MousePicker> m_mousePicker;
 
+    std::shared_ptr<SceneBuffers> m_sceneBuffers;
+
+    uint32_t m_mainViewOffset = 0;
+
+    // Seconds rendered so far, handed to the shaders with the camera
+    float m_elapsedTime = 0.0f;
+
     bool m_shouldRenderGrid = true;
 
     glm::vec3 m_viewPosition{};
@@ -135,6 +162,16 @@ namespace vke {
     std::unordered_map<PipelineType, std::vector<std::shared_ptr<RenderObject>>> m_renderObjectsToRender;
     std::vector<std::shared_ptr<RenderObject>> m_renderObjectsToRenderFlattened;
 
+    std::shared_ptr<FrustumCuller> m_frustumCuller;
+
+    std::vector<std::shared_ptr<RenderObject>> m_visibleRenderObjects;
+
+    // Rebuilt every frame from the objects left after culling
+    DrawList m_drawList;
+
+    CullingStats m_cameraCullingStats;
+    CullingStats m_shadowCullingStats;
+
     std::vector<LineVertex> m_lineVerticesToRender;
 
     std::vector<BendyPlant> m_bendyPlantsToRender;
@@ -164,13 +201,11 @@ namespace vke {
 
     std::shared_ptr<Cloud> m_cloudToRender;
 
-    void createCommandPool();
-
     void createDescriptorPool();
 
-    void renderRenderObjectsByPipeline(const RenderInfo* renderInfo,
-                                       const std::shared_ptr<PipelineManager>& pipelineManager,
-                                       const std::shared_ptr<LightingManager>& lightingManager) const;
+    void renderDrawCommands(const RenderInfo* renderInfo,
+                            const std::shared_ptr<PipelineManager>& pipelineManager,
+                            const std::shared_ptr<LightingManager>& lightingManager) const;
 
     void renderSmokeSystems(const RenderInfo* renderInfo,
                             const std::shared_ptr<PipelineManager>& pipelineManager) const;
@@ -178,12 +213,6 @@ namespace vke {
     static void renderGrid(const std::shared_ptr<PipelineManager>& pipelineManager,
                            const RenderInfo* renderInfo);
 
-    void renderRenderObjects(const std::shared_ptr<PipelineManager>& pipelineManager,
-                             const std::shared_ptr<LightingManager>& lightingManager,
-                             const RenderInfo* renderInfo,
-                             PipelineType pipelineType,
-                             const std::vector<std::shared_ptr<RenderObject>>* objects) const;
-
     void bindPushConstant(const std::shared_ptr<PipelineManager>& pipelineManager,
                           const std::shared_ptr<CommandBuffer>& commandBuffer,
                           PipelineType pipelineType) const;
@@ -207,6 +236,8 @@ namespace vke {
     void displayEllipticalDotsGui();
 
     void displayMiscGui();
+
+    void displayCullingGui() const;
   };
 } // vke
 
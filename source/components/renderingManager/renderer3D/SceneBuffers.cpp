@@ -0,0 +1,292 @@
+#include "SceneBuffers.h"
+#include "../../assets/objects/RenderObject.h"
+#include "../../logicalDevice/LogicalDevice.h"
+#include "../../physicalDevice/PhysicalDevice.h"
+#include "../../pipelines/descriptorSets/DescriptorSet.h"
+#include "../../pipelines/pipelineManager/PipelineManager.h"
+#include "../../pipelines/uniformBuffers/UniformBuffer.h"
+#include "../../profiler/CpuProfiler.h"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <tuple>
+
+namespace {
+
+  // Passes that can select their own camera in a single frame
+  constexpr uint32_t MAX_VIEWS_PER_FRAME = 8;
+
+  // Objects and instances the storage buffers have room for before their first reallocation
+  constexpr size_t INITIAL_OBJECT_CAPACITY = 64;
+  constexpr size_t INITIAL_INSTANCE_CAPACITY = 256;
+
+  constexpr vk::DescriptorSetLayoutBinding viewLayout {
+    .binding = 0,
+    .descriptorType = vk::DescriptorType::eUniformBufferDynamic,
+    .descriptorCount = 1,
+    .stageFlags = vk::ShaderStageFlagBits::eVertex |
+                  vk::ShaderStageFlagBits::eGeometry |
+                  vk::ShaderStageFlagBits::eFragment
+  };
+
+  constexpr vk::DescriptorSetLayoutBinding objectsLayout {
+    .binding = 1,
+    .descriptorType = vk::DescriptorType::eStorageBuffer,
+    .descriptorCount = 1,
+    .stageFlags = vk::ShaderStageFlagBits::eVertex |
+                  vk::ShaderStageFlagBits::eGeometry |
+                  vk::ShaderStageFlagBits::eFragment
+  };
+
+  constexpr vk::DescriptorSetLayoutBinding instancesLayout {
+    .binding = 2,
+    .descriptorType = vk::DescriptorType::eStorageBuffer,
+    .descriptorCount = 1,
+    .stageFlags = vk::ShaderStageFlagBits::eVertex |
+                  vk::ShaderStageFlagBits::eGeometry |
+                  vk::ShaderStageFlagBits::eFragment
+  };
+
+}
+
+namespace vke {
+
+  SceneBuffers::SceneBuffers(std::shared_ptr<LogicalDevice> logicalDevice,
+                             const vk::DescriptorPool descriptorPool)
+    : m_logicalDevice(std::move(logicalDevice))
+  {
+    createViewUniform();
+
+    createStorageBuffer(m_objectsBuffer, sizeof(ObjectUniform), INITIAL_OBJECT_CAPACITY, 1);
+
+    createStorageBuffer(m_instancesBuffer, sizeof(uint32_t), INITIAL_INSTANCE_CAPACITY, 2);
+
+    createDescriptorSet(descriptorPool);
+  }
+
+  void SceneBuffers::updateObjects(const uint32_t currentFrame,
+                                   const std::vector<std::shared_ptr<RenderObject>>& renderObjects)
+  {
+    VKE_PROFILE_ZONE("SceneBuffers::updateObjects");
+
+    m_viewCount = 0;
+
+    m_instanceObjectIndices.clear();
+
+    reserveStorageBuffer(m_objectsBuffer, renderObjects.size(), currentFrame);
+
+    m_objectUniforms.resize(renderObjects.size());
+
+    for (uint32_t i = 0; i < renderObjects.size(); ++i)
+    {
+      m_objectUniforms[i] = {
+        .model = renderObjects[i]->getModelMatrix(),
+        .reflectivity = renderObjects[i]->getReflectivity(),
+        .refractivity = renderObjects[i]->getRefractivity(),
+        .indexOfRefraction = renderObjects[i]->getIndexOfRefraction(),
+        .receivesShadows = renderObjects[i]->receivesShadows()
+      };
+
+      renderObjects[i]->setObjectIndex(i);
+    }
+
+    m_objectsBuffer.buffer->update(currentFrame, m_objectUniforms.data(), sizeof(ObjectUniform) * m_objectUniforms.size());
+  }
+
+  void SceneBuffers::createDrawBatches(const std::vector<std::shared_ptr<RenderObject>>& renderObjects,
+                                       const bool matchTextures,
+                                       std::vector<DrawBatch>& drawBatches,
+                                       const std::vector<uint8_t>* viewMasks)
+  {
+    VKE_PROFILE_ZONE("SceneBuffers::createDrawBatches");
+
+    drawBatches.clear();
+
+    const auto getBatchKey = [&renderObjects, matchTextures](const uint32_t i) {
+      const auto& renderObject = renderObjects[i];
+
+      return std::make_tuple(
+        renderObject->getModel().get(),
+        matchTextures ? renderObject->getTexture().get() : nullptr,
+        matchTextures ? renderObject->getSpecularMap().get() : nullptr
+      );
+    };
+
+    m_batchOrder.resize(renderObjects.size());
+    for (uint32_t i = 0; i < m_batchOrder.size(); ++i)
+    {
+      m_batchOrder[i] = i;
+    }
+
+    // Stable so objects within a batch keep their submission order
+    std::ranges::stable_sort(m_batchOrder, [&getBatchKey](const uint32_t a, const uint32_t b) {
+      return getBatchKey(a) < getBatchKey(b);
+    });
+
+    for (size_t i = 0; i < m_batchOrder.size(); ++i)
+    {
+      const uint32_t objectOrder = m_batchOrder[i];
+      const auto& renderObject = renderObjects[objectOrder];
+
+      if (i == 0 || getBatchKey(objectOrder) != getBatchKey(m_batchOrder[i - 1]))
+      {
+        drawBatches.push_back({
+          .renderObject = renderObject,
+          .firstInstance = static_cast<uint32_t>(m_instanceObjectIndices.size())
+        });
+      }
+
+      const uint32_t culledViews = viewMasks ? static_cast<uint8_t>(~(*viewMasks)[objectOrder]) : 0;
+
+      m_instanceObjectIndices.push_back(renderObject->getObjectIndex() | culledViews << INSTANCE_CULLED_VIEWS_SHIFT);
+
+      ++drawBatches.back().instanceCount;
+    }
+  }
+
+  uint32_t SceneBuffers::addInstance(const RenderObject& renderObject)
+  {
+    m_instanceObjectIndices.push_back(renderObject.getObjectIndex());
+
+    return static_cast<uint32_t>(m_instanceObjectIndices.size() - 1);
+  }
+
+  void SceneBuffers::updateInstances(const uint32_t currentFrame)
+  {
+    reserveStorageBuffer(m_instancesBuffer, m_instanceObjectIndices.size(), currentFrame);
+
+    m_instancesBuffer.buffer->update(currentFrame, m_instanceObjectIndices.data(),
+                                     sizeof(uint32_t) * m_instanceObjectIndices.size());
+  }
+
+  uint32_t SceneBuffers::writeView(const uint32_t currentFrame,
+                                   const ViewUniform& view)
+  {
+    if (m_viewCount == MAX_VIEWS_PER_FRAME)
+    {
+      throw std::runtime_error("too many views written in one frame!");
+    }
+
+    const auto viewOffset = static_cast<uint32_t>(m_viewStride * m_viewCount++);
+
+    m_viewUniform->update(currentFrame, &view, sizeof(ViewUniform), viewOffset);
+
+    return viewOffset;
+  }
+
+  void SceneBuffers::bind(const std::shared_ptr<PipelineManager>& pipelineManager,
+                          const std::shared_ptr<CommandBuffer>& commandBuffer,
+                          const PipelineType pipelineType,
+                          const uint32_t currentFrame,
+                          const uint32_t viewOffset) const
+  {
+    pipelineManager->bindGraphicsPipelineDescriptorSet(
+      commandBuffer,
+      pipelineType,
+      m_sceneDescriptorSet->getDescriptorSet(currentFrame),
+      0,
+      { viewOffset }
+    );
+  }
+
+  vk::DescriptorSetLayout SceneBuffers::getDescriptorSetLayout() const
+  {
+    return m_sceneDescriptorSet->getDescriptorSetLayout();
+  }
+
+  void SceneBuffers::createViewUniform()
+  {
+    const vk::DeviceSize alignment = m_logicalDevice->getPhysicalDevice()->getDeviceProperties().limits.minUniformBufferOffsetAlignment;
+
+    m_viewStride = (sizeof(ViewUniform) + alignment - 1) / alignment * alignment;
+
+    m_viewUniform = std::make_unique<UniformBuffer>(m_logicalDevice, m_viewStride * MAX_VIEWS_PER_FRAME);
+
+    for (size_t i = 0; i < m_logicalDevice->getMaxFramesInFlight(); ++i)
+    {
+      m_viewBufferInfos.push_back({
+        .buffer = m_viewUniform->getBuffer(i),
+        .offset = 0,
+        .range = sizeof(ViewUniform)
+      });
+    }
+  }
+
+  void SceneBuffers::createStorageBuffer(SceneStorageBuffer& storageBuffer,
+                                         const vk::DeviceSize elementSize,
+                                         const size_t capacity,
+                                         const uint32_t binding) const
+  {
+    storageBuffer.buffer = std::make_unique<UniformBuffer>(m_logicalDevice, elementSize * capacity);
+    storageBuffer.elementSize = elementSize;
+    storageBuffer.capacity = capacity;
+    storageBuffer.binding = binding;
+    storageBuffer.descriptorsOutdated.resize(m_logicalDevice->getMaxFramesInFlight(), false);
+  }
+
+  void SceneBuffers::reserveStorageBuffer(SceneStorageBuffer& storageBuffer,
+                                          const size_t count,
+                                          const uint32_t currentFrame) const
+  {
+    if (count > storageBuffer.capacity)
+    {
+      storageBuffer.capacity = std::bit_ceil(count);
+
+      // The old buffers are retired by their destructor, so frames still in flight can finish reading them
+      storageBuffer.buffer = std::make_unique<UniformBuffer>(m_logicalDevice, storageBuffer.elementSize * storageBuffer.capacity);
+
+      storageBuffer.descriptorsOutdated.assign(m_logicalDevice->getMaxFramesInFlight(), true);
+    }
+
+    // Descriptor sets of other frames may still be in use, so each one is pointed at the new buffer on its own frame
+    if (storageBuffer.descriptorsOutdated[currentFrame])
+    {
+      m_logicalDevice->updateDescriptorSets({
+        getStorageDescriptorSet(storageBuffer, m_sceneDescriptorSet->getDescriptorSet(currentFrame), currentFrame)
+      });
+
+      storageBuffer.descriptorsOutdated[currentFrame] = false;
+    }
+  }
+
+  void SceneBuffers::createDescriptorSet(const vk::DescriptorPool descriptorPool)
+  {
+    const std::vector layoutBindings {
+      viewLayout,
+      objectsLayout,
+      instancesLayout
+    };
+
+    m_sceneDescriptorSet = std::make_shared<DescriptorSet>(m_logicalDevice, descriptorPool, layoutBindings);
+    m_sceneDescriptorSet->updateDescriptorSets([this](const vk::DescriptorSet descriptorSet, const size_t frame)
+    {
+      const vk::WriteDescriptorSet viewDescriptorSet {
+        .dstSet = descriptorSet,
+        .dstBinding = 0,
+        .dstArrayElement = 0,
+        .descriptorCount = 1,
+        .descriptorType = vk::DescriptorType::eUniformBufferDynamic,
+        .pBufferInfo = &m_viewBufferInfos[frame]
+      };
+
+      std::vector descriptorWrites{{
+        viewDescriptorSet,
+        getStorageDescriptorSet(m_objectsBuffer, descriptorSet, frame),
+        getStorageDescriptorSet(m_instancesBuffer, descriptorSet, frame)
+      }};
+
+      return descriptorWrites;
+    });
+  }
+
+  vk::WriteDescriptorSet SceneBuffers::getStorageDescriptorSet(const SceneStorageBuffer& storageBuffer,
+                                                               const vk::DescriptorSet descriptorSet,
+                                                               const size_t frame)
+  {
+    auto descriptorWrite = storageBuffer.buffer->getDescriptorSet(storageBuffer.binding, descriptorSet, frame);
+    descriptorWrite.descriptorType = vk::DescriptorType::eStorageBuffer;
+
+    return descriptorWrite;
+  }
+
+} // namespace vke
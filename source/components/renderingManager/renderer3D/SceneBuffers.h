@@ -0,0 +1,136 @@
+#ifndef VKE_SCENEBUFFERS_H
+#define VKE_SCENEBUFFERS_H
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <vulkan/vulkan_raii.hpp>
+#include <memory>
+#include <vector>
+
+namespace vke {
+
+  class CommandBuffer;
+  class DescriptorSet;
+  class LogicalDevice;
+  class PipelineManager;
+  enum class PipelineType;
+  class RenderObject;
+  class UniformBuffer;
+
+  struct ViewUniform {
+    alignas(16) glm::mat4 view;
+    alignas(16) glm::mat4 proj;
+    alignas(16) glm::mat4 viewProj;
+    alignas(16) glm::vec3 position;
+    float time;
+  };
+
+  // Matches ObjectData in Scene.glsl
+  struct ObjectUniform {
+    alignas(16) glm::mat4 model;
+    float reflectivity;
+    float refractivity;
+    float indexOfRefraction;
+    uint32_t receivesShadows;
+  };
+
+  // Instances hold their object index below this bit and the multiview views they are culled from above it
+  constexpr uint32_t INSTANCE_CULLED_VIEWS_SHIFT = 26;
+
+  // One instanced draw, every instance shares the model and descriptor set of renderObject
+  struct DrawBatch {
+    std::shared_ptr<RenderObject> renderObject;
+    uint32_t firstInstance = 0;
+    uint32_t instanceCount = 0;
+  };
+
+  // Storage buffer that only grows, each frame's descriptor is pointed at a new buffer on that frame
+  struct SceneStorageBuffer {
+    std::unique_ptr<UniformBuffer> buffer;
+    vk::DeviceSize elementSize = 0;
+    size_t capacity = 0;
+    uint32_t binding = 0;
+    std::vector<bool> descriptorsOutdated;
+  };
+
+  // Per frame camera, object and instance data shared by every pass, bound as set 0 of the render object pipelines
+  class SceneBuffers {
+  public:
+    SceneBuffers(std::shared_ptr<LogicalDevice> logicalDevice,
+                 vk::DescriptorPool descriptorPool);
+
+    // Starts the frame's scene data, writing every object's data and giving each its index before any pass draws them
+    void updateObjects(uint32_t currentFrame,
+                       const std::vector<std::shared_ptr<RenderObject>>& renderObjects);
+
+    // Groups objects sharing a model, and their textures when matchTextures is set, into instanced draws
+    // viewMasks, indexed like renderObjects, holds the multiview views each object is visible in
+    void createDrawBatches(const std::vector<std::shared_ptr<RenderObject>>& renderObjects,
+                           bool matchTextures,
+                           std::vector<DrawBatch>& drawBatches,
+                           const std::vector<uint8_t>* viewMasks = nullptr);
+
+    // Appends an instance of the object for a batch built outside createDrawBatches, returns the instance's index
+    uint32_t addInstance(const RenderObject& renderObject);
+
+    // Uploads the instances of every batch created this frame, has to run before any of them are recorded
+    void updateInstances(uint32_t currentFrame);
+
+    // Returns the dynamic offset that selects the view when binding, views are written from the first slot every frame
+    [[nodiscard]] uint32_t writeView(uint32_t currentFrame,
+                                     const ViewUniform& view);
+
+    void bind(const std::shared_ptr<PipelineManager>& pipelineManager,
+              const std::shared_ptr<CommandBuffer>& commandBuffer,
+              PipelineType pipelineType,
+              uint32_t currentFrame,
+              uint32_t viewOffset) const;
+
+    [[nodiscard]] vk::DescriptorSetLayout getDescriptorSetLayout() const;
+
+  private:
+    std::shared_ptr<LogicalDevice> m_logicalDevice;
+
+    std::shared_ptr<DescriptorSet> m_sceneDescriptorSet;
+
+    std::unique_ptr<UniformBuffer> m_viewUniform;
+
+    std::vector<vk::DescriptorBufferInfo> m_viewBufferInfos;
+
+    // Size of one view slot, rounded up to the device's dynamic offset alignment
+    vk::DeviceSize m_viewStride = 0;
+
+    uint32_t m_viewCount = 0;
+
+    SceneStorageBuffer m_objectsBuffer;
+
+    std::vector<ObjectUniform> m_objectUniforms;
+
+    SceneStorageBuffer m_instancesBuffer;
+
+    // Object index of every instance, each batch owns a contiguous range starting at its firstInstance
+    std::vector<uint32_t> m_instanceObjectIndices;
+
+    std::vector<uint32_t> m_batchOrder;
+
+    void createViewUniform();
+
+    void createStorageBuffer(SceneStorageBuffer& storageBuffer,
+                             vk::DeviceSize elementSize,
+                             size_t capacity,
+                             uint32_t binding) const;
+
+    void reserveStorageBuffer(SceneStorageBuffer& storageBuffer,
+                              size_t count,
+                              uint32_t currentFrame) const;
+
+    void createDescriptorSet(vk::DescriptorPool descriptorPool);
+
+    [[nodiscard]] static vk::WriteDescriptorSet getStorageDescriptorSet(const SceneStorageBuffer& storageBuffer,
+                                                                        vk::DescriptorSet descriptorSet,
+                                                                        size_t frame);
+  };
+
+} // namespace vke
+
+#endif //VKE_SCENEBUFFERS_H
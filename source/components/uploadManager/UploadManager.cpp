@@ -0,0 +1,543 @@
+#include "UploadManager.h"
+#include "../commandBuffer/UploadCommandBuffer.h"
+#include "../logicalDevice/LogicalDevice.h"
+#include "../physicalDevice/PhysicalDevice.h"
+#include "../profiler/CpuProfiler.h"
+#include "../../utilities/Buffers.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace vke {
+
+  // Covers the texel size of every format uploaded through the ring
+  constexpr vk::DeviceSize STAGING_ALIGNMENT = 16;
+
+  UploadManager::UploadManager(std::shared_ptr<LogicalDevice> logicalDevice,
+                               const vk::DeviceSize stagingCapacity)
+    : m_logicalDevice(std::move(logicalDevice)), m_stagingCapacity(stagingCapacity)
+  {
+    const auto queueFamilies = m_logicalDevice->getPhysicalDevice()->getQueueFamilies();
+
+    m_graphicsFamily = queueFamilies.graphicsFamily.value();
+
+    // Released buffers are only acquired on the graphics queue, so compute work on another family couldn't use them
+    if (queueFamilies.computeFamily == queueFamilies.graphicsFamily)
+    {
+      m_transferFamily = queueFamilies.transferFamily;
+    }
+
+    createCommandPools();
+
+    createStagingBuffer();
+  }
+
+  UploadManager::~UploadManager()
+  {
+    if (!m_submittedBatches.empty())
+    {
+      m_logicalDevice->waitForGraphicsTimelineValue(m_submittedBatches.back().timelineValue);
+    }
+  }
+
+  void UploadManager::uploadBuffer(const vk::Buffer dstBuffer,
+                                   const void* data,
+                                   const vk::DeviceSize size,
+                                   const vk::DeviceSize dstOffset)
+  {
+    upload(size, [data, size](void* stagingData) {
+      memcpy(stagingData, data, size);
+    }, [dstBuffer, size, dstOffset](const CommandBuffer& commandBuffer, const StagingRegion& stagingRegion) {
+      Buffers::copyBuffer(commandBuffer, stagingRegion.buffer, dstBuffer, size, stagingRegion.offset, dstOffset);
+    });
+
+    releaseBuffer(dstBuffer);
+  }
+
+  void UploadManager::updateBuffer(const vk::Buffer dstBuffer,
+                                   const void* data,
+                                   const vk::DeviceSize size,
+                                   const vk::DeviceSize dstOffset)
+  {
+    stage(false, size, [data, size](void* stagingData) {
+      memcpy(stagingData, data, size);
+    }, [dstBuffer, size, dstOffset](const CommandBuffer& commandBuffer, const StagingRegion& stagingRegion) {
+      Buffers::copyBuffer(commandBuffer, stagingRegion.buffer, dstBuffer, size, stagingRegion.offset, dstOffset);
+    });
+  }
+
+  void UploadManager::upload(const vk::DeviceSize size,
+                             const std::function<void(void* data)>& writeFunction,
+                             const std::function<void(const CommandBuffer& commandBuffer,
+                                                      const StagingRegion& stagingRegion)>& recordFunction)
+  {
+    stage(true, size, writeFunction, recordFunction);
+  }
+
+  void UploadManager::releaseBuffer(const vk::Buffer buffer)
+  {
+    // Without a dedicated transfer queue the trailing barrier of the batch already makes the copy visible
+    if (!m_transferFamily)
+    {
+      return;
+    }
+
+    auto& batch = getOpenBatch();
+
+    // Releasing twice would leave the second copy outside the transfer queue's ownership
+    if (std::ranges::any_of(batch.bufferReleases, [buffer](const auto& release) { return release.buffer == buffer; }))
+    {
+      return;
+    }
+
+    batch.bufferReleases.push_back({
+      .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+      .dstAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite,
+      .srcQueueFamilyIndex = m_transferFamily.value(),
+      .dstQueueFamilyIndex = m_graphicsFamily,
+      .buffer = buffer,
+      .offset = 0,
+      .size = vk::WholeSize
+    });
+  }
+
+  void UploadManager::releaseImage(const ImageRelease& imageRelease)
+  {
+    vk::ImageMemoryBarrier imageMemoryBarrier {
+      .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+      .dstAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite,
+      .oldLayout = imageRelease.oldLayout,
+      .newLayout = imageRelease.newLayout,
+      .srcQueueFamilyIndex = vk::QueueFamilyIgnored,
+      .dstQueueFamilyIndex = vk::QueueFamilyIgnored,
+      .image = imageRelease.image,
+      .subresourceRange = {
+        .aspectMask = vk::ImageAspectFlagBits::eColor,
+        .baseMipLevel = 0,
+        .levelCount = imageRelease.mipLevels,
+        .baseArrayLayer = 0,
+        .layerCount = imageRelease.layerCount
+      }
+    };
+
+    // Sharing the graphics queue, the layout transition is all that is left to do
+    if (!m_transferFamily)
+    {
+      record([&imageMemoryBarrier](const CommandBuffer& commandBuffer) {
+        commandBuffer.pipelineBarrier(
+          vk::PipelineStageFlagBits::eTransfer,
+          vk::PipelineStageFlagBits::eAllCommands,
+          {},
+          {},
+          {},
+          { imageMemoryBarrier }
+        );
+      });
+
+      return;
+    }
+
+    imageMemoryBarrier.srcQueueFamilyIndex = m_transferFamily.value();
+    imageMemoryBarrier.dstQueueFamilyIndex = m_graphicsFamily;
+
+    getOpenBatch().imageReleases.push_back(imageMemoryBarrier);
+  }
+
+  void UploadManager::record(const std::function<void(const CommandBuffer& commandBuffer)>& recordFunction)
+  {
+    const auto& commandBuffer = getOpenBatch().commandBuffer;
+
+    commandBuffer->record([&recordFunction, &commandBuffer] {
+      recordFunction(*commandBuffer);
+    });
+  }
+
+  void UploadManager::retain(vk::raii::Buffer buffer,
+                             MemoryAllocation bufferMemory)
+  {
+    auto& batch = getOpenBatch();
+
+    batch.retainedBuffers.push_back(std::move(buffer));
+    batch.retainedBuffersMemory.push_back(std::move(bufferMemory));
+  }
+
+  uint64_t UploadManager::flush()
+  {
+    VKE_PROFILE_ZONE("UploadManager::flush");
+
+    retireCompletedBatches();
+
+    if (!m_openBatch)
+    {
+      return m_lastTimelineValue;
+    }
+
+    auto batch = std::move(*m_openBatch);
+    m_openBatch.reset();
+
+    const uint64_t transferWaitValue = submitTransferWork(batch);
+
+    // Later submissions on the queue see every upload in the batch
+    recordFullBarrier(*batch.commandBuffer);
+
+    batch.commandBuffer->end();
+
+    std::vector<vk::CommandBuffer> commandBuffers;
+
+    if (batch.acquireCommandBuffer)
+    {
+      commandBuffers.push_back(batch.acquireCommandBuffer->getCommandBuffer());
+    }
+
+    commandBuffers.push_back(batch.commandBuffer->getCommandBuffer());
+
+    batch.timelineValue = m_logicalDevice->submitUploadCommandBuffers(commandBuffers, transferWaitValue);
+    m_lastTimelineValue = batch.timelineValue;
+
+    m_submittedBatches.push_back(std::move(batch));
+
+    return m_lastTimelineValue;
+  }
+
+  void UploadManager::waitIdle()
+  {
+    m_logicalDevice->waitForGraphicsTimelineValue(flush());
+
+    retireCompletedBatches();
+  }
+
+  void UploadManager::createCommandPools()
+  {
+    const vk::CommandPoolCreateInfo poolInfo {
+      .flags = vk::CommandPoolCreateFlagBits::eResetCommandBuffer | vk::CommandPoolCreateFlagBits::eTransient,
+      .queueFamilyIndex = m_graphicsFamily
+    };
+
+    m_commandPool = m_logicalDevice->createCommandPool(poolInfo);
+
+    if (m_transferFamily)
+    {
+      const vk::CommandPoolCreateInfo transferPoolInfo {
+        .flags = vk::CommandPoolCreateFlagBits::eResetCommandBuffer | vk::CommandPoolCreateFlagBits::eTransient,
+        .queueFamilyIndex = m_transferFamily.value()
+      };
+
+      m_transferCommandPool = m_logicalDevice->createCommandPool(transferPoolInfo);
+    }
+  }
+
+  void UploadManager::createStagingBuffer()
+  {
+    Buffers::createBuffer(m_logicalDevice, m_stagingCapacity,
+                          vk::BufferUsageFlagBits::eTransferSrc,
+                          vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+                          m_stagingBuffer, m_stagingBufferMemory);
+
+    // Stays mapped for the lifetime of the ring
+    m_stagingData = static_cast<std::byte*>(m_stagingBufferMemory.getMappedData());
+  }
+
+  UploadBatch& UploadManager::getOpenBatch()
+  {
+    if (m_openBatch)
+    {
+      return *m_openBatch;
+    }
+
+    auto commandBuffer = beginCommandBuffer(*m_commandPool, m_freeCommandBuffers);
+
+    // Earlier frames may still be reading what the batch is about to overwrite
+    recordFullBarrier(*commandBuffer);
+
+    m_openBatch = UploadBatch {
+      .commandBuffer = std::move(commandBuffer),
+      .stagingEnd = m_stagingHead
+    };
+
+    return *m_openBatch;
+  }
+
+  UploadCommandBuffer& UploadManager::getTransferCommandBuffer(UploadBatch& batch)
+  {
+    if (!m_transferFamily)
+    {
+      return *batch.commandBuffer;
+    }
+
+    if (!batch.transferCommandBuffer)
+    {
+      batch.transferCommandBuffer = beginCommandBuffer(*m_transferCommandPool, m_freeTransferCommandBuffers);
+    }
+
+    return *batch.transferCommandBuffer;
+  }
+
+  std::unique_ptr<UploadCommandBuffer> UploadManager::beginCommandBuffer(const vk::CommandPool commandPool,
+                                                                         std::vector<std::unique_ptr<UploadCommandBuffer>>& freeCommandBuffers) const
+  {
+    std::unique_ptr<UploadCommandBuffer> commandBuffer;
+
+    if (freeCommandBuffers.empty())
+    {
+      commandBuffer = std::make_unique<UploadCommandBuffer>(m_logicalDevice, commandPool);
+    }
+    else
+    {
+      commandBuffer = std::move(freeCommandBuffers.back());
+      freeCommandBuffers.pop_back();
+    }
+
+    commandBuffer->begin();
+
+    return commandBuffer;
+  }
+
+  void UploadManager::stage(const bool onTransferQueue,
+                            const vk::DeviceSize size,
+                            const std::function<void(void* data)>& writeFunction,
+                            const std::function<void(const CommandBuffer& commandBuffer,
+                                                     const StagingRegion& stagingRegion)>& recordFunction)
+  {
+    VKE_PROFILE_ZONE("UploadManager::stage");
+
+    vk::raii::Buffer stagingBuffer = nullptr;
+    MemoryAllocation stagingBufferMemory = nullptr;
+
+    StagingRegion stagingRegion;
+
+    // Uploads larger than the whole ring get a staging buffer of their own
+    if (size > m_stagingCapacity)
+    {
+      Buffers::createBuffer(m_logicalDevice, size,
+                            vk::BufferUsageFlagBits::eTransferSrc,
+                            vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+                            stagingBuffer, stagingBufferMemory);
+
+      Buffers::doMappedMemoryOperation(stagingBufferMemory, writeFunction);
+
+      stagingRegion.buffer = *stagingBuffer;
+    }
+    else
+    {
+      // May flush the open batch, so the command buffer is only looked up afterwards
+      const vk::DeviceSize offset = acquireStagingOffset(size);
+
+      writeFunction(m_stagingData + offset);
+
+      stagingRegion.buffer = *m_stagingBuffer;
+      stagingRegion.offset = offset;
+    }
+
+    auto& batch = getOpenBatch();
+    const auto& commandBuffer = onTransferQueue ? getTransferCommandBuffer(batch) : *batch.commandBuffer;
+
+    commandBuffer.record([&recordFunction, &commandBuffer, &stagingRegion] {
+      recordFunction(commandBuffer, stagingRegion);
+    });
+
+    if (*stagingBuffer)
+    {
+      retain(std::move(stagingBuffer), std::move(stagingBufferMemory));
+    }
+  }
+
+  uint64_t UploadManager::submitTransferWork(UploadBatch& batch)
+  {
+    if (!batch.transferCommandBuffer)
+    {
+      return 0;
+    }
+
+    const bool hasReleases = !batch.bufferReleases.empty() || !batch.imageReleases.empty();
+
+    if (hasReleases)
+    {
+      // The release half of each ownership transfer only makes the copies available
+      auto bufferReleases = batch.bufferReleases;
+      auto imageReleases = batch.imageReleases;
+
+      for (auto& release : bufferReleases)
+      {
+        release.dstAccessMask = {};
+      }
+
+      for (auto& release : imageReleases)
+      {
+        release.dstAccessMask = {};
+      }
+
+      batch.transferCommandBuffer->pipelineBarrier(
+        vk::PipelineStageFlagBits::eTransfer,
+        vk::PipelineStageFlagBits::eBottomOfPipe,
+        {},
+        {},
+        bufferReleases,
+        imageReleases
+      );
+
+      // The acquire half makes them visible to everything recorded on the graphics queue after it
+      for (auto& acquire : batch.bufferReleases)
+      {
+        acquire.srcAccessMask = {};
+      }
+
+      for (auto& acquire : batch.imageReleases)
+      {
+        acquire.srcAccessMask = {};
+      }
+
+      batch.acquireCommandBuffer = beginCommandBuffer(*m_commandPool, m_freeCommandBuffers);
+
+      batch.acquireCommandBuffer->pipelineBarrier(
+        vk::PipelineStageFlagBits::eTopOfPipe,
+        vk::PipelineStageFlagBits::eAllCommands,
+        {},
+        {},
+        batch.bufferReleases,
+        batch.imageReleases
+      );
+
+      batch.acquireCommandBuffer->end();
+    }
+
+    batch.transferCommandBuffer->end();
+
+    return m_logicalDevice->submitTransferCommandBuffer(batch.transferCommandBuffer->getCommandBuffer());
+  }
+
+  std::optional<vk::DeviceSize> UploadManager::allocateStaging(const vk::DeviceSize size)
+  {
+    const vk::DeviceSize alignedSize = (size + STAGING_ALIGNMENT - 1) & ~(STAGING_ALIGNMENT - 1);
+
+    if (m_stagingUsed == 0)
+    {
+      m_stagingHead = 0;
+      m_stagingTail = 0;
+    }
+    else if (m_stagingHead == m_stagingTail)
+    {
+      return std::nullopt;
+    }
+
+    if (m_stagingHead < m_stagingTail)
+    {
+      if (m_stagingTail - m_stagingHead < alignedSize)
+      {
+        return std::nullopt;
+      }
+
+      const vk::DeviceSize offset = m_stagingHead;
+      m_stagingHead += alignedSize;
+      m_stagingUsed += alignedSize;
+
+      return offset;
+    }
+
+    if (m_stagingCapacity - m_stagingHead >= alignedSize)
+    {
+      const vk::DeviceSize offset = m_stagingHead;
+      m_stagingHead += alignedSize;
+      m_stagingUsed += alignedSize;
+
+      return offset;
+    }
+
+    // Wrap around, the skipped space at the end is released along with this allocation
+    if (m_stagingTail < alignedSize)
+    {
+      return std::nullopt;
+    }
+
+    m_stagingUsed += m_stagingCapacity - m_stagingHead + alignedSize;
+    m_stagingHead = alignedSize;
+
+    return 0;
+  }
+
+  vk::DeviceSize UploadManager::acquireStagingOffset(const vk::DeviceSize size)
+  {
+    while (true)
+    {
+      const vk::DeviceSize usedBefore = m_stagingUsed;
+
+      if (const auto offset = allocateStaging(size))
+      {
+        auto& batch = getOpenBatch();
+        batch.stagingEnd = m_stagingHead;
+        batch.stagingBytes += m_stagingUsed - usedBefore;
+
+        return *offset;
+      }
+
+      // The open batch holds part of the ring, submit it so it can retire
+      if (m_openBatch && m_openBatch->stagingBytes > 0)
+      {
+        static_cast<void>(flush());
+        continue;
+      }
+
+      if (m_submittedBatches.empty())
+      {
+        throw std::runtime_error("Staging ring is full with nothing in flight!");
+      }
+
+      waitForOldestBatch();
+    }
+  }
+
+  void UploadManager::retireCompletedBatches()
+  {
+    const uint64_t completedValue = m_logicalDevice->getCompletedGraphicsTimelineValue();
+
+    while (!m_submittedBatches.empty() && m_submittedBatches.front().timelineValue <= completedValue)
+    {
+      retireBatch(m_submittedBatches.front());
+      m_submittedBatches.pop_front();
+    }
+  }
+
+  void UploadManager::retireBatch(UploadBatch& batch)
+  {
+    m_stagingTail = batch.stagingEnd;
+    m_stagingUsed -= batch.stagingBytes;
+
+    m_freeCommandBuffers.push_back(std::move(batch.commandBuffer));
+
+    if (batch.acquireCommandBuffer)
+    {
+      m_freeCommandBuffers.push_back(std::move(batch.acquireCommandBuffer));
+    }
+
+    if (batch.transferCommandBuffer)
+    {
+      m_freeTransferCommandBuffers.push_back(std::move(batch.transferCommandBuffer));
+    }
+  }
+
+  void UploadManager::waitForOldestBatch()
+  {
+    VKE_PROFILE_ZONE("UploadManager::waitForOldestBatch");
+
+    m_logicalDevice->waitForGraphicsTimelineValue(m_submittedBatches.front().timelineValue);
+
+    retireCompletedBatches();
+  }
+
+  void UploadManager::recordFullBarrier(const CommandBuffer& commandBuffer)
+  {
+    const vk::MemoryBarrier memoryBarrier {
+      .srcAccessMask = vk::AccessFlagBits::eMemoryWrite,
+      .dstAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite
+    };
+
+    commandBuffer.pipelineBarrier(
+      vk::PipelineStageFlagBits::eAllCommands,
+      vk::PipelineStageFlagBits::eAllCommands,
+      {},
+      { memoryBarrier },
+      {},
+      {}
+    );
+  }
+
+} // namespace vke
@@ -0,0 +1,177 @@
+#ifndef VKE_UPLOADMANAGER_H
+#define VKE_UPLOADMANAGER_H
+
+#include "../memory/MemoryAllocation.h"
+#include <vulkan/vulkan_raii.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace vke {
+
+  class CommandBuffer;
+  class LogicalDevice;
+  class UploadCommandBuffer;
+
+  constexpr vk::DeviceSize DEFAULT_STAGING_CAPACITY = 64 * 1024 * 1024;
+
+  // Where an upload's bytes were written, the recorded commands copy out of this region
+  struct StagingRegion {
+    vk::Buffer buffer;
+    vk::DeviceSize offset = 0;
+  };
+
+  // An uploaded image handed over to the graphics queue, moving from oldLayout to newLayout on the way
+  struct ImageRelease {
+    vk::Image image;
+    vk::ImageLayout oldLayout = vk::ImageLayout::eTransferDstOptimal;
+    vk::ImageLayout newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+    uint32_t mipLevels = 1;
+    uint32_t layerCount = 1;
+  };
+
+  struct UploadBatch {
+    // Graphics queue work, recorded after the acquires when the device has a dedicated transfer queue
+    std::unique_ptr<UploadCommandBuffer> commandBuffer;
+
+    // Copies on the dedicated transfer queue, empty when uploads share the graphics queue
+    std::unique_ptr<UploadCommandBuffer> transferCommandBuffer;
+
+    // Recorded at flush, ends the transfer work with the releases and starts the graphics work with the acquires
+    std::unique_ptr<UploadCommandBuffer> acquireCommandBuffer;
+    std::vector<vk::BufferMemoryBarrier> bufferReleases;
+    std::vector<vk::ImageMemoryBarrier> imageReleases;
+
+    // Graphics timeline value signaled once the batch has executed, zero while it is still recording
+    uint64_t timelineValue = 0;
+
+    // Staging ring head after the batch's last allocation, and the bytes it consumed including wrap padding
+    vk::DeviceSize stagingEnd = 0;
+    vk::DeviceSize stagingBytes = 0;
+
+    // Buffers the batch reads that must outlive its execution
+    std::vector<vk::raii::Buffer> retainedBuffers;
+    std::vector<MemoryAllocation> retainedBuffersMemory;
+  };
+
+  class UploadManager {
+  public:
+    explicit UploadManager(std::shared_ptr<LogicalDevice> logicalDevice,
+                           vk::DeviceSize stagingCapacity = DEFAULT_STAGING_CAPACITY);
+
+    ~UploadManager();
+
+    // Stages the data, records its copy into dstBuffer and releases dstBuffer to the graphics queue.
+    // Only for buffers nothing on the GPU is using yet, the copy may run on the transfer queue
+    void uploadBuffer(vk::Buffer dstBuffer,
+                      const void* data,
+                      vk::DeviceSize size,
+                      vk::DeviceSize dstOffset = 0);
+
+    // Stages the data and records its copy into dstBuffer on the graphics queue, after any frame still reading it
+    void updateBuffer(vk::Buffer dstBuffer,
+                      const void* data,
+                      vk::DeviceSize size,
+                      vk::DeviceSize dstOffset = 0);
+
+    // Stages size bytes filled by writeFunction, then records the commands that read them back out.
+    // These may run on the transfer queue, so only copies and transfer layout transitions can be recorded,
+    // and every written resource has to be released afterwards
+    void upload(vk::DeviceSize size,
+                const std::function<void(void* data)>& writeFunction,
+                const std::function<void(const CommandBuffer& commandBuffer,
+                                         const StagingRegion& stagingRegion)>& recordFunction);
+
+    // Hands a buffer written by upload over to the graphics queue, which the compute queue shares whenever
+    // uploads use a dedicated transfer queue
+    void releaseBuffer(vk::Buffer buffer);
+
+    // Hands an image written by upload over to the graphics queue, performing its layout transition
+    void releaseImage(const ImageRelease& imageRelease);
+
+    // Records graphics queue commands that need no staging memory, such as mipmap generation and
+    // acceleration structure builds. Released resources are available to them
+    void record(const std::function<void(const CommandBuffer& commandBuffer)>& recordFunction);
+
+    // Keeps a buffer used by the recorded commands alive until they have executed
+    void retain(vk::raii::Buffer buffer,
+                MemoryAllocation bufferMemory);
+
+    // Submits everything recorded so far, returning the graphics timeline value signaled once it completes
+    uint64_t flush();
+
+    // Submits everything recorded so far and blocks until every upload has completed
+    void waitIdle();
+
+  private:
+    std::shared_ptr<LogicalDevice> m_logicalDevice;
+
+    vk::raii::CommandPool m_commandPool = nullptr;
+    vk::raii::CommandPool m_transferCommandPool = nullptr;
+
+    uint32_t m_graphicsFamily = 0;
+
+    // Only set when the device has a dedicated transfer queue and computes on the graphics family
+    std::optional<uint32_t> m_transferFamily;
+
+    vk::raii::Buffer m_stagingBuffer = nullptr;
+    MemoryAllocation m_stagingBufferMemory = nullptr;
+    std::byte* m_stagingData = nullptr;
+
+    vk::DeviceSize m_stagingCapacity;
+
+    // Allocations are made at the head and retired from the tail, head == tail with bytes in use means full
+    vk::DeviceSize m_stagingHead = 0;
+    vk::DeviceSize m_stagingTail = 0;
+    vk::DeviceSize m_stagingUsed = 0;
+
+    std::optional<UploadBatch> m_openBatch;
+    std::deque<UploadBatch> m_submittedBatches;
+
+    std::vector<std::unique_ptr<UploadCommandBuffer>> m_freeCommandBuffers;
+    std::vector<std::unique_ptr<UploadCommandBuffer>> m_freeTransferCommandBuffers;
+
+    uint64_t m_lastTimelineValue = 0;
+
+    void createCommandPools();
+
+    void createStagingBuffer();
+
+    UploadBatch& getOpenBatch();
+
+    [[nodiscard]] UploadCommandBuffer& getTransferCommandBuffer(UploadBatch& batch);
+
+    // Reuses a retired command buffer from freeCommandBuffers when there is one, then begins it
+    [[nodiscard]] std::unique_ptr<UploadCommandBuffer> beginCommandBuffer(vk::CommandPool commandPool,
+                                                                          std::vector<std::unique_ptr<UploadCommandBuffer>>& freeCommandBuffers) const;
+
+    void stage(bool onTransferQueue,
+               vk::DeviceSize size,
+               const std::function<void(void* data)>& writeFunction,
+               const std::function<void(const CommandBuffer& commandBuffer,
+                                        const StagingRegion& stagingRegion)>& recordFunction);
+
+    // Records the ownership transfers and submits the transfer queue work, returning the value to wait on or zero
+    [[nodiscard]] uint64_t submitTransferWork(UploadBatch& batch);
+
+    [[nodiscard]] std::optional<vk::DeviceSize> allocateStaging(vk::DeviceSize size);
+
+    // Flushes and waits on earlier batches until the ring has room
+    [[nodiscard]] vk::DeviceSize acquireStagingOffset(vk::DeviceSize size);
+
+    void retireCompletedBatches();
+
+    void retireBatch(UploadBatch& batch);
+
+    void waitForOldestBatch();
+
+    static void recordFullBarrier(const CommandBuffer& commandBuffer);
+  };
+
+} // namespace vke
+
+#endif //VKE_UPLOADMANAGER_H
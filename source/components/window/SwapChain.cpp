@@ -73,9 +73,11 @@ namespace vke {
     return actualExtent;
   }
 
-  uint32_t SwapChain::chooseSwapImageCount(const vk::SurfaceCapabilitiesKHR& capabilities)
+  uint32_t SwapChain::chooseSwapImageCount(const vk::SurfaceCapabilitiesKHR& capabilities,
+                                           const uint32_t maxFramesInFlight)
   {
-    const uint32_t imageCount = capabilities.minImageCount + 1;
+    // Every frame in flight may hold an image while another is being presented
+    const uint32_t imageCount = std::max(capabilities.minImageCount + 1, maxFramesInFlight + 1);
 
     const bool imageCountExceeded = capabilities.maxImageCount > 0 &&
                                     imageCount > capabilities.maxImageCount;
@@ -92,7 +94,7 @@ namespace vke {
     const vk::SurfaceFormatKHR surfaceFormat = chooseSwapSurfaceFormat(swapChainSupport.formats);
     const vk::PresentModeKHR presentMode = chooseSwapPresentMode(swapChainSupport.presentModes);
     const vk::Extent2D extent = chooseSwapExtent(swapChainSupport.capabilities, window);
-    const uint32_t imageCount = chooseSwapImageCount(swapChainSupport.capabilities);
+    const uint32_t imageCount = chooseSwapImageCount(swapChainSupport.capabilities, logicalDevice->getMaxFramesInFlight());
 
     const auto indices = logicalDevice->getPhysicalDevice()->getQueueFamilies();
     const uint32_t queueFamilyIndices[] = {
@@ -53,7 +53,8 @@ namespace vke {
     [[nodiscard]] static vk::Extent2D chooseSwapExtent(const vk::SurfaceCapabilitiesKHR& capabilities,
                                                        const std::shared_ptr<Window>& window);
 
-    static uint32_t chooseSwapImageCount(const vk::SurfaceCapabilitiesKHR& capabilities);
+    static uint32_t chooseSwapImageCount(const vk::SurfaceCapabilitiesKHR& capabilities,
+                                         uint32_t maxFramesInFlight);
 
     void createSwapChain(const std::shared_ptr<LogicalDevice>& logicalDevice,
                          const std::shared_ptr<Window>& window,
@@ -2,6 +2,9 @@
 #extension GL_GOOGLE_include_directive : require
 #include "common/Lighting.glsl"
 
+#define LIGHTING_SET 1
+#include "common/LightClusters.glsl"
+
 layout(set = 0, binding = 2) uniform sampler2D texSampler;
 
 layout(set = 1, binding = 0) uniform PointLightsMetadata {
@@ -31,15 +34,17 @@ void main()
     discard;
   }
 
+  uint clusterIndex = getLightClusterIndex(gl_FragCoord.xy, fragPos);
+
   vec3 result = vec3(0);
-  for (int i = 0; i < numPointLights; i++)
+  for (uint i = 0u; i < getClusterPointLightCount(clusterIndex); i++)
   {
-    result += SmokePointLightAffect(pointLights[i], texColor.rgb, fragPos);
+    result += SmokePointLightAffect(pointLights[getClusterPointLightIndex(clusterIndex, i)], texColor.rgb, fragPos);
   }
 
-  for (int i = 0; i < numSpotLights; i++)
+  for (uint i = 0u; i < getClusterSpotLightCount(clusterIndex); i++)
   {
-    result += SmokeSpotLightAffect(spotLights[i], texColor.rgb, fragPos);
+    result += SmokeSpotLightAffect(spotLights[getClusterSpotLightIndex(clusterIndex, i)], texColor.rgb, fragPos);
   }
 
   outColor = vec4(result, texColor.a);
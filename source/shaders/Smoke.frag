@@ -2,6 +2,9 @@
 #extension GL_GOOGLE_include_directive : require
 #include "common/Lighting.glsl"
 
+#define LIGHTING_SET 1
+#include "common/LightClusters.glsl"
+
 layout(set = 1, binding = 0) uniform PointLightsMetadata {
   int numPointLights;
   int numSpotLights;
@@ -53,15 +56,17 @@ void main()
   float finalMask = (0.7 + 0.3 * noise) * (0.8 + 0.2 * swirl);
   finalMask *= 0.9 + 0.1 * secondNoise;
 
+  uint clusterIndex = getLightClusterIndex(gl_FragCoord.xy, fragPos);
+
   vec3 result = vec3(0);
-  for (int i = 0; i < numPointLights; i++)
+  for (uint i = 0u; i < getClusterPointLightCount(clusterIndex); i++)
   {
-    result += SmokePointLightAffect(pointLights[i], fragColor.rgb, fragPos);
+    result += SmokePointLightAffect(pointLights[getClusterPointLightIndex(clusterIndex, i)], fragColor.rgb, fragPos);
   }
 
-  for (int i = 0; i < numSpotLights; i++)
+  for (uint i = 0u; i < getClusterSpotLightCount(clusterIndex); i++)
   {
-    result += SmokeSpotLightAffect(spotLights[i], fragColor.rgb, fragPos);
+    result += SmokeSpotLightAffect(spotLights[getClusterSpotLightIndex(clusterIndex, i)], fragColor.rgb, fragPos);
   }
 
   outColor = vec4(result, finalMask * fragColor.a);
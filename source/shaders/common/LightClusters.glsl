@@ -0,0 +1,70 @@
+// Lights binned each frame into clusters of the camera's frustum, so a fragment only shades the lights near it
+// Shaders define LIGHTING_SET, the set the lighting descriptor set is bound to, before including this file
+
+// Screen tiles across and down and depth slices the frustum is split into, matches LightingManager.h
+const uint LIGHT_CLUSTER_COUNT_X = 16u;
+const uint LIGHT_CLUSTER_COUNT_Y = 9u;
+const uint LIGHT_CLUSTER_COUNT_Z = 24u;
+const uint LIGHT_CLUSTER_COUNT = LIGHT_CLUSTER_COUNT_X * LIGHT_CLUSTER_COUNT_Y * LIGHT_CLUSTER_COUNT_Z;
+
+const uint MAX_LIGHTS_PER_CLUSTER = 126u;
+
+struct LightCluster {
+  uint pointLightCount;
+  uint spotLightCount;
+  uint lightIndices[MAX_LIGHTS_PER_CLUSTER]; // Point lights, then spot lights
+};
+
+layout(set = LIGHTING_SET, binding = 7) uniform LightClusterInfo {
+  mat4 view;
+  mat4 inverseProjection;
+  vec2 screenSize;
+  vec2 tileSize;
+  float nearPlane;
+  float farPlane;
+  float sliceScale; // Depth slices are spaced exponentially, slice = log(depth) * sliceScale - sliceBias
+  float sliceBias;
+} lightClusterInfo;
+
+#ifdef LIGHT_CLUSTERS_WRITABLE
+layout(set = LIGHTING_SET, binding = 8) writeonly buffer LightClusters {
+#else
+layout(set = LIGHTING_SET, binding = 8) readonly buffer LightClusters {
+#endif
+  LightCluster clusters[];
+} lightClusters;
+
+uint getLightClusterIndex(vec2 fragCoord, vec3 fragPos)
+{
+  float viewDepth = -(lightClusterInfo.view * vec4(fragPos, 1.0)).z;
+  float slice = log(max(viewDepth, lightClusterInfo.nearPlane)) * lightClusterInfo.sliceScale - lightClusterInfo.sliceBias;
+
+  uvec3 cluster = uvec3(
+    min(uvec2(fragCoord / lightClusterInfo.tileSize), uvec2(LIGHT_CLUSTER_COUNT_X, LIGHT_CLUSTER_COUNT_Y) - 1u),
+    min(uint(max(slice, 0.0)), LIGHT_CLUSTER_COUNT_Z - 1u)
+  );
+
+  return cluster.x + LIGHT_CLUSTER_COUNT_X * (cluster.y + LIGHT_CLUSTER_COUNT_Y * cluster.z);
+}
+
+#ifndef LIGHT_CLUSTERS_WRITABLE
+uint getClusterPointLightCount(uint clusterIndex)
+{
+  return lightClusters.clusters[clusterIndex].pointLightCount;
+}
+
+uint getClusterPointLightIndex(uint clusterIndex, uint i)
+{
+  return lightClusters.clusters[clusterIndex].lightIndices[i];
+}
+
+uint getClusterSpotLightCount(uint clusterIndex)
+{
+  return lightClusters.clusters[clusterIndex].spotLightCount;
+}
+
+uint getClusterSpotLightIndex(uint clusterIndex, uint i)
+{
+  return lightClusters.clusters[clusterIndex].lightIndices[lightClusters.clusters[clusterIndex].pointLightCount + i];
+}
+#endif
@@ -1,17 +1,15 @@
 struct PointLight {
-  mat4[6] lightViewProjections;
   vec3 position;
-  float padding1; // Padding to ensure alignment
+  float range;
   vec3 color;
-  float padding2; // Padding to ensure alignment
+  int shadowMapIndex; // Cube of the shadow map array, -1 without one
   float ambient;
   float diffuse;
   float specular;
-  float padding3; // Padding to ensure alignment
+  int shadowMapTier; // Shadow map array the cube is in, one per shadow map size
 };
 
 struct SpotLight {
-  mat4 lightViewProjection;
   vec3 position;
   float ambient;
   vec3 color;
@@ -19,8 +17,23 @@ struct SpotLight {
   vec3 direction;
   float specular;
   float coneAngle;
+  float range;
+  float padding1; // Padding to ensure alignment
+  float padding2; // Padding to ensure alignment
 };
 
+// Kept apart from SpotLight so shading only reads it for fragments that receive shadows
+struct SpotLightShadow {
+  mat4 lightViewProjection;
+  vec4 shadowAtlasRect; // Offset and scale of the light's tile in the shadow atlas, zero sized without one
+};
+
+// Fades a light out over the last fifth of its range, past which it adds nothing and light clusters leave it out
+float getRangeFalloff(vec3 lightPosition, float range, vec3 fragPos)
+{
+  return 1.0 - smoothstep(range * 0.8, range, distance(lightPosition, fragPos));
+}
+
 bool isInSpotlight(SpotLight light, vec3 fragPos)
 {
   float cutoffAngle = cos(light.coneAngle);
@@ -81,7 +94,7 @@ vec3 StandardPointLightAffect(PointLight light,
   vec3 diffuse = getStandardDiffuse(light.position, light.diffuse, fragPos, normalizedNormal, color);
   vec3 specular = getStandardSpecular(light.position, light.specular, light.color, cameraPosition, fragPos, normalizedNormal, shininess);
 
-  return (ambient + diffuse + specular) * light.color;
+  return (ambient + diffuse + specular) * light.color * getRangeFalloff(light.position, light.range, fragPos);
 }
 
 vec3 StandardSpotLightAffect(SpotLight light,
@@ -95,7 +108,7 @@ vec3 StandardSpotLightAffect(SpotLight light,
   {
     vec3 ambient = getStandardAmbient(light.ambient, color);
 
-    return ambient * light.color;
+    return ambient * light.color * getRangeFalloff(light.position, light.range, fragPos);
   }
 
   vec3 normalizedNormal = normalize(normal);
@@ -104,7 +117,7 @@ vec3 StandardSpotLightAffect(SpotLight light,
   vec3 diffuse = getStandardDiffuse(light.position, light.diffuse, fragPos, normalizedNormal, color);
   vec3 specular = getStandardSpecular(light.position, light.specular, light.color, cameraPosition, fragPos, normalizedNormal, shininess);
 
-  return (ambient + diffuse + specular) * light.color;
+  return (ambient + diffuse + specular) * light.color * getRangeFalloff(light.position, light.range, fragPos);
 }
 
 vec3 SpecularMapPointLightAffect(PointLight light,
@@ -121,7 +134,7 @@ vec3 SpecularMapPointLightAffect(PointLight light,
   vec3 diffuse = getStandardDiffuse(light.position, light.diffuse, fragPos, normalizedNormal, color);
   vec3 specular = getStandardSpecular(light.position, light.specular, light.color, cameraPosition, fragPos, normalizedNormal, shininess) * specColor;
 
-  return (ambient + diffuse + specular) * light.color;
+  return (ambient + diffuse + specular) * light.color * getRangeFalloff(light.position, light.range, fragPos);
 }
 
 vec3 SpecularMapSpotLightAffect(SpotLight light,
@@ -136,7 +149,7 @@ vec3 SpecularMapSpotLightAffect(SpotLight light,
   {
     vec3 ambient = getStandardAmbient(light.ambient, color);
 
-    return ambient * light.color;
+    return ambient * light.color * getRangeFalloff(light.position, light.range, fragPos);
   }
 
   vec3 normalizedNormal = normalize(normal);
@@ -145,7 +158,7 @@ vec3 SpecularMapSpotLightAffect(SpotLight light,
   vec3 diffuse = getStandardDiffuse(light.position, light.diffuse, fragPos, normalizedNormal, color);
   vec3 specular = getStandardSpecular(light.position, light.specular, light.color, cameraPosition, fragPos, normalizedNormal, shininess) * specColor;
 
-  return (ambient + diffuse + specular) * light.color;
+  return (ambient + diffuse + specular) * light.color * getRangeFalloff(light.position, light.range, fragPos);
 }
 
 vec3 SmokePointLightAffect(PointLight light, vec3 color, vec3 fragPos)
@@ -156,6 +169,7 @@ vec3 SmokePointLightAffect(PointLight light, vec3 color, vec3 fragPos)
 
   // Calculate attenuation
   float attenuation = 1.0 / (1.0 + 0.09 * dist + 0.032 * dist * dist);
+  attenuation *= getRangeFalloff(light.position, light.range, fragPos);
 
   // Combined Output
   return (light.ambient + light.diffuse) * color * light.color * attenuation; // Color * Color for brighter color
@@ -169,6 +183,7 @@ vec3 SmokeSpotLightAffect(SpotLight light, vec3 color, vec3 fragPos)
 
   // Calculate attenuation
   float attenuation = 1.0 / (1.0 + 0.09 * dist + 0.032 * dist * dist);
+  attenuation *= getRangeFalloff(light.position, light.range, fragPos);
 
   if (!isInSpotlight(light, fragPos))
   {
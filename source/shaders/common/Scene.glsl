@@ -0,0 +1,44 @@
+// Camera data of the pass being drawn, each pass binds its own slot of the frame's view buffer
+layout(set = 0, binding = 0) uniform View {
+  mat4 view;
+  mat4 proj;
+  mat4 viewProj;
+  vec3 position;
+  float time;
+} view;
+
+struct ObjectData {
+  mat4 model;
+  float reflectivity;
+  float refractivity;
+  float indexOfRefraction;
+  uint receivesShadows;
+};
+
+// Model matrices and material parameters of every object drawn this frame, written once and shared by every pass
+layout(set = 0, binding = 1) readonly buffer Objects {
+  ObjectData data[];
+} objects;
+
+// Objects of every instanced draw this frame, each draw reads its run of indices starting at its first instance
+layout(set = 0, binding = 2) readonly buffer Instances {
+  uint objectIndices[];
+} instances;
+
+// Entries hold the object index below this bit and the multiview views the instance is culled from above it
+const uint INSTANCE_CULLED_VIEWS_SHIFT = 26;
+
+uint getObjectIndex(uint instanceIndex)
+{
+  return instances.objectIndices[instanceIndex] & ((1u << INSTANCE_CULLED_VIEWS_SHIFT) - 1u);
+}
+
+bool isInstanceCulledFromView(uint instanceIndex, uint viewIndex)
+{
+  return ((instances.objectIndices[instanceIndex] >> INSTANCE_CULLED_VIEWS_SHIFT) & (1u << viewIndex)) != 0u;
+}
+
+mat4 getModelMatrix(uint objectIndex)
+{
+  return objects.data[objectIndex].model;
+}
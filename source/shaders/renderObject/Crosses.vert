@@ -1,13 +1,17 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
+#include "../common/Scene.glsl"
 
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inNormal;
 
 layout(location = 0) out vec3 gsPos;
 layout(location = 1) out vec3 gsNormal;
+layout(location = 2) flat out uint gsObjectIndex;
 
 void main()
 {
   gsPos = inPosition;
   gsNormal = inNormal;
-}
\ No newline at end of file
+  gsObjectIndex = getObjectIndex(gl_InstanceIndex);
+}
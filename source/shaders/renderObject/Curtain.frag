@@ -2,26 +2,29 @@
 #extension GL_GOOGLE_include_directive : require
 #include "../common/Lighting.glsl"
 
+#define LIGHTING_SET 2
+#include "../common/LightClusters.glsl"
+
 layout(push_constant) uniform CurtainPC {
   float amplitude;
   float period;
   float shininess;
 } pc;
 
-layout(set = 1, binding = 0) uniform PointLightsMetadata {
+layout(set = 2, binding = 0) uniform PointLightsMetadata {
   int numPointLights;
   int numSpotLights;
 };
 
-layout(set = 1, binding = 1) readonly buffer PointLights {
+layout(set = 2, binding = 1) readonly buffer PointLights {
   PointLight pointLights[];
 };
 
-layout(set = 1, binding = 2) readonly buffer SpotLights {
+layout(set = 2, binding = 2) readonly buffer SpotLights {
   SpotLight spotLights[];
 };
 
-layout(set = 1, binding = 3) uniform Camera {
+layout(set = 2, binding = 3) uniform Camera {
   vec3 position;
 } camera;
 
@@ -35,16 +38,18 @@ void main()
 {
   vec3 fragColor = vec3(0.855, 0.647, 0.125);
 
+  uint clusterIndex = getLightClusterIndex(gl_FragCoord.xy, fragPos);
+
   // now use fragColor in the per-fragment lighting equations:
   vec3 result = vec3(0);
-  for (int i = 0; i < numPointLights; i++)
+  for (uint i = 0u; i < getClusterPointLightCount(clusterIndex); i++)
   {
-    result += StandardPointLightAffect(pointLights[i], fragColor, fragNormal, fragPos, camera.position, pc.shininess);
+    result += StandardPointLightAffect(pointLights[getClusterPointLightIndex(clusterIndex, i)], fragColor, fragNormal, fragPos, camera.position, pc.shininess);
   }
 
-  for (int i = 0; i < numSpotLights; i++)
+  for (uint i = 0u; i < getClusterSpotLightCount(clusterIndex); i++)
   {
-    result += StandardSpotLightAffect(spotLights[i], fragColor, fragNormal, fragPos, camera.position, pc.shininess);
+    result += StandardSpotLightAffect(spotLights[getClusterSpotLightIndex(clusterIndex, i)], fragColor, fragNormal, fragPos, camera.position, pc.shininess);
   }
 
   outColor = vec4(result, 1.0);
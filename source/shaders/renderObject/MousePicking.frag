@@ -1,8 +1,6 @@
 #version 450
 
-layout(push_constant) uniform PushConstants {
-  uint objectID;
-};
+layout(location = 0) flat in uint objectID;
 
 layout(location = 0) out uvec4 outColor;
 
@@ -1,14 +1,17 @@
 #version 450
-
-layout(set = 0, binding = 0) uniform Transform {
-  mat4 model;
-  mat4 view;
-  mat4 proj;
-} transform;
+#extension GL_GOOGLE_include_directive : require
+#include "../common/Scene.glsl"
 
 layout(location = 0) in vec3 inPosition;
 
+layout(location = 0) flat out uint objectID;
+
 void main()
 {
-  gl_Position = transform.proj * transform.view * transform.model * vec4(inPosition, 1.0);
-}
\ No newline at end of file
+  uint objectIndex = getObjectIndex(gl_InstanceIndex);
+
+  // 0 is left for the cleared background
+  objectID = objectIndex + 1;
+
+  gl_Position = view.viewProj * getModelMatrix(objectIndex) * vec4(inPosition, 1.0);
+}
@@ -1,15 +1,11 @@
 #version 450
-
-layout(set = 0, binding = 0) uniform Transform {
-  mat4 model;
-  mat4 view;
-  mat4 proj;
-} transform;
+#extension GL_GOOGLE_include_directive : require
+#include "../common/Scene.glsl"
 
 layout(location = 0) in vec3 inPosition;
 
 void main()
 {
   vec3 scaledPosition = inPosition * 1.01;
-  gl_Position = transform.proj * transform.view * transform.model * vec4(scaledPosition, 1.0);
-}
\ No newline at end of file
+  gl_Position = view.viewProj * getModelMatrix(getObjectIndex(gl_InstanceIndex)) * vec4(scaledPosition, 1.0);
+}
@@ -1,17 +1,15 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
+#include "../common/Scene.glsl"
 
 layout(push_constant) uniform PushConstants {
     mat4 lightViewProj;
 } pc;
 
-layout(set = 0, binding = 0) uniform Transform {
-    mat4 model;
-} transform;
-
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inNormal;
 layout(location = 2) in vec2 inTexCoord;
 
 void main() {
-    gl_Position = pc.lightViewProj * transform.model * vec4(inPosition, 1.0);
-}
\ No newline at end of file
+    gl_Position = pc.lightViewProj * getModelMatrix(getObjectIndex(gl_InstanceIndex)) * vec4(inPosition, 1.0);
+}
@@ -3,6 +3,7 @@
 
 layout(push_constant) uniform PushConstants {
   vec3 lightPos;
+  float range;
 } pc;
 
 layout(location = 0) in vec3 fragPos;
@@ -10,9 +11,7 @@ layout(location = 0) in vec3 fragPos;
 void main() {
   float dist = length(fragPos - pc.lightPos);
 
-  const float farPlane = 100.0;
-
-  float depth = clamp(dist / farPlane, 0.0, 1.0);
+  float depth = clamp(dist / pc.range, 0.0, 1.0);
 
   gl_FragDepth = depth;
 }
\ No newline at end of file
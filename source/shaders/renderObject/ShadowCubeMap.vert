@@ -1,9 +1,7 @@
 #version 450
 #extension GL_EXT_multiview : require
-
-layout(set = 0, binding = 0) uniform Transform {
-  mat4 model;
-} transform;
+#extension GL_GOOGLE_include_directive : require
+#include "../common/Scene.glsl"
 
 layout(set = 1, binding = 0) uniform Shadow {
   mat4 lightViewProj[6];
@@ -16,8 +14,15 @@ layout(location = 2) in vec2 inTexCoord;
 layout(location = 0) out vec3 fragPos;
 
 void main() {
-  vec4 worldPos = transform.model * vec4(inPosition, 1.0);
+  // Casters missing this face land outside the clip volume, so none of their triangles are rasterized into it
+  if (isInstanceCulledFromView(gl_InstanceIndex, gl_ViewIndex))
+  {
+    gl_Position = vec4(0.0, 0.0, 2.0, 1.0);
+    return;
+  }
+
+  vec4 worldPos = getModelMatrix(getObjectIndex(gl_InstanceIndex)) * vec4(inPosition, 1.0);
   fragPos = worldPos.xyz;
 
   gl_Position = shadow.lightViewProj[gl_ViewIndex] * worldPos;
-}
\ No newline at end of file
+}
@@ -2,20 +2,23 @@
 #extension GL_GOOGLE_include_directive : require
 #include "../common/Lighting.glsl"
 
-layout(set = 1, binding = 0) uniform PointLightsMetadata {
+#define LIGHTING_SET 2
+#include "../common/LightClusters.glsl"
+
+layout(set = 2, binding = 0) uniform PointLightsMetadata {
   int numPointLights;
   int numSpotLights;
 };
 
-layout(set = 1, binding = 1) readonly buffer PointLights {
+layout(set = 2, binding = 1) readonly buffer PointLights {
   PointLight pointLights[];
 };
 
-layout(set = 1, binding = 2) readonly buffer SpotLights {
+layout(set = 2, binding = 2) readonly buffer SpotLights {
   SpotLight spotLights[];
 };
 
-layout(set = 1, binding = 3) uniform Camera {
+layout(set = 2, binding = 3) uniform Camera {
   vec3 position;
 } camera;
 
@@ -59,15 +62,17 @@ void main()
   color.b -= tension;
   color.r += tension;
 
+  uint clusterIndex = getLightClusterIndex(gl_FragCoord.xy, fragPos);
+
   vec3 result = vec3(0);
-  for (int i = 0; i < numPointLights; i++)
+  for (uint i = 0u; i < getClusterPointLightCount(clusterIndex); i++)
   {
-    result += StandardPointLightAffect(pointLights[i], color, fragNormal, fragPos, camera.position, 10);
+    result += StandardPointLightAffect(pointLights[getClusterPointLightIndex(clusterIndex, i)], color, fragNormal, fragPos, camera.position, 10);
   }
 
-  for (int i = 0; i < numSpotLights; i++)
+  for (uint i = 0u; i < getClusterSpotLightCount(clusterIndex); i++)
   {
-    result += StandardSpotLightAffect(spotLights[i], color, fragNormal, fragPos, camera.position, 10);
+    result += StandardSpotLightAffect(spotLights[getClusterSpotLightIndex(clusterIndex, i)], color, fragNormal, fragPos, camera.position, 10);
   }
 
   outColor = vec4(result, 1.0);
@@ -1,10 +1,6 @@
 #version 450
-
-layout(set = 0, binding = 0) uniform Transform {
-  mat4 model;
-  mat4 view;
-  mat4 proj;
-} transform;
+#extension GL_GOOGLE_include_directive : require
+#include "../common/Scene.glsl"
 
 layout(push_constant) uniform PushConstants {
   float wiggle;
@@ -23,7 +19,9 @@ void main()
   vec3 pos = inPosition;
   pos.z += sin(pos.x * 0.5) * wiggle;
 
-  fragPos = vec3(transform.model * vec4(pos, 1.0));
+  mat4 model = getModelMatrix(getObjectIndex(gl_InstanceIndex));
+
+  fragPos = vec3(model * vec4(pos, 1.0));
   fragTexCoord = inTexCoord;
-  fragNormal = mat3(transpose(inverse(transform.model))) * inNormal;
+  fragNormal = mat3(transpose(inverse(model))) * inNormal;
 }
\ No newline at end of file
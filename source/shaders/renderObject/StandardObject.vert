@@ -1,10 +1,6 @@
 #version 450
-
-layout(set = 0, binding = 0) uniform Transform {
-  mat4 model;
-  mat4 view;
-  mat4 proj;
-} transform;
+#extension GL_GOOGLE_include_directive : require
+#include "../common/Scene.glsl"
 
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inNormal;
@@ -13,12 +9,17 @@ layout(location = 2) in vec2 inTexCoord;
 layout(location = 0) out vec3 fragPos;
 layout(location = 1) out vec2 fragTexCoord;
 layout(location = 2) out vec3 fragNormal;
+layout(location = 3) flat out uint fragObjectIndex;
 
 void main()
 {
-  fragPos = vec3(transform.model * vec4(inPosition, 1.0));
+  uint objectIndex = getObjectIndex(gl_InstanceIndex);
+  mat4 model = getModelMatrix(objectIndex);
+
+  fragPos = vec3(model * vec4(inPosition, 1.0));
   fragTexCoord = inTexCoord;
-  fragNormal = mat3(transpose(inverse(transform.model))) * inNormal;
+  fragNormal = mat3(transpose(inverse(model))) * inNormal;
+  fragObjectIndex = objectIndex;
 
-  gl_Position = transform.proj * transform.view * transform.model * vec4(inPosition, 1.0);
-}
\ No newline at end of file
+  gl_Position = view.viewProj * model * vec4(inPosition, 1.0);
+}
@@ -1,7 +1,7 @@
 #version 450
 
-layout(set = 0, binding = 1) uniform sampler2D texSampler;
-layout(set = 0, binding = 4) uniform sampler2D specSampler;
+layout(set = 1, binding = 1) uniform sampler2D texSampler;
+layout(set = 1, binding = 4) uniform sampler2D specSampler;
 
 layout(location = 0) in vec3 fragPos;
 layout(location = 1) in vec2 fragTexCoord;
@@ -1,10 +1,6 @@
 #version 450
-
-layout(set = 0, binding = 0) uniform Transform {
-  mat4 model;
-  mat4 view;
-  mat4 proj;
-} transform;
+#extension GL_GOOGLE_include_directive : require
+#include "../common/Scene.glsl"
 
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inNormal;
@@ -16,9 +12,11 @@ layout(location = 2) out vec3 fragNormal;
 
 void main()
 {
-  fragPos = vec3(transform.model * vec4(inPosition, 1.0));
+  mat4 model = getModelMatrix(getObjectIndex(gl_InstanceIndex));
+
+  fragPos = vec3(model * vec4(inPosition, 1.0));
   fragTexCoord = inTexCoord;
-  fragNormal = mat3(transpose(inverse(transform.model))) * inNormal;
+  fragNormal = mat3(transpose(inverse(model))) * inNormal;
 
-  gl_Position = transform.proj * transform.view * transform.model * vec4(inPosition, 1.0);
-}
\ No newline at end of file
+  gl_Position = view.viewProj * model * vec4(inPosition, 1.0);
+}
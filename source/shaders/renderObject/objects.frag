@@ -2,40 +2,44 @@
 #extension GL_GOOGLE_include_directive : require
 #extension GL_EXT_nonuniform_qualifier : require
 #include "../common/Lighting.glsl"
+#include "../common/Scene.glsl"
 
-layout(set = 0, binding = 0) uniform Transform {
-  mat4 model;
-  mat4 view;
-  mat4 proj;
-} transform;
+#define LIGHTING_SET 2
+#include "../common/LightClusters.glsl"
 
-layout(set = 0, binding = 1) uniform sampler2D texSampler;
-layout(set = 0, binding = 4) uniform sampler2D specSampler;
+layout(set = 1, binding = 1) uniform sampler2D texSampler;
+layout(set = 1, binding = 4) uniform sampler2D specSampler;
 
-layout(set = 1, binding = 0) uniform PointLightsMetadata {
+layout(set = 2, binding = 0) uniform PointLightsMetadata {
   int numPointLights;
   int numSpotLights;
 };
 
-layout(set = 1, binding = 1) readonly buffer PointLights {
+layout(set = 2, binding = 1) readonly buffer PointLights {
   PointLight pointLights[];
 };
 
-layout(set = 1, binding = 2) readonly buffer SpotLights {
+layout(set = 2, binding = 2) readonly buffer SpotLights {
   SpotLight spotLights[];
 };
 
-layout(set = 1, binding = 3) uniform Camera {
+layout(set = 2, binding = 3) uniform Camera {
   vec3 position;
 } camera;
 
-layout(set = 1, binding = 4) uniform sampler2DShadow[] spotLightShadowMaps;
+layout(set = 2, binding = 4) uniform sampler2DShadow spotLightShadowAtlas;
 
-layout(set = 1, binding = 5) uniform samplerCubeShadow[] pointLightShadowMaps;
+// One cube map array per shadow map size
+layout(set = 2, binding = 5) uniform samplerCubeArrayShadow pointLightShadowMaps[4];
+
+layout(set = 2, binding = 6) readonly buffer SpotLightShadows {
+  SpotLightShadow spotLightShadows[];
+};
 
 layout(location = 0) in vec3 fragPos;
 layout(location = 1) in vec2 fragTexCoord;
 layout(location = 2) in vec3 fragNormal;
+layout(location = 3) flat in uint fragObjectIndex;
 
 layout(location = 0) out vec4 outColor;
 
@@ -44,21 +48,29 @@ void main()
   vec3 texColor = texture(texSampler, fragTexCoord).rgb;
   vec3 specColor = texture(specSampler, fragTexCoord).rgb;
 
+  bool receivesShadows = objects.data[fragObjectIndex].receivesShadows != 0u;
+
+  uint clusterIndex = getLightClusterIndex(gl_FragCoord.xy, fragPos);
+
   vec3 result = vec3(0);
-  for (int i = 0; i < numPointLights; i++)
+  for (uint i = 0u; i < getClusterPointLightCount(clusterIndex); i++)
   {
-    PointLight light = pointLights[i];
+    PointLight light = pointLights[getClusterPointLightIndex(clusterIndex, i)];
 
     vec3 fragToLight = light.position - fragPos;
     fragToLight.xz *= -1.0;
 
     float currentDist = length(fragToLight);
-    float ref = currentDist / 100.0;
+    float ref = currentDist / light.range;
 
     float bias = 0.001;
     ref -= bias;
 
-    float shadow = texture(pointLightShadowMaps[nonuniformEXT(i)], vec4(fragToLight, ref));
+    float shadow = 1.0;
+    if (receivesShadows && light.shadowMapIndex >= 0)
+    {
+      shadow = texture(pointLightShadowMaps[nonuniformEXT(light.shadowMapTier)], vec4(fragToLight, light.shadowMapIndex), ref);
+    }
 
     if (shadow > 0.1)
     {
@@ -66,28 +78,45 @@ void main()
     }
     else
     {
-      result += getStandardAmbient(light.ambient, texColor);
+      result += getStandardAmbient(light.ambient, texColor) * getRangeFalloff(light.position, light.range, fragPos);
     }
   }
 
-  for (int i = 0; i < numSpotLights; i++)
+  for (uint i = 0u; i < getClusterSpotLightCount(clusterIndex); i++)
   {
-    vec4 fragPosLightSpace = spotLights[i].lightViewProjection * vec4(fragPos, 1.0);
-    vec3 projCoords = fragPosLightSpace.xyz / fragPosLightSpace.w;
-    projCoords.xy = projCoords.xy * 0.5 + 0.5;
+    uint lightIndex = getClusterSpotLightIndex(clusterIndex, i);
+    SpotLight light = spotLights[lightIndex];
 
-    float bias = 0.0001;
-    projCoords.z -= bias;
+    float shadow = 1.0;
+    if (receivesShadows)
+    {
+      SpotLightShadow lightShadow = spotLightShadows[lightIndex];
+
+      vec4 fragPosLightSpace = lightShadow.lightViewProjection * vec4(fragPos, 1.0);
+      vec3 projCoords = fragPosLightSpace.xyz / fragPosLightSpace.w;
+      projCoords.xy = projCoords.xy * 0.5 + 0.5;
+
+      float bias = 0.0001;
+      projCoords.z -= bias;
 
-    float shadow = texture(spotLightShadowMaps[nonuniformEXT(i)], projCoords);
+      vec4 atlasRect = lightShadow.shadowAtlasRect;
+
+      // Past the edges of the light's tile lie the tiles of other lights
+      bool inShadowMap = all(greaterThanEqual(projCoords, vec3(0.0))) && all(lessThanEqual(projCoords, vec3(1.0)));
+
+      if (atlasRect.z > 0.0 && inShadowMap)
+      {
+        shadow = texture(spotLightShadowAtlas, vec3(atlasRect.xy + projCoords.xy * atlasRect.zw, projCoords.z));
+      }
+    }
 
     if (shadow > 0.5)
     {
-      result += SpecularMapSpotLightAffect(spotLights[i], texColor, specColor, fragNormal, fragPos, camera.position, 32);
+      result += SpecularMapSpotLightAffect(light, texColor, specColor, fragNormal, fragPos, camera.position, 32);
     }
     else
     {
-      result += getStandardAmbient(spotLights[i].ambient, texColor);
+      result += getStandardAmbient(light.ambient, texColor) * getRangeFalloff(light.position, light.range, fragPos);
     }
   }
 
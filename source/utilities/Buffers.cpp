@@ -1,16 +1,39 @@
 #include "Buffers.h"
-#include "../components/commandBuffer/SingleUseCommandBuffer.h"
+#include "../components/commandBuffer/CommandBuffer.h"
 #include "../components/logicalDevice/LogicalDevice.h"
-#include "../components/physicalDevice/PhysicalDevice.h"
+#include "../components/memory/MemoryAllocator.h"
+#include <stdexcept>
 
 namespace vke::Buffers {
 
+  // Host written data read on the GPU is better off in device local memory the host can also see, such as resizable BAR
+  vk::MemoryPropertyFlags getPreferredProperties(const vk::BufferUsageFlags usage,
+                                                 const vk::MemoryPropertyFlags properties)
+  {
+    constexpr auto gpuReadUsage = vk::BufferUsageFlagBits::eUniformBuffer | vk::BufferUsageFlagBits::eStorageBuffer |
+                                  vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eIndexBuffer |
+                                  vk::BufferUsageFlagBits::eShaderBindingTableKHR;
+
+    if ((properties & vk::MemoryPropertyFlagBits::eHostVisible) && (usage & gpuReadUsage))
+    {
+      return properties | vk::MemoryPropertyFlagBits::eDeviceLocal;
+    }
+
+    // Readback targets are only read by the host, where cached memory is far faster to read from
+    if ((properties & vk::MemoryPropertyFlagBits::eHostVisible) && usage == vk::BufferUsageFlagBits::eTransferDst)
+    {
+      return properties | vk::MemoryPropertyFlagBits::eHostCached;
+    }
+
+    return properties;
+  }
+
   void createBuffer(const std::shared_ptr<LogicalDevice>& logicalDevice,
                     const vk::DeviceSize size,
                     const vk::BufferUsageFlags usage,
                     const vk::MemoryPropertyFlags properties,
                     vk::raii::Buffer& buffer,
-                    vk::raii::DeviceMemory& bufferMemory)
+                    MemoryAllocation& bufferMemory)
   {
     const vk::BufferCreateInfo bufferInfo {
       .size = size,
@@ -20,63 +43,48 @@ namespace vke::Buffers {
 
     buffer = logicalDevice->createBuffer(bufferInfo);
 
-    const vk::MemoryRequirements memoryRequirements = buffer.getMemoryRequirements();
+    bufferMemory = logicalDevice->getMemoryAllocator().allocate(
+      buffer.getMemoryRequirements(),
+      properties,
+      getPreferredProperties(usage, properties),
+      ResourceTiling::linear
+    );
 
-    const vk::MemoryAllocateFlagsInfo allocateFlagsInfo {
-      .flags = (usage & vk::BufferUsageFlagBits::eShaderDeviceAddress)
-                 ? vk::MemoryAllocateFlagBits::eDeviceAddress
-                 : vk::MemoryAllocateFlags{}
-    };
-
-    const vk::MemoryAllocateInfo allocateInfo {
-      .pNext = &allocateFlagsInfo,
-      .allocationSize = memoryRequirements.size,
-      .memoryTypeIndex = logicalDevice->getPhysicalDevice()->findMemoryType(memoryRequirements.memoryTypeBits, properties)
-    };
-
-    logicalDevice->allocateMemory(allocateInfo, bufferMemory);
-
-    buffer.bindMemory(bufferMemory, 0);
+    buffer.bindMemory(bufferMemory.getMemory(), bufferMemory.getOffset());
   }
 
-  void copyBuffer(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                  const vk::CommandPool& commandPool,
-                  const vk::Queue queue,
-                  vk::Buffer srcBuffer,
-                  vk::Buffer dstBuffer,
-                  const vk::DeviceSize size)
+  void copyBuffer(const CommandBuffer& commandBuffer,
+                  const vk::Buffer srcBuffer,
+                  const vk::Buffer dstBuffer,
+                  const vk::DeviceSize size,
+                  const vk::DeviceSize srcOffset,
+                  const vk::DeviceSize dstOffset)
   {
-    const auto commandBuffer = SingleUseCommandBuffer(logicalDevice, commandPool, queue);
-
-    commandBuffer.record([&commandBuffer, &srcBuffer, &dstBuffer, size] {
-      const vk::BufferCopy copyRegion {
-        .size = size
-      };
+    const vk::BufferCopy copyRegion {
+      .srcOffset = srcOffset,
+      .dstOffset = dstOffset,
+      .size = size
+    };
 
-      commandBuffer.copyBuffer(
-        srcBuffer,
-        dstBuffer,
-        { copyRegion }
-      );
-    });
+    commandBuffer.copyBuffer(
+      srcBuffer,
+      dstBuffer,
+      { copyRegion }
+    );
   }
 
-  void doMappedMemoryOperation(const vk::raii::DeviceMemory& deviceMemory,
+  void doMappedMemoryOperation(const MemoryAllocation& deviceMemory,
                                const std::function<void(void* data)>& operationFunction)
   {
-    void* data = deviceMemory.mapMemory(0, vk::WholeSize);
+    // Host visible blocks stay mapped, so there is nothing to map or unmap around the operation
+    void* data = deviceMemory.getMappedData();
 
-    try
-    {
-      operationFunction(data);
-    }
-    catch (...)
+    if (!data)
     {
-      deviceMemory.unmapMemory();
-      throw;
+      throw std::runtime_error("memory is not host visible!");
     }
 
-    deviceMemory.unmapMemory();
+    operationFunction(data);
   }
 
 } // namespace vke::Buffers
\ No newline at end of file
@@ -1,12 +1,14 @@
 #ifndef VKE_BUFFERS_H
 #define VKE_BUFFERS_H
 
+#include "../components/memory/MemoryAllocation.h"
 #include <vulkan/vulkan_raii.hpp>
 #include <functional>
 #include <memory>
 
 namespace vke {
 
+  class CommandBuffer;
   class LogicalDevice;
 
   namespace Buffers {
@@ -15,16 +17,16 @@ namespace vke {
                       vk::BufferUsageFlags usage,
                       vk::MemoryPropertyFlags properties,
                       vk::raii::Buffer& buffer,
-                      vk::raii::DeviceMemory& bufferMemory);
+                      MemoryAllocation& bufferMemory);
 
-    void copyBuffer(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                    const vk::CommandPool& commandPool,
-                    vk::Queue queue,
+    void copyBuffer(const CommandBuffer& commandBuffer,
                     vk::Buffer srcBuffer,
                     vk::Buffer dstBuffer,
-                    vk::DeviceSize size);
+                    vk::DeviceSize size,
+                    vk::DeviceSize srcOffset = 0,
+                    vk::DeviceSize dstOffset = 0);
 
-    void doMappedMemoryOperation(const vk::raii::DeviceMemory& deviceMemory,
+    void doMappedMemoryOperation(const MemoryAllocation& deviceMemory,
                                  const std::function<void(void* data)>& operationFunction);
   }
 
@@ -1,14 +1,14 @@
 #include "Images.h"
 #include "Buffers.h"
-#include "../components/commandBuffer/SingleUseCommandBuffer.h"
+#include "../components/commandBuffer/CommandBuffer.h"
 #include "../components/logicalDevice/LogicalDevice.h"
-#include "../components/physicalDevice/PhysicalDevice.h"
+#include "../components/memory/MemoryAllocator.h"
 #include <stdexcept>
 
 namespace vke::Images {
 
-  std::pair<vk::raii::Image, vk::raii::DeviceMemory> createImage(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                                                 const ImageConfig& imageConfig)
+  std::pair<vk::raii::Image, MemoryAllocation> createImage(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                                                           const ImageConfig& imageConfig)
   {
     const vk::ImageCreateInfo imageCreateInfo{
       .flags = imageConfig.flags,
@@ -26,18 +26,14 @@ namespace vke::Images {
 
     vk::raii::Image image = logicalDevice->createImage(imageCreateInfo);
 
-    const vk::MemoryRequirements memoryRequirements = image.getMemoryRequirements();
-
-    const vk::MemoryAllocateInfo allocateInfo {
-      .allocationSize = memoryRequirements.size,
-      .memoryTypeIndex = logicalDevice->getPhysicalDevice()->findMemoryType(memoryRequirements.memoryTypeBits,
-                                                                            imageConfig.properties)
-    };
-
-    vk::raii::DeviceMemory imageMemory = nullptr;
-    logicalDevice->allocateMemory(allocateInfo, imageMemory);
+    auto imageMemory = logicalDevice->getMemoryAllocator().allocate(
+      image.getMemoryRequirements(),
+      imageConfig.properties,
+      imageConfig.properties,
+      imageConfig.tiling == vk::ImageTiling::eOptimal ? ResourceTiling::optimal : ResourceTiling::linear
+    );
 
-    image.bindMemory(*imageMemory, 0);
+    image.bindMemory(imageMemory.getMemory(), imageMemory.getOffset());
 
     return { std::move(image), std::move(imageMemory) };
   }
@@ -180,90 +176,81 @@ namespace vke::Images {
     return transitionInfo;
   }
 
-  void transitionImageLayout(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                             const vk::CommandPool commandPool,
-                             vk::Image image,
+  void transitionImageLayout(const CommandBuffer& commandBuffer,
+                             const vk::Image image,
                              const vk::Format format,
                              const vk::ImageLayout oldLayout,
                              const vk::ImageLayout newLayout,
                              const uint32_t mipLevels,
                              const uint32_t layerCount)
   {
-    const auto commandBuffer = SingleUseCommandBuffer(logicalDevice, commandPool, logicalDevice->getGraphicsQueue());
-
-    commandBuffer.record([&commandBuffer, image, format, oldLayout, newLayout, mipLevels, layerCount] {
-      const auto [aspectMask,
-                  srcAccessMask,
-                  dstAccessMask,
-                  sourceStage,
-                  destinationStage] = getTransitionInfo(oldLayout, newLayout, format);
-
-      const vk::ImageMemoryBarrier imageMemoryBarrier {
-        .srcAccessMask = srcAccessMask,
-        .dstAccessMask = dstAccessMask,
-        .oldLayout = oldLayout,
-        .newLayout = newLayout,
-        .srcQueueFamilyIndex = vk::QueueFamilyIgnored,
-        .dstQueueFamilyIndex = vk::QueueFamilyIgnored,
-        .image = image,
-        .subresourceRange = {
-          .aspectMask = aspectMask,
-          .baseMipLevel = 0,
-          .levelCount = mipLevels,
-          .baseArrayLayer = 0,
-          .layerCount = layerCount
-        }
-      };
+    const auto [aspectMask,
+                srcAccessMask,
+                dstAccessMask,
+                sourceStage,
+                destinationStage] = getTransitionInfo(oldLayout, newLayout, format);
+
+    const vk::ImageMemoryBarrier imageMemoryBarrier {
+      .srcAccessMask = srcAccessMask,
+      .dstAccessMask = dstAccessMask,
+      .oldLayout = oldLayout,
+      .newLayout = newLayout,
+      .srcQueueFamilyIndex = vk::QueueFamilyIgnored,
+      .dstQueueFamilyIndex = vk::QueueFamilyIgnored,
+      .image = image,
+      .subresourceRange = {
+        .aspectMask = aspectMask,
+        .baseMipLevel = 0,
+        .levelCount = mipLevels,
+        .baseArrayLayer = 0,
+        .layerCount = layerCount
+      }
+    };
 
-      commandBuffer.pipelineBarrier(
-        sourceStage,
-        destinationStage,
-        {},
-        {},
-        {},
-        { imageMemoryBarrier }
-      );
-    });
+    commandBuffer.pipelineBarrier(
+      sourceStage,
+      destinationStage,
+      {},
+      {},
+      {},
+      { imageMemoryBarrier }
+    );
   }
 
-  void copyBufferToImage(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                         const vk::CommandPool commandPool,
-                         vk::Buffer buffer,
-                         vk::Image image,
+  void copyBufferToImage(const CommandBuffer& commandBuffer,
+                         const vk::Buffer buffer,
+                         const vk::DeviceSize bufferOffset,
+                         const vk::Image image,
                          const uint32_t width,
                          const uint32_t height,
                          const uint32_t depth)
   {
-    const auto commandBuffer = SingleUseCommandBuffer(logicalDevice, commandPool, logicalDevice->getGraphicsQueue());
-
-    commandBuffer.record([&commandBuffer, buffer, image, width, height, depth] {
-      const vk::BufferImageCopy region {
-        .bufferOffset = 0,
-        .bufferRowLength = 0,
-        .bufferImageHeight = 0,
-        .imageSubresource = {
-          .aspectMask = vk::ImageAspectFlagBits::eColor,
-          .mipLevel = 0,
-          .baseArrayLayer = 0,
-          .layerCount = 1
-        },
-        .imageOffset = { 0, 0, 0 },
-        .imageExtent = { width, height, depth }
-      };
+    const vk::BufferImageCopy region {
+      .bufferOffset = bufferOffset,
+      .bufferRowLength = 0,
+      .bufferImageHeight = 0,
+      .imageSubresource = {
+        .aspectMask = vk::ImageAspectFlagBits::eColor,
+        .mipLevel = 0,
+        .baseArrayLayer = 0,
+        .layerCount = 1
+      },
+      .imageOffset = { 0, 0, 0 },
+      .imageExtent = { width, height, depth }
+    };
 
-      commandBuffer.copyBufferToImage(
-        buffer,
-        image,
-        vk::ImageLayout::eTransferDstOptimal,
-        { region }
-      );
-    });
+    commandBuffer.copyBufferToImage(
+      buffer,
+      image,
+      vk::ImageLayout::eTransferDstOptimal,
+      { region }
+    );
   }
 
   void copyImageToBuffer(const vk::Image image,
                          const vk::Offset3D offset,
                          const vk::Extent3D extent,
-                         const SingleUseCommandBuffer& commandBuffer,
+                         const CommandBuffer& commandBuffer,
                          const vk::Buffer stagingBuffer)
   {
     const vk::BufferImageCopy region {
@@ -294,7 +281,8 @@ namespace vke::Images {
                                        const vk::ImageAspectFlags aspectFlags,
                                        const uint32_t mipLevels,
                                        const vk::ImageViewType viewType,
-                                       const uint32_t layerCount)
+                                       const uint32_t layerCount,
+                                       const uint32_t baseArrayLayer)
   {
     const vk::ImageViewCreateInfo imageViewCreateInfo {
       .image = image,
@@ -310,7 +298,7 @@ namespace vke::Images {
         .aspectMask = aspectFlags,
         .baseMipLevel = 0,
         .levelCount = mipLevels,
-        .baseArrayLayer = 0,
+        .baseArrayLayer = baseArrayLayer,
         .layerCount = layerCount
       }
     };
@@ -1,13 +1,14 @@
 #ifndef VKE_IMAGES_H
 #define VKE_IMAGES_H
 
+#include "../components/memory/MemoryAllocation.h"
 #include <vulkan/vulkan_raii.hpp>
 #include <memory>
 
 namespace vke {
 
+  class CommandBuffer;
   class LogicalDevice;
-  class SingleUseCommandBuffer;
 
   namespace Images {
 
@@ -24,11 +25,10 @@ namespace vke {
       vk::MemoryPropertyFlags properties;
     };
 
-    std::pair<vk::raii::Image, vk::raii::DeviceMemory> createImage(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                                                                   const ImageConfig& imageConfig);
+    std::pair<vk::raii::Image, MemoryAllocation> createImage(const std::shared_ptr<LogicalDevice>& logicalDevice,
+                                                             const ImageConfig& imageConfig);
 
-    void transitionImageLayout(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                               vk::CommandPool commandPool,
+    void transitionImageLayout(const CommandBuffer& commandBuffer,
                                vk::Image image,
                                vk::Format format,
                                vk::ImageLayout oldLayout,
@@ -36,9 +36,9 @@ namespace vke {
                                uint32_t mipLevels,
                                uint32_t layerCount);
 
-    void copyBufferToImage(const std::shared_ptr<LogicalDevice>& logicalDevice,
-                           vk::CommandPool commandPool,
+    void copyBufferToImage(const CommandBuffer& commandBuffer,
                            vk::Buffer buffer,
+                           vk::DeviceSize bufferOffset,
                            vk::Image image,
                            uint32_t width,
                            uint32_t height,
@@ -47,7 +47,7 @@ namespace vke {
     void copyImageToBuffer(vk::Image image,
                            vk::Offset3D offset,
                            vk::Extent3D extent,
-                           const SingleUseCommandBuffer& commandBuffer,
+                           const CommandBuffer& commandBuffer,
                            vk::Buffer stagingBuffer);
 
     vk::raii::ImageView createImageView(const std::shared_ptr<LogicalDevice>& logicalDevice,
@@ -56,7 +56,8 @@ namespace vke {
                                         vk::ImageAspectFlags aspectFlags,
                                         uint32_t mipLevels,
                                         vk::ImageViewType viewType,
-                                        uint32_t layerCount);
+                                        uint32_t layerCount,
+                                        uint32_t baseArrayLayer = 0);
 
     bool hasStencilComponent(vk::Format format);
 
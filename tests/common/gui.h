@@ -47,17 +47,24 @@ inline void displayObjectGui(const std::shared_ptr<vke::RenderObject>& object,
 
   if (ImGui::CollapsingHeader(("Object " + std::to_string(id)).c_str()))
   {
+    // Only applied when edited, so objects left alone keep their cached shadow maps
     glm::vec3 position = object->getPosition();
-    ImGui::SliderFloat3("Position", value_ptr(position), -50.0f, 50.0f);
-    object->setPosition(position);
+    if (ImGui::SliderFloat3("Position", value_ptr(position), -50.0f, 50.0f))
+    {
+      object->setPosition(position);
+    }
 
     glm::vec3 scale = object->getScale();
-    ImGui::SliderFloat3("Scale", value_ptr(scale), 0.01f, 50.0f);
-    object->setScale(scale);
+    if (ImGui::SliderFloat3("Scale", value_ptr(scale), 0.01f, 50.0f))
+    {
+      object->setScale(scale);
+    }
 
     glm::vec3 rotation = object->getOrientationEuler();
-    ImGui::SliderFloat3("Rotation", value_ptr(rotation), -90.0f, 90.0f);
-    object->setOrientationEuler(rotation);
+    if (ImGui::SliderFloat3("Rotation", value_ptr(rotation), -90.0f, 90.0f))
+    {
+      object->setOrientationEuler(rotation);
+    }
 
     auto reflectivity = object->getReflectivity();
     if (ImGui::SliderFloat("Reflectivity", &reflectivity, 0.0f, 1.0f))
@@ -76,6 +83,18 @@ inline void displayObjectGui(const std::shared_ptr<vke::RenderObject>& object,
     {
       object->setIndexOfRefraction(indexOfRefraction);
     }
+
+    auto castsShadows = object->castsShadows();
+    if (ImGui::Checkbox("Casts Shadows", &castsShadows))
+    {
+      object->setCastsShadows(castsShadows);
+    }
+
+    auto receivesShadows = object->receivesShadows();
+    if (ImGui::Checkbox("Receives Shadows", &receivesShadows))
+    {
+      object->setReceivesShadows(receivesShadows);
+    }
   }
 
   ImGui::PopID();
@@ -91,6 +110,7 @@ inline void displayLightGui(const std::shared_ptr<vke::Light>& light,
   float ambient = light->getAmbient();
   float diffuse = light->getDiffuse();
   float specular = light->getSpecular();
+  float range = light->getRange();
   bool isSpotLight = light->getLightType() == vke::LightType::spotLight;
 
   if (isSpotLight)
@@ -110,6 +130,7 @@ inline void displayLightGui(const std::shared_ptr<vke::Light>& light,
     ImGui::SliderFloat("Ambient", &ambient, 0.0f, 1.0f);
     ImGui::SliderFloat("Diffuse", &diffuse, 0.0f, 1.0f);
     ImGui::SliderFloat("Specular", &specular, 0.0f, 1.0f);
+    ImGui::SliderFloat("Range", &range, 1.0f, 200.0f);
     ImGui::SliderFloat3("Position", value_ptr(position), -50.0f, 50.0f);
     ImGui::SliderFloat3("Direction", value_ptr(direction), -1.0f, 1.0f);
     ImGui::SliderFloat("Cone Angle", &coneAngle, 0.0f, 180.0f);
@@ -123,6 +144,7 @@ inline void displayLightGui(const std::shared_ptr<vke::Light>& light,
   light->setAmbient(ambient);
   light->setDiffuse(diffuse);
   light->setSpecular(specular);
+  light->setRange(range);
   if (isSpotLight)
   {
     spotLight->setDirection(direction);
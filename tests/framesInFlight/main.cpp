@@ -0,0 +1,204 @@
+#include <source/components/lighting/LightingManager.h>
+#include <source/components/logicalDevice/LogicalDevice.h>
+#include <source/components/assets/objects/RenderObject.h>
+#include <source/components/assets/AssetManager.h>
+#include <source/components/imGui/ImGuiInstance.h>
+#include <source/components/pipelines/implementations/common/PipelineTypes.h>
+#include <source/components/renderingManager/RenderingManager.h>
+#include <source/components/renderingManager/renderer3D/Renderer3D.h>
+#include <source/VulkanEngine.h>
+#include <imgui.h>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Renders a GPU heavy scene for a fixed number of frames and reports the throughput and latency for the
+// configured number of frames in flight. Usage: framesInFlight [framesInFlight] [numFrames] [gridSize]
+
+using Clock = std::chrono::steady_clock;
+
+struct PendingFrame {
+  uint64_t timelineValue;
+  Clock::time_point start;
+};
+
+struct BenchmarkResults {
+  std::vector<double> frameTimes;
+  std::vector<double> latencies;
+};
+
+std::vector<std::shared_ptr<vke::RenderObject>> createObjects(const vke::VulkanEngine& renderer,
+                                                              int gridSize);
+
+std::vector<std::shared_ptr<vke::Light>> createLights(const vke::VulkanEngine& renderer);
+
+void collectCompletedFrames(const std::shared_ptr<vke::LogicalDevice>& logicalDevice,
+                            std::deque<PendingFrame>& pendingFrames,
+                            std::vector<double>& latencies);
+
+double percentile(std::vector<double> values,
+                  double percent);
+
+void printResults(uint32_t framesInFlight,
+                  const BenchmarkResults& results);
+
+int main(const int argc,
+         char* argv[])
+{
+  try
+  {
+    const uint32_t framesInFlight = argc > 1 ? std::stoul(argv[1]) : 2;
+    const int numFrames = argc > 2 ? std::stoi(argv[2]) : 1000;
+    const int gridSize = argc > 3 ? std::stoi(argv[3]) : 20;
+
+    const vke::EngineConfig engineConfig {
+      .window {
+        .width = 1280,
+        .height = 720,
+        .title = "Frames In Flight"
+      },
+      .camera {
+        .position = { 0.0f, 20.0f, -40.0f }
+      },
+      .rendering {
+        .framesInFlight = framesInFlight
+      }
+    };
+
+    vke::VulkanEngine renderer(engineConfig);
+
+    ImGui::SetCurrentContext(vke::ImGuiInstance::getImGuiContext());
+
+    const auto objects = createObjects(renderer, gridSize);
+    const auto lights = createLights(renderer);
+
+    const auto r3d = renderer.getRenderingManager()->getRenderer3D();
+    const auto logicalDevice = renderer.getLogicalDevice();
+
+    BenchmarkResults results;
+    results.frameTimes.reserve(numFrames);
+    results.latencies.reserve(numFrames);
+
+    std::deque<PendingFrame> pendingFrames;
+
+    for (int frame = 0; frame < numFrames && renderer.isActive(); ++frame)
+    {
+      const auto frameStart = Clock::now();
+
+      for (const auto& object : objects)
+      {
+        r3d->renderObject(object, vke::PipelineType::object);
+      }
+
+      for (const auto& light : lights)
+      {
+        renderer.getLightingManager()->renderLight(light);
+      }
+
+      renderer.render();
+
+      pendingFrames.push_back({ logicalDevice->getSubmittedGraphicsTimelineValue(), frameStart });
+
+      collectCompletedFrames(logicalDevice, pendingFrames, results.latencies);
+
+      results.frameTimes.push_back(std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count());
+    }
+
+    logicalDevice->waitIdle();
+    collectCompletedFrames(logicalDevice, pendingFrames, results.latencies);
+
+    printResults(framesInFlight, results);
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+std::vector<std::shared_ptr<vke::RenderObject>> createObjects(const vke::VulkanEngine& renderer,
+                                                              const int gridSize)
+{
+  const auto texture = renderer.getAssetManager()->loadTexture("assets/textures/white.png");
+  const auto specularMap = renderer.getAssetManager()->loadTexture("assets/textures/blank_specular.png");
+  const auto model = renderer.getAssetManager()->loadModel("assets/models/square.glb");
+
+  std::vector<std::shared_ptr<vke::RenderObject>> objects;
+  objects.reserve(gridSize * gridSize);
+
+  for (int x = 0; x < gridSize; ++x)
+  {
+    for (int z = 0; z < gridSize; ++z)
+    {
+      const auto object = renderer.getAssetManager()->loadRenderObject(texture, specularMap, model);
+      object->setPosition({ (x - gridSize / 2) * 3.0f, 0, (z - gridSize / 2) * 3.0f });
+      objects.push_back(object);
+    }
+  }
+
+  return objects;
+}
+
+std::vector<std::shared_ptr<vke::Light>> createLights(const vke::VulkanEngine& renderer)
+{
+  return {
+    renderer.getLightingManager()->createPointLight({0, 5.0f, 0}, {1.0f, 1.0f, 1.0f}, 0.1f, 0.5f, 1.0f),
+    renderer.getLightingManager()->createPointLight({15.0f, 5.0f, 15.0f}, {1.0f, 1.0f, 0}, 0, 0.5f, 1.0f),
+    renderer.getLightingManager()->createPointLight({-15.0f, 5.0f, -15.0f}, {0.5f, 0.5f, 1.0f}, 0, 0.5f, 1.0f),
+    renderer.getLightingManager()->createPointLight({15.0f, 5.0f, -15.0f}, {0, 1.0f, 0}, 0, 0.5f, 1.0f)
+  };
+}
+
+void collectCompletedFrames(const std::shared_ptr<vke::LogicalDevice>& logicalDevice,
+                            std::deque<PendingFrame>& pendingFrames,
+                            std::vector<double>& latencies)
+{
+  // Completion is only observed when polled, so latencies are upper bounds with one frame of resolution
+  const auto completedValue = logicalDevice->getCompletedGraphicsTimelineValue();
+  const auto now = Clock::now();
+
+  while (!pendingFrames.empty() && pendingFrames.front().timelineValue <= completedValue)
+  {
+    latencies.push_back(std::chrono::duration<double, std::milli>(now - pendingFrames.front().start).count());
+    pendingFrames.pop_front();
+  }
+}
+
+double percentile(std::vector<double> values,
+                  const double percent)
+{
+  if (values.empty())
+  {
+    return 0.0;
+  }
+
+  const auto index = static_cast<size_t>(percent / 100.0 * static_cast<double>(values.size() - 1));
+  std::ranges::nth_element(values, values.begin() + static_cast<std::ptrdiff_t>(index));
+
+  return values[index];
+}
+
+void printResults(const uint32_t framesInFlight,
+                  const BenchmarkResults& results)
+{
+  double totalFrameTime = 0.0;
+  for (const auto frameTime : results.frameTimes)
+  {
+    totalFrameTime += frameTime;
+  }
+
+  const double averageFrameTime = results.frameTimes.empty() ? 0.0 : totalFrameTime / static_cast<double>(results.frameTimes.size());
+
+  std::cout << "frames in flight: " << framesInFlight << "\n"
+            << "frames rendered:  " << results.frameTimes.size() << "\n"
+            << "throughput:       " << (averageFrameTime > 0.0 ? 1000.0 / averageFrameTime : 0.0) << " fps\n"
+            << "frame time p50:   " << percentile(results.frameTimes, 50) << " ms\n"
+            << "frame time p95:   " << percentile(results.frameTimes, 95) << " ms\n"
+            << "latency p50:      " << percentile(results.latencies, 50) << " ms\n"
+            << "latency p95:      " << percentile(results.latencies, 95) << " ms" << std::endl;
+}
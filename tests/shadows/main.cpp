@@ -29,6 +29,11 @@ int main()
       },
       .camera {
         .position = { 0.0f, 0.0f, -5.0f }
+      },
+      .profiling {
+        .gpuTimings = true,
+        .gpuPipelineStatistics = true,
+        .gpuOverlay = true
       }
     };
 